@@ -0,0 +1,46 @@
+#include "BenchApp.h"
+
+#include "../source/controllers/Random.h"
+#include "../source/loaders/CustomScene2Loader.h"
+#include "LevelGeneratorBench.h"
+#include "NetworkBench.h"
+#include "PhysicsBench.h"
+#include "SceneBench.h"
+
+/** The seed of the random streams, so every run does the same work. */
+#define RANDOM_SEED 1
+
+namespace bench {
+
+void BenchApp::onStartup() {
+  Random::Init(RANDOM_SEED);
+
+  // Sounds are never played, so they are never loaded.
+  _assets = cugl::AssetManager::alloc();
+  _assets->attach<cugl::Texture>(cugl::TextureLoader::alloc()->getHook());
+  _assets->attach<cugl::Font>(cugl::FontLoader::alloc()->getHook());
+  _assets->attach<cugl::JsonValue>(cugl::JsonLoader::alloc()->getHook());
+  _assets->attach<cugl::WidgetValue>(cugl::WidgetLoader::alloc()->getHook());
+  _assets->attach<cugl::scene2::SceneNode>(
+      cugl::CustomScene2Loader::alloc()->getHook());
+  _assets->loadDirectory("json/assets.json");
+  _assets->loadDirectory("json/tiles.json");
+
+  _passed = benchNetwork(_runner) && _passed;
+  benchGenerators(_runner);
+  _passed = benchScene(_runner, _assets) && _passed;
+  benchPhysics(_runner);
+
+  if (!_output.empty()) _runner.write(_output);
+  quit();
+
+  cugl::Application::onStartup();  // YOU MUST END with call to parent.
+}
+
+void BenchApp::onShutdown() {
+  _assets = nullptr;
+
+  cugl::Application::onShutdown();  // YOU MUST END with call to parent.
+}
+
+}  // namespace bench
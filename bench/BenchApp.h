@@ -0,0 +1,63 @@
+#ifndef BENCH_BENCH_APP_H_
+#define BENCH_BENCH_APP_H_
+#include <cugl/cugl.h>
+
+#include "Benchmark.h"
+
+namespace bench {
+
+/**
+ * This class is the application root of the benchmark suite.
+ *
+ * The scene benchmarks need the game's assets, so the suite runs in a
+ * headless Application with the null renderer, which needs no GPU. It loads
+ * the assets the way HeadlessApp does, runs every benchmark once it has
+ * started, writes the results and quits without running a single frame.
+ */
+class BenchApp : public cugl::Application {
+  /** The global asset manager */
+  std::shared_ptr<cugl::AssetManager> _assets;
+  /** The runner timing every benchmark */
+  Runner _runner;
+  /** The file to write the results to, or empty to only log them */
+  std::string _output;
+  /** If every benchmark passed its checks */
+  bool _passed;
+
+ public:
+  /**
+   * Creates the application with the given runner settings.
+   *
+   * @param warmup The number of untimed iterations of each benchmark.
+   * @param iterations The number of timed iterations of each benchmark.
+   */
+  BenchApp(int warmup, int iterations)
+      : _runner(warmup, iterations), _passed(true) {}
+
+  /**
+   * Only runs the benchmarks whose names contain the filter.
+   *
+   * @param filter The filter, or the empty string to run every benchmark.
+   */
+  void setFilter(const std::string &filter) { _runner.setFilter(filter); }
+
+  /**
+   * Sets the file to write the results to as JSON.
+   *
+   * @param path The file, or the empty string to only log the results.
+   */
+  void setOutput(const std::string &path) { _output = path; }
+
+  /** @return If every benchmark passed its checks. */
+  bool hasPassed() const { return _passed; }
+
+  /** Loads the assets and runs every benchmark. */
+  void onStartup() override;
+
+  /** Releases the assets. */
+  void onShutdown() override;
+};
+
+}  // namespace bench
+
+#endif  // BENCH_BENCH_APP_H_
@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+
+/** The version of the results format, bumped when fields change. */
+#define RESULTS_VERSION 2
+
+namespace bench {
+
+namespace {
+
+/**
+ * Returns a percentile of sorted samples, by nearest rank.
+ *
+ * @param sorted The samples, in increasing order.
+ * @param percent The percentile, from 0 to 100.
+ * @return The sample at the percentile.
+ */
+double percentile(const std::vector<double> &sorted, double percent) {
+  size_t rank = (size_t)(percent / 100.0 * sorted.size() + 0.5);
+  rank = std::min(std::max(rank, (size_t)1), sorted.size());
+  return sorted[rank - 1];
+}
+
+}  // namespace
+
+bool Runner::run(const std::string &name, const std::function<void()> &setup,
+                 const std::function<void()> &body) {
+  if (!accepts(name) || _iterations <= 0) return false;
+
+  for (int i = 0; i < _warmup; i++) {
+    if (setup) setup();
+    body();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(_iterations);
+  double total = 0;
+  for (int i = 0; i < _iterations; i++) {
+    if (setup) setup();
+    cugl::Timestamp start;
+    body();
+    cugl::Timestamp end;
+    double micros = cugl::Timestamp::ellapsedNanos(start, end) / 1000.0;
+    samples.push_back(micros);
+    total += micros;
+  }
+  std::sort(samples.begin(), samples.end());
+
+  Result result;
+  result.name = name;
+  result.iterations = _iterations;
+  result.mean = total / _iterations;
+  result.min = samples.front();
+  result.p50 = percentile(samples, 50);
+  result.p90 = percentile(samples, 90);
+  result.p99 = percentile(samples, 99);
+  result.max = samples.back();
+  _results.push_back(result);
+
+  CULog("%-44s %10.2f us  p50 %10.2f  p99 %10.2f", name.c_str(), result.mean,
+        result.p50, result.p99);
+  return true;
+}
+
+void Runner::annotate(const std::string &counter, long value) {
+  if (_results.empty()) return;
+  Result &result = _results.back();
+  result.counters.emplace_back(counter, value);
+  CULog("%-44s %10ld", ("  " + counter).c_str(), value);
+}
+
+std::shared_ptr<cugl::JsonValue> Runner::toJson() const {
+  auto json = cugl::JsonValue::allocObject();
+  json->appendValue("version", (long)RESULTS_VERSION);
+  json->appendValue("warmup", (long)_warmup);
+  json->appendValue("iterations", (long)_iterations);
+
+  auto results = cugl::JsonValue::allocArray();
+  for (const Result &result : _results) {
+    auto entry = cugl::JsonValue::allocObject();
+    entry->appendValue("name", result.name);
+    entry->appendValue("iterations", (long)result.iterations);
+    entry->appendValue("mean_us", result.mean);
+    entry->appendValue("min_us", result.min);
+    entry->appendValue("p50_us", result.p50);
+    entry->appendValue("p90_us", result.p90);
+    entry->appendValue("p99_us", result.p99);
+    entry->appendValue("max_us", result.max);
+    if (!result.counters.empty()) {
+      auto counters = cugl::JsonValue::allocObject();
+      for (const auto &counter : result.counters) {
+        counters->appendValue(counter.first, counter.second);
+      }
+      entry->appendChild("counters", counters);
+    }
+    results->appendChild(entry);
+  }
+  json->appendChild("results", results);
+  return json;
+}
+
+void Runner::write(const std::string &path) const {
+  auto writer = cugl::JsonWriter::alloc(path);
+  if (writer == nullptr) {
+    CULogError("Could not write benchmark results to %s", path.c_str());
+    return;
+  }
+  writer->writeJson(toJson());
+  writer->close();
+  CULog("Wrote %zu benchmark results to %s", _results.size(), path.c_str());
+}
+
+}  // namespace bench
@@ -0,0 +1,128 @@
+#ifndef BENCH_BENCHMARK_H_
+#define BENCH_BENCHMARK_H_
+#include <cugl/cugl.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/** The timing of one benchmark, in microseconds per iteration. */
+struct Result {
+  /** The name of the benchmark, such as "network/encode_enemy_info_64". */
+  std::string name;
+  /** The number of timed iterations. */
+  int iterations;
+  /** The mean time of an iteration. */
+  double mean;
+  /** The fastest iteration. */
+  double min;
+  /** The median iteration. */
+  double p50;
+  /** The 90th percentile iteration. */
+  double p90;
+  /** The 99th percentile iteration. */
+  double p99;
+  /** The slowest iteration. */
+  double max;
+  /** Counts of work done by an iteration, such as draw calls. */
+  std::vector<std::pair<std::string, long>> counters;
+};
+
+/**
+ * This class times benchmarks and collects their results.
+ *
+ * Every benchmark runs a number of untimed warmup iterations, so caches and
+ * pools are filled, and then the timed iterations. The results can be logged
+ * or written as JSON, with one entry per benchmark in the order they ran, so
+ * the files of two commits can be diffed directly.
+ */
+class Runner {
+  /** The number of untimed iterations before timing starts. */
+  int _warmup;
+  /** The number of timed iterations. */
+  int _iterations;
+  /** Only benchmarks whose names contain this are run. */
+  std::string _filter;
+  /** The results of every benchmark run so far. */
+  std::vector<Result> _results;
+
+ public:
+  /**
+   * Creates a runner.
+   *
+   * @param warmup The number of untimed iterations of each benchmark.
+   * @param iterations The number of timed iterations of each benchmark.
+   */
+  Runner(int warmup = 5, int iterations = 100)
+      : _warmup(warmup), _iterations(iterations) {}
+
+  /**
+   * Only runs the benchmarks whose names contain the filter.
+   *
+   * @param filter The filter, or the empty string to run every benchmark.
+   */
+  void setFilter(const std::string &filter) { _filter = filter; }
+
+  /**
+   * Returns true if the benchmark with the given name would run.
+   *
+   * Use this to skip expensive setup for benchmarks that are filtered out.
+   *
+   * @param name The name of the benchmark.
+   * @return If the benchmark would run.
+   */
+  bool accepts(const std::string &name) const {
+    return _filter.empty() || name.find(_filter) != std::string::npos;
+  }
+
+  /**
+   * Times a benchmark.
+   *
+   * @param name The name of the benchmark.
+   * @param body The code to time, called once per iteration.
+   * @return If the benchmark was timed, and not filtered out.
+   */
+  bool run(const std::string &name, const std::function<void()> &body) {
+    return run(name, nullptr, body);
+  }
+
+  /**
+   * Times a benchmark that needs fresh state every iteration.
+   *
+   * @param name The name of the benchmark.
+   * @param setup The code to run before each iteration, which is not timed.
+   * @param body The code to time, called once per iteration.
+   * @return If the benchmark was timed, and not filtered out.
+   */
+  bool run(const std::string &name, const std::function<void()> &setup,
+           const std::function<void()> &body);
+
+  /**
+   * Records a count of the work done by an iteration of the last benchmark,
+   * so a change in timing can be told apart from a change in work.
+   *
+   * @param counter The name of the count, such as "draw_calls".
+   * @param value The count.
+   */
+  void annotate(const std::string &counter, long value);
+
+  /** @return The results of every benchmark run so far. */
+  const std::vector<Result> &getResults() const { return _results; }
+
+  /** @return The results as a JSON object. */
+  std::shared_ptr<cugl::JsonValue> toJson() const;
+
+  /**
+   * Writes the results as JSON.
+   *
+   * @param path The file to write.
+   */
+  void write(const std::string &path) const;
+};
+
+}  // namespace bench
+
+#endif  // BENCH_BENCHMARK_H_
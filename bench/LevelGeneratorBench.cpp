@@ -0,0 +1,158 @@
+#include "LevelGeneratorBench.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcomma"
+#include "../source/generators/Delaunator.h"
+#pragma GCC diagnostic pop
+
+#include "../source/generators/Hungarian.h"
+#include "../source/generators/LevelGenerator.h"
+#include "../source/generators/Pcg32.h"
+
+namespace bench {
+
+namespace {
+
+/** The seeds to sweep when benchmarking. */
+const Uint64 SEEDS[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+/** The room counts to sweep when benchmarking. */
+const int ROOM_COUNTS[] = {25, 35, 45, 55, 60};
+
+/** The point counts to triangulate, from one level's rooms to far more. */
+const int POINT_COUNTS[] = {60, 1000};
+
+/** The cost matrix sizes to assign, from one room's doors to far more. */
+const int MATRIX_SIZES[] = {4, 16, 64};
+
+/** A recorded layout hash for a seed and room count. */
+struct GoldenLayout {
+  /** The seed of the level. */
+  Uint64 seed;
+  /** The number of rooms in the level config. */
+  int num_rooms;
+  /** The layout hash of the level. */
+  Uint64 hash;
+};
+
+/**
+ * The recorded layout hashes. Update these when the generator changes on
+ * purpose. Room placement still goes through the platform's sin and cos, so
+ * a mismatch on only one platform points at its math library.
+ */
+const GoldenLayout GOLDEN_LAYOUTS[] = {
+    {1, 25, 0xd371c7cf14db3f07ULL},
+    {2, 45, 0xef6032b275280e3fULL},
+    {3, 55, 0xc793f331e74396ccULL},
+    {4, 60, 0x4a8f3e04900b8973ULL},
+};
+
+/**
+ * Generate a level to completion.
+ *
+ * @param gen The generator to use, will be disposed first.
+ * @param seed The seed of the level.
+ * @param num_rooms The number of rooms in the level config.
+ */
+void generate(level_gen::LevelGenerator &gen, Uint64 seed, int num_rooms) {
+  level_gen::LevelGeneratorConfig config;
+  config.setNumRooms(num_rooms);
+
+  gen.dispose();
+  gen.init(config, seed);
+  while (gen.update())
+    ;
+}
+
+}  // namespace
+
+void benchGenerators(Runner &runner) {
+  for (int num_rooms : ROOM_COUNTS) {
+    level_gen::LevelGenerator gen;
+    Uint64 seed = 0;
+    runner.run("level_gen/generate_" + std::to_string(num_rooms),
+               [&]() { generate(gen, ++seed, num_rooms); });
+  }
+
+  for (int count : POINT_COUNTS) {
+    level_gen::Pcg32 rng(count);
+    std::vector<double> coords;
+    for (int i = 0; i < 2 * count; i++) {
+      coords.push_back(rng.nextFloat() * 1000);
+    }
+    runner.run("level_gen/delaunator_" + std::to_string(count),
+               [&]() { delaunator::Delaunator d(coords); });
+  }
+
+  for (int size : MATRIX_SIZES) {
+    level_gen::Pcg32 rng(size);
+    std::vector<std::vector<double>> costs(size, std::vector<double>(size));
+    for (auto &row : costs) {
+      for (double &cost : row) cost = rng.nextFloat() * 100;
+    }
+    // Solve does not modify the costs, so they are only made once.
+    std::vector<int> assignment;
+    runner.run("level_gen/hungarian_" + std::to_string(size), [&]() {
+      HungarianAlgorithm hungarian;
+      hungarian.Solve(costs, assignment);
+    });
+  }
+}
+
+bool benchLevelGenerator() {
+  bool passed = true;
+  const int num_seeds = sizeof(SEEDS) / sizeof(SEEDS[0]);
+
+  for (int num_rooms : ROOM_COUNTS) {
+    Uint64 stage_totals[level_gen::LevelGenerator::NUM_STAGES] = {0};
+    Uint64 total = 0;
+
+    for (Uint64 seed : SEEDS) {
+      level_gen::LevelGenerator gen;
+      generate(gen, seed, num_rooms);
+      Uint64 hash = gen.getLayoutHash();
+
+      for (int i = 0; i < level_gen::LevelGenerator::NUM_STAGES; i++) {
+        auto stage = static_cast<level_gen::LevelGenerator::Stage>(i);
+        stage_totals[i] += gen.getStageTime(stage);
+        total += gen.getStageTime(stage);
+      }
+
+      generate(gen, seed, num_rooms);
+      if (gen.getLayoutHash() != hash) {
+        CULogError("Seed %llu with %d rooms is not deterministic",
+                   (unsigned long long)seed, num_rooms);
+        passed = false;
+      }
+    }
+
+    CULog("Level generator, %d rooms, %d seeds: %.3f ms per level", num_rooms,
+          num_seeds, total / 1000.0f / num_seeds);
+    for (int i = 0; i < level_gen::LevelGenerator::NUM_STAGES; i++) {
+      auto stage = static_cast<level_gen::LevelGenerator::Stage>(i);
+      CULog("  %-10s %8.3f ms",
+            level_gen::LevelGenerator::getStageName(stage).c_str(),
+            stage_totals[i] / 1000.0f / num_seeds);
+    }
+  }
+  return passed;
+}
+
+bool checkLevelGeneratorGolden() {
+  bool passed = true;
+  for (const GoldenLayout &golden : GOLDEN_LAYOUTS) {
+    level_gen::LevelGenerator gen;
+    generate(gen, golden.seed, golden.num_rooms);
+    Uint64 hash = gen.getLayoutHash();
+    if (hash != golden.hash) {
+      CULogError("Seed %llu with %d rooms: hash %016llx, expected %016llx",
+                 (unsigned long long)golden.seed, golden.num_rooms,
+                 (unsigned long long)hash, (unsigned long long)golden.hash);
+      passed = false;
+    }
+  }
+  CULog("Level generator golden layouts %s", passed ? "passed" : "FAILED");
+  return passed;
+}
+
+}  // namespace bench
@@ -0,0 +1,40 @@
+#ifndef BENCH_LEVEL_GENERATOR_BENCH_H_
+#define BENCH_LEVEL_GENERATOR_BENCH_H_
+#include <cugl/cugl.h>
+
+#include "Benchmark.h"
+
+namespace bench {
+
+/**
+ * Benchmark the level generator end-to-end for every room count, along with
+ * the Delaunay triangulation and the Hungarian algorithm it is built on.
+ *
+ * @param runner The runner to time the benchmarks with.
+ */
+void benchGenerators(Runner &runner);
+
+/**
+ * Benchmark the level generator over a sweep of seeds and room counts, and
+ * log the average time spent in each generation stage for every room count.
+ *
+ * Every level is generated twice and the layout hashes are compared, so the
+ * benchmark also fails if generation from a seed is not deterministic.
+ *
+ * @return If every level generated the same layout both times.
+ */
+bool benchLevelGenerator();
+
+/**
+ * Check the layout hashes of a few fixed seeds against the hashes recorded
+ * when the generator was last changed on purpose. A mismatch means the levels
+ * built from a lobby seed changed, or that this platform builds a different
+ * level than the others.
+ *
+ * @return If every layout hash matched its recorded hash.
+ */
+bool checkLevelGeneratorGolden();
+
+}  // namespace bench
+
+#endif  // BENCH_LEVEL_GENERATOR_BENCH_H_
@@ -0,0 +1,83 @@
+#include "NetworkBench.h"
+
+#include "../source/generators/Pcg32.h"
+#include "../source/network/CustomNetworkSerializer.h"
+#include "../source/network/NetworkCodes.h"
+
+namespace bench {
+
+namespace {
+
+/** The enemy counts to benchmark, up to a level full of enemies. */
+const int ENEMY_COUNTS[] = {16, 64, 256};
+
+/**
+ * Creates the enemy updates for a tick.
+ *
+ * @param count The number of enemies.
+ * @return The updates, with positions and targets spread over a level.
+ */
+std::vector<std::shared_ptr<cugl::Serializable>> makeEnemyInfos(int count) {
+  level_gen::Pcg32 rng(count);
+  std::vector<std::shared_ptr<cugl::Serializable>> infos;
+  for (int i = 0; i < count; i++) {
+    auto info = cugl::EnemyInfo::alloc();
+    info->enemy_id = i;
+    info->pos.set(rng.nextFloat() * 4000, rng.nextFloat() * 4000);
+    info->has_target = rng.nextInt(0, 3) == 0;
+    info->target.set(rng.nextFloat() * 2 - 1, rng.nextFloat() * 2 - 1);
+    infos.push_back(info);
+  }
+  return infos;
+}
+
+}  // namespace
+
+bool benchNetwork(Runner &runner) {
+  bool passed = true;
+  cugl::CustomNetworkSerializer serializer;
+  cugl::CustomNetworkDeserializer deserializer;
+
+  for (int count : ENEMY_COUNTS) {
+    auto infos = makeEnemyInfos(count);
+    std::string suffix = "_" + std::to_string(count);
+
+    runner.run("network/encode_enemy_info" + suffix, [&]() {
+      serializer.writeSint32(NC_HOST_ALL_ENEMY_INFO);
+      serializer.writeSerializableVector(infos);
+      serializer.serialize();
+      serializer.reset();
+    });
+
+    serializer.writeSint32(NC_HOST_ALL_ENEMY_INFO);
+    serializer.writeSerializableVector(infos);
+    std::vector<uint8_t> msg = serializer.serialize();
+    serializer.reset();
+
+    std::vector<std::shared_ptr<cugl::Serializable>> decoded;
+    bool timed = runner.run("network/decode_enemy_info" + suffix, [&]() {
+      deserializer.receive(msg);
+      std::get<Sint32>(deserializer.read());
+      decoded = std::get<std::vector<std::shared_ptr<cugl::Serializable>>>(
+          deserializer.read());
+      deserializer.reset();
+    });
+
+    // Only check the round trip if the decoder ran at all.
+    if (!timed) continue;
+    bool same = decoded.size() == infos.size();
+    for (size_t i = 0; same && i < decoded.size(); i++) {
+      auto a = std::dynamic_pointer_cast<cugl::EnemyInfo>(infos[i]);
+      auto b = std::dynamic_pointer_cast<cugl::EnemyInfo>(decoded[i]);
+      same = b != nullptr && a->enemy_id == b->enemy_id && a->pos == b->pos &&
+             a->has_target == b->has_target && a->target == b->target;
+    }
+    if (!same) {
+      CULogError("%d enemy updates did not survive a round trip", count);
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+}  // namespace bench
@@ -0,0 +1,21 @@
+#ifndef BENCH_NETWORK_BENCH_H_
+#define BENCH_NETWORK_BENCH_H_
+#include <cugl/cugl.h>
+
+#include "Benchmark.h"
+
+namespace bench {
+
+/**
+ * Benchmark encoding and decoding the enemy updates the host sends every
+ * tick, for a few enemy counts. The decode benchmark also checks that every
+ * enemy survives the round trip.
+ *
+ * @param runner The runner to time the benchmarks with.
+ * @return If every enemy was decoded as it was encoded.
+ */
+bool benchNetwork(Runner &runner);
+
+}  // namespace bench
+
+#endif  // BENCH_NETWORK_BENCH_H_
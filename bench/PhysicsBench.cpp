@@ -0,0 +1,120 @@
+#include "PhysicsBench.h"
+
+#include <box2d/b2_body.h>
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_fixture.h>
+#include <box2d/b2_polygon_shape.h>
+#include <box2d/b2_world.h>
+
+#include "../source/generators/LevelGenerator.h"
+#include "../source/generators/Pcg32.h"
+
+/** The size of a tile in physics units, as in LevelController. */
+#define TILE_SIZE 48.0f
+/** The radius of an enemy body in physics units. */
+#define ENEMY_RADIUS 16.0f
+/** The fastest an enemy moves in physics units per second. */
+#define ENEMY_SPEED 150.0f
+/** The timestep of every physics step, in seconds. */
+#define TIMESTEP (1.0f / 60.0f)
+/** The velocity iterations of every step, as in ObstacleWorld. */
+#define VELOCITY_ITERATIONS 6
+/** The position iterations of every step, as in ObstacleWorld. */
+#define POSITION_ITERATIONS 2
+
+namespace bench {
+
+namespace {
+
+/** The seed of the benchmarked level. */
+const Uint64 LEVEL_SEED = 1;
+
+/** The enemy counts per room to benchmark. */
+const int ENEMIES_PER_ROOM[] = {2, 6};
+
+/**
+ * Adds a static box covering one tile.
+ *
+ * @param world The physics world.
+ * @param col The column of the tile in the level.
+ * @param row The row of the tile in the level.
+ */
+void addWallTile(b2World &world, int col, int row) {
+  b2BodyDef def;
+  def.type = b2_staticBody;
+  def.position.Set((col + 0.5f) * TILE_SIZE, (row + 0.5f) * TILE_SIZE);
+  b2Body *body = world.CreateBody(&def);
+
+  b2PolygonShape shape;
+  shape.SetAsBox(TILE_SIZE / 2, TILE_SIZE / 2);
+  body->CreateFixture(&shape, 0);
+}
+
+/**
+ * Fills a world with a generated level.
+ *
+ * @param world The physics world, which should be empty.
+ * @param enemies The number of enemies in each room.
+ */
+void buildLevel(b2World &world, int enemies) {
+  level_gen::LevelGeneratorConfig config;
+  level_gen::LevelGenerator gen;
+  gen.init(config, LEVEL_SEED);
+  while (gen.update())
+    ;
+
+  level_gen::Pcg32 rng(LEVEL_SEED);
+  for (const std::shared_ptr<level_gen::Room> &room : gen.getRooms()) {
+    cugl::Rect rect = room->getRect();
+    int left = (int)rect.getMinX();
+    int bottom = (int)rect.getMinY();
+    int right = (int)rect.getMaxX() - 1;
+    int top = (int)rect.getMaxY() - 1;
+
+    for (int col = left; col <= right; col++) {
+      addWallTile(world, col, bottom);
+      addWallTile(world, col, top);
+    }
+    for (int row = bottom + 1; row < top; row++) {
+      addWallTile(world, left, row);
+      addWallTile(world, right, row);
+    }
+
+    for (int i = 0; i < enemies; i++) {
+      b2BodyDef def;
+      def.type = b2_dynamicBody;
+      def.fixedRotation = true;
+      def.position.Set(
+          (left + 1 + rng.nextFloat() * (right - left - 1)) * TILE_SIZE,
+          (bottom + 1 + rng.nextFloat() * (top - bottom - 1)) * TILE_SIZE);
+      def.linearVelocity.Set((rng.nextFloat() * 2 - 1) * ENEMY_SPEED,
+                             (rng.nextFloat() * 2 - 1) * ENEMY_SPEED);
+      b2Body *body = world.CreateBody(&def);
+
+      b2CircleShape shape;
+      shape.m_radius = ENEMY_RADIUS;
+      b2FixtureDef fixture;
+      fixture.shape = &shape;
+      fixture.density = 1;
+      fixture.restitution = 1;
+      body->CreateFixture(&fixture);
+    }
+  }
+}
+
+}  // namespace
+
+void benchPhysics(Runner &runner) {
+  for (int enemies : ENEMIES_PER_ROOM) {
+    std::string name = "physics/step_" + std::to_string(enemies) + "_per_room";
+    if (!runner.accepts(name)) continue;
+
+    b2World world(b2Vec2(0, 0));
+    buildLevel(world, enemies);
+    runner.run(name, [&]() {
+      world.Step(TIMESTEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    });
+  }
+}
+
+}  // namespace bench
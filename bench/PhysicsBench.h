@@ -0,0 +1,20 @@
+#ifndef BENCH_PHYSICS_BENCH_H_
+#define BENCH_PHYSICS_BENCH_H_
+#include <cugl/cugl.h>
+
+#include "Benchmark.h"
+
+namespace bench {
+
+/**
+ * Benchmark a physics step of a generated level, with a static box for every
+ * wall tile around each room and enemies moving inside every room, as
+ * LevelController lays them out.
+ *
+ * @param runner The runner to time the benchmarks with.
+ */
+void benchPhysics(Runner &runner);
+
+}  // namespace bench
+
+#endif  // BENCH_PHYSICS_BENCH_H_
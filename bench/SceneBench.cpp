@@ -0,0 +1,172 @@
+#include "SceneBench.h"
+
+#include <random>
+#include <unordered_set>
+
+#include "../source/controllers/ParticleController.h"
+#include "../source/models/level_gen/DefaultRooms.h"
+
+/** The size of the view the rooms are rendered into. */
+#define VIEW_WIDTH 1024
+#define VIEW_HEIGHT 576
+/** The timestep of every particle update, in seconds. */
+#define TIMESTEP (1.0f / 60.0f)
+/** How long the benchmarked particles live, longer than any benchmark. */
+#define PARTICLE_LIFETIME 3600.0f
+/** More particles than fit in both pools, so both are full. */
+#define NUM_PARTICLES 1000
+/** Vertices to transform, not a multiple of four so the tail is covered. */
+#define NUM_VERTICES 1027
+/** The largest relative difference allowed between transformed positions. */
+#define POSITION_TOLERANCE 1e-6f
+
+namespace bench {
+
+namespace {
+
+/**
+ * Benchmark updating the particle controller with both pools full.
+ *
+ * @param runner The runner to time the benchmarks with.
+ */
+void benchParticles(Runner &runner) {
+  const std::string name = "scene/particle_update_full_pool";
+  if (!runner.accepts(name)) return;
+
+  cugl::Size size(VIEW_WIDTH, VIEW_HEIGHT);
+  auto world = cugl::scene2::SceneNode::alloc();
+  auto screen = cugl::scene2::SceneNode::alloc();
+  world->setContentSize(size);
+  screen->setContentSize(size);
+  auto particles = ParticleController::alloc(world, screen);
+
+  ParticleProps props;
+  props.setLifeTime(PARTICLE_LIFETIME)
+      ->setPosition(size.width / 2, size.height / 2)
+      ->setPositionVariation(size.width / 2, size.height / 2)
+      ->setVelocity(0, 0)
+      ->setVelocityVariation(20, 20)
+      ->setSizeStart(5.0f)
+      ->setSizeEnd(2.0f)
+      ->setColorStart(cugl::Color4(148, 183, 212, 200))
+      ->setColorEnd(cugl::Color4(148, 183, 212, 0))
+      ->setAngularSpeed(0.5f);
+  particles->emit(props, NUM_PARTICLES);
+  props.setScreenCoord(true);
+  particles->emit(props, NUM_PARTICLES);
+
+  runner.run(name, [&]() { particles->update(TIMESTEP); });
+}
+
+}  // namespace
+
+bool benchScene(Runner &runner,
+                const std::shared_ptr<cugl::AssetManager> &assets) {
+  bool passed = true;
+  auto loader = std::dynamic_pointer_cast<cugl::Scene2Loader>(
+      assets->access<cugl::scene2::SceneNode>());
+
+  // Rendering draws one of every room side by side, as the level does.
+  auto root = cugl::scene2::OrderedNode::allocWithOrder(
+      cugl::scene2::OrderedNode::Order::ASCEND);
+  float offset = 0;
+
+  std::unordered_set<std::string> built;
+  for (const default_rooms::RoomConfig &room : default_rooms::kAllRooms) {
+    if (!built.insert(room.scene2_source).second) continue;
+
+    auto reader = cugl::JsonReader::allocWithAsset(room.scene2_source);
+    auto doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+    auto json = (doc == nullptr ? nullptr : doc->toJsonValue());
+    if (json == nullptr) {
+      CULogError("Could not read room %s", room.scene2_source.c_str());
+      passed = false;
+      continue;
+    }
+
+    std::shared_ptr<cugl::scene2::SceneNode> node;
+    runner.run("scene/build_" + room.scene2_key,
+               [&]() { node = loader->build("", json); });
+    if (node == nullptr) node = loader->build("", json);
+    if (node == nullptr) {
+      CULogError("Could not build room %s", room.scene2_source.c_str());
+      passed = false;
+      continue;
+    }
+
+    node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
+    node->setPosition(offset, 0);
+    offset += node->getContentWidth();
+    root->addChild(node);
+  }
+
+  if (offset > 0) root->setScale(VIEW_WIDTH / offset);
+  auto batch = cugl::SpriteBatch::alloc();
+  auto camera =
+      cugl::OrthographicCamera::alloc(cugl::Size(VIEW_WIDTH, VIEW_HEIGHT));
+  bool rendered = runner.run("scene/render_all_rooms", [&]() {
+    batch->begin(camera->getCombined());
+    root->render(batch);
+    batch->end();
+  });
+  if (rendered) {
+    runner.annotate("draw_calls", batch->getCallsMade());
+    runner.annotate("vertices", batch->getVerticesDrawn());
+    if (batch->getCallsMade() == 0 || batch->getVerticesDrawn() == 0) {
+      CULogError("Rendering the rooms drew nothing");
+      passed = false;
+    }
+  }
+
+  benchParticles(runner);
+  return passed;
+}
+
+bool checkSpriteBatchTransform() {
+  std::mt19937 random(NUM_VERTICES);
+  std::uniform_real_distribution<float> coord(-1000.0f, 1000.0f);
+  std::uniform_int_distribution<GLuint> color;
+
+  std::vector<cugl::SpriteVertex2> src(NUM_VERTICES);
+  for (cugl::SpriteVertex2 &vert : src) {
+    vert.position.set(coord(random), coord(random));
+    vert.color = color(random);
+    vert.texcoord.set(coord(random), coord(random));
+    vert.gradcoord.set(coord(random), coord(random));
+  }
+
+  cugl::Affine2 mat;
+  cugl::Affine2::createRotation(0.3f, &mat);
+  mat.scale(1.5f, 0.75f);
+  mat.translate(12.5f, -40.25f);
+
+  bool passed = true;
+  for (bool shade : {false, true}) {
+    std::vector<cugl::SpriteVertex2> scalar(NUM_VERTICES);
+    std::vector<cugl::SpriteVertex2> vector(NUM_VERTICES);
+    GLuint tint = color(random);
+    cugl::SpriteBatch::transformVertices(src.data(), scalar.data(),
+                                         NUM_VERTICES, mat, tint, shade, false);
+    cugl::SpriteBatch::transformVertices(src.data(), vector.data(),
+                                         NUM_VERTICES, mat, tint, shade, true);
+
+    for (int i = 0; i < NUM_VERTICES; i++) {
+      const cugl::SpriteVertex2 &a = scalar[i];
+      const cugl::SpriteVertex2 &b = vector[i];
+      float scale = std::max(1.0f, a.position.length());
+      if (a.color != b.color || a.texcoord != b.texcoord ||
+          a.gradcoord != b.gradcoord ||
+          a.position.distance(b.position) > POSITION_TOLERANCE * scale) {
+        CULogError("Sprite vertex %d differs: (%f, %f) %08x vs (%f, %f) %08x",
+                   i, a.position.x, a.position.y, a.color, b.position.x,
+                   b.position.y, b.color);
+        passed = false;
+        break;
+      }
+    }
+  }
+  CULog("Sprite batch vertex transform %s", passed ? "passed" : "FAILED");
+  return passed;
+}
+
+}  // namespace bench
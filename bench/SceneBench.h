@@ -0,0 +1,38 @@
+#ifndef BENCH_SCENE_BENCH_H_
+#define BENCH_SCENE_BENCH_H_
+#include <cugl/cugl.h>
+
+#include "Benchmark.h"
+
+namespace bench {
+
+/**
+ * Benchmark building every room file into a scene graph, rendering all of
+ * the rooms at once and updating a full particle pool.
+ *
+ * These need the game's assets and a display, so they must run inside an
+ * Application after the assets are loaded. With the null renderer, the
+ * render benchmark times the CPU side of a frame and records the draw calls
+ * and vertices of one pass.
+ *
+ * @param runner The runner to time the benchmarks with.
+ * @param assets The loaded assets, with the game's scene2 loader attached.
+ * @return If every room file could be read and built, and rendering drew.
+ */
+bool benchScene(Runner &runner,
+                const std::shared_ptr<cugl::AssetManager> &assets);
+
+/**
+ * Check the vectorized sprite batch vertex transform against the scalar one.
+ *
+ * Random vertices are transformed and tinted both ways. The colors must be
+ * identical, and the positions equal up to rounding. This needs no display,
+ * and passes trivially on targets without a vectorized path.
+ *
+ * @return If both paths gave the same vertices.
+ */
+bool checkSpriteBatchTransform();
+
+}  // namespace bench
+
+#endif  // BENCH_SCENE_BENCH_H_
@@ -0,0 +1,67 @@
+#include <cugl/cugl.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "BenchApp.h"
+#include "LevelGeneratorBench.h"
+#include "SceneBench.h"
+
+/**
+ * Runs the gameplay benchmarks.
+ *
+ * The command line is [--out <json>] [--filter <name>] [--warmup <n>]
+ * [--iterations <n>]. The timed benchmarks run in a headless application
+ * with the null renderer, as some need the game's assets but none need a
+ * GPU. Their results are written to the JSON file so two commits can be
+ * compared. The level generator stage breakdown and golden layouts are
+ * checked first, without an application.
+ *
+ * Build with the game sources (every file in source/ except main.cpp) and
+ * link against CUGL, as the DungeonDeceptionBench target in build-linux
+ * does.
+ */
+int main(int argc, char *argv[]) {
+  std::string output;
+  std::string filter;
+  int warmup = 5;
+  int iterations = 100;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--out") == 0) {
+      output = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--filter") == 0) {
+      filter = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--warmup") == 0) {
+      warmup = std::atoi(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--iterations") == 0) {
+      iterations = std::atoi(argv[i + 1]);
+    }
+  }
+
+  bool passed = true;
+  if (filter.empty()) {
+    passed = bench::benchLevelGenerator() && passed;
+    passed = bench::checkLevelGeneratorGolden() && passed;
+    passed = bench::checkSpriteBatchTransform() && passed;
+  }
+
+  bench::BenchApp app(warmup, iterations);
+  app.setHeadless(true);
+  app.setNullRenderer(true);
+  app.setFilter(filter);
+  app.setOutput(output);
+  app.setName("Dungeon Deception Bench");
+  app.setOrganization("(Oops) Games");
+
+  if (!app.init()) {
+    return 1;
+  }
+
+  app.onStartup();
+  while (app.step())
+    ;
+  app.onShutdown();
+
+  passed = app.hasPassed() && passed;
+  return passed ? 0 : 1;
+}
@@ -50,6 +50,7 @@
 #include <cugl/util/CUThreadPool.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/assets/CULoader.h>
+#include <cugl/assets/CUJsonDocument.h>
 #include <typeinfo>
 #include <atomic>
 
@@ -98,6 +99,19 @@ protected:
     /** Wait variable to create a load barrier for directories. */
     std::atomic<bool> _wait;
 
+    /**
+     * Returns the hash of the asset type for a directory category.
+     *
+     * This is the one place that maps the category names of an asset
+     * directory (e.g. "textures") to asset types, so that every way of
+     * reading a directory agrees on them.
+     *
+     * @param key   The name of the category
+     *
+     * @return the hash of the asset type, or 0 if the category is unknown.
+     */
+    static size_t categoryHash(const std::string& key);
+
     /**
      * Synchronously reads an asset category from a JSON file
      *
@@ -121,6 +135,22 @@ protected:
      * @return true if all assets of this type were successfully loaded.
      */
     bool readCategory(size_t hash, const std::shared_ptr<JsonValue>& json);
+
+    /**
+     * Synchronously reads an asset category from a directory document.
+     *
+     * This method is the same as {@link readCategory} for a JsonValue, except
+     * that the category is a value of a read-only document.  Each asset is
+     * handed to its loader as a document value, so that it is never
+     * converted to a JsonValue unless the loader needs it to be.
+     *
+     * @param hash  The hash of the asset type
+     * @param doc   The document of the asset directory
+     * @param node  The index of the category in the document
+     *
+     * @return true if all assets of this type were successfully loaded.
+     */
+    bool readCategory(size_t hash, const std::shared_ptr<JsonDocument>& doc, Uint32 node);
     
     /**
      * Asynchronously reads an asset category from a JSON file
@@ -157,6 +187,20 @@ protected:
      */
     void readCategory(size_t hash, const std::shared_ptr<JsonValue>& json,
                       LoaderCallback callback);
+
+    /**
+     * Asynchronously reads an asset category from a directory document.
+     *
+     * This method is the same as the asynchronous {@link readCategory} for a
+     * JsonValue, except that the category is a value of a read-only document.
+     *
+     * @param hash      The hash of the asset type
+     * @param doc       The document of the asset directory
+     * @param node      The index of the category in the document
+     * @param callback  An optional callback after each asset is loaded
+     */
+    void readCategory(size_t hash, const std::shared_ptr<JsonDocument>& doc, Uint32 node,
+                      LoaderCallback callback);
     
     /**
      * Immediately removes an asset category previously loaded from the JSON file
@@ -809,6 +853,18 @@ public:
      */
     bool loadDirectory(const std::shared_ptr<JsonValue>& json);
 
+    /**
+     * Synchronously loads all assets in the given directory document.
+     *
+     * This method is the same as {@link loadDirectory} for a JsonValue,
+     * except that the directory has been parsed into a read-only document.
+     *
+     * @param doc   The JSON asset directory document
+     *
+     * @return true if all assets specified in the directory were successfully loaded.
+     */
+    bool loadDirectory(const std::shared_ptr<JsonDocument>& doc);
+
     /**
      * Synchronously loads all assets in the given directory.
      *
@@ -899,6 +955,17 @@ public:
      */
     void loadDirectoryAsync(const std::shared_ptr<JsonValue>& json, LoaderCallback callback);
 
+    /**
+     * Asynchronously loads all assets in the given directory document.
+     *
+     * This method is the same as {@link loadDirectoryAsync} for a JsonValue,
+     * except that the directory has been parsed into a read-only document.
+     *
+     * @param doc       The JSON asset directory document
+     * @param callback  An optional callback after each asset is loaded
+     */
+    void loadDirectoryAsync(const std::shared_ptr<JsonDocument>& doc, LoaderCallback callback);
+
     /**
      * Asynchronously loads all assets in the given directory.
      *
@@ -0,0 +1,356 @@
+//
+//  CUJsonDocument.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a read-only alternative to JsonValue for large JSON
+//  files, such as asset directories and scene files. The document parses the
+//  JSON directly, without cJSON, into a handful of flat arrays. Object keys
+//  are interned and looked up with a hash table, so access by key is O(1)
+//  instead of a scan over the children.
+//
+//  Values in the document are referred to by their index in the document,
+//  with the root at index 0. Use toJsonValue to convert all or part of the
+//  document for the classes that still require a JsonValue.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#ifndef __CU_JSON_DOCUMENT_H__
+#define __CU_JSON_DOCUMENT_H__
+#include <cugl/assets/CUJsonValue.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cugl {
+
+/**
+ * This class is a read-only JSON document.
+ *
+ * Unlike JsonValue, the values of a document are not individually allocated.
+ * Every value is an entry in a single array, the children of every array or
+ * object are a contiguous range of a second array, and all strings share a
+ * single character buffer. Object keys are interned, so each distinct key is
+ * only stored once, and (object, key) pairs are stored in an open addressed
+ * hash table for constant time lookup.
+ *
+ * Values are referred to by their index in the document. The root value is
+ * always at index 0, and {@link INVALID} is returned for missing values.
+ * Every accessor treats {@link INVALID} as a null value, so lookups may be
+ * chained without checking each step, like the nullptr of a JsonValue.
+ */
+class JsonDocument {
+public:
+    /** The type of a value in the document */
+    typedef JsonValue::Type Type;
+
+    /** The index returned for a value that does not exist */
+    static constexpr Uint32 INVALID = 0xffffffff;
+
+private:
+    /** A single value in the document */
+    struct Entry {
+        /** The type of this value */
+        Type type;
+        /** The interned key of this value (INVALID if not in an object) */
+        Uint32 key;
+        /** The first child, or the offset of the string in the text buffer */
+        Uint32 first;
+        /** The number of children, or the length of the string */
+        Uint32 size;
+        /** The number or boolean data stored in this value */
+        double number;
+    };
+
+    /** All of the values in the document, with the root first */
+    std::vector<Entry> _entries;
+    /** The children of every array and object, in contiguous ranges */
+    std::vector<Uint32> _children;
+    /** The (unescaped) characters of every string value */
+    std::string _text;
+
+    /** The interned keys, indexed by key id */
+    std::vector<std::string> _keys;
+    /** The id of each interned key */
+    std::unordered_map<std::string, Uint32> _keyids;
+
+    /** The (object, key) pair for each slot of the lookup table */
+    std::vector<Uint64> _slotkeys;
+    /** The child for each slot of the lookup table, or INVALID if empty */
+    std::vector<Uint32> _slotvalues;
+
+#pragma mark -
+#pragma mark Parsing
+    /** The parser state while initializing the document */
+    struct Parser;
+
+    /**
+     * Builds the hash table for looking up object children by key.
+     *
+     * If an object has several children with the same key, the first one is
+     * returned by {@link get}, like {@link JsonValue#get}.
+     */
+    void buildLookup();
+
+    /**
+     * Returns the lookup table slot for the given object and key.
+     *
+     * @param node  The object index
+     * @param key   The interned key id
+     *
+     * @return the lookup table slot for the given object and key.
+     */
+    Uint32 findSlot(Uint32 node, Uint32 key) const;
+
+    /**
+     * Stores the given value in the JsonValue.
+     *
+     * @param node  The value index
+     * @param value The JsonValue to store the result
+     */
+    void toJsonValue(Uint32 node, JsonValue* value) const;
+
+public:
+#pragma mark -
+#pragma mark Constructors
+    /**
+     * Creates an empty document.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    JsonDocument() {}
+
+    /**
+     * Deletes this document and all of its resources.
+     */
+    ~JsonDocument() { dispose(); }
+
+    /**
+     * Deletes all of the values in this document.
+     */
+    void dispose();
+
+    /**
+     * Initializes this document from the given JSON string.
+     *
+     * If there is a parsing error, this method will return false. Detailed
+     * information about the parsing error will be passed to an assert. Hence
+     * error messages are suppressed if asserts are turned off.
+     *
+     * @param json  The JSON string to parse.
+     *
+     * @return true if the document is initialized properly, false otherwise.
+     */
+    bool initWithJson(const std::string& json);
+
+    /**
+     * Returns a newly allocated document from the given JSON string.
+     *
+     * If there is a parsing error, this method will return nullptr. Detailed
+     * information about the parsing error will be passed to an assert. Hence
+     * error messages are suppressed if asserts are turned off.
+     *
+     * @param json  The JSON string to parse.
+     *
+     * @return a newly allocated document from the given JSON string.
+     */
+    static std::shared_ptr<JsonDocument> allocWithJson(const std::string& json) {
+        std::shared_ptr<JsonDocument> result = std::make_shared<JsonDocument>();
+        return (result->initWithJson(json) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Value Access
+    /**
+     * Returns the index of the root value.
+     *
+     * @return the index of the root value.
+     */
+    Uint32 root() const { return _entries.empty() ? INVALID : 0; }
+
+    /**
+     * Returns true if the given index refers to a value in this document.
+     *
+     * @param node  The value index
+     *
+     * @return true if the given index refers to a value in this document.
+     */
+    bool isValid(Uint32 node) const { return node < _entries.size(); }
+
+    /**
+     * Returns the type of the given value.
+     *
+     * A missing value has type {@link JsonValue::Type::NullType}.
+     *
+     * @param node  The value index
+     *
+     * @return the type of the given value.
+     */
+    Type type(Uint32 node) const {
+        return isValid(node) ? _entries[node].type : Type::NullType;
+    }
+
+    /**
+     * Returns the key of the given value, or the empty string if it has none.
+     *
+     * @param node  The value index
+     *
+     * @return the key of the given value, or the empty string if it has none.
+     */
+    const std::string& key(Uint32 node) const;
+
+    /**
+     * Returns the number of children of the given array or object.
+     *
+     * @param node  The value index
+     *
+     * @return the number of children of the given array or object.
+     */
+    size_t size(Uint32 node) const {
+        Type type = this->type(node);
+        return (type == Type::ArrayType || type == Type::ObjectType) ? _entries[node].size : 0;
+    }
+
+    /**
+     * Returns the child of the given array or object at the given position.
+     *
+     * @param node  The value index
+     * @param index The position of the child
+     *
+     * @return the child at the given position, or {@link INVALID}.
+     */
+    Uint32 get(Uint32 node, size_t index) const {
+        return index < size(node) ? _children[_entries[node].first+index] : INVALID;
+    }
+
+    /**
+     * Returns the child of the given object with the given key.
+     *
+     * This lookup takes constant time.
+     *
+     * @param node  The value index
+     * @param key   The key of the child
+     *
+     * @return the child with the given key, or {@link INVALID}.
+     */
+    Uint32 get(Uint32 node, const std::string& key) const;
+
+    /**
+     * Returns true if the given object has a child with the given key.
+     *
+     * @param node  The value index
+     * @param key   The key of the child
+     *
+     * @return true if the given object has a child with the given key.
+     */
+    bool has(Uint32 node, const std::string& key) const {
+        return get(node,key) != INVALID;
+    }
+
+    /**
+     * Returns the given value as a string, or the default if it is not one.
+     *
+     * @param node          The value index
+     * @param defaultValue  The value to return if the value is not a string
+     *
+     * @return the given value as a string.
+     */
+    std::string asString(Uint32 node, const std::string& defaultValue="") const;
+
+    /**
+     * Returns the given value as a double, or the default if it is not one.
+     *
+     * @param node          The value index
+     * @param defaultValue  The value to return if the value is not a number
+     *
+     * @return the given value as a double.
+     */
+    double asDouble(Uint32 node, double defaultValue=0.0) const {
+        return type(node) == Type::NumberType ? _entries[node].number : defaultValue;
+    }
+
+    /**
+     * Returns the given value as a float, or the default if it is not one.
+     *
+     * @param node          The value index
+     * @param defaultValue  The value to return if the value is not a number
+     *
+     * @return the given value as a float.
+     */
+    float asFloat(Uint32 node, float defaultValue=0.0f) const {
+        return (float)asDouble(node,defaultValue);
+    }
+
+    /**
+     * Returns the given value as an int, or the default if it is not one.
+     *
+     * @param node          The value index
+     * @param defaultValue  The value to return if the value is not a number
+     *
+     * @return the given value as an int.
+     */
+    int asInt(Uint32 node, int defaultValue=0) const {
+        return type(node) == Type::NumberType ? (int)_entries[node].number : defaultValue;
+    }
+
+    /**
+     * Returns the given value as a bool, or the default if it is not one.
+     *
+     * @param node          The value index
+     * @param defaultValue  The value to return if the value is not a bool
+     *
+     * @return the given value as a bool.
+     */
+    bool asBool(Uint32 node, bool defaultValue=false) const {
+        return type(node) == Type::BoolType ? _entries[node].number != 0 : defaultValue;
+    }
+
+#pragma mark -
+#pragma mark Conversion
+    /**
+     * Returns a newly allocated JsonValue for the given value.
+     *
+     * The JsonValue is built directly from the document, without printing
+     * or parsing any JSON, and is equivalent to parsing the same JSON with
+     * {@link JsonValue#allocWithJson}.
+     *
+     * @param node  The value index (the root by default)
+     *
+     * @return a newly allocated JsonValue for the given value.
+     */
+    std::shared_ptr<JsonValue> toJsonValue(Uint32 node=0) const;
+};
+
+}
+#endif /* __CU_JSON_DOCUMENT_H__ */
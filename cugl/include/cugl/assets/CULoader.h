@@ -52,6 +52,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <cugl/assets/CUJsonValue.h>
+#include <cugl/assets/CUJsonDocument.h>
 #include <cugl/util/CUThreadPool.h>
 
 namespace cugl {
@@ -159,6 +160,27 @@ protected:
                       LoaderCallback callback, bool async) {
         return false;
     }
+
+    /**
+     * Internal method to support asset loading.
+     *
+     * This method is the same as the read method for a JsonValue, except
+     * that the directory entry is a value of a read-only document.  By
+     * default only that entry is converted to a JsonValue.  Loaders whose
+     * entries are large (such as scene graphs) should override this to read
+     * the document directly.
+     *
+     * @param doc       The document of the asset directory
+     * @param node      The index of the directory entry for the asset
+     * @param callback  An optional callback for asynchronous loading
+     * @param async     Whether the asset was loaded asynchronously
+     *
+     * @return true if the asset was successfully loaded
+     */
+    virtual bool read(const std::shared_ptr<JsonDocument>& doc, Uint32 node,
+                      LoaderCallback callback, bool async) {
+        return read(doc->toJsonValue(node),callback,async);
+    }
     
     /**
      * Unloads the asset for the given key
@@ -395,6 +417,21 @@ public:
     bool load(const std::shared_ptr<JsonValue>& json) {
         return read(json,nullptr,false);
     }
+
+    /**
+     * Synchronously loads the given asset from a directory document.
+     *
+     * This method is the same as the load method for a JsonValue, except
+     * that the directory entry is a value of a read-only document.
+     *
+     * @param doc   The document of the asset directory
+     * @param node  The index of the directory entry for the asset
+     *
+     * @return true if the asset was successfully loaded
+     */
+    bool load(const std::shared_ptr<JsonDocument>& doc, Uint32 node) {
+        return read(doc,node,nullptr,false);
+    }
     
     /**
      * Asynchronously loads the given asset with the specified key.
@@ -447,6 +484,20 @@ public:
         read(json, callback,true);
     }
 
+    /**
+     * Asynchronously loads the given asset from a directory document.
+     *
+     * This method is the same as the loadAsync method for a JsonValue, except
+     * that the directory entry is a value of a read-only document.
+     *
+     * @param doc       The document of the asset directory
+     * @param node      The index of the directory entry for the asset
+     * @param callback  An optional callback for asynchronous loading
+     */
+    void loadAsync(const std::shared_ptr<JsonDocument>& doc, Uint32 node, LoaderCallback callback) {
+        read(doc, node, callback, true);
+    }
+
     /**
      * Unloads the asset for the given key
      *
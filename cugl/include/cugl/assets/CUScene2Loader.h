@@ -231,6 +231,24 @@ class Scene2Loader : public Loader<scene2::SceneNode> {
    */
   virtual bool read(const std::shared_ptr<JsonValue>& json,
                     LoaderCallback callback, bool async) override;
+
+  /**
+   * Internal method to support asset loading.
+   *
+   * This method is like the read method for a JsonValue, except that the
+   * scene is built directly from a value of a read-only document. The
+   * document is kept alive until an asynchronous build is done.
+   *
+   * @param doc       The document of the asset directory
+   * @param node      The index of the directory entry for the asset
+   * @param callback  An optional callback for asynchronous loading
+   * @param async     Whether the asset was loaded asynchronously
+   *
+   * @return true if the asset was successfully loaded
+   */
+  virtual bool read(const std::shared_ptr<JsonDocument>& doc, Uint32 node,
+                    LoaderCallback callback, bool async) override;
+
   /**
    * Unloads the asset for the given directory entry
    *
@@ -267,6 +285,9 @@ class Scene2Loader : public Loader<scene2::SceneNode> {
   /**
      * Translates the JSON of a widget to the JSON of the node that it encodes.
      *
+     * The result shares every node of the widget contents that the instance
+     * does not change, so it must not be modified.
+     *
      * If this scene is built before the JSON of any used widgets have been
      * loaded, this will fail.
      *
@@ -406,6 +427,29 @@ class Scene2Loader : public Loader<scene2::SceneNode> {
    */
   virtual std::shared_ptr<scene2::SceneNode> build(
       const std::string& key, const std::shared_ptr<JsonValue>& json) const;
+
+  /**
+   * Recursively builds the scene from the given value of a document.
+   *
+   * This method is the same as {@link build} for a JsonValue, except that
+   * the tree is walked in the document, looking up each attribute by key in
+   * constant time. Only the "data", "format" and "layout" of each node are
+   * converted to a JsonValue, as that is what the nodes are initialized
+   * with. Each node is still created by {@link build} for a JsonValue, so
+   * the node types of a subclass are supported.
+   *
+   * Widgets are expanded from the JSON of their widget asset, so an
+   * instance of one is converted and built as a JsonValue.
+   *
+   * @param key       The key to access the scene after loading
+   * @param doc       The document defining the scene
+   * @param json      The index of the scene in the document
+   *
+   * @return the root node of the scene
+   */
+  std::shared_ptr<scene2::SceneNode> build(const std::string& key,
+                                           const JsonDocument& doc,
+                                           Uint32 json) const;
 };
 
 }  // namespace cugl
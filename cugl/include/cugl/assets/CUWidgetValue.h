@@ -46,6 +46,9 @@
 #include <cugl/base/CUBase.h>
 #include <cugl/assets/CUJsonValue.h>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace cugl {
 
@@ -54,11 +57,18 @@ namespace cugl {
  * the scene graph JSON.
  *
  * This class wraps a JsonValue for the purposes of safe dependency loading.
+ * It also compiles the widget once on load, so that instances of the widget
+ * can be expanded without searching the variable list or parsing the variable
+ * addresses again.
  */
 class WidgetValue {
 protected:
 	/** The JSON entry representing this widget */
 	std::shared_ptr<JsonValue> json;
+	/** The contents of the widget, shared by every instance of the widget */
+	std::shared_ptr<JsonValue> contents;
+	/** The address in the contents of each exposed variable, by variable name */
+	std::unordered_map<std::string, std::vector<std::string>> variables;
 
 public:
 #pragma mark -
@@ -94,6 +104,14 @@ public:
 		}
 
 		this->json = json;
+		contents = json->get("contents");
+		std::shared_ptr<JsonValue> vars = json->get("variables");
+		if (vars != nullptr) {
+			for (int ii = 0; ii < vars->size(); ii++) {
+				std::shared_ptr<JsonValue> var = vars->get(ii);
+				variables.emplace(var->key(), var->asStringArray());
+			}
+		}
 		return true;
     }
     
@@ -122,6 +140,33 @@ public:
 	const std::shared_ptr<JsonValue> getJson() const {
 		return json;
 	}
+
+	/**
+	* Returns the contents of this widget.
+	*
+	* The contents are shared by every instance of the widget, and should
+	* never be modified.
+	*
+	* @return the contents of this widget.
+	*/
+	const std::shared_ptr<JsonValue> getContents() const {
+		return contents;
+	}
+
+	/**
+	* Returns the address in the contents of the given exposed variable.
+	*
+	* The address is the list of keys leading from the contents to the
+	* value that the variable replaces.
+	*
+	* @param name	The name of the exposed variable
+	*
+	* @return the address of the variable, or nullptr if it is not exposed.
+	*/
+	const std::vector<std::string>* getVariable(const std::string& name) const {
+		auto it = variables.find(name);
+		return it == variables.end() ? nullptr : &(it->second);
+	}
 };
 
 }
@@ -155,6 +155,10 @@ protected:
     bool _highdpi;
 	/** Whether this application supports multisampling */
 	bool _multisamp;
+    /** Whether this application runs without a visible display */
+    bool _headless;
+    /** Whether this application runs without an OpenGL context */
+    bool _nullrender;
     
     /** The target FPS of this application */
     float _fps;
@@ -596,6 +600,79 @@ public:
      * @return true if this application supports high dpi resolution.
      */
     bool isHighDPI() const { return _highdpi; }
+
+    /**
+     * Sets whether this application runs without a visible display.
+     *
+     * A headless application still has an OpenGL context, so that assets
+     * such as textures may be loaded, but its window is never shown.  The
+     * update() method is called every frame as normal, but the screen is
+     * never cleared, draw() is never called, and the display is never
+     * refreshed.  As nothing is presented, vsync is ignored and the frame
+     * rate is throttled by {@link #getFPS()} alone.
+     *
+     * On Linux, a headless application uses the SDL offscreen video driver
+     * (unless SDL_VIDEODRIVER is already set), so that it may be run on a
+     * machine without a window server.  This is the intended way to run a
+     * dedicated server or a load test.
+     *
+     * This method may only be safely called before the application is
+     * initialized.  Once the application is initialized; this value may not
+     * be changed.
+     *
+     * @param value Whether this application runs without a visible display
+     */
+    void setHeadless(bool value);
+
+    /**
+     * Returns true if this application runs without a visible display.
+     *
+     * A headless application still has an OpenGL context, so that assets
+     * such as textures may be loaded, but its window is never shown.  The
+     * update() method is called every frame as normal, but the screen is
+     * never cleared, draw() is never called, and the display is never
+     * refreshed.
+     *
+     * @return true if this application runs without a visible display.
+     */
+    bool isHeadless() const { return _headless; }
+
+    /**
+     * Sets whether this application renders without an OpenGL context.
+     *
+     * An application with a null renderer never creates an OpenGL context,
+     * and so it may run on a machine without a GPU.  Its window is never
+     * shown.  Unlike a headless application, draw() is still called every
+     * frame, but the screen is never cleared or refreshed.  The render
+     * classes keep their state on the CPU instead: textures only have a
+     * size and format, shaders are never compiled, and a {@link SpriteBatch}
+     * records its draw commands (see {@link SpriteBatch#getCallsMade()} and
+     * {@link SpriteBatch#getVerticesDrawn()}).  This measures the CPU cost of
+     * a frame, such as scene graph traversal and vertex preparation, without
+     * any device.
+     *
+     * A headless application may also use a null renderer, in which case
+     * draw() is never called.  This allows a dedicated server to load its
+     * textures on a machine without a GPU.
+     *
+     * This method may only be safely called before the application is
+     * initialized.  Once the application is initialized; this value may not
+     * be changed.
+     *
+     * @param value Whether this application renders without an OpenGL context
+     */
+    void setNullRenderer(bool value);
+
+    /**
+     * Returns true if this application renders without an OpenGL context.
+     *
+     * An application with a null renderer never creates an OpenGL context,
+     * and its window is never shown.  The render classes keep their state
+     * on the CPU instead of making OpenGL calls.
+     *
+     * @return true if this application renders without an OpenGL context.
+     */
+    bool isNullRenderer() const { return _nullrender; }
   
 	/**
 	 * Sets whether this application supports graphics multisampling.
@@ -30,6 +30,7 @@
 #define __CU_BASE_H__
 
 #include <memory>
+#include <cstring>
 #include <string>
 #include <SDL/SDL.h>
 
@@ -117,6 +118,15 @@
 	#include <GL/glu.h>	
 	/** The current OpenGL platform */
 	#define CU_GL_PLATFORM   CU_GL_OPENGL
+#elif defined (__LINUX__)
+    // Only used for dedicated hosts, which never need more than OpenGL 3
+    #ifndef GL_GLEXT_PROTOTYPES
+        #define GL_GLEXT_PROTOTYPES 1
+    #endif
+    #include <GL/gl.h>
+    #include <GL/glext.h>
+    /** The current OpenGL platform */
+    #define CU_GL_PLATFORM   CU_GL_OPENGL
 #endif
 
 #ifdef _MSC_VER 
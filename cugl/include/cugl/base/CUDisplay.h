@@ -177,6 +177,10 @@ public:
     static Uint32 INIT_MULTISAMPLED;
     /** Whether this display should be centered (on windowed screens) */
     static Uint32 INIT_CENTERED;
+    /** Whether this display is never shown (for servers and load tests) */
+    static Uint32 INIT_HEADLESS;
+    /** Whether this display has no OpenGL context (for profiling without a GPU) */
+    static Uint32 INIT_NULL_RENDER;
     
 #pragma mark Values
 protected:
@@ -194,6 +198,8 @@ protected:
     int _framebuffer;
     /** The default renderbuffer associated with the display */
     int _rendbuffer;
+    /** Whether this display has no OpenGL context */
+    bool _nullrender;
 
     /** The full screen resolution of this device */
     Rect _bounds;
@@ -655,7 +661,8 @@ public:
     /**
      * Refreshes the display.
      *
-     * This method will swap the OpenGL framebuffers, drawing the screen.
+     * This method will swap the OpenGL framebuffers, drawing the screen. If
+     * this display has no OpenGL context, there is nothing to swap.
      *
      * It will also reassess the orientation state and call the listener as
      * necessary
@@ -681,6 +688,21 @@ public:
      * on iOS).
      */
     void queryRenderTarget();
+
+    /**
+     * Returns true if this display has no OpenGL context.
+     *
+     * A display started with the flag {@link INIT_NULL_RENDER} has a window,
+     * but never creates an OpenGL context. The render classes check this
+     * value and keep their state on the CPU instead of making OpenGL calls.
+     * Textures only keep their size and format, shaders are never compiled,
+     * and a {@link SpriteBatch} records its draw commands instead of drawing
+     * them. This allows the full game loop to run, and to be profiled, on a
+     * machine without a GPU.
+     *
+     * @return true if this display has no OpenGL context.
+     */
+    bool isNullRenderer() const { return _nullrender; }
     
 private:
     /**
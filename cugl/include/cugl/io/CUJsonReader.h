@@ -50,6 +50,7 @@
 #define __CU_JSON_READER_H__
 #include <cugl/io/CUTextReader.h>
 #include <cugl/assets/CUJsonValue.h>
+#include <cugl/assets/CUJsonDocument.h>
 
 namespace  cugl {
 
@@ -178,6 +179,21 @@ public:
      * @return a newly allocated JsonValue for the next available JSON string.
      */
     std::shared_ptr<JsonValue> readJson();
+
+    /**
+     * Returns a newly allocated JsonDocument for the next available JSON string.
+     *
+     * This method uses {@link readJsonString()} to extract the next available
+     * JSON string and parses it directly into a read-only document, without
+     * cJSON. This is much cheaper than {@link readJson()} for large files.
+     *
+     * If there is a parsing error, this  method will return nullptr.  Detailed
+     * information about the parsing error will be passed to an assert.  Hence
+     * error messages are suppressed if asserts are turned off.
+     *
+     * @return a newly allocated JsonDocument for the next available JSON string.
+     */
+    std::shared_ptr<JsonDocument> readJsonDocument();
     
 };
 
@@ -0,0 +1,438 @@
+//
+//  CULoopbackNetwork.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides an in-memory network for testing NetworkConnection
+//  without a punchthrough server.  Any number of connections in the same
+//  process may join the same loopback network, which plays the role of both
+//  the internet and the punchthrough server.  Packets are delayed, dropped and
+//  throttled according to simulated network conditions.  The conditions are
+//  driven by a seeded random generator, and the network can be given a manual
+//  clock, so that a test with the same inputs produces the same traffic.
+//
+//  To use it, allocate a network and set the transport factory of each
+//  connection configuration to {@link LoopbackNetwork#getTransportFactory}.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#ifndef __CU_LOOPBACK_NETWORK_H__
+#define __CU_LOOPBACK_NETWORK_H__
+#include <cugl/base/CUBase.h>
+#include <cugl/net/CUNetworkTransport.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace cugl {
+
+class LoopbackTransport;
+
+#pragma mark -
+#pragma mark Loopback Network
+/**
+ * An in-memory network shared by several connections in one process.
+ *
+ * Each connection using this network gets a {@link LoopbackTransport} with
+ * its own address. Connecting to any address that is not a loopback peer is
+ * treated as connecting to the punchthrough server, which assigns the peer a
+ * room. A client may then join the host of that room, exactly as it would
+ * through a real punchthrough server.
+ *
+ * Every packet between peers is subject to the current {@link Conditions}.
+ * A packet leaves its sender once the sender's uplink is free, arrives after
+ * the latency plus some jitter, and may be lost. A lost reliable packet is
+ * resent after a round trip, so it arrives late instead of not at all. Ordered
+ * packets never overtake earlier ones on the same link. Connection events are
+ * delayed by the latency but never lost.
+ *
+ * This class is not thread safe. All connections using it must be updated
+ * on the same thread.
+ */
+class LoopbackNetwork : public std::enable_shared_from_this<LoopbackNetwork> {
+public:
+    /**
+     * The simulated conditions of every link in the network.
+     */
+    struct Conditions {
+        /** The one-way latency in milliseconds */
+        float latency;
+        /** The maximum random change to the latency in milliseconds */
+        float jitter;
+        /** The probability that a packet is lost (0 to 1) */
+        float loss;
+        /** The upload rate of each peer in bytes per second (0 is unlimited) */
+        Uint32 bandwidth;
+
+        /**
+         * Creates a perfect network.
+         */
+        Conditions() : latency(0), jitter(0), loss(0), bandwidth(0) {}
+    };
+
+    /**
+     * The traffic statistics of a single peer.
+     */
+    struct Stats {
+        /** The number of packets sent, including each broadcast copy */
+        Uint64 packetsSent;
+        /** The number of bytes sent, including the UDP/IP overhead */
+        Uint64 bytesSent;
+        /** The number of unreliable packets that were dropped */
+        Uint64 packetsDropped;
+        /** The number of reliable packets that had to be resent */
+        Uint64 packetsResent;
+        /** The number of packets received */
+        Uint64 packetsReceived;
+
+        /**
+         * Creates empty statistics.
+         */
+        Stats() : packetsSent(0), bytesSent(0), packetsDropped(0),
+        packetsResent(0), packetsReceived(0) {}
+    };
+
+private:
+    /** The peers currently on this network */
+    std::vector<LoopbackTransport*> _peers;
+    /** The hosts of each room */
+    std::unordered_map<std::string, LoopbackTransport*> _rooms;
+    /** The conditions of every link */
+    Conditions _conditions;
+    /** The traffic statistics of every peer combined */
+    Stats _stats;
+    /** The random generator for jitter and loss */
+    std::mt19937 _random;
+    /** The next port to assign */
+    unsigned short _nextPort;
+    /** The next room number to assign */
+    Uint32 _nextRoom;
+    /** Whether the clock only moves on calls to {@link #advance} */
+    bool _manualClock;
+    /** The manual time in microseconds */
+    Uint64 _time;
+    /** The start of the real clock */
+    std::chrono::steady_clock::time_point _start;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an uninitialized loopback network.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    LoopbackNetwork();
+
+    /**
+     * Deletes this network.
+     *
+     * Transports created by this network keep it alive, so this is only
+     * called once they are all gone.
+     */
+    ~LoopbackNetwork() {}
+
+    /**
+     * Initializes a perfect network with the given random seed.
+     *
+     * @param seed  The seed for jitter and loss
+     *
+     * @return true if initialization was successful
+     */
+    bool init(Uint32 seed);
+
+    /**
+     * Returns a newly allocated perfect network with the given random seed.
+     *
+     * @param seed  The seed for jitter and loss
+     *
+     * @return a newly allocated perfect network with the given random seed.
+     */
+    static std::shared_ptr<LoopbackNetwork> alloc(Uint32 seed = 0) {
+        std::shared_ptr<LoopbackNetwork> result = std::make_shared<LoopbackNetwork>();
+        return (result->init(seed) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns a factory for transports on this network.
+     *
+     * Set this as the transport of a connection configuration to put the
+     * connection on this network.
+     *
+     * @return a factory for transports on this network.
+     */
+    NetworkTransport::Factory getTransportFactory();
+
+    /**
+     * Returns the conditions of every link in this network.
+     *
+     * @return the conditions of every link in this network.
+     */
+    const Conditions& getConditions() const { return _conditions; }
+
+    /**
+     * Sets the conditions of every link in this network.
+     *
+     * The new conditions only apply to packets sent afterwards. The loss
+     * is clamped to 0..1. A reliable packet is resent until it arrives, but
+     * one lost too many times is dropped, as if the connection timed out.
+     *
+     * @param conditions    The conditions of every link
+     */
+    void setConditions(const Conditions& conditions);
+
+    /**
+     * Returns the combined traffic statistics of every peer so far.
+     *
+     * This includes peers that have since left the network.
+     *
+     * @return the combined traffic statistics of every peer so far.
+     */
+    const Stats& getStats() const { return _stats; }
+
+    /**
+     * Sets whether the clock only moves on calls to {@link #advance}.
+     *
+     * By default, the network uses real time. A manual clock makes a test
+     * independent of how fast it runs.
+     *
+     * @param value Whether to use a manual clock
+     */
+    void setManualClock(bool value);
+
+    /**
+     * Moves the manual clock forward.
+     *
+     * This method does nothing if the clock is not manual.
+     *
+     * @param micros    The time to move forward in microseconds
+     */
+    void advance(Uint64 micros) { _time += micros; }
+
+    /**
+     * Returns the current network time in microseconds.
+     *
+     * @return the current network time in microseconds.
+     */
+    Uint64 now() const;
+
+#pragma mark Internals
+    /**
+     * Adds a transport to this network, returning its address.
+     *
+     * This method should only be called by {@link LoopbackTransport}.
+     *
+     * @param peer  The transport to add
+     *
+     * @return the address of the transport
+     */
+    SLNet::SystemAddress attach(LoopbackTransport* peer);
+
+    /**
+     * Removes a transport from this network, along with any room it hosts.
+     *
+     * This method should only be called by {@link LoopbackTransport}.
+     *
+     * @param peer  The transport to remove
+     */
+    void detach(LoopbackTransport* peer);
+
+    /**
+     * Returns the transport with the given address, or nullptr if there is none.
+     *
+     * @param address   The address to look up
+     *
+     * @return the transport with the given address, or nullptr if there is none.
+     */
+    LoopbackTransport* find(const SLNet::SystemAddress& address) const;
+
+    /**
+     * Connects a transport to the punchthrough server at the given address.
+     *
+     * The transport is assigned a new room.
+     *
+     * @param peer      The transport connecting
+     * @param server    The address of the server
+     */
+    void connectServer(LoopbackTransport* peer, const SLNet::SystemAddress& server);
+
+    /**
+     * Punches through from a transport to the host of the given room.
+     *
+     * @param peer      The transport asking
+     * @param room      The room to join
+     * @param server    The address of the server
+     */
+    void openNAT(LoopbackTransport* peer, const std::string& room,
+                 const SLNet::SystemAddress& server);
+
+    /**
+     * Sends a packet between two transports under the current conditions.
+     *
+     * @param from          The sender
+     * @param to            The receiver
+     * @param data          The packet
+     * @param size          The number of bytes in the packet
+     * @param reliability   The packet reliability
+     */
+    void transmit(LoopbackTransport* from, LoopbackTransport* to,
+                  const uint8_t* data, size_t size, PacketReliability reliability);
+
+    /**
+     * Delivers a connection event to a transport after the latency.
+     *
+     * @param to        The receiver
+     * @param from      The address the event comes from
+     * @param event     The Slikenet message ID of the event
+     * @param data      Any data following the message ID
+     */
+    void notify(LoopbackTransport* to, const SLNet::SystemAddress& from,
+                uint8_t event, const std::vector<uint8_t>& data = {});
+
+private:
+    /**
+     * Returns a random latency in microseconds, including jitter.
+     *
+     * @return a random latency in microseconds, including jitter.
+     */
+    Uint64 sampleLatency();
+};
+
+#pragma mark -
+#pragma mark Loopback Transport
+/**
+ * A transport on a {@link LoopbackNetwork}.
+ *
+ * This class is created by the factory of a loopback network, and should
+ * not be used directly.
+ */
+class LoopbackTransport : public NetworkTransport {
+private:
+    /**
+     * The traffic on the link to a single connected peer.
+     */
+    struct Link {
+        /** The number of transmissions to the peer, including resends */
+        Uint64 packets;
+        /** The number of transmissions to the peer that were lost */
+        Uint64 lost;
+        /** The number of bytes sent to the peer */
+        Uint64 bytesSent;
+        /** The number of bytes received from the peer */
+        Uint64 bytesReceived;
+        /** The arrival time of the last ordered packet sent to the peer */
+        Uint64 lastArrival;
+
+        /**
+         * Creates an unused link.
+         */
+        Link() : packets(0), lost(0), bytesSent(0), bytesReceived(0), lastArrival(0) {}
+    };
+
+    /** The network this transport is on */
+    std::shared_ptr<LoopbackNetwork> _network;
+    /** The address of this transport */
+    SLNet::SystemAddress _address;
+    /** Whether this transport has started */
+    bool _active;
+    /** The transports this one is connected to */
+    std::vector<LoopbackTransport*> _connections;
+    /** The packets on their way to this transport, by arrival time */
+    std::multimap<Uint64, SLNet::Packet*> _inbox;
+    /** The time the uplink of this transport is next free */
+    Uint64 _uplinkFree;
+    /** The traffic on the link to each connected peer */
+    std::unordered_map<LoopbackTransport*, Link> _links;
+    /** The traffic statistics */
+    LoopbackNetwork::Stats _stats;
+
+    friend class LoopbackNetwork;
+
+public:
+    /**
+     * Creates a transport on the given network that has not started.
+     *
+     * @param network   The loopback network
+     */
+    LoopbackTransport(const std::shared_ptr<LoopbackNetwork>& network);
+
+    /**
+     * Deletes this transport, closing all connections.
+     */
+    ~LoopbackTransport();
+
+    /**
+     * Returns the address of this transport.
+     *
+     * @return the address of this transport.
+     */
+    const SLNet::SystemAddress& getAddress() const { return _address; }
+
+    /**
+     * Returns the traffic statistics of this transport.
+     *
+     * @return the traffic statistics of this transport.
+     */
+    const LoopbackNetwork::Stats& getStats() const { return _stats; }
+
+    bool startup(unsigned int maxConnections, unsigned int timeout) override;
+    void shutdown(unsigned int block) override;
+    void setMaximumIncomingConnections(unsigned short count) override {}
+    void connect(const SLNet::SystemAddress& address) override;
+    void closeConnection(const SLNet::SystemAddress& address) override;
+    bool isConnected(const SLNet::SystemAddress& address) override;
+    unsigned short getNumberOfConnections() override {
+        return (unsigned short)_connections.size();
+    }
+    void openNAT(const std::string& room, const SLNet::SystemAddress& server) override;
+    void send(const uint8_t* data, size_t size, PacketReliability reliability,
+              const SLNet::SystemAddress& address, bool broadcast) override;
+    SLNet::Packet* receive() override;
+    void deallocatePacket(SLNet::Packet* packet) override;
+    bool getPeerStats(const SLNet::SystemAddress& address, PeerStats& stats) override;
+    std::string getGuid() override { return _address.ToString(); }
+
+private:
+    /**
+     * Removes a connection without notifying the other peer.
+     *
+     * @param peer  The peer to disconnect from
+     */
+    void drop(LoopbackTransport* peer);
+};
+
+}
+
+#endif /* __CU_LOOPBACK_NETWORK_H__ */
@@ -53,7 +53,7 @@
 
 #include <slikenet/BitStream.h>
 #include <slikenet/MessageIdentifiers.h>
-#include <slikenet/NatPunchthroughClient.h>
+#include <cugl/net/CUNetworkTransport.h>
 
 // Forward declarations
 namespace SLNet {
@@ -75,6 +75,11 @@ namespace cugl {
  * server. However, any messages sent are relayed by the host to all other players too,
  * so the interface appears peer-to-peer.
  *
+ * The host does not relay a client message as soon as it arrives. The messages from
+ * one call to {@link #receive} are packed into a single datagram per player, and
+ * sent at the end of that call. A relay filter (see {@link #setRelayFilter}) lets
+ * the host keep some messages to itself, or only relay the newest of a kind.
+ *
  * You can use this as a true client-server by just checking the player ID. Player ID 0
  * is the host, and all others are clients connected to the host.
  *
@@ -114,6 +119,14 @@ public:
          * incompatible API change happens.
          */
         uint8_t apiVersion;
+        /**
+         * The factory for the datagram layer of the connection.
+         *
+         * If this is empty, the connection uses Slikenet and the punchthrough
+         * server. Use {@link LoopbackNetwork#getTransportFactory} to run several
+         * connections in one process without a server.
+         */
+        NetworkTransport::Factory transport;
 
         /**
          * Creates a placeholder connection configuration
@@ -188,9 +201,42 @@ public:
         GenericError
     };
 
+    /**
+     * How the host relays a message sent by a client.
+     */
+    enum class RelayAction {
+        /** Relay the message to all other players */
+        Forward,
+        /** Keep the message on the host */
+        Consume,
+        /**
+         * Relay the message to all other players, but replace any message with
+         * the same key from the same client that has not been relayed yet
+         */
+        Merge
+    };
+
+    /**
+     * The relay decision for a single client message.
+     */
+    struct RelayRule {
+        /** What to do with the message */
+        RelayAction action;
+        /** The key identifying messages that replace each other (Merge only) */
+        uint32_t key;
+    };
+
+    /**
+     * A function deciding how the host relays a client message.
+     *
+     * The function is given the message bytes, which are only valid for the
+     * duration of the call.
+     */
+    typedef std::function<RelayRule(const uint8_t*, size_t)> RelayFilter;
+
 private:
     /** Connection object */
-    std::unique_ptr<SLNet::RakPeerInterface> _peer;
+    std::unique_ptr<NetworkTransport> _transport;
     /** Current status */
     NetStatus _status;
     /** API version number */
@@ -207,8 +253,6 @@ private:
     std::bitset<256> _connectedPlayers;
     /** Address of punchthrough server */
     std::unique_ptr<SLNet::SystemAddress> _natPunchServerAddress;
-    /** NAT Punchthrough Client */
-    SLNet::NatPunchthroughClient _natPunchthroughClient;
     /** Last reconnection attempt time, or none if n/a */
     std::optional<time_t> _lastReconnAttempt;
     /** Time when disconnected, or none if connected */
@@ -218,6 +262,25 @@ private:
     /** Whether to enable debug loggging on connection (default true) */
     bool _debug;
 
+    /**
+     * A client message waiting to be relayed by the host
+     */
+    struct RelayMessage {
+        /** The player that sent the message */
+        uint8_t sender;
+        /** Whether a newer message with the same key replaces this one */
+        bool merge;
+        /** The merge key */
+        uint32_t key;
+        /** The message */
+        std::vector<uint8_t> data;
+    };
+
+    /** How the host relays client messages (empty to relay everything) */
+    RelayFilter _relayFilter;
+    /** The client messages to relay at the end of {@link #receive} */
+    std::vector<RelayMessage> _relayQueue;
+
     /**
      * Data structure to manage the connection state for the server
      */
@@ -286,7 +349,9 @@ private:
         PlayerJoined,
         PlayerLeft,
         StartGame,
-        DirectToHost
+        DirectToHost,
+        // Several standard messages relayed by the host
+        Batch
     };
     
     /** The default reliability of this connetion */
@@ -423,6 +488,22 @@ public:
      */
     void sendOnlyToHost(const std::vector<uint8_t>& msg);
 
+    /**
+     * Sends a byte array to a single player only.
+     *
+     * This is only useful when called from the host (player ID 0). As a client,
+     * this method does nothing. Within a few frames, the given player should
+     * receive this via a call to {@link #receive}. Unlike {@link #send}, the
+     * message is not relayed to any other player.
+     *
+     * This allows the host to limit state to the players that need it. If the
+     * player is not connected, this method does nothing.
+     *
+     * @param msg       The byte array to send.
+     * @param playerID  The player to send to.
+     */
+    void sendToPlayer(const std::vector<uint8_t>& msg, uint8_t playerID);
+
     /**
      * Receives incoming network messages.
      *
@@ -443,6 +524,20 @@ public:
      */
     void receive(const std::function<void(const std::vector<uint8_t>&)>& dispatcher);
 
+    /**
+     * Receives incoming network messages without copying them.
+     *
+     * This method is identical to the vector version of {@link #receive}, except
+     * that `dispatch` is given a pointer into the received packet and the number
+     * of bytes in the message. The bytes are only valid for the duration of the
+     * call, as the packet is released as soon as `dispatch` returns. This allows
+     * a message to be decoded with {@link NetworkDeserializer} straight out of
+     * the packet.
+     *
+     * @param dispatcher    The function to process received data
+     */
+    void receive(const std::function<void(const uint8_t*, size_t)>& dispatcher);
+
     /**
      * Marks the game as started and ban incoming connections except for reconnects.
      *
@@ -521,6 +616,22 @@ public:
      */
      void setReliability(PacketReliability reliability);
 
+    /**
+     * Sets how the host relays the messages clients send with {@link #send}.
+     *
+     * The filter is called on the host once for every message a client sends.
+     * A message may be relayed to everyone else, kept on the host, or merged
+     * so that only the newest message with a given key from that client is
+     * relayed each time {@link #receive} is called. The host still receives
+     * every message, whatever the rule. Without a filter, every message is
+     * forwarded.
+     *
+     * This method only matters for the host.
+     *
+     * @param filter    The function deciding how to relay each message
+     */
+    void setRelayFilter(const RelayFilter& filter) { _relayFilter = filter; }
+
     /**
      * Returns the current status of this network connection.
      *
@@ -613,6 +724,20 @@ public:
      */
     unsigned int getMaxPacketSize();
 
+    /**
+     * Stores the link statistics for the connection to the given player.
+     *
+     * The host has a link to every client, while a client only has a link to
+     * the host (player 0). The statistics come from the transport, and so
+     * include protocol overhead and resends that {@link #send} does not see.
+     *
+     * @param playerID  The player at the other end of the link
+     * @param stats     The statistics to write to
+     *
+     * @return true if this connection has a link to the player
+     */
+    bool getPeerStats(uint8_t playerID, NetworkTransport::PeerStats& stats);
+
 #pragma mark Communication Internals
 private:
     /**
@@ -650,6 +775,30 @@ private:
                     CustomDataPackets packetType,
                     SLNet::SystemAddress dest);
 
+    /**
+     * Queues a message from a client to be relayed to the other players.
+     *
+     * PRECONDITION: This player MUST be the host
+     *
+     * @param h         The host peers
+     * @param source    The address of the client that sent the message
+     * @param msg       The message bytes
+     * @param size      The number of bytes in the message
+     */
+    void queueRelay(HostPeers& h, const SLNet::SystemAddress& source,
+                    const uint8_t* msg, size_t size);
+
+    /**
+     * Sends all queued client messages, one datagram per player if possible.
+     *
+     * Each player is sent the messages from every client other than itself.
+     *
+     * PRECONDITION: This player MUST be the host
+     *
+     * @param h The host peers
+     */
+    void flushRelay(HostPeers& h);
+
     /**
      * Attempts to reconnect to the host.
      *
@@ -757,6 +906,8 @@ private:
      */
     void cr2HostGetClientResp(HostPeers& h, SLNet::Packet* packet, const std::vector<uint8_t>& msgConverted);
 
+    /** The loopback network plays the punchthrough server, so it sends room assignments */
+    friend class LoopbackNetwork;
 };
 }
 
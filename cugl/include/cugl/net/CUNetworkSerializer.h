@@ -433,8 +433,12 @@ public:
  */
 class NetworkDeserializer {
 protected:
-    /** Currently loaded data */
-    std::vector<uint8_t> _data;
+    /** Storage for messages loaded by copy */
+    std::vector<uint8_t> _buffer;
+    /** Currently loaded data (either _buffer or bytes owned by the caller) */
+    const uint8_t* _data;
+    /** The number of bytes in the loaded data */
+    size_t _size;
     /** Position in the data of next byte to read */
     size_t _pos;
 
@@ -478,7 +482,7 @@ public:
      * to use an init method. However, we do include a static {@link #alloc} method
      * for creating shared pointers.
      */
-    NetworkDeserializer() : _pos(0) {}
+    NetworkDeserializer() : _data(nullptr), _size(0), _pos(0) {}
 
     /**
      * Returns a newly created Network Deserializer.
@@ -510,6 +514,20 @@ public:
      */
     void receive(const std::vector<uint8_t>& msg);
 
+    /**
+     * Loads a new message to be read without copying it.
+     *
+     * This method is identical to {@link #receive(const std::vector<uint8_t>&)},
+     * except that the bytes are read in place. The caller must keep them alive
+     * and unchanged until the message has been read and {@link #reset} (or
+     * another receive) has been called. This allows a message to be decoded
+     * directly out of a network packet.
+     *
+     * @param data  The bytes serialized by {@link NetworkSerializer}
+     * @param size  The number of bytes
+     */
+    void receive(const uint8_t* data, size_t size);
+
     /**
      * Reads the next unreturned value or vector from the currently loaded byte vector.
      * 
@@ -531,7 +549,7 @@ public:
      *
      * @return true if there is any data left to be read
      */
-    bool available() const { return _pos < _data.size(); }
+    bool available() const { return _pos < _size; }
     
     /**
      * Returns the type of the next data value to be read.
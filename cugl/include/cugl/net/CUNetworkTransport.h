@@ -0,0 +1,266 @@
+//
+//  CUNetworkTransport.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides the datagram layer underneath NetworkConnection.  The
+//  connection handles rooms, player IDs and message relaying, while the
+//  transport only connects to addresses and moves packets between them.  The
+//  default transport is Slikenet with NAT punchthrough.  Other transports (such
+//  as LoopbackNetwork) allow the connection to run without a server.
+//
+//  Addresses and packets use the Slikenet types, so that the connection code
+//  is identical whatever the transport.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#ifndef __CU_NETWORK_TRANSPORT_H__
+#define __CU_NETWORK_TRANSPORT_H__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <slikenet/types.h>
+#include <slikenet/PacketPriority.h>
+
+// Forward declarations
+namespace SLNet {
+    class RakPeerInterface;
+    class NatPunchthroughClient;
+}
+
+namespace cugl {
+
+#pragma mark -
+#pragma mark Network Transport
+/**
+ * An abstract datagram layer for {@link NetworkConnection}.
+ *
+ * A transport connects to other peers by address and sends them packets.
+ * Connection events are reported as packets, exactly as Slikenet reports them
+ * (e.g. ID_CONNECTION_REQUEST_ACCEPTED or ID_DISCONNECTION_NOTIFICATION), so
+ * the connection does not know which transport it is using.
+ *
+ * The punchthrough server is also part of the transport. Connecting to the
+ * server address must eventually produce ID_CONNECTION_REQUEST_ACCEPTED from
+ * that address, followed by a room assignment for a host. Calling
+ * {@link #openNAT} must produce ID_NAT_PUNCHTHROUGH_SUCCEEDED on both sides,
+ * or a failure code on the client.
+ */
+class NetworkTransport {
+public:
+    /** A function creating a new, unstarted transport */
+    typedef std::function<std::unique_ptr<NetworkTransport>()> Factory;
+
+    /**
+     * The link statistics for a single connected peer.
+     */
+    struct PeerStats {
+        /** The average round trip time in milliseconds */
+        int ping;
+        /** The fraction of packets lost over the last second (0 to 1) */
+        float lossLastSecond;
+        /** The fraction of packets lost over the whole connection (0 to 1) */
+        float lossTotal;
+        /** The number of bytes sent to the peer, including protocol overhead */
+        uint64_t bytesSent;
+        /** The number of bytes received from the peer, including protocol overhead */
+        uint64_t bytesReceived;
+
+        /**
+         * Creates empty statistics.
+         */
+        PeerStats() : ping(0), lossLastSecond(0), lossTotal(0),
+        bytesSent(0), bytesReceived(0) {}
+    };
+
+    /**
+     * Deletes this transport, closing all connections.
+     */
+    virtual ~NetworkTransport() {}
+
+    /**
+     * Starts the transport so that it can connect to other peers.
+     *
+     * @param maxConnections    The maximum number of connections
+     * @param timeout           The time in milliseconds before a silent peer is dropped
+     *
+     * @return true if the transport started successfully
+     */
+    virtual bool startup(unsigned int maxConnections, unsigned int timeout) = 0;
+
+    /**
+     * Stops the transport, closing all connections.
+     *
+     * If block is positive, the transport waits up to that many milliseconds
+     * to notify other peers. Otherwise they see the connection as lost.
+     *
+     * @param block The time in milliseconds to wait for notifications
+     */
+    virtual void shutdown(unsigned int block) = 0;
+
+    /**
+     * Sets the number of peers that may connect to this one.
+     *
+     * @param count The number of peers that may connect to this one
+     */
+    virtual void setMaximumIncomingConnections(unsigned short count) = 0;
+
+    /**
+     * Starts connecting to the given address.
+     *
+     * @param address   The address to connect to
+     */
+    virtual void connect(const SLNet::SystemAddress& address) = 0;
+
+    /**
+     * Closes the connection to the given address, notifying the other peer.
+     *
+     * @param address   The address to disconnect from
+     */
+    virtual void closeConnection(const SLNet::SystemAddress& address) = 0;
+
+    /**
+     * Returns true if this transport is connected to the given address.
+     *
+     * @param address   The address to check
+     *
+     * @return true if this transport is connected to the given address.
+     */
+    virtual bool isConnected(const SLNet::SystemAddress& address) = 0;
+
+    /**
+     * Returns the number of open connections.
+     *
+     * @return the number of open connections.
+     */
+    virtual unsigned short getNumberOfConnections() = 0;
+
+    /**
+     * Asks the punchthrough server to connect this peer to the host of a room.
+     *
+     * @param room      The room ID
+     * @param server    The address of the punchthrough server
+     */
+    virtual void openNAT(const std::string& room, const SLNet::SystemAddress& server) = 0;
+
+    /**
+     * Sends a packet to the given address.
+     *
+     * If broadcast is true, the packet is instead sent to every connected peer
+     * except the given address.
+     *
+     * @param data          The packet
+     * @param size          The number of bytes in the packet
+     * @param reliability   The packet reliability
+     * @param address       The destination (or the peer to skip on broadcast)
+     * @param broadcast     Whether to send to every other connected peer
+     */
+    virtual void send(const uint8_t* data, size_t size, PacketReliability reliability,
+                      const SLNet::SystemAddress& address, bool broadcast) = 0;
+
+    /**
+     * Returns the next received packet, or nullptr if there is none.
+     *
+     * Each packet must be returned with {@link #deallocatePacket}.
+     *
+     * @return the next received packet, or nullptr if there is none.
+     */
+    virtual SLNet::Packet* receive() = 0;
+
+    /**
+     * Releases a packet returned by {@link #receive}.
+     *
+     * @param packet    The packet to release
+     */
+    virtual void deallocatePacket(SLNet::Packet* packet) = 0;
+
+    /**
+     * Stores the link statistics for the peer at the given address.
+     *
+     * @param address   The address of a connected peer
+     * @param stats     The statistics to write to
+     *
+     * @return true if the peer is connected
+     */
+    virtual bool getPeerStats(const SLNet::SystemAddress& address, PeerStats& stats) = 0;
+
+    /**
+     * Returns a string identifying this peer, for debugging.
+     *
+     * @return a string identifying this peer, for debugging.
+     */
+    virtual std::string getGuid() = 0;
+};
+
+#pragma mark -
+#pragma mark Slikenet Transport
+/**
+ * The default transport, which uses Slikenet and NAT punchthrough.
+ */
+class SLikeNetTransport : public NetworkTransport {
+private:
+    /** Connection object */
+    std::unique_ptr<SLNet::RakPeerInterface> _peer;
+    /** NAT Punchthrough Client */
+    std::unique_ptr<SLNet::NatPunchthroughClient> _natPunchthroughClient;
+
+public:
+    /**
+     * Creates a transport that has not started.
+     */
+    SLikeNetTransport();
+
+    /**
+     * Deletes this transport, closing all connections.
+     */
+    ~SLikeNetTransport();
+
+    /**
+     * Returns a factory for Slikenet transports.
+     *
+     * @return a factory for Slikenet transports.
+     */
+    static Factory factory() {
+        return []() { return std::unique_ptr<NetworkTransport>(new SLikeNetTransport()); };
+    }
+
+    bool startup(unsigned int maxConnections, unsigned int timeout) override;
+    void shutdown(unsigned int block) override;
+    void setMaximumIncomingConnections(unsigned short count) override;
+    void connect(const SLNet::SystemAddress& address) override;
+    void closeConnection(const SLNet::SystemAddress& address) override;
+    bool isConnected(const SLNet::SystemAddress& address) override;
+    unsigned short getNumberOfConnections() override;
+    void openNAT(const std::string& room, const SLNet::SystemAddress& server) override;
+    void send(const uint8_t* data, size_t size, PacketReliability reliability,
+              const SLNet::SystemAddress& address, bool broadcast) override;
+    SLNet::Packet* receive() override;
+    void deallocatePacket(SLNet::Packet* packet) override;
+    bool getPeerStats(const SLNet::SystemAddress& address, PeerStats& stats) override;
+    std::string getGuid() override;
+};
+
+}
+
+#endif /* __CU_NETWORK_TRANSPORT_H__ */
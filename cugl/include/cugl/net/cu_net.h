@@ -28,7 +28,9 @@
 #ifndef __CU_NET_PKG_H__
 #define __CU_NET_PKG_H__
 
+#include "CUNetworkTransport.h"
 #include "CUNetworkConnection.h"
+#include "CULoopbackNetwork.h"
 #include "CUNetworkSerializer.h"
 
 #endif /* __CU_NET_PKG_H__ */
@@ -75,6 +75,10 @@ namespace cugl {
  * {@link Texture::PixelFormat}. Finally, all output textures are bound sequentially
  * to output locations 0..\#outputs-1. However, we find that still allows us to handle
  * the vast majority of applications with a framebuffer.
+ *
+ * Without an OpenGL context (see {@link Display#isNullRenderer}), there is no
+ * framebuffer.  The output textures are only metadata (see {@link Texture}),
+ * and {@link #begin} and {@link #end} do nothing.
  */
 class RenderTarget {
 private:
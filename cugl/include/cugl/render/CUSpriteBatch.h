@@ -830,9 +830,37 @@ enum StencilEffect {
  * than one of these at a time. If you want to implement your own shader effects,
  * it is better to construct your own custom pipeline with {@link Shader} and
  * {@link VertexBuffer}.
+ *
+ * Without an OpenGL context (see {@link Display#isNullRenderer}), a sprite
+ * batch builds its meshes as usual but records each draw call as a
+ * {@link DrawCommand} instead of sending it to the graphics card. Together
+ * with {@link #getCallsMade} and {@link #getVerticesDrawn}, this allows
+ * rendering to be tested and profiled without a GPU.
  */
 class SpriteBatch {
 #pragma mark Values
+public:
+    /**
+     * A draw call recorded by a sprite batch without an OpenGL context.
+     *
+     * Each command is one call that would have been made to the vertex
+     * buffer, along with the drawing context in effect for that call.
+     */
+    struct DrawCommand {
+        /** The drawing command (e.g. GL_TRIANGLES or GL_LINES) */
+        GLenum command;
+        /** The drawing type for the shader */
+        GLint  type;
+        /** The buffer of the active texture (0 if there is none) */
+        GLuint texture;
+        /** The active stencil effect */
+        StencilEffect stencil;
+        /** The first index drawn */
+        GLuint first;
+        /** The number of indices drawn */
+        GLuint count;
+    };
+    
 private:
     
     /**
@@ -892,6 +920,10 @@ private:
     unsigned int _vertTotal;
     /** The number of OpenGL calls in this pass (so far) */
     unsigned int _callTotal;
+    /** Whether draw calls are recorded instead of sent to OpenGL */
+    bool _nullrender;
+    /** The draw calls recorded in this pass (so far) */
+    std::vector<DrawCommand> _commands;
     
 
 #pragma mark -
@@ -1156,6 +1188,17 @@ public:
      */
     unsigned int getCallsMade() const { return _callTotal; }
 
+    /**
+     * Returns the draw calls recorded in the latest pass (so far).
+     *
+     * Draw calls are only recorded when there is no OpenGL context (see
+     * {@link Display#isNullRenderer}). Otherwise this list is empty. It
+     * will be cleared whenever begin() is called.
+     *
+     * @return the draw calls recorded in the latest pass (so far).
+     */
+    const std::vector<DrawCommand>& getCommands() const { return _commands; }
+
     /**
      * Sets the shader for this sprite batch
      *
@@ -1600,7 +1643,8 @@ public:
      * texturing. You must call either {@link #flush} or {@link #end} to
      * complete drawing.
      *
-     * Calling this method will reset the vertex and OpenGL call counters to 0.
+     * Calling this method will reset the vertex and OpenGL call counters to 0,
+     * and clear any recorded draw commands.
      */
     void begin();
     
@@ -1611,7 +1655,8 @@ public:
      * texturing. You must call either {@link #flush} or {@link #end} to
      * complete drawing.
      *
-     * Calling this method will reset the vertex and OpenGL call counters to 0.
+     * Calling this method will reset the vertex and OpenGL call counters to 0,
+     * and clear any recorded draw commands.
      *
      * @param perspective   The perspective matrix to draw with.
      */
@@ -2738,6 +2783,26 @@ public:
      * @return the number of vertices added to the drawing buffer.
      */
     void drawMesh(const SpriteVertex2* vertices, size_t size, const Affine2& transform, bool tint = true);
+
+    /**
+     * Copies the vertices to dst, transforming the positions and tinting the colors.
+     *
+     * This is the vertex transform of every drawing method. On targets with
+     * SSE2 or 64-bit Neon, it transforms four vertices at a time. If vectorize
+     * is false, every vertex is processed one at a time instead. Both paths
+     * give identical colors, and positions that differ by at most the last
+     * bit. It is public so that the two paths can be compared.
+     *
+     * @param src       The vertices to copy
+     * @param dst       The buffer to store the result
+     * @param size      The number of vertices
+     * @param mat       The transform to apply to the vertices
+     * @param tint      The packed tint color
+     * @param shade     Whether to tint the vertex colors
+     * @param vectorize Whether to use the vectorized path, if there is one
+     */
+    static void transformVertices(const SpriteVertex2* src, SpriteVertex2* dst, size_t size,
+                                  const Affine2& mat, GLuint tint, bool shade, bool vectorize = true);
     
 #pragma mark -
 #pragma mark Text Drawing
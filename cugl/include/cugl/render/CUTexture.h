@@ -80,6 +80,11 @@ namespace cugl {
  * {@link UniformBuffer}. However, for legacy reasons, OpenGL does not allow a
  * texture to be active without being bound.  Hence the {@link #bind} method
  * below is used for both activating and binding a texture.
+ *
+ * Without an OpenGL context (see {@link Display#isNullRenderer}), a texture
+ * is only metadata. It has a unique buffer id, size and format, and binding
+ * is tracked on the CPU so that {@link #isBound} and {@link #isActive} still
+ * work.  However, it has no pixel data and cannot be saved.
  */
 class Texture : public std::enable_shared_from_this<Texture> {
 #pragma mark Values
@@ -200,6 +205,9 @@ private:
     /** Whether the algorithm or wrap-style has changed. */
     bool _dirty;
     
+    /** Whether the buffer is CPU-side metadata with no OpenGL texture */
+    bool _nullbuffer;
+    
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -79,6 +79,10 @@ namespace cugl {
  * uniform values can be assigned at the start of the render pass, each to a different
  * block.  Once the shader starts to receive vertices, the uniforms should be managed
  * via the {@link #setBlock} method.
+ *
+ * Without an OpenGL context (see {@link Display#isNullRenderer}), a uniform
+ * buffer only has its backing byte buffer.  Uniforms may still be set and
+ * read back, but they are never sent to a shader.
  */
 class UniformBuffer {
 private:
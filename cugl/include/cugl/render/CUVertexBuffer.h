@@ -76,6 +76,10 @@ class Shader;
  * buffer has attributes lacking in the shader, they will be ignored. If it is missing
  * attributes that the shader expects, the shader will use the default value
  * for the type.
+ *
+ * Without an OpenGL context (see {@link Display#isNullRenderer}), a vertex
+ * buffer is never created on the GPU.  It keeps its attributes and shader,
+ * but loading data and drawing do nothing.
  */
 class VertexBuffer {
 private:
@@ -173,6 +173,23 @@ protected:
      */
     Affine2  _combined;
     
+    /**
+     * The cached node to world transform.
+     *
+     * This matrix is the product of the local transforms of this node and
+     * all of its ancestors. It is only valid if _worldDirty is false, and is
+     * recomputed lazily by {@link getNodeToWorldTransform()} or by render.
+     */
+    mutable Affine2 _worldTransform;
+    
+    /**
+     * Whether the cached world transform is out of date.
+     *
+     * If a node is dirty, then so are all of its descendants. Changing the
+     * local transform or the parent of a node marks its entire subtree.
+     */
+    mutable bool _worldDirty;
+    
     /** The array of children nodes */
     std::vector<std::shared_ptr<SceneNode>> _children;
 
@@ -1385,9 +1402,15 @@ public:
      * It is the recursive (left-multiplied) node-to-parent transforms of all 
      * of its ancestors.
      *
+     * This matrix is cached, and is only recomputed when the transform of
+     * this node or one of its ancestors changes. As recomputing it updates
+     * the caches of the ancestors, this method is no more thread safe than
+     * the setters. A scene graph must only be used by one thread at a time,
+     * such as a worker thread building it before it is attached to a scene.
+     *
      * @return the matrix transforming node space to world space.
      */
-    Affine2 getNodeToWorldTransform() const;
+    Affine2 getNodeToWorldTransform() const { return getWorldTransform(); }
     
     /**
      * Returns the matrix transforming node space to world space.
@@ -1884,6 +1907,25 @@ public:
         render(batch,Affine2::IDENTITY,Color4::WHITE);
     }
 
+    /**
+     * Returns the node to world transform to render this node with.
+     *
+     * If transform is the cached world transform of the parent (or the
+     * identity for a node at the top of a scene), this method refreshes and
+     * returns the cached world transform of this node. Passing that to the
+     * children lets them use their caches too. Any other transform is
+     * multiplied into local, and local is returned.
+     *
+     * This method is for custom implementations of render. Like the cache,
+     * it must only be used by the thread that owns the scene graph.
+     *
+     * @param transform The global transformation matrix of the parent.
+     * @param local     The matrix to use if the cache cannot be.
+     *
+     * @return the node to world transform to render this node with.
+     */
+    const Affine2& getRenderTransform(const Affine2& transform, Affine2& local) const;
+
     /**
      * Draws this Node via the given SpriteBatch.
      *
@@ -1961,7 +2003,22 @@ private:
      *
      * @param parent    A pointer to the parent node.
      */
-    void setParent(SceneNode* parent) { _parent = parent; }
+    void setParent(SceneNode* parent) { _parent = parent; markWorldDirty(); }
+
+    /**
+     * Marks the cached world transform of this node and its descendants dirty.
+     *
+     * The recursion stops at any node that is already dirty, as all of its
+     * descendants are guaranteed to be dirty as well.
+     */
+    void markWorldDirty();
+
+    /**
+     * Returns the cached node to world transform, refreshing it if necessary.
+     *
+     * @return the cached node to world transform.
+     */
+    const Affine2& getWorldTransform() const;
 
     /**
      * Sets the scene graph.
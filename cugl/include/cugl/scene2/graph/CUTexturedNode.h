@@ -603,6 +603,21 @@ public:
      */
     void refresh() { clearRenderData(); generateRenderData(); }
 
+    /**
+     * Returns the render data for this node, generating it if necessary.
+     *
+     * The mesh is in node space and uses the current texture coordinates,
+     * including any animation frame or flip. It is intended for nodes that
+     * redraw this node elsewhere, such as motion trails.
+     *
+     * @return the render data for this node.
+     */
+    const Mesh<SpriteVertex2>& getMesh() {
+        if (!_rendered) {
+            generateRenderData();
+        }
+        return _mesh;
+    }
     
 protected:
     /**
@@ -0,0 +1,291 @@
+//
+//  CUProfiler.h
+//  Cornell University Game Library (CUGL)
+//
+//  Module for lightweight frame instrumentation.  Code is measured by placing
+//  a named scope around it with the macro CU_PROFILE_SCOPE.  Each scope is
+//  recorded as a single event in a fixed-size ring buffer owned by the thread
+//  that executed it, so recording never locks and never allocates.  The events
+//  may be summarized once a frame for a debug overlay, or written out in the
+//  Chrome trace format (chrome://tracing or https://ui.perfetto.dev).
+//
+//  Profiling is off by default.  A disabled scope costs a single atomic read.
+//  Defining CU_NO_PROFILE removes the scopes from the build entirely.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#ifndef __CU_PROFILER_H__
+#define __CU_PROFILER_H__
+#include <cugl/base/CUBase.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace cugl {
+
+#pragma mark -
+#pragma mark Profiler
+
+/**
+ * Static class for recording timed events.
+ *
+ * An event is a named interval of time measured in nanoseconds.  Event names
+ * must be string literals (or otherwise outlive the profiler), as only the
+ * pointer is stored.  This allows the summary to group events by pointer
+ * instead of comparing strings.
+ *
+ * Every thread that records an event is given its own ring buffer of
+ * {@link #BUFFER_SIZE} events the first time it records.  Only the owning
+ * thread writes to a buffer, so recording is lock-free.  Once a buffer is
+ * full, new events overwrite the oldest ones.  The buffer of a thread that
+ * exits is kept, so that a trace can still include it, until the next call
+ * to {@link #clear}.  Call {@link #dispose} to release every buffer when the
+ * profiler is no longer needed.
+ *
+ * The thread that calls {@link #markFrame} (normally the main thread) is
+ * treated as the frame thread.  Its events since the previous mark are
+ * summarized in {@link #getFrameStats}, which is what an overlay displays.
+ *
+ * This class should not be used directly to time code.  Use the macro
+ * CU_PROFILE_SCOPE instead, which records an event when the scope exits.
+ */
+class Profiler {
+public:
+    /** The number of events stored per thread */
+    static const Uint32 BUFFER_SIZE = 16384;
+
+    /**
+     * A single recorded event.
+     */
+    class Event {
+    public:
+        /** The static name of the event */
+        const char* name;
+        /** The start of the event in nanoseconds */
+        Uint64 start;
+        /** The end of the event in nanoseconds */
+        Uint64 end;
+        /** The number of scopes enclosing this one on the same thread */
+        Uint32 depth;
+    };
+
+    /**
+     * The time spent in a named scope in the last frame.
+     */
+    class Stat {
+    public:
+        /** The static name of the scope */
+        const char* name;
+        /** The nesting depth of the first occurrence of the scope */
+        Uint32 depth;
+        /** The start of the first occurrence of the scope in nanoseconds */
+        Uint64 start;
+        /** The number of times the scope was entered */
+        Uint32 calls;
+        /** The total time spent in the scope, in nanoseconds */
+        Uint64 total;
+    };
+
+private:
+    /** Whether events are currently being recorded */
+    static std::atomic<bool> _enabled;
+
+public:
+#pragma mark Recording
+    /**
+     * Sets whether the profiler records events.
+     *
+     * Scopes that are already open when this changes are handled correctly:
+     * a scope records an event only if profiling was enabled when it opened.
+     *
+     * @param value Whether the profiler records events
+     */
+    static void setEnabled(bool value) { _enabled.store(value, std::memory_order_relaxed); }
+
+    /**
+     * Returns true if the profiler records events.
+     *
+     * @return true if the profiler records events.
+     */
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns the current time in nanoseconds.
+     *
+     * The time is measured from an arbitrary fixed point using the steady
+     * clock, and is only meaningful relative to other profiler times.
+     *
+     * @return the current time in nanoseconds.
+     */
+    static Uint64 now();
+
+    /**
+     * Opens a scope on the current thread, returning its nesting depth.
+     *
+     * This method should only be called by {@link ProfileScope}.
+     *
+     * @return the nesting depth of the new scope.
+     */
+    static Uint32 push();
+
+    /**
+     * Closes a scope on the current thread, recording it as an event.
+     *
+     * This method should only be called by {@link ProfileScope}.
+     *
+     * @param name  The static name of the scope
+     * @param start The time the scope was opened in nanoseconds
+     * @param depth The nesting depth returned by {@link #push}
+     */
+    static void pop(const char* name, Uint64 start, Uint32 depth);
+
+    /**
+     * Discards all recorded events on every thread.
+     *
+     * This also releases the buffers of threads that have exited. This
+     * method is not safe to call while other threads are recording.
+     */
+    static void clear();
+
+    /**
+     * Releases the buffers of every thread, discarding all recorded events.
+     *
+     * A thread that records again afterwards is given a new buffer.  This
+     * method is not safe to call while other threads are recording.
+     */
+    static void dispose();
+
+#pragma mark Frame Summary
+    /**
+     * Marks the end of a frame, summarizing the events since the last mark.
+     *
+     * This should be called once per frame from the main thread, after the
+     * frame has been drawn.  Only the events recorded by the calling thread
+     * are included in the summary.
+     */
+    static void markFrame();
+
+    /**
+     * Returns the scopes of the last frame in the order they first appeared.
+     *
+     * The result is only updated by {@link #markFrame}.  The list is empty
+     * if profiling was disabled for the whole frame.
+     *
+     * @return the scopes of the last frame.
+     */
+    static const std::vector<Stat>& getFrameStats();
+
+    /**
+     * Returns the length of the last frame in nanoseconds.
+     *
+     * This is the time between the last two calls to {@link #markFrame}.
+     *
+     * @return the length of the last frame in nanoseconds.
+     */
+    static Uint64 getFrameTime();
+
+#pragma mark Trace Output
+    /**
+     * Writes every buffered event to a file in the Chrome trace format.
+     *
+     * The file is a JSON object with a single "traceEvents" array of complete
+     * ("X") events, one thread per ring buffer.  It can be opened in the
+     * Chrome trace viewer or in Perfetto.  The path follows the rules of
+     * {@link TextWriter}, so a relative path is placed in the save directory.
+     *
+     * Threads may continue recording while the trace is written.  Events that
+     * are overwritten during the dump are left out rather than torn.
+     *
+     * @param path  The file to write to
+     *
+     * @return true if the file was written.
+     */
+    static bool writeChromeTrace(const std::string& path);
+};
+
+#pragma mark -
+#pragma mark Profile Scope
+
+/**
+ * A scope that records a profiler event for its lifetime.
+ *
+ * This class should be created on the stack with the macro CU_PROFILE_SCOPE.
+ * If the profiler is disabled when the scope opens, it does nothing.
+ */
+class ProfileScope {
+private:
+    /** The static name of this scope */
+    const char* _name;
+    /** The time this scope opened in nanoseconds */
+    Uint64 _start;
+    /** The nesting depth of this scope */
+    Uint32 _depth;
+    /** Whether this scope is recording */
+    bool _active;
+
+public:
+    /**
+     * Opens a scope with the given static name.
+     *
+     * @param name  The static name of the scope
+     */
+    explicit ProfileScope(const char* name) : _name(name), _start(0), _depth(0) {
+        _active = Profiler::isEnabled();
+        if (_active) {
+            _depth = Profiler::push();
+            _start = Profiler::now();
+        }
+    }
+
+    /**
+     * Closes this scope, recording its event.
+     */
+    ~ProfileScope() {
+        if (_active) {
+            Profiler::pop(_name, _start, _depth);
+        }
+    }
+
+    /** Scopes may not be copied */
+    ProfileScope(const ProfileScope&) = delete;
+    /** Scopes may not be copied */
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+}
+
+#define __CU_PROFILE_JOIN2(a, b) a##b
+#define __CU_PROFILE_JOIN(a, b) __CU_PROFILE_JOIN2(a, b)
+
+/**
+ * Records the time until the end of the enclosing block under the given name.
+ *
+ * The name must be a string literal.
+ */
+#ifdef CU_NO_PROFILE
+    #define CU_PROFILE_SCOPE(name)
+#else
+    #define CU_PROFILE_SCOPE(name) \
+        cugl::ProfileScope __CU_PROFILE_JOIN(__cu_profile_, __LINE__)(name)
+#endif
+
+#endif /* __CU_PROFILER_H__ */
@@ -82,6 +82,34 @@ void AssetManager::dispose() {
 
 #pragma mark -
 #pragma mark Internal Asset Loading
+/**
+ * Returns the hash of the asset type for a directory category.
+ *
+ * This is the one place that maps the category names of an asset
+ * directory (e.g. "textures") to asset types, so that every way of
+ * reading a directory agrees on them.
+ *
+ * @param key   The name of the category
+ *
+ * @return the hash of the asset type, or 0 if the category is unknown.
+ */
+size_t AssetManager::categoryHash(const std::string& key) {
+    if (key == "textures") {
+        return typeid(Texture).hash_code();
+    } else if (key == "sounds") {
+        return typeid(Sound).hash_code();
+    } else if (key == "fonts") {
+        return typeid(Font).hash_code();
+    } else if (key == "jsons") {
+        return typeid(JsonValue).hash_code();
+    } else if (key == "widgets") {
+        return typeid(WidgetValue).hash_code();
+    } else if (key == "scene2s") {
+        return typeid(scene2::SceneNode).hash_code();
+    }
+    return 0;
+}
+
 /**
  * Synchronously reads an asset category from a JSON file
  *
@@ -105,6 +133,7 @@ void AssetManager::dispose() {
  * @return true if all assets of this type were successfully loaded.
  */
 bool AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& json) {
+    CU_PROFILE_SCOPE("AssetManager::readCategory");
     auto it = _handlers.find(hash);
     if (it == _handlers.end()) {
         return false;
@@ -125,6 +154,41 @@ bool AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& j
     return success;
 }
 
+/**
+ * Synchronously reads an asset category from a directory document.
+ *
+ * This method is the same as {@link readCategory} for a JsonValue, except
+ * that the category is a value of a read-only document.  Each asset is
+ * handed to its loader as a document value, so that it is never
+ * converted to a JsonValue unless the loader needs it to be.
+ *
+ * @param hash  The hash of the asset type
+ * @param doc   The document of the asset directory
+ * @param node  The index of the category in the document
+ *
+ * @return true if all assets of this type were successfully loaded.
+ */
+bool AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonDocument>& doc, Uint32 node) {
+    CU_PROFILE_SCOPE("AssetManager::readCategory");
+    auto it = _handlers.find(hash);
+    if (it == _handlers.end()) {
+        return false;
+    }
+    
+    std::shared_ptr<BaseLoader> loader = it->second;
+    if (loader == nullptr) {
+        CULogError("No loader for hash %zu",hash);
+        return false;
+    }
+    
+    bool success = true;
+    for(size_t ii = 0; ii < doc->size(node); ii++) {
+        success = loader->load(doc,doc->get(node,ii)) && success;
+    }
+    
+    return success;
+}
+
 /**
  * Asynchronously reads an asset category from a JSON file
  *
@@ -160,6 +224,7 @@ bool AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& j
  */
 void AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& json,
                                 LoaderCallback callback) {
+    CU_PROFILE_SCOPE("AssetManager::readCategoryAsync");
     auto it = _handlers.find(hash);
     std::shared_ptr<BaseLoader> loader = it->second;
     if (loader == nullptr) {
@@ -178,6 +243,38 @@ void AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonValue>& j
     }
 }
 
+/**
+ * Asynchronously reads an asset category from a directory document.
+ *
+ * This method is the same as the asynchronous {@link readCategory} for a
+ * JsonValue, except that the category is a value of a read-only document.
+ *
+ * @param hash      The hash of the asset type
+ * @param doc       The document of the asset directory
+ * @param node      The index of the category in the document
+ * @param callback  An optional callback after each asset is loaded
+ */
+void AssetManager::readCategory(size_t hash, const std::shared_ptr<JsonDocument>& doc, Uint32 node,
+                                LoaderCallback callback) {
+    CU_PROFILE_SCOPE("AssetManager::readCategoryAsync");
+    auto it = _handlers.find(hash);
+    std::shared_ptr<BaseLoader> loader = (it == _handlers.end() ? nullptr : it->second);
+    if (loader == nullptr) {
+        if (callback) {
+            std::string key = doc->key(node);
+            Application::get()->schedule([=] {
+                callback(key,false);
+                return false;
+            });
+        }
+        return;
+    }
+    
+    for(size_t ii = 0; ii < doc->size(node); ii++) {
+        loader->loadAsync(doc, doc->get(node,ii), callback);
+    }
+}
+
 /**
  * Immediately removes an asset category previously loaded from the JSON file
  *
@@ -285,21 +382,13 @@ void AssetManager::resume() {
  * @return true if all assets specified in the directory were successfully loaded.
  */
 bool AssetManager::loadDirectory(const std::shared_ptr<JsonValue>& json) {
+    CU_PROFILE_SCOPE("AssetManager::loadDirectory");
     bool success = true;
     for(int ii = 0; ii < json->size(); ii++) {
         std::shared_ptr<JsonValue> child = json->get(ii);
-        if (child->key() == "textures") {
-            success = readCategory(typeid(Texture).hash_code(),child) && success;
-        } else if (child->key() == "sounds") {
-            success = readCategory(typeid(Sound).hash_code(),child) && success;
-        } else if (child->key() == "fonts") {
-            success = readCategory(typeid(Font).hash_code(),child) && success;
-		} else if (child->key() == "jsons") {
-			success = readCategory(typeid(JsonValue).hash_code(), child) && success;
-		} else if (child->key() == "widgets") {
-			success = readCategory(typeid(WidgetValue).hash_code(), child) && success;
-        } else if (child->key() == "scene2s") {
-            success = readCategory(typeid(scene2::SceneNode).hash_code(),child) && success;
+        size_t hash = categoryHash(child->key());
+        if (hash) {
+            success = readCategory(hash,child) && success;
         } else {
             CULogError("Unknown asset category '%s'",child->key().c_str());
             success = false;
@@ -340,8 +429,40 @@ bool AssetManager::loadDirectory(const std::string& directory) {
         return false;
     }
     
-    std::shared_ptr<JsonValue> json = reader->readJson();
-    return loadDirectory(json);
+    std::shared_ptr<JsonDocument> doc = reader->readJsonDocument();
+    return loadDirectory(doc);
+}
+
+/**
+ * Synchronously loads all assets in the given directory document.
+ *
+ * This method is the same as {@link loadDirectory} for a JsonValue,
+ * except that the directory has been parsed into a read-only document.
+ *
+ * @param doc   The JSON asset directory document
+ *
+ * @return true if all assets specified in the directory were successfully loaded.
+ */
+bool AssetManager::loadDirectory(const std::shared_ptr<JsonDocument>& doc) {
+    CU_PROFILE_SCOPE("AssetManager::loadDirectory");
+    if (doc == nullptr) {
+        return false;
+    }
+    
+    // Categories are found by walking the document, and never converted.
+    bool success = true;
+    Uint32 root = doc->root();
+    for(size_t ii = 0; ii < doc->size(root); ii++) {
+        Uint32 child = doc->get(root,ii);
+        size_t hash = categoryHash(doc->key(child));
+        if (hash) {
+            success = readCategory(hash,doc,child) && success;
+        } else {
+            CULogError("Unknown asset category '%s'",doc->key(child).c_str());
+            success = false;
+        }
+    }
+    return success;
 }
 
 /**
@@ -377,20 +498,14 @@ bool AssetManager::loadDirectory(const std::string& directory) {
  * @param callback  An optional callback after each asset is loaded
  */
 void AssetManager::loadDirectoryAsync(const std::shared_ptr<JsonValue>& json, LoaderCallback callback) {
+    size_t scenes = typeid(scene2::SceneNode).hash_code();
     for(int ii = 0; ii < json->size(); ii++) {
         std::shared_ptr<JsonValue> child = json->get(ii);
-        if (child->key() == "textures") {
-            readCategory(typeid(Texture).hash_code(),child,callback);
-        } else if (child->key() == "sounds") {
-            readCategory(typeid(Sound).hash_code(),child,callback);
-        } else if (child->key() == "fonts") {
-            readCategory(typeid(Font).hash_code(),child,callback);
-        } else if (child->key() == "jsons") {
-            readCategory(typeid(JsonValue).hash_code(),child,callback);
-        } else if (child->key() == "widgets") {
-            readCategory(typeid(WidgetValue).hash_code(),child,callback);
-        } else if (child->key() != "scene2s") {
+        size_t hash = categoryHash(child->key());
+        if (!hash) {
             CULogError("Unknown asset category '%s'",child->key().c_str());
+        } else if (hash != scenes) {
+            readCategory(hash,child,callback);
         }
     }
     
@@ -398,7 +513,37 @@ void AssetManager::loadDirectoryAsync(const std::shared_ptr<JsonValue>& json, Lo
     std::shared_ptr<JsonValue> child = json->get("scene2s");
     sync();
     if (child) {
-        readCategory(typeid(scene2::SceneNode).hash_code(),child,callback);
+        readCategory(scenes,child,callback);
+    }
+}
+
+/**
+ * Asynchronously loads all assets in the given directory document.
+ *
+ * This method is the same as {@link loadDirectoryAsync} for a JsonValue,
+ * except that the directory has been parsed into a read-only document.
+ *
+ * @param doc       The JSON asset directory document
+ * @param callback  An optional callback after each asset is loaded
+ */
+void AssetManager::loadDirectoryAsync(const std::shared_ptr<JsonDocument>& doc, LoaderCallback callback) {
+    size_t scenes = typeid(scene2::SceneNode).hash_code();
+    Uint32 root = doc->root();
+    for(size_t ii = 0; ii < doc->size(root); ii++) {
+        Uint32 child = doc->get(root,ii);
+        size_t hash = categoryHash(doc->key(child));
+        if (!hash) {
+            CULogError("Unknown asset category '%s'",doc->key(child).c_str());
+        } else if (hash != scenes) {
+            readCategory(hash,doc,child,callback);
+        }
+    }
+    
+    // Scenes are read after everything else.
+    Uint32 child = doc->get(root,"scene2s");
+    sync();
+    if (child != JsonDocument::INVALID) {
+        readCategory(scenes,doc,child,callback);
     }
 }
 
@@ -444,8 +589,18 @@ void AssetManager::loadDirectoryAsync(const std::string& directory, LoaderCallba
     }
     
     _workers->addTask([=](void) {
-        std::shared_ptr<JsonValue> json = reader->readJson();
-        loadDirectoryAsync(json,callback);
+        std::shared_ptr<JsonDocument> doc = reader->readJsonDocument();
+        if (doc == nullptr) {
+            CULogError("Could not read asset directory '%s'",directory.c_str());
+            if (callback != nullptr) {
+                Application::get()->schedule([=] {
+                    callback("",false);
+                    return false;
+                });
+            }
+        } else {
+            loadDirectoryAsync(doc,callback);
+        }
         _preload = false;
     });
 }
@@ -464,18 +619,9 @@ bool AssetManager::unloadDirectory(const std::shared_ptr<JsonValue>& json) {
     bool success = true;
     for(int ii = 0; ii < json->size(); ii++) {
         std::shared_ptr<JsonValue> child = json->get(ii);
-        if (child->key() == "textures") {
-            success = purgeCategory(typeid(Texture).hash_code(),child) && success;
-        } else if (child->key() == "sounds") {
-            success = purgeCategory(typeid(Sound).hash_code(),child) && success;
-        } else if (child->key() == "fonts") {
-            success = purgeCategory(typeid(Font).hash_code(),child) && success;
-        } else if (child->key() == "jsons") {
-            success = purgeCategory(typeid(JsonValue).hash_code(),child) && success;
-        } else if (child->key() == "widgets") {
-            success = purgeCategory(typeid(WidgetValue).hash_code(),child) && success;
-        } else if (child->key() == "scene2s") {
-            success = purgeCategory(typeid(scene2::SceneNode).hash_code(),child) && success;
+        size_t hash = categoryHash(child->key());
+        if (hash) {
+            success = purgeCategory(hash,child) && success;
         } else {
             CULogError("Unknown asset category '%s'",child->key().c_str());
             success = false;
@@ -502,7 +648,8 @@ bool AssetManager::unloadDirectory(const std::string& directory) {
         return false;
     }
     
-    std::shared_ptr<JsonValue> json = reader->readJson();
+    std::shared_ptr<JsonDocument> doc = reader->readJsonDocument();
+    std::shared_ptr<JsonValue> json = (doc == nullptr ? nullptr : doc->toJsonValue());
     return unloadDirectory(json);
 }
 
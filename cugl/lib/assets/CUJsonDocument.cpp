@@ -0,0 +1,719 @@
+//
+//  CUJsonDocument.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a read-only alternative to JsonValue for large JSON
+//  files, such as asset directories and scene files. The document parses the
+//  JSON directly, without cJSON, into a handful of flat arrays. Object keys
+//  are interned and looked up with a hash table, so access by key is O(1)
+//  instead of a scan over the children.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#include <cugl/assets/CUJsonDocument.h>
+#include <cugl/util/CUDebug.h>
+#include <climits>
+#include <cmath>
+
+using namespace cugl;
+
+/** The maximum nesting of arrays and objects (the same limit as cJSON) */
+#define MAX_DEPTH 1000
+
+/** The empty key returned for values without one */
+static const std::string EMPTY_KEY = "";
+
+#pragma mark -
+#pragma mark Parser
+/**
+ * The parser state while initializing a document.
+ *
+ * The parser is a recursive descent parser that writes directly into the
+ * document arrays. The children of an array or object are collected on a
+ * stack while it is parsed, and moved to a contiguous range of the children
+ * array once it is closed.
+ */
+struct JsonDocument::Parser {
+    /** The document being initialized */
+    JsonDocument* doc;
+    /** The start of the JSON string */
+    const char* start;
+    /** The current position in the JSON string */
+    const char* pos;
+    /** The end of the JSON string */
+    const char* end;
+    /** The children of the arrays and objects currently being parsed */
+    std::vector<Uint32> stack;
+    /** A scratch buffer for object keys */
+    std::string scratch;
+    /** The current nesting depth */
+    int depth;
+
+    /**
+     * Creates a parser for the given document and string.
+     *
+     * @param doc   The document to initialize
+     * @param json  The JSON string to parse
+     */
+    Parser(JsonDocument* doc, const std::string& json) :
+    doc(doc), start(json.data()), pos(json.data()), end(json.data()+json.size()), depth(0) {}
+
+    /**
+     * Skips over any whitespace.
+     */
+    void skip() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) {
+            pos++;
+        }
+    }
+
+    /**
+     * Reports a parsing error at the current position.
+     *
+     * @param message   The error message
+     *
+     * @return false, so that parse methods can return the result
+     */
+    bool error(const char* message) {
+        int line = 1;
+        for (const char* it = start; it < pos && it < end; it++) {
+            if (*it == '\n') {
+                line++;
+            }
+        }
+        CUAssertLog(false, "Invalid JSON at line %d: %s", line, message);
+        return false; // If asserts turned off
+    }
+
+    /**
+     * Returns true if the string at the current position starts with word.
+     *
+     * If so, the position is moved past the word.
+     *
+     * @param word  The word to match
+     *
+     * @return true if the string at the current position starts with word.
+     */
+    bool match(const char* word) {
+        const char* it = pos;
+        for(; *word; word++, it++) {
+            if (it >= end || *it != *word) {
+                return false;
+            }
+        }
+        pos = it;
+        return true;
+    }
+
+    /**
+     * Adds a new value of the given type to the document.
+     *
+     * @param type  The type of the value
+     * @param key   The interned key of the value
+     *
+     * @return the index of the new value
+     */
+    Uint32 add(Type type, Uint32 key) {
+        Entry entry;
+        entry.type = type;
+        entry.key = key;
+        entry.first = 0;
+        entry.size = 0;
+        entry.number = 0.0;
+        doc->_entries.push_back(entry);
+        return (Uint32)doc->_entries.size()-1;
+    }
+
+    /**
+     * Parses a string at the current position into the output buffer.
+     *
+     * The position must be at the opening quote, and is moved past the
+     * closing quote.
+     *
+     * @param out   The buffer to append the unescaped string to
+     *
+     * @return true if the string was parsed successfully
+     */
+    bool parseString(std::string& out) {
+        pos++; // Opening quote
+        while (pos < end && *pos != '"') {
+            // Copy the run of plain characters at once.
+            const char* run = pos;
+            while (pos < end && *pos != '"' && *pos != '\\') {
+                pos++;
+            }
+            out.append(run, pos-run);
+            if (pos >= end || *pos == '"') {
+                break;
+            }
+
+            pos++; // Backslash
+            if (pos >= end) {
+                return error("unterminated string");
+            }
+            switch (*pos++) {
+                case '"':  out.push_back('"');  break;
+                case '\\': out.push_back('\\'); break;
+                case '/':  out.push_back('/');  break;
+                case 'b':  out.push_back('\b'); break;
+                case 'f':  out.push_back('\f'); break;
+                case 'n':  out.push_back('\n'); break;
+                case 'r':  out.push_back('\r'); break;
+                case 't':  out.push_back('\t'); break;
+                case 'u':
+                {
+                    Uint32 code;
+                    if (!parseHex(code)) {
+                        return false;
+                    }
+                    // Combine a surrogate pair into a single code point.
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        Uint32 low;
+                        if (!match("\\u") || !parseHex(low) || low < 0xDC00 || low > 0xDFFF) {
+                            return error("invalid surrogate pair");
+                        }
+                        code = 0x10000 + ((code-0xD800) << 10) + (low-0xDC00);
+                    }
+                    appendUTF8(out, code);
+                    break;
+                }
+                default:
+                    return error("invalid escape sequence");
+            }
+        }
+        if (pos >= end) {
+            return error("unterminated string");
+        }
+        pos++; // Closing quote
+        return true;
+    }
+
+    /**
+     * Parses four hex digits at the current position.
+     *
+     * @param code  The variable to store the result
+     *
+     * @return true if the digits were parsed successfully
+     */
+    bool parseHex(Uint32& code) {
+        code = 0;
+        for (int ii = 0; ii < 4; ii++, pos++) {
+            if (pos >= end) {
+                return error("unterminated unicode escape");
+            }
+            char c = *pos;
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= c-'0';
+            } else if (c >= 'a' && c <= 'f') {
+                code |= c-'a'+10;
+            } else if (c >= 'A' && c <= 'F') {
+                code |= c-'A'+10;
+            } else {
+                return error("invalid unicode escape");
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Appends the UTF8 encoding of the given code point.
+     *
+     * @param out   The buffer to append to
+     * @param code  The unicode code point
+     */
+    static void appendUTF8(std::string& out, Uint32 code) {
+        if (code < 0x80) {
+            out.push_back((char)code);
+        } else if (code < 0x800) {
+            out.push_back((char)(0xC0 | (code >> 6)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back((char)(0xE0 | (code >> 12)));
+            out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back((char)(0xF0 | (code >> 18)));
+            out.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (code & 0x3F)));
+        }
+    }
+
+    /**
+     * Parses an object key at the current position and interns it.
+     *
+     * @param key   The variable to store the interned key id
+     *
+     * @return true if the key was parsed successfully
+     */
+    bool parseKey(Uint32& key) {
+        if (pos >= end || *pos != '"') {
+            return error("expected a string key");
+        }
+        scratch.clear();
+        if (!parseString(scratch)) {
+            return false;
+        }
+        auto it = doc->_keyids.find(scratch);
+        if (it == doc->_keyids.end()) {
+            key = (Uint32)doc->_keys.size();
+            doc->_keys.push_back(scratch);
+            doc->_keyids.emplace(scratch, key);
+        } else {
+            key = it->second;
+        }
+        return true;
+    }
+
+    /**
+     * Parses a value at the current position.
+     *
+     * @param key   The interned key of the value
+     *
+     * @return true if the value was parsed successfully
+     */
+    bool parseValue(Uint32 key) {
+        skip();
+        if (pos >= end) {
+            return error("unexpected end of input");
+        }
+
+        switch (*pos) {
+            case '{':
+            case '[':
+                return parseContainer(key);
+            case '"':
+            {
+                Uint32 node = add(Type::StringType, key);
+                size_t offset = doc->_text.size();
+                if (!parseString(doc->_text)) {
+                    return false;
+                }
+                doc->_entries[node].first = (Uint32)offset;
+                doc->_entries[node].size = (Uint32)(doc->_text.size()-offset);
+                return true;
+            }
+            case 't':
+                if (match("true")) {
+                    doc->_entries[add(Type::BoolType, key)].number = 1.0;
+                    return true;
+                }
+                return error("invalid literal");
+            case 'f':
+                if (match("false")) {
+                    add(Type::BoolType, key);
+                    return true;
+                }
+                return error("invalid literal");
+            case 'n':
+                if (match("null")) {
+                    add(Type::NullType, key);
+                    return true;
+                }
+                return error("invalid literal");
+            default:
+            {
+                double number;
+                if (!parseNumber(number)) {
+                    return false;
+                }
+                doc->_entries[add(Type::NumberType, key)].number = number;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Parses a number at the current position.
+     *
+     * This uses the same arithmetic as cJSON, so that a document has exactly
+     * the same numbers as a JsonValue parsed from the same string. Unlike
+     * strtod, it also does not depend on the locale.
+     *
+     * @param number    The variable to store the result
+     *
+     * @return true if the number was parsed successfully
+     */
+    bool parseNumber(double& number) {
+        double n = 0;
+        double sign = 1;
+        int scale = 0;
+        int subscale = 0;
+        int signsubscale = 1;
+
+        if (pos < end && *pos == '-') {
+            sign = -1;
+            pos++;
+        }
+        if (pos >= end || *pos < '0' || *pos > '9') {
+            return error("invalid value");
+        }
+        while (pos < end && *pos >= '0' && *pos <= '9') {
+            n = (n * 10.0) + (*pos++ - '0');
+        }
+        if (pos+1 < end && *pos == '.' && pos[1] >= '0' && pos[1] <= '9') {
+            pos++;
+            while (pos < end && *pos >= '0' && *pos <= '9') {
+                n = (n * 10.0) + (*pos++ - '0');
+                scale--;
+            }
+        }
+        if (pos < end && (*pos == 'e' || *pos == 'E')) {
+            pos++;
+            if (pos < end && *pos == '+') {
+                pos++;
+            } else if (pos < end && *pos == '-') {
+                signsubscale = -1;
+                pos++;
+            }
+            while (pos < end && *pos >= '0' && *pos <= '9') {
+                subscale = (subscale * 10) + (*pos++ - '0');
+            }
+        }
+
+        number = sign * n * pow(10.0, (scale + subscale * signsubscale));
+        return true;
+    }
+
+    /**
+     * Parses an array or object at the current position.
+     *
+     * @param key   The interned key of the array or object
+     *
+     * @return true if the array or object was parsed successfully
+     */
+    bool parseContainer(Uint32 key) {
+        if (++depth > MAX_DEPTH) {
+            return error("nested too deeply");
+        }
+        bool object = (*pos == '{');
+        char close = object ? '}' : ']';
+        Uint32 node = add(object ? Type::ObjectType : Type::ArrayType, key);
+        size_t base = stack.size();
+        pos++;
+
+        skip();
+        if (pos < end && *pos == close) {
+            pos++;
+        } else {
+            while (true) {
+                Uint32 childkey = INVALID;
+                if (object) {
+                    skip();
+                    if (!parseKey(childkey)) {
+                        return false;
+                    }
+                    skip();
+                    if (pos >= end || *pos != ':') {
+                        return error("expected ':'");
+                    }
+                    pos++;
+                }
+
+                stack.push_back((Uint32)doc->_entries.size());
+                if (!parseValue(childkey)) {
+                    return false;
+                }
+
+                skip();
+                if (pos < end && *pos == ',') {
+                    pos++;
+                } else if (pos < end && *pos == close) {
+                    pos++;
+                    break;
+                } else {
+                    return error(object ? "expected ',' or '}'" : "expected ',' or ']'");
+                }
+            }
+        }
+
+        // Move the children to a contiguous range.
+        Entry& entry = doc->_entries[node];
+        entry.first = (Uint32)doc->_children.size();
+        entry.size = (Uint32)(stack.size()-base);
+        doc->_children.insert(doc->_children.end(), stack.begin()+base, stack.end());
+        stack.resize(base);
+        depth--;
+        return true;
+    }
+};
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Deletes all of the values in this document.
+ */
+void JsonDocument::dispose() {
+    _entries.clear();
+    _children.clear();
+    _text.clear();
+    _keys.clear();
+    _keyids.clear();
+    _slotkeys.clear();
+    _slotvalues.clear();
+}
+
+/**
+ * Initializes this document from the given JSON string.
+ *
+ * If there is a parsing error, this method will return false. Detailed
+ * information about the parsing error will be passed to an assert. Hence
+ * error messages are suppressed if asserts are turned off.
+ *
+ * @param json  The JSON string to parse.
+ *
+ * @return true if the document is initialized properly, false otherwise.
+ */
+bool JsonDocument::initWithJson(const std::string& json) {
+    if (!_entries.empty()) {
+        CUAssertLog(false, "Document is already initialized");
+        return false;
+    }
+
+    // A rough guess from the typical value size in asset and scene files, to
+    // avoid most of the reallocations while parsing.
+    _entries.reserve(json.size()/8+1);
+    _children.reserve(json.size()/8+1);
+    _text.reserve(json.size()/2+1);
+
+    Parser parser(this, json);
+    bool success = parser.parseValue(INVALID);
+    if (success) {
+        parser.skip();
+        if (parser.pos != parser.end) {
+            success = parser.error("unexpected characters after the root value");
+        }
+    }
+    if (!success) {
+        dispose();
+        return false;
+    }
+
+    _entries.shrink_to_fit();
+    _children.shrink_to_fit();
+    buildLookup();
+    return true;
+}
+
+#pragma mark -
+#pragma mark Lookup
+/**
+ * Returns the hash of the given object and key.
+ *
+ * @param pair  The object index in the high bits, and the key id in the low bits
+ *
+ * @return the hash of the given object and key.
+ */
+static Uint64 hashPair(Uint64 pair) {
+    pair ^= pair >> 33;
+    pair *= 0xff51afd7ed558ccdULL;
+    pair ^= pair >> 33;
+    return pair;
+}
+
+/**
+ * Builds the hash table for looking up object children by key.
+ *
+ * If an object has several children with the same key, the first one is
+ * returned by {@link get}, like {@link JsonValue#get}.
+ */
+void JsonDocument::buildLookup() {
+    size_t count = 0;
+    for(auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->type == Type::ObjectType) {
+            count += it->size;
+        }
+    }
+
+    // Keep the table at most half full.
+    size_t capacity = 16;
+    while (capacity < 2*count) {
+        capacity *= 2;
+    }
+    _slotkeys.assign(capacity, 0);
+    _slotvalues.assign(capacity, INVALID);
+
+    for(Uint32 node = 0; node < _entries.size(); node++) {
+        const Entry& entry = _entries[node];
+        if (entry.type != Type::ObjectType) {
+            continue;
+        }
+        for(Uint32 ii = 0; ii < entry.size; ii++) {
+            Uint32 child = _children[entry.first+ii];
+            Uint32 slot = findSlot(node, _entries[child].key);
+            if (_slotvalues[slot] == INVALID) {
+                _slotkeys[slot] = ((Uint64)node << 32) | _entries[child].key;
+                _slotvalues[slot] = child;
+            }
+        }
+    }
+}
+
+/**
+ * Returns the lookup table slot for the given object and key.
+ *
+ * @param node  The object index
+ * @param key   The interned key id
+ *
+ * @return the lookup table slot for the given object and key.
+ */
+Uint32 JsonDocument::findSlot(Uint32 node, Uint32 key) const {
+    Uint64 pair = ((Uint64)node << 32) | key;
+    size_t mask = _slotkeys.size()-1;
+    size_t slot = hashPair(pair) & mask;
+    while (_slotvalues[slot] != INVALID && _slotkeys[slot] != pair) {
+        slot = (slot+1) & mask;
+    }
+    return (Uint32)slot;
+}
+
+#pragma mark -
+#pragma mark Value Access
+/**
+ * Returns the key of the given value, or the empty string if it has none.
+ *
+ * @param node  The value index
+ *
+ * @return the key of the given value, or the empty string if it has none.
+ */
+const std::string& JsonDocument::key(Uint32 node) const {
+    if (!isValid(node)) {
+        return EMPTY_KEY;
+    }
+    Uint32 key = _entries[node].key;
+    return key == INVALID ? EMPTY_KEY : _keys[key];
+}
+
+/**
+ * Returns the child of the given object with the given key.
+ *
+ * This lookup takes constant time.
+ *
+ * @param node  The value index
+ * @param key   The key of the child
+ *
+ * @return the child with the given key, or {@link INVALID}.
+ */
+Uint32 JsonDocument::get(Uint32 node, const std::string& key) const {
+    if (type(node) != Type::ObjectType) {
+        return INVALID;
+    }
+    auto it = _keyids.find(key);
+    if (it == _keyids.end()) {
+        return INVALID;
+    }
+    return _slotvalues[findSlot(node, it->second)];
+}
+
+/**
+ * Returns the given value as a string, or the default if it is not one.
+ *
+ * @param node          The value index
+ * @param defaultValue  The value to return if the value is not a string
+ *
+ * @return the given value as a string.
+ */
+std::string JsonDocument::asString(Uint32 node, const std::string& defaultValue) const {
+    if (type(node) != Type::StringType) {
+        return defaultValue;
+    }
+    const Entry& entry = _entries[node];
+    return _text.substr(entry.first, entry.size);
+}
+
+#pragma mark -
+#pragma mark Conversion
+/**
+ * Returns a newly allocated JsonValue for the given value.
+ *
+ * The JsonValue is built directly from the document, without printing
+ * or parsing any JSON, and is equivalent to parsing the same JSON with
+ * {@link JsonValue#allocWithJson}.
+ *
+ * @param node  The value index (the root by default)
+ *
+ * @return a newly allocated JsonValue for the given value.
+ */
+std::shared_ptr<JsonValue> JsonDocument::toJsonValue(Uint32 node) const {
+    if (!isValid(node)) {
+        return nullptr;
+    }
+    std::shared_ptr<JsonValue> result = std::make_shared<JsonValue>();
+    toJsonValue(node, result.get());
+    return result;
+}
+
+/**
+ * Stores the given value in the JsonValue.
+ *
+ * @param node  The value index
+ * @param value The JsonValue to store the result
+ */
+void JsonDocument::toJsonValue(Uint32 node, JsonValue* value) const {
+    const Entry& entry = _entries[node];
+    value->_type = entry.type;
+    value->_key = key(node);
+    switch (entry.type) {
+        case Type::BoolType:
+            value->_longValue = (long)entry.number;
+            break;
+        case Type::NumberType:
+            // Match the saturated integer value of cJSON
+            if (entry.number >= INT_MAX) {
+                value->_longValue = INT_MAX;
+            } else if (entry.number <= (double)INT_MIN) {
+                value->_longValue = INT_MIN;
+            } else {
+                value->_longValue = (int)entry.number;
+            }
+            value->_doubleValue = entry.number;
+            break;
+        case Type::StringType:
+            value->_stringValue.assign(_text, entry.first, entry.size);
+            break;
+        case Type::ArrayType:
+        case Type::ObjectType:
+            value->_children.reserve(entry.size);
+            for(Uint32 ii = 0; ii < entry.size; ii++) {
+                std::shared_ptr<JsonValue> child = std::make_shared<JsonValue>();
+                toJsonValue(_children[entry.first+ii], child.get());
+                child->_parent = value;
+                value->_children.push_back(child);
+            }
+            break;
+        case Type::NullType:
+            break;
+    }
+}
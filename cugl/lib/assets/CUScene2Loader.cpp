@@ -285,10 +285,172 @@ std::shared_ptr<scene2::SceneNode> Scene2Loader::build(const std::string& key,
     return node;
 }
 
+/**
+ * Recursively builds the scene from the given value of a document.
+ *
+ * This method is the same as {@link build} for a JsonValue, except that
+ * the tree is walked in the document, looking up each attribute by key in
+ * constant time. Only the "data", "format" and "layout" of each node are
+ * converted to a JsonValue, as that is what the nodes are initialized
+ * with. Each node is still created by {@link build} for a JsonValue, so
+ * the node types of a subclass are supported.
+ *
+ * Widgets are expanded from the JSON of their widget asset, so an
+ * instance of one is converted and built as a JsonValue.
+ *
+ * @param key       The key to access the scene after loading
+ * @param doc       The document defining the scene
+ * @param json      The index of the scene in the document
+ *
+ * @return the root node of the scene
+ */
+std::shared_ptr<scene2::SceneNode> Scene2Loader::build(const std::string& key,
+                                                      const JsonDocument& doc,
+                                                      Uint32 json) const {
+    if (json == JsonDocument::INVALID) {
+        return nullptr;
+    }
+    
+    Uint32 tnode = doc.get(json,"type");
+    std::string type = (tnode == JsonDocument::INVALID ? UNKNOWN_STR : doc.asString(tnode,UNKNOWN_STR));
+    auto it = _types.find(cugl::strtool::tolower(type));
+    if (it != _types.end() && it->second == Widget::EXTERNAL_IMPORT) {
+        return build(key, doc.toJsonValue(json));
+    }
+    
+    // The node and its layout manager are made from a childless copy
+    std::shared_ptr<JsonValue> head = JsonValue::allocObject();
+    head->appendChild("type", JsonValue::alloc(type));
+    Uint32 data = doc.get(json,"data");
+    if (data != JsonDocument::INVALID) {
+        head->appendChild("data", doc.toJsonValue(data));
+    }
+    Uint32 form = doc.get(json,"format");
+    if (form != JsonDocument::INVALID) {
+        head->appendChild("format", doc.toJsonValue(form));
+    }
+    
+    std::shared_ptr<scene2::SceneNode> node = build(key, head);
+    if (node == nullptr) {
+        return nullptr;
+    }
+    bool nonrelative = (it != _types.end() && it->second == Widget::SOLID);
+    std::shared_ptr<scene2::Layout> layout = node->getLayout();
+    
+    Uint32 children = doc.get(json,"children");
+    for (size_t ii = 0; children != JsonDocument::INVALID && ii < doc.size(children); ii++) {
+        Uint32 item = doc.get(children,ii);
+        const std::string& local = doc.key(item);
+        if (local == "comment") {
+            continue;
+        }
+        
+        std::shared_ptr<scene2::SceneNode> kid = nullptr;
+        std::shared_ptr<JsonValue> posit = nullptr;
+        Uint32 ktype = doc.get(item,"type");
+        if (ktype != JsonDocument::INVALID && doc.asString(ktype) == "Widget") {
+            // If this is a widget, use the loaded widget json instead
+            std::shared_ptr<JsonValue> widget = getWidgetJson(doc.toJsonValue(item));
+            kid = build(local, widget);
+            posit = widget->get("layout");
+        } else {
+            kid = build(local, doc, item);
+            Uint32 place = doc.get(item,"layout");
+            if (place != JsonDocument::INVALID) {
+                posit = doc.toJsonValue(place);
+            }
+        }
+        
+        if (nonrelative) {
+            kid->setRelativeColor(false);
+        }
+        node->addChild(kid);
+        
+        if (layout != nullptr && posit != nullptr) {
+            layout->add(local, posit);
+        }
+    }
+    
+    return node;
+}
+
+
+/**
+ * Returns a copy of value that shares the children of value.
+ *
+ * The children keep their original parent, which is how an instance of a
+ * widget tells the nodes that it owns from those shared with the widget.
+ *
+ * @param value     The node to copy
+ * @param parent    The parent of the copy
+ * @param key       The key of the copy
+ *
+ * @return a copy of value that shares the children of value.
+ */
+static std::shared_ptr<JsonValue> shallowCopy(const JsonValue* value, JsonValue* parent,
+                                              const std::string& key) {
+    std::shared_ptr<JsonValue> copy = std::make_shared<JsonValue>();
+    copy->_type = value->_type;
+    copy->_parent = parent;
+    copy->_key = key;
+    copy->_stringValue = value->_stringValue;
+    copy->_longValue = value->_longValue;
+    copy->_doubleValue = value->_doubleValue;
+    copy->_children = value->_children;
+    return copy;
+}
+
+/**
+ * Returns the child of node with the given key, or nullptr if there is none.
+ *
+ * If the child is still shared with the widget contents, it is copied first
+ * so that the caller may safely change it.
+ *
+ * @param node      A node owned by the widget instance
+ * @param key       The key of the child
+ *
+ * @return the child of node with the given key, or nullptr if there is none.
+ */
+static JsonValue* ownChild(JsonValue* node, const std::string& key) {
+    for (auto it = node->_children.begin(); it != node->_children.end(); ++it) {
+        if ((*it)->_key == key) {
+            if ((*it)->_parent != node) {
+                *it = shallowCopy(it->get(), node, key);
+            }
+            return it->get();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Replaces the child of node with the given key by value.
+ *
+ * Like {@link JsonValue#merge}, the replacement is moved to the end of the
+ * children. The value is not modified; a copy sharing its children is used.
+ *
+ * @param node      A node owned by the widget instance
+ * @param key       The key of the child
+ * @param value     The value to replace the child with
+ */
+static void replaceChild(JsonValue* node, const std::string& key,
+                         const std::shared_ptr<JsonValue>& value) {
+    for (auto it = node->_children.begin(); it != node->_children.end(); ++it) {
+        if ((*it)->_key == key) {
+            node->_children.erase(it);
+            break;
+        }
+    }
+    node->_children.push_back(shallowCopy(value.get(), node, key));
+}
 
 /**
  * Translates the JSON of a widget to the JSON of the node that it encodes.
  *
+ * The widget contents are never printed or parsed again. The instance shares
+ * every node of the contents, except for those on the address of a variable
+ * it sets, which are copied before the variable is replaced.
+ *
  * If this scene is built before the JSON of any used widgets have been loaded, this will fail.
  *
  * @param json      The JSON object specifying the widget's file and the values for its exposed variables
@@ -305,30 +467,19 @@ std::shared_ptr<JsonValue> Scene2Loader::getWidgetJson(const std::shared_ptr<Jso
 
   CUAssertLog(widget != nullptr, "No widget found with name %s", widgetSource.c_str());
 
-  const std::shared_ptr<JsonValue> widgetJson = widget->getJson();
-
-  std::shared_ptr<JsonValue> variables = widgetJson->get("variables");
-  std::shared_ptr<JsonValue> contents = widgetJson->get("contents");
-  std::string contentString = contents->toString();
-  std::shared_ptr<JsonValue> contentCopy = JsonValue::allocWithJson(contentString);
+  std::shared_ptr<JsonValue> contentCopy = shallowCopy(widget->getContents().get(), nullptr, "");
     if (widgetVars) {
         for (int ii = 0; ii < widgetVars->size(); ii++) {
             auto child = widgetVars->get(ii);
-            if (variables->has(child->key())) {
-                bool found = true;
-                std::shared_ptr<JsonValue> address = variables->get(child->key());
-                std::shared_ptr<JsonValue> spotToChange = contentCopy;
-                std::vector<std::string> sAry = address->asStringArray();
-                for (std::string s : sAry) {
-                    if (spotToChange->has(s)) {
-                        spotToChange = spotToChange->get(s);
-                    }
-                    else {
-                        found = false;
-                    }
+            const std::vector<std::string>* address = widget->getVariable(child->key());
+            if (address != nullptr) {
+                CUAssertLog(!address->empty(), "You cannot merge with the root node");
+                JsonValue* spotToChange = contentCopy.get();
+                for (int jj = 0; spotToChange != nullptr && jj + 1 < address->size(); jj++) {
+                    spotToChange = ownChild(spotToChange, (*address)[jj]);
                 }
-                if (found) {
-                    spotToChange->merge(child);
+                if (spotToChange != nullptr && !address->empty() && spotToChange->has(address->back())) {
+                    replaceChild(spotToChange, address->back(), child);
                 } else {
                     std::string err = "No variable found within widget " + widgetSource + " matching name " + child->key();
                     CULogError("%s",err.c_str());
@@ -339,12 +490,7 @@ std::shared_ptr<JsonValue> Scene2Loader::getWidgetJson(const std::shared_ptr<Jso
 
   // reassign the layout if it exists
   if (layout != nullptr) {
-    std::shared_ptr<JsonValue> contentsLayout = contentCopy->get("layout");
-    if (contentsLayout == nullptr) {
-      contentCopy->appendChild("layout", std::make_shared<JsonValue>());
-      contentsLayout = contentCopy->get("layout");
-    }
-    contentsLayout->merge(layout);
+    replaceChild(contentCopy.get(), "layout", layout);
   }
 
   // now recursively check to see if this was a widget
@@ -415,8 +561,8 @@ bool Scene2Loader::read(const std::string key, const std::string source,
     bool success = false;
     if (_loader == nullptr || !async) {
         std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-        std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
-        std::shared_ptr<scene2::SceneNode> node = build(key,json);
+        std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+        std::shared_ptr<scene2::SceneNode> node = (doc == nullptr ? nullptr : build(key,*doc,doc->root()));
         node->doLayout();
         if (node != nullptr) {
             success = true;
@@ -427,8 +573,8 @@ bool Scene2Loader::read(const std::string key, const std::string source,
     } else {
         _loader->addTask([=](void) {
             std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-            std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
-            std::shared_ptr<scene2::SceneNode> node = build(key,json);
+            std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+            std::shared_ptr<scene2::SceneNode> node = (doc == nullptr ? nullptr : build(key,*doc,doc->root()));
             node->doLayout();
             Application::get()->schedule([=](void) {
                 this->materialize(node,callback);
@@ -504,6 +650,54 @@ bool Scene2Loader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback c
     return success;
 }
 
+/**
+ * Internal method to support asset loading.
+ *
+ * This method is like the read method for a JsonValue, except that the
+ * scene is built directly from a value of a read-only document. The
+ * document is kept alive until an asynchronous build is done.
+ *
+ * @param doc       The document of the asset directory
+ * @param node      The index of the directory entry for the asset
+ * @param callback  An optional callback for asynchronous loading
+ * @param async     Whether the asset was loaded asynchronously
+ *
+ * @return true if the asset was successfully loaded
+ */
+bool Scene2Loader::read(const std::shared_ptr<JsonDocument>& doc, Uint32 node,
+                        LoaderCallback callback, bool async) {
+    std::string key = doc->key(node);
+    if (_assets.find(key) != _assets.end() || _queue.find(key) != _queue.end()) {
+        return false;
+    }
+    _queue.emplace(key);
+    
+    bool success = false;
+    if (_loader == nullptr || !async) {
+        std::shared_ptr<scene2::SceneNode> scene = build(key,*doc,node);
+        if (scene != nullptr) {
+            scene->doLayout();
+            success = true;
+            materialize(scene,callback);
+        } else {
+            _queue.erase(key);
+        }
+    } else {
+        _loader->addTask([=](void) {
+            std::shared_ptr<scene2::SceneNode> scene = build(key,*doc,node);
+            if (scene != nullptr) {
+                scene->doLayout();
+            }
+            Application::get()->schedule([=](void) {
+                this->materialize(scene,callback);
+                return false;
+            });
+        });
+    }
+    
+    return success;
+}
+
 /**
  * Unloads the asset for the given directory entry
  *
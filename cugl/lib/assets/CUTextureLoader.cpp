@@ -45,6 +45,7 @@
 //
 #include <cugl/assets/CUTextureLoader.h>
 #include <cugl/base/CUApplication.h>
+#include <cugl/util/CUProfiler.h>
 #include <SDL/SDL_image.h>
 
 using namespace cugl;
@@ -157,6 +158,7 @@ _mipmaps(false) {
  * @return the SDL_Surface with the texture information
  */
 SDL_Surface* TextureLoader::preload(const std::string& source) {
+    CU_PROFILE_SCOPE("TextureLoader::preload");
     // Make sure we reference the asset directory
 #if defined (__WINDOWS__)
     bool absolute = (bool)strstr(source.c_str(),":") || source[0] == '\\';
@@ -200,6 +202,7 @@ SDL_Surface* TextureLoader::preload(const std::string& source) {
  * @param callback  An optional callback for asynchronous loading
  */
 void TextureLoader::materialize(const std::string& key, SDL_Surface* surface, LoaderCallback callback) {
+    CU_PROFILE_SCOPE("TextureLoader::materialize");
     std::shared_ptr<Texture> texture = Texture::allocWithData(surface->pixels, surface->w, surface->h);
     
     bool success = false;
@@ -251,6 +254,7 @@ void TextureLoader::materialize(const std::string& key, SDL_Surface* surface, Lo
  * @param callback  An optional callback for asynchronous loading
  */
 void TextureLoader::materialize(const std::shared_ptr<JsonValue>& json, SDL_Surface* surface, LoaderCallback callback) {
+    CU_PROFILE_SCOPE("TextureLoader::materialize");
     std::shared_ptr<Texture> texture = Texture::allocWithData(surface->pixels, surface->w, surface->h);
     std::string key = json->key();
 
@@ -112,14 +112,16 @@ bool WidgetLoader::read(const std::string key, const std::string source, LoaderC
     bool success = false;
     if (_loader == nullptr || !async) {
         std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-        std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+        std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+        std::shared_ptr<JsonValue> json = (doc == nullptr ? nullptr : doc->toJsonValue());
 		std::shared_ptr<WidgetValue> widget = WidgetValue::alloc(json);
         success = (widget != nullptr);
         materialize(key,widget,callback);
     } else {
         _loader->addTask([=](void) {
             std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-            std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+            std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+            std::shared_ptr<JsonValue> json = (doc == nullptr ? nullptr : doc->toJsonValue());
 			std::shared_ptr<WidgetValue> widget = WidgetValue::alloc(json);
             Application::get()->schedule([=](void) {
                 this->materialize(key,widget,callback);
@@ -162,14 +164,16 @@ bool WidgetLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback c
     bool success = false;
     if (_loader == nullptr || !async) {
         std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-        std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+        std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+        std::shared_ptr<JsonValue> json = (doc == nullptr ? nullptr : doc->toJsonValue());
 		std::shared_ptr<WidgetValue> widget = WidgetValue::alloc(json);
         success = (widget != nullptr);
         materialize(key,widget,callback);
     } else {
         _loader->addTask([=](void) {
             std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(source);
-            std::shared_ptr<JsonValue> json = (reader == nullptr ? nullptr : reader->readJson());
+            std::shared_ptr<JsonDocument> doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+            std::shared_ptr<JsonValue> json = (doc == nullptr ? nullptr : doc->toJsonValue());
 			std::shared_ptr<WidgetValue> widget = WidgetValue::alloc(json);
             Application::get()->schedule([=](void) {
                 this->materialize(key,widget,callback);
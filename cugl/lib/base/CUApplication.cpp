@@ -67,6 +67,8 @@ _assetdir(""),
 _state(State::NONE),
 _fullscreen(false),
 _highdpi(true),
+_headless(false),
+_nullrender(false),
 _fps(0),
 _vsync(true),
 _funcid(0),
@@ -96,6 +98,8 @@ void Application::dispose() {
     _display.set(0,0,DEFAULT_WIDTH,DEFAULT_HEIGHT);
     _fullscreen = false;
     _highdpi = true;
+    _headless = false;
+    _nullrender = false;
     _fpswindow.clear();
     _clearColor = Color4f::CORNFLOWER;
     setFPS(60.0f);
@@ -128,6 +132,12 @@ bool Application::init() {
     if (_multisamp) {
         flags |= Display::INIT_MULTISAMPLED;
     }
+    if (_headless) {
+        flags |= Display::INIT_HEADLESS;
+    }
+    if (_nullrender) {
+        flags |= Display::INIT_NULL_RENDER;
+    }
     if (!Display::start(_name,_display, flags)) {
         return false;
     }
@@ -150,7 +160,9 @@ bool Application::init() {
     }
     
     _fpswindow.resize(FPS_WINDOW,1.0f/_fps);
-    SDL_GL_SetSwapInterval(_vsync ? 1 : 0);
+    if (!_nullrender) {
+        SDL_GL_SetSwapInterval(_vsync ? 1 : 0);
+    }
     Input::start();
     Texture::getBlank(); // Prevent this from happening in loading threads
     Application::_theapp = this;
@@ -173,7 +185,9 @@ bool Application::init() {
  */
 void Application::onStartup() {
     // Switch states and show to user
-    Display::get()->show();
+    if (!_headless && !_nullrender) {
+        Display::get()->show();
+    }
     _state = State::FOREGROUND;
     _start.mark();
 }
@@ -279,12 +293,17 @@ bool Application::step() {
         _fpswindow.push_back(1000000.0f/micros);
         update(micros/1000000.0f);
 
-        glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
-        glStencilMask(0xffffffff);
-        glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        if (_nullrender && !_headless) {
+            // Only the CPU side of the frame is run
+            draw();
+        } else if (!_headless) {
+            glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
+            glStencilMask(0xffffffff);
+            glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-        draw();
-        Display::get()->refresh();
+            draw();
+            Display::get()->refresh();
+        }
     } else {
         running = _state == State::BACKGROUND;
     }
@@ -292,7 +311,8 @@ bool Application::step() {
 	// Sleep the remainder
     poststep.mark();
     Uint32 millis = (Uint32)poststep.ellapsedMillis(_finish)+1;
-    if (!_vsync && millis < _delay) {
+    // Nothing is presented without a display, so vsync cannot pace the frames
+    if ((!_vsync || _headless || _nullrender) && millis < _delay) {
 		SDL_Delay(_delay - millis);
 	}
     
@@ -542,6 +562,67 @@ void Application::setMultiSampled(bool flag) {
 	_multisamp = flag;
 }
 
+/**
+ * Sets whether this application runs without a visible display.
+ *
+ * A headless application still has an OpenGL context, so that assets
+ * such as textures may be loaded, but its window is never shown.  The
+ * update() method is called every frame as normal, but the screen is
+ * never cleared, draw() is never called, and the display is never
+ * refreshed.  As nothing is presented, vsync is ignored and the frame
+ * rate is throttled by {@link #getFPS()} alone.
+ *
+ * On Linux, a headless application uses the SDL offscreen video driver
+ * (unless SDL_VIDEODRIVER is already set), so that it may be run on a
+ * machine without a window server.  This is the intended way to run a
+ * dedicated server or a load test.
+ *
+ * This method may only be safely called before the application is
+ * initialized.  Once the application is initialized; this value may not
+ * be changed.
+ *
+ * @param value Whether this application runs without a visible display
+ */
+void Application::setHeadless(bool value) {
+    CUAssertLog(_state == State::NONE, "Cannot reset application display after initialization");
+#if (CU_PLATFORM == CU_PLATFORM_IPHONE || CU_PLATFORM == CU_PLATFORM_ANDROID)
+    CUAssertLog(false, "Headless applications are not supported on mobile devices");
+#endif
+    _headless = value;
+}
+
+/**
+ * Sets whether this application renders without an OpenGL context.
+ *
+ * An application with a null renderer never creates an OpenGL context,
+ * and so it may run on a machine without a GPU.  Its window is never
+ * shown.  Unlike a headless application, draw() is still called every
+ * frame, but the screen is never cleared or refreshed.  The render
+ * classes keep their state on the CPU instead: textures only have a
+ * size and format, shaders are never compiled, and a {@link SpriteBatch}
+ * records its draw commands (see {@link SpriteBatch#getCallsMade()} and
+ * {@link SpriteBatch#getVerticesDrawn()}).  This measures the CPU cost of
+ * a frame, such as scene graph traversal and vertex preparation, without
+ * any device.
+ *
+ * A headless application may also use a null renderer, in which case
+ * draw() is never called.  This allows a dedicated server to load its
+ * textures on a machine without a GPU.
+ *
+ * This method may only be safely called before the application is
+ * initialized.  Once the application is initialized; this value may not
+ * be changed.
+ *
+ * @param value Whether this application renders without an OpenGL context
+ */
+void Application::setNullRenderer(bool value) {
+    CUAssertLog(_state == State::NONE, "Cannot reset application display after initialization");
+#if (CU_PLATFORM == CU_PLATFORM_IPHONE || CU_PLATFORM == CU_PLATFORM_ANDROID)
+    CUAssertLog(false, "Null renderers are not supported on mobile devices");
+#endif
+    _nullrender = value;
+}
+
 
 #pragma mark -
 #pragma mark Runtime Attributes
@@ -638,7 +719,7 @@ void Application::setOrganization(const std::string& name) {
  */
 void Application::setVSync(bool vsync) {
     _vsync = vsync;
-    if (_state != State::NONE) {
+    if (_state != State::NONE && !_nullrender) {
         SDL_GL_SetSwapInterval(_vsync ? 1 : 0);
     }
 }
@@ -686,6 +767,9 @@ float Application::getAverageFPS() const {
  * @return the OpenGL description for this application
  */
 const std::string Application::getOpenGLDescription() const {
+    if (_nullrender) {
+        return "Null renderer";
+    }
     const char* glinfo = (const char*)glGetString(GL_VERSION);
     return std::string(glinfo);
 }
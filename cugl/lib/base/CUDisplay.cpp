@@ -55,6 +55,10 @@ Uint32 Display::INIT_HIGH_DPI     = 2;
 Uint32 Display::INIT_MULTISAMPLED = 4;
 /** Whether this display should be centered (on windowed screens) */
 Uint32 Display::INIT_CENTERED     = 8;
+/** Whether this display is never shown (for servers and load tests) */
+Uint32 Display::INIT_HEADLESS     = 16;
+/** Whether this display has no OpenGL context (for profiling without a GPU) */
+Uint32 Display::INIT_NULL_RENDER  = 32;
 
 #pragma mark Constructors
 /**
@@ -71,6 +75,7 @@ _window(nullptr),
 _glContext(NULL),
 _framebuffer(0),
 _rendbuffer(0),
+_nullrender(false),
 _initialOrientation(Orientation::UNKNOWN),
 _displayOrientation(Orientation::UNKNOWN),
 _deviceOrientation(Orientation::UNKNOWN) {}
@@ -96,6 +101,12 @@ _deviceOrientation(Orientation::UNKNOWN) {}
  * @return true if initialization was successful.
  */
 bool Display::init(std::string title, Rect bounds, Uint32 flags) {
+#if CU_PLATFORM == CU_PLATFORM_UNKNOWN
+    // A headless Linux server may not have a window server to connect to
+    if (flags & (INIT_HEADLESS | INIT_NULL_RENDER)) {
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+    }
+#endif
     if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
         CULogError("Could not initialize display: %s",SDL_GetError());
         return false;
@@ -108,11 +119,15 @@ bool Display::init(std::string title, Rect bounds, Uint32 flags) {
     }
     
     // We have to set the OpenGL prefs BEFORE creating window
-    if (!prepareOpenGL(flags & INIT_MULTISAMPLED)) {
+    _nullrender = flags & INIT_NULL_RENDER;
+    if (!_nullrender && !prepareOpenGL(flags & INIT_MULTISAMPLED)) {
         return false;
     }
 
-    Uint32 sdlflags = SDL_WINDOW_HIDDEN | SDL_WINDOW_OPENGL;
+    Uint32 sdlflags = SDL_WINDOW_HIDDEN;
+    if (!_nullrender) {
+        sdlflags |= SDL_WINDOW_OPENGL;
+    }
     if (flags & INIT_HIGH_DPI) {
         sdlflags |= SDL_WINDOW_ALLOW_HIGHDPI;
     }
@@ -143,7 +158,7 @@ bool Display::init(std::string title, Rect bounds, Uint32 flags) {
     }
 
     // Now we can create the OpenGL context
-    if (!initOpenGL(flags & INIT_MULTISAMPLED)) {
+    if (!_nullrender && !initOpenGL(flags & INIT_MULTISAMPLED)) {
         SDL_DestroyWindow(_window);
         _window = nullptr;
         return false;
@@ -155,7 +170,9 @@ bool Display::init(std::string title, Rect bounds, Uint32 flags) {
 
 // The mobile devices have viewport problems
 #if CU_PLATFORM == CU_PLATFORM_ANDROID || CU_PLATFORM == CU_PLATFORM_IPHONE
-    glViewport(0, 0, (int)bounds.size.width, (int)bounds.size.height);
+    if (!_nullrender) {
+        glViewport(0, 0, (int)bounds.size.width, (int)bounds.size.height);
+    }
 #endif
 
     _initialOrientation = DisplayOrientation(true);
@@ -176,12 +193,15 @@ bool Display::init(std::string title, Rect bounds, Uint32 flags) {
  */
 void Display::dispose() {
     if (_window != nullptr) {
-        SDL_GL_DeleteContext(_glContext);
+        if (_glContext != NULL) {
+            SDL_GL_DeleteContext(_glContext);
+        }
         SDL_DestroyWindow(_window);
         _window = nullptr;
         _glContext = NULL;
     }
     _framebuffer = 0;
+    _nullrender = false;
     _bounds.size.set(0,0);
     _usable.size.set(0,0);
     _scale.setZero();
@@ -457,6 +477,9 @@ bool Display::removeOrientationListener() {
  * on iOS).
  */
 void Display::restoreRenderTarget() {
+    if (_nullrender) {
+        return;
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
     glBindRenderbuffer(GL_RENDERBUFFER, _rendbuffer);
 }
@@ -470,6 +493,9 @@ void Display::restoreRenderTarget() {
  * on iOS).
  */
 void Display::queryRenderTarget() {
+    if (_nullrender) {
+        return;
+    }
     glGetIntegerv(GL_FRAMEBUFFER_BINDING,  &_framebuffer);
     glGetIntegerv(GL_RENDERBUFFER_BINDING, &_rendbuffer);
 }
@@ -563,13 +589,16 @@ bool Display::initOpenGL(bool multisample) {
 /**
  * Refreshes the display.
  *
- * This method will swap the OpenGL framebuffers, drawing the screen.
+ * This method will swap the OpenGL framebuffers, drawing the screen. If
+ * this display has no OpenGL context, there is nothing to swap.
  *
  * It will also reassess the orientation state and call the listener as
  * necessary
  */
 void Display::refresh() {
-    SDL_GL_SwapWindow(_window);
+    if (!_nullrender) {
+        SDL_GL_SwapWindow(_window);
+    }
     Orientation oldDisplay = _displayOrientation;
     Orientation oldDevice  = _deviceOrientation;
     _displayOrientation = DisplayOrientation(true);
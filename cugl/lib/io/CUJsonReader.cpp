@@ -116,3 +116,24 @@ std::shared_ptr<JsonValue> JsonReader::readJson() {
     }
     return nullptr;
 }
+
+/**
+ * Returns a newly allocated JsonDocument for the next available JSON string.
+ *
+ * This method uses {@link readJsonString()} to extract the next available
+ * JSON string and parses it directly into a read-only document, without
+ * cJSON. This is much cheaper than {@link readJson()} for large files.
+ *
+ * If there is a parsing error, this  method will return nullptr.  Detailed
+ * information about the parsing error will be passed to an assert.  Hence
+ * error messages are suppressed if asserts are turned off.
+ *
+ * @return a newly allocated JsonDocument for the next available JSON string.
+ */
+std::shared_ptr<JsonDocument> JsonReader::readJsonDocument() {
+    std::string data = readJsonString();
+    if (!data.empty()) {
+        return JsonDocument::allocWithJson(data);
+    }
+    return nullptr;
+}
@@ -0,0 +1,564 @@
+//
+//  CULoopbackNetwork.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides an in-memory network for testing NetworkConnection
+//  without a punchthrough server.  Any number of connections in the same
+//  process may join the same loopback network, which plays the role of both
+//  the internet and the punchthrough server.  Packets are delayed, dropped and
+//  throttled according to simulated network conditions.  The conditions are
+//  driven by a seeded random generator, and the network can be given a manual
+//  clock, so that a test with the same inputs produces the same traffic.
+//
+//  To use it, allocate a network and set the transport factory of each
+//  connection configuration to {@link LoopbackNetwork#getTransportFactory}.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#include <cugl/net/CULoopbackNetwork.h>
+#include <cugl/net/CUNetworkConnection.h>
+#include <slikenet/MessageIdentifiers.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace cugl;
+
+/** The first port assigned to a loopback peer */
+constexpr unsigned short FIRST_PORT = 20000;
+
+/** The UDP/IP overhead added to each packet for bandwidth and statistics */
+constexpr size_t PACKET_OVERHEAD = 28;
+
+/** The number of times a reliable packet is resent before it is dropped */
+constexpr int MAX_RESENDS = 32;
+
+#pragma mark -
+#pragma mark Loopback Network
+/**
+ * Creates an uninitialized loopback network.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+LoopbackNetwork::LoopbackNetwork() :
+_nextPort(FIRST_PORT),
+_nextRoom(1),
+_manualClock(false),
+_time(0) {
+}
+
+/**
+ * Initializes a perfect network with the given random seed.
+ *
+ * @param seed  The seed for jitter and loss
+ *
+ * @return true if initialization was successful
+ */
+bool LoopbackNetwork::init(Uint32 seed) {
+    _random.seed(seed);
+    _start = std::chrono::steady_clock::now();
+    return true;
+}
+
+/**
+ * Returns a factory for transports on this network.
+ *
+ * Set this as the transport of a connection configuration to put the
+ * connection on this network.
+ *
+ * @return a factory for transports on this network.
+ */
+NetworkTransport::Factory LoopbackNetwork::getTransportFactory() {
+    std::shared_ptr<LoopbackNetwork> self = shared_from_this();
+    return [self]() {
+        return std::unique_ptr<NetworkTransport>(new LoopbackTransport(self));
+    };
+}
+
+/**
+ * Sets the conditions of every link in this network.
+ *
+ * The new conditions only apply to packets sent afterwards. The loss
+ * is clamped to 0..1. A reliable packet is resent until it arrives, but
+ * one lost too many times is dropped, as if the connection timed out.
+ *
+ * @param conditions    The conditions of every link
+ */
+void LoopbackNetwork::setConditions(const Conditions& conditions) {
+    _conditions = conditions;
+    _conditions.loss = std::min(std::max(conditions.loss, 0.0f), 1.0f);
+}
+
+/**
+ * Sets whether the clock only moves on calls to {@link #advance}.
+ *
+ * By default, the network uses real time. A manual clock makes a test
+ * independent of how fast it runs.
+ *
+ * @param value Whether to use a manual clock
+ */
+void LoopbackNetwork::setManualClock(bool value) {
+    if (value && !_manualClock) {
+        _time = now();
+    }
+    _manualClock = value;
+}
+
+/**
+ * Returns the current network time in microseconds.
+ *
+ * @return the current network time in microseconds.
+ */
+Uint64 LoopbackNetwork::now() const {
+    if (_manualClock) {
+        return _time;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+/**
+ * Adds a transport to this network, returning its address.
+ *
+ * This method should only be called by {@link LoopbackTransport}.
+ *
+ * @param peer  The transport to add
+ *
+ * @return the address of the transport
+ */
+SLNet::SystemAddress LoopbackNetwork::attach(LoopbackTransport* peer) {
+    _peers.push_back(peer);
+    return SLNet::SystemAddress("127.0.0.1", _nextPort++);
+}
+
+/**
+ * Removes a transport from this network, along with any room it hosts.
+ *
+ * This method should only be called by {@link LoopbackTransport}.
+ *
+ * @param peer  The transport to remove
+ */
+void LoopbackNetwork::detach(LoopbackTransport* peer) {
+    _peers.erase(std::remove(_peers.begin(), _peers.end(), peer), _peers.end());
+    for (auto it = _rooms.begin(); it != _rooms.end();) {
+        if (it->second == peer) {
+            it = _rooms.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Returns the transport with the given address, or nullptr if there is none.
+ *
+ * @param address   The address to look up
+ *
+ * @return the transport with the given address, or nullptr if there is none.
+ */
+LoopbackTransport* LoopbackNetwork::find(const SLNet::SystemAddress& address) const {
+    for (auto peer : _peers) {
+        if (peer->_address == address) {
+            return peer;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Connects a transport to the punchthrough server at the given address.
+ *
+ * The transport is assigned a new room.
+ *
+ * @param peer      The transport connecting
+ * @param server    The address of the server
+ */
+void LoopbackNetwork::connectServer(LoopbackTransport* peer, const SLNet::SystemAddress& server) {
+    notify(peer, server, ID_CONNECTION_REQUEST_ACCEPTED);
+
+    // The room is a fixed-length number, like the rooms of the real server
+    char room[16];
+    std::snprintf(room, sizeof(room), "%05u", _nextRoom++ % 100000);
+    _rooms[room] = peer;
+
+    std::vector<uint8_t> data;
+    data.push_back((uint8_t)std::strlen(room));
+    data.insert(data.end(), room, room + std::strlen(room));
+    notify(peer, server, ID_USER_PACKET_ENUM + NetworkConnection::AssignedRoom, data);
+}
+
+/**
+ * Punches through from a transport to the host of the given room.
+ *
+ * @param peer      The transport asking
+ * @param room      The room to join
+ * @param server    The address of the server
+ */
+void LoopbackNetwork::openNAT(LoopbackTransport* peer, const std::string& room,
+                              const SLNet::SystemAddress& server) {
+    auto it = _rooms.find(room);
+    if (it == _rooms.end() || it->second == peer) {
+        notify(peer, server, ID_NAT_TARGET_NOT_CONNECTED);
+        return;
+    }
+    notify(peer, it->second->_address, ID_NAT_PUNCHTHROUGH_SUCCEEDED);
+    notify(it->second, peer->_address, ID_NAT_PUNCHTHROUGH_SUCCEEDED);
+}
+
+/**
+ * Returns a random latency in microseconds, including jitter.
+ *
+ * @return a random latency in microseconds, including jitter.
+ */
+Uint64 LoopbackNetwork::sampleLatency() {
+    std::uniform_real_distribution<float> jitter(-_conditions.jitter, _conditions.jitter);
+    float millis = std::max(0.0f, _conditions.latency + jitter(_random));
+    return (Uint64)(millis * 1000);
+}
+
+/**
+ * Sends a packet between two transports under the current conditions.
+ *
+ * @param from          The sender
+ * @param to            The receiver
+ * @param data          The packet
+ * @param size          The number of bytes in the packet
+ * @param reliability   The packet reliability
+ */
+void LoopbackNetwork::transmit(LoopbackTransport* from, LoopbackTransport* to,
+                               const uint8_t* data, size_t size, PacketReliability reliability) {
+    Uint64 time = now();
+    size_t wire = size + PACKET_OVERHEAD;
+    from->_stats.packetsSent++;
+    from->_stats.bytesSent += wire;
+    _stats.packetsSent++;
+    _stats.bytesSent += wire;
+
+    // The packet leaves once the uplink has sent everything before it
+    Uint64 depart = std::max(time, from->_uplinkFree);
+    if (_conditions.bandwidth > 0) {
+        depart += (Uint64)wire * 1000000 / _conditions.bandwidth;
+    }
+    from->_uplinkFree = depart;
+
+    bool reliable = (reliability == RELIABLE || reliability == RELIABLE_ORDERED ||
+                     reliability == RELIABLE_SEQUENCED ||
+                     reliability == RELIABLE_WITH_ACK_RECEIPT ||
+                     reliability == RELIABLE_ORDERED_WITH_ACK_RECEIPT);
+    bool ordered = (reliability != RELIABLE && reliability != UNRELIABLE &&
+                    reliability != RELIABLE_WITH_ACK_RECEIPT &&
+                    reliability != UNRELIABLE_WITH_ACK_RECEIPT);
+
+    LoopbackTransport::Link& link = from->_links[to];
+    link.packets++;
+    link.bytesSent += wire;
+
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    Uint64 arrive = depart + sampleLatency();
+    int resends = 0;
+    while (_conditions.loss > 0 && chance(_random) < _conditions.loss) {
+        link.lost++;
+        if (!reliable || resends++ == MAX_RESENDS) {
+            from->_stats.packetsDropped++;
+            _stats.packetsDropped++;
+            return;
+        }
+        // Resent after the acknowledgement fails to come back
+        from->_stats.packetsResent++;
+        _stats.packetsResent++;
+        link.packets++;
+        link.bytesSent += wire;
+        arrive += sampleLatency() + sampleLatency();
+    }
+    to->_links[from].bytesReceived += wire;
+
+    if (ordered) {
+        arrive = std::max(arrive, link.lastArrival);
+        link.lastArrival = arrive;
+    }
+
+    SLNet::Packet* packet = new SLNet::Packet();
+    packet->systemAddress = from->_address;
+    packet->length = (unsigned int)size;
+    packet->bitSize = (SLNet::BitSize_t)(size * 8);
+    packet->data = new unsigned char[size];
+    std::memcpy(packet->data, data, size);
+    packet->deleteData = true;
+    packet->wasGeneratedLocally = false;
+    to->_inbox.emplace(arrive, packet);
+}
+
+/**
+ * Delivers a connection event to a transport after the latency.
+ *
+ * @param to        The receiver
+ * @param from      The address the event comes from
+ * @param event     The Slikenet message ID of the event
+ * @param data      Any data following the message ID
+ */
+void LoopbackNetwork::notify(LoopbackTransport* to, const SLNet::SystemAddress& from,
+                             uint8_t event, const std::vector<uint8_t>& data) {
+    SLNet::Packet* packet = new SLNet::Packet();
+    packet->systemAddress = from;
+    packet->length = (unsigned int)(data.size() + 1);
+    packet->bitSize = (SLNet::BitSize_t)(packet->length * 8);
+    packet->data = new unsigned char[packet->length];
+    packet->data[0] = event;
+    if (!data.empty()) {
+        std::memcpy(packet->data + 1, data.data(), data.size());
+    }
+    packet->deleteData = true;
+    packet->wasGeneratedLocally = false;
+
+    // Events must not overtake anything already on its way, or a client
+    // could hear from the host before it hears that punchthrough succeeded
+    Uint64 arrive = now() + sampleLatency();
+    if (!to->_inbox.empty()) {
+        arrive = std::max(arrive, to->_inbox.rbegin()->first);
+    }
+    to->_inbox.emplace(arrive, packet);
+}
+
+#pragma mark -
+#pragma mark Loopback Transport
+/**
+ * Creates a transport on the given network that has not started.
+ *
+ * @param network   The loopback network
+ */
+LoopbackTransport::LoopbackTransport(const std::shared_ptr<LoopbackNetwork>& network) :
+_network(network),
+_active(false),
+_uplinkFree(0) {
+}
+
+/**
+ * Deletes this transport, closing all connections.
+ */
+LoopbackTransport::~LoopbackTransport() {
+    shutdown(0);
+}
+
+/**
+ * Starts the transport so that it can connect to other peers.
+ *
+ * @param maxConnections    The maximum number of connections
+ * @param timeout           The time in milliseconds before a silent peer is dropped
+ *
+ * @return true if the transport started successfully
+ */
+bool LoopbackTransport::startup(unsigned int maxConnections, unsigned int timeout) {
+    if (_active) {
+        return false;
+    }
+    _address = _network->attach(this);
+    _active = true;
+    return true;
+}
+
+/**
+ * Stops the transport, closing all connections.
+ *
+ * If block is positive, the other peers are notified of the disconnection.
+ * Otherwise they see the connection as lost.
+ *
+ * @param block The time in milliseconds to wait for notifications
+ */
+void LoopbackTransport::shutdown(unsigned int block) {
+    if (!_active) {
+        return;
+    }
+    uint8_t event = block > 0 ? ID_DISCONNECTION_NOTIFICATION : ID_CONNECTION_LOST;
+    for (auto peer : _connections) {
+        peer->drop(this);
+        _network->notify(peer, _address, event);
+    }
+    _connections.clear();
+    _links.clear();
+
+    for (auto& it : _inbox) {
+        deallocatePacket(it.second);
+    }
+    _inbox.clear();
+
+    _network->detach(this);
+    _active = false;
+}
+
+/**
+ * Starts connecting to the given address.
+ *
+ * Any address that is not a peer on this network is the punchthrough server.
+ *
+ * @param address   The address to connect to
+ */
+void LoopbackTransport::connect(const SLNet::SystemAddress& address) {
+    LoopbackTransport* peer = _network->find(address);
+    if (peer == nullptr) {
+        _network->connectServer(this, address);
+        return;
+    }
+    if (isConnected(address)) {
+        return;
+    }
+    _connections.push_back(peer);
+    peer->_connections.push_back(this);
+    _network->notify(this, address, ID_CONNECTION_REQUEST_ACCEPTED);
+    _network->notify(peer, _address, ID_NEW_INCOMING_CONNECTION);
+}
+
+/**
+ * Closes the connection to the given address, notifying the other peer.
+ *
+ * @param address   The address to disconnect from
+ */
+void LoopbackTransport::closeConnection(const SLNet::SystemAddress& address) {
+    LoopbackTransport* peer = _network->find(address);
+    if (peer == nullptr || !isConnected(address)) {
+        return;
+    }
+    drop(peer);
+    peer->drop(this);
+    _network->notify(peer, _address, ID_DISCONNECTION_NOTIFICATION);
+}
+
+/**
+ * Returns true if this transport is connected to the given address.
+ *
+ * @param address   The address to check
+ *
+ * @return true if this transport is connected to the given address.
+ */
+bool LoopbackTransport::isConnected(const SLNet::SystemAddress& address) {
+    for (auto peer : _connections) {
+        if (peer->_address == address) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Asks the punchthrough server to connect this peer to the host of a room.
+ *
+ * @param room      The room ID
+ * @param server    The address of the punchthrough server
+ */
+void LoopbackTransport::openNAT(const std::string& room, const SLNet::SystemAddress& server) {
+    _network->openNAT(this, room, server);
+}
+
+/**
+ * Sends a packet to the given address.
+ *
+ * If broadcast is true, the packet is instead sent to every connected peer
+ * except the given address. Packets to the punchthrough server are ignored.
+ *
+ * @param data          The packet
+ * @param size          The number of bytes in the packet
+ * @param reliability   The packet reliability
+ * @param address       The destination (or the peer to skip on broadcast)
+ * @param broadcast     Whether to send to every other connected peer
+ */
+void LoopbackTransport::send(const uint8_t* data, size_t size, PacketReliability reliability,
+                             const SLNet::SystemAddress& address, bool broadcast) {
+    for (auto peer : _connections) {
+        if ((peer->_address == address) != broadcast) {
+            _network->transmit(this, peer, data, size, reliability);
+        }
+    }
+}
+
+/**
+ * Returns the next received packet, or nullptr if there is none.
+ *
+ * Only packets whose arrival time has passed are returned.
+ *
+ * @return the next received packet, or nullptr if there is none.
+ */
+SLNet::Packet* LoopbackTransport::receive() {
+    if (_inbox.empty() || _inbox.begin()->first > _network->now()) {
+        return nullptr;
+    }
+    SLNet::Packet* packet = _inbox.begin()->second;
+    _inbox.erase(_inbox.begin());
+    _stats.packetsReceived++;
+    return packet;
+}
+
+/**
+ * Releases a packet returned by {@link #receive}.
+ *
+ * @param packet    The packet to release
+ */
+void LoopbackTransport::deallocatePacket(SLNet::Packet* packet) {
+    delete[] packet->data;
+    delete packet;
+}
+
+/**
+ * Stores the link statistics for the peer at the given address.
+ *
+ * The ping is the round trip of the current latency, and the loss is the
+ * fraction of all transmissions to the peer that were lost.
+ *
+ * @param address   The address of a connected peer
+ * @param stats     The statistics to write to
+ *
+ * @return true if the peer is connected
+ */
+bool LoopbackTransport::getPeerStats(const SLNet::SystemAddress& address, PeerStats& stats) {
+    LoopbackTransport* peer = _network->find(address);
+    if (peer == nullptr || !isConnected(address)) {
+        return false;
+    }
+    const Link& link = _links[peer];
+    stats.ping = (int)(2 * _network->getConditions().latency);
+    stats.lossTotal = link.packets > 0 ? (float)link.lost / link.packets : 0.0f;
+    stats.lossLastSecond = stats.lossTotal;
+    stats.bytesSent = link.bytesSent;
+    stats.bytesReceived = link.bytesReceived;
+    return true;
+}
+
+/**
+ * Removes a connection without notifying the other peer.
+ *
+ * @param peer  The peer to disconnect from
+ */
+void LoopbackTransport::drop(LoopbackTransport* peer) {
+    _connections.erase(std::remove(_connections.begin(), _connections.end(), peer),
+                       _connections.end());
+    _links.erase(peer);
+}
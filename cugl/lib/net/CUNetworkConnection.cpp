@@ -39,6 +39,7 @@
 //
 #include <cugl/net/CUNetworkConnection.h>
 #include <cugl/cugl.h>
+#include <cstring>
 #include <utility>
 
 
@@ -142,8 +143,9 @@ _maxPlayers(1) {
  * Deletes this network connection, disposing all resources
  */
 NetworkConnection::~NetworkConnection() {
-    _peer->Shutdown(SHUTDOWN_BLOCK);
-    SLNet::RakPeerInterface::DestroyInstance(_peer.release());
+    if (_transport) {
+        _transport->shutdown(SHUTDOWN_BLOCK);
+    }
 }
 
 /**
@@ -152,8 +154,12 @@ NetworkConnection::~NetworkConnection() {
  * A disposed network connection can be safely reinitialized.
  */
 void NetworkConnection::dispose() {
-    _peer->Shutdown(SHUTDOWN_BLOCK);
-    SLNet::RakPeerInterface::DestroyInstance(_peer.release());
+    if (_transport) {
+        _transport->shutdown(SHUTDOWN_BLOCK);
+        _transport = nullptr;
+    }
+    _relayFilter = nullptr;
+    _relayQueue.clear();
 }
 
 /**
@@ -172,7 +178,7 @@ void NetworkConnection::dispose() {
  * @return true if initialization was successful
  */
 bool NetworkConnection::init(ConnectionConfig config) {
-    if (_peer) {
+    if (_transport) {
         return false;
     }
     _status = NetStatus::Pending;
@@ -183,7 +189,7 @@ bool NetworkConnection::init(ConnectionConfig config) {
     _config = config;
     c0StartupConn();
   _remotePeer = HostPeers(config.maxNumPlayers);
-    return _peer != nullptr;
+    return _transport != nullptr;
 }
 
 /**
@@ -201,7 +207,7 @@ bool NetworkConnection::init(ConnectionConfig config) {
  * @return true if initialization was successful
  */
 bool NetworkConnection::init(ConnectionConfig config, std::string roomID) {
-    if (_peer) {
+    if (_transport) {
         return false;
     }
     _status = NetStatus::Pending;
@@ -212,8 +218,8 @@ bool NetworkConnection::init(ConnectionConfig config, std::string roomID) {
     _config = config;
     c0StartupConn();
     _remotePeer = ClientPeer(std::move(roomID));
-    if (_peer != nullptr) {
-        _peer->SetMaximumIncomingConnections(1);
+    if (_transport != nullptr) {
+        _transport->setMaximumIncomingConnections(1);
         return true;
     }
     return false;
@@ -278,6 +284,37 @@ void NetworkConnection::setReliability(PacketReliability reliability) {
   */
 unsigned int NetworkConnection::getMaxPacketSize() { return MAX_PACKET; }
 
+/**
+ * Stores the link statistics for the connection to the given player.
+ *
+ * The host has a link to every client, while a client only has a link to
+ * the host (player 0). The statistics come from the transport, and so
+ * include protocol overhead and resends that {@link #send} does not see.
+ *
+ * @param playerID  The player at the other end of the link
+ * @param stats     The statistics to write to
+ *
+ * @return true if this connection has a link to the player
+ */
+bool NetworkConnection::getPeerStats(uint8_t playerID, NetworkTransport::PeerStats& stats) {
+    if (_transport == nullptr) {
+        return false;
+    }
+    SLNet::SystemAddress* addr = nullptr;
+    std::visit(make_visitor(
+        [&](HostPeers& h) {
+            if (playerID > 0 && playerID <= h.peers.size()) {
+                addr = h.peers.at(playerID - 1).get();
+            }
+        },
+        [&](ClientPeer& c) {
+            if (playerID == 0) {
+                addr = c.addr.get();
+            }
+        }), _remotePeer);
+    return addr != nullptr && _transport->getPeerStats(*addr, stats);
+}
+
 #pragma mark -
 #pragma mark Connection Handshake
 /**
@@ -310,6 +347,44 @@ std::vector<uint8_t> readBs(SLNet::BitStream& bts) {
   return msgConverted;
 }
 
+/**
+ * Returns the message in a bitstream without copying it.
+ *
+ * This works if the BitStream was encoded in the standard format used by
+ * this class. The result points into the data of the bitstream, and so is
+ * only valid as long as that data is.
+ *
+ * The size comes from the message header, which is not trusted. If the
+ * header cannot be read, or claims more bytes than are left in the
+ * bitstream, this returns nullptr.
+ *
+ * @param bts   The data bitstream
+ * @param size  The number of bytes in the message
+ *
+ * @return a pointer to the first byte of the message, or nullptr if truncated
+ */
+const uint8_t* peekBs(SLNet::BitStream& bts, Uint32& size) {
+  uint8_t ignored;
+  uint8_t length;
+  if (!bts.Read(ignored) || !bts.Read(length)) {
+    return nullptr;
+  }
+
+  size = length;
+  if (length == 255) {
+    uint8_t* ptr = reinterpret_cast<uint8_t*>(&size);
+    if (!bts.ReadAlignedBytes(ptr, sizeof(Uint32))) {
+      return nullptr;
+    }
+    size = marshall(size); // Fix endianness issues
+  }
+
+  if (size > BITS_TO_BYTES(bts.GetNumberOfUnreadBits())) {
+    return nullptr;
+  }
+  return bts.GetData() + BITS_TO_BYTES(bts.GetReadOffset());
+}
+
 /**
  * Write a byte vector message to a bitstream.
  *
@@ -338,38 +413,67 @@ void writeBs(SLNet::BitStream& bts, uint8_t head,
     bts.WriteAlignedBytes(msg.data(), length);
 }
 
+/**
+ * Returns the number of bytes a message takes up in a batch.
+ *
+ * @param msg   The message to batch
+ *
+ * @return the number of bytes a message takes up in a batch.
+ */
+size_t batchSize(const std::vector<uint8_t>& msg) {
+    return (msg.size() < 255 ? 1 : 1 + sizeof(Uint32)) + msg.size();
+}
+
+/**
+ * Appends a message to a batch.
+ *
+ * A batch is a sequence of messages, each preceded by its length in the
+ * same format as {@link writeBs}.
+ *
+ * @param batch The batch to append to
+ * @param msg   The message to append
+ */
+void writeBatch(std::vector<uint8_t>& batch, const std::vector<uint8_t>& msg) {
+    Uint32 length = (Uint32)msg.size();
+    if (length < 255) {
+        batch.push_back(static_cast<uint8_t>(length));
+    } else {
+        batch.push_back(255);
+        Uint32 size = marshall(length); // Fix endianness issues
+        const uint8_t* ptr = reinterpret_cast<uint8_t*>(&size);
+        batch.insert(batch.end(), ptr, ptr + sizeof(Uint32));
+    }
+    batch.insert(batch.end(), msg.begin(), msg.end());
+}
+
 /**
  * Step 0
  *
  * Connect to punchthrough server (both client and host)
  */
 void NetworkConnection::c0StartupConn() {
-  _peer = std::unique_ptr<SLNet::RakPeerInterface>(SLNet::RakPeerInterface::GetInstance());
-
-  _peer->SetTimeoutTime(DISCONN_TIME, SLNet::UNASSIGNED_SYSTEM_ADDRESS);
+  if (_config.transport) {
+    _transport = _config.transport();
+  } else {
+    _transport = std::make_unique<SLikeNetTransport>();
+  }
 
-  _peer->AttachPlugin(&(_natPunchthroughClient));
   _natPunchServerAddress = std::make_unique<SLNet::SystemAddress>(
     SLNet::SystemAddress(_config.punchthroughServerAddr.c_str(),
                              _config.punchthroughServerPort));
 
-  // Use the default socket descriptor
-  // This will make the OS assign us a random port.
-  SLNet::SocketDescriptor socketDescriptor;
   // Allow connections for each player and one for the NAT server.
-  _peer->Startup(_config.maxNumPlayers, &socketDescriptor, 1);
+  _transport->startup(_config.maxNumPlayers, DISCONN_TIME);
 
     if (_debug) {
-        CULog("Your GUID is: %s",
-            _peer->GetGuidFromSystemAddress(SLNet::UNASSIGNED_SYSTEM_ADDRESS).ToString());
+        CULog("Your GUID is: %s", _transport->getGuid().c_str());
     }
 
   // Connect to the NAT Punchthrough server
     if (_debug) {
         CULog("Connecting to punchthrough server");
     }
-  _peer->Connect(_natPunchServerAddress->ToString(false),
-                   _natPunchServerAddress->GetPort(), nullptr, 0);
+  _transport->connect(*_natPunchServerAddress);
 }
 
 /**
@@ -412,9 +516,7 @@ void NetworkConnection::cc1ClientConnServer(ClientPeer& c) {
         CULog("Connected to punchthrough server");
         CULog("Trying to connect to %s", c.room.c_str());
     }
-  SLNet::RakNetGUID remote;
-  remote.FromString(c.room.c_str());
-  _natPunchthroughClient.OpenNAT(remote, *(_natPunchServerAddress));
+  _transport->openNAT(c.room, *_natPunchServerAddress);
 }
 
 /**
@@ -435,7 +537,7 @@ void NetworkConnection::cc3HostReceivedPunch(HostPeers& h, SLNet::Packet* packet
   auto p = packet->systemAddress;
     if (_debug) {
         CULog("Host received punchthrough; curr num players %d",
-              _peer->NumberOfConnections());
+              _transport->getNumberOfConnections());
     }
 
   bool hasRoom = false;
@@ -462,7 +564,7 @@ void NetworkConnection::cc3HostReceivedPunch(HostPeers& h, SLNet::Packet* packet
     if (_debug) {
         CULog("Connecting to client now");
     }
-  _peer->Connect(p.ToString(false), p.GetPort(), nullptr, 0);
+  _transport->connect(p);
 }
 
 /**
@@ -494,7 +596,7 @@ void NetworkConnection::cc5HostConfirmClient(HostPeers& h, SLNet::Packet* packet
 
     directSend({}, JoinRoomFail, packet->systemAddress);
 
-    _peer->CloseConnection(packet->systemAddress, true);
+    _transport->closeConnection(packet->systemAddress);
     return;
   }
 
@@ -525,7 +627,7 @@ void NetworkConnection::cc5HostConfirmClient(HostPeers& h, SLNet::Packet* packet
 
     if (_debug) {
         CULog("Host confirmed players; curr connections %d",
-              _peer->NumberOfConnections());
+              _transport->getNumberOfConnections());
     }
 }
 
@@ -551,7 +653,7 @@ void NetworkConnection::cc6ClientAssignedID(ClientPeer& c,
     _status = NetStatus::Connected;
   }
 
-  _peer->CloseConnection(*_natPunchServerAddress, true);
+  _transport->closeConnection(*_natPunchServerAddress);
 
   directSend({ *_playerID, (uint8_t)(apiMatch ? 1 : 0) }, JoinRoom, *c.addr);
 }
@@ -575,7 +677,7 @@ void NetworkConnection::cc7HostGetClientData(HostPeers& h, SLNet::Packet* packet
                     CULog("Player ID mismatch; client reported id %d; disconnecting",
                           msgConverted[0]);
                 }
-        _peer->CloseConnection(packet->systemAddress, true);
+        _transport->closeConnection(packet->systemAddress);
         return;
       }
 
@@ -583,7 +685,7 @@ void NetworkConnection::cc7HostGetClientData(HostPeers& h, SLNet::Packet* packet
                 if (_debug) {
                     CULog("Client %d reported outdated API or other issue; disconnecting", pID);
                 }
-        _peer->CloseConnection(packet->systemAddress, true);
+        _transport->closeConnection(packet->systemAddress);
         return;
       }
 
@@ -604,7 +706,7 @@ void NetworkConnection::cc7HostGetClientData(HostPeers& h, SLNet::Packet* packet
     if (_debug) {
         CULogError("Unknown connection target; disconnecting");
     }
-  _peer->CloseConnection(packet->systemAddress, true);
+  _transport->closeConnection(packet->systemAddress);
 }
 
 /**
@@ -650,7 +752,7 @@ void cugl::NetworkConnection::cr1ClientReceivedInfo(ClientPeer& c,
     _lastReconnAttempt.reset();
     _disconnTime.reset();
   }
-  _peer->CloseConnection(*_natPunchServerAddress, true);
+  _transport->closeConnection(*_natPunchServerAddress);
 
   directSend({
     static_cast<uint8_t>(_playerID.has_value() ? *_playerID : 0),
@@ -687,7 +789,7 @@ void NetworkConnection::broadcast(const std::vector<uint8_t>& msg,
                                   CustomDataPackets packetType) {
   SLNet::BitStream bs;
     writeBs(bs,ID_USER_PACKET_ENUM + packetType,msg);
-  _peer->Send(&bs, MEDIUM_PRIORITY, _reliability, 1, ignore, true);
+  _transport->send(bs.GetData(), bs.GetNumberOfBytesUsed(), _reliability, ignore, true);
 }
 
 /**
@@ -704,13 +806,14 @@ void NetworkConnection::send(const std::vector<uint8_t>& msg, CustomDataPackets
 
   std::visit(make_visitor(
     [&](HostPeers& /*h*/) {
-      _peer->Send(&bs, MEDIUM_PRIORITY, _reliability, 1, *_natPunchServerAddress, true);
+      _transport->send(bs.GetData(), bs.GetNumberOfBytesUsed(), _reliability,
+                       *_natPunchServerAddress, true);
     },
     [&](ClientPeer& c) {
       if (c.addr == nullptr) {
         return;
       }
-      _peer->Send(&bs, MEDIUM_PRIORITY, _reliability, 1, *c.addr, false);
+      _transport->send(bs.GetData(), bs.GetNumberOfBytesUsed(), _reliability, *c.addr, false);
     }), _remotePeer);
 }
 
@@ -726,7 +829,99 @@ void cugl::NetworkConnection::directSend(const std::vector<uint8_t>& msg,
                                          SLNet::SystemAddress dest) {
   SLNet::BitStream bs;
     writeBs(bs,ID_USER_PACKET_ENUM + packetType,msg);
-  _peer->Send(&bs, MEDIUM_PRIORITY, _reliability, 1, dest, false);
+  _transport->send(bs.GetData(), bs.GetNumberOfBytesUsed(), _reliability, dest, false);
+}
+
+/**
+ * Queues a message from a client to be relayed to the other players.
+ *
+ * PRECONDITION: This player MUST be the host
+ *
+ * @param h         The host peers
+ * @param source    The address of the client that sent the message
+ * @param msg       The message bytes
+ * @param size      The number of bytes in the message
+ */
+void NetworkConnection::queueRelay(HostPeers& h, const SLNet::SystemAddress& source,
+                                   const uint8_t* msg, size_t size) {
+    RelayRule rule = { RelayAction::Forward, 0 };
+    if (_relayFilter) {
+        rule = _relayFilter(msg, size);
+    }
+    if (rule.action == RelayAction::Consume) {
+        return;
+    }
+
+    uint8_t sender = 0;
+    for (uint8_t i = 0; i < h.peers.size(); i++) {
+        if (h.peers.at(i) != nullptr && *h.peers.at(i) == source) {
+            sender = i + 1;
+            break;
+        }
+    }
+
+    if (rule.action == RelayAction::Merge) {
+        for (auto& it : _relayQueue) {
+            if (it.merge && it.sender == sender && it.key == rule.key) {
+                it.data.assign(msg, msg + size);
+                return;
+            }
+        }
+    }
+
+    RelayMessage relay;
+    relay.sender = sender;
+    relay.merge = rule.action == RelayAction::Merge;
+    relay.key = rule.key;
+    relay.data.assign(msg, msg + size);
+    _relayQueue.push_back(std::move(relay));
+}
+
+/**
+ * Sends all queued client messages, one datagram per player if possible.
+ *
+ * Each player is sent the messages from every client other than itself.
+ *
+ * PRECONDITION: This player MUST be the host
+ *
+ * @param h The host peers
+ */
+void NetworkConnection::flushRelay(HostPeers& h) {
+    if (_relayQueue.empty()) {
+        return;
+    }
+
+    std::vector<uint8_t> batch;
+    batch.reserve(MAX_PACKET);
+    for (uint8_t i = 0; i < h.peers.size(); i++) {
+        if (h.peers.at(i) == nullptr) {
+            continue;
+        }
+        uint8_t pID = i + 1;
+        SLNet::SystemAddress& dest = *h.peers.at(i);
+
+        batch.clear();
+        for (const auto& it : _relayQueue) {
+            if (it.sender == pID) {
+                continue;
+            }
+            size_t size = batchSize(it.data);
+            if (size >= MAX_PACKET) {
+                // Too large to share a datagram
+                directSend(it.data, Standard, dest);
+                continue;
+            }
+            if (batch.size() + size >= MAX_PACKET) {
+                directSend(batch, Batch, dest);
+                batch.clear();
+            }
+            writeBatch(batch, it.data);
+        }
+        if (!batch.empty()) {
+            directSend(batch, Batch, dest);
+        }
+    }
+    _relayQueue.clear();
 }
 
 /**
@@ -759,14 +954,13 @@ void NetworkConnection::attemptReconnect() {
         CULog("Attempting reconnection");
     }
 
-  _peer->Shutdown(0);
-  SLNet::RakPeerInterface::DestroyInstance(_peer.release());
+  _transport->shutdown(0);
   
   _lastReconnAttempt = now;
-  _peer = nullptr;
+  _transport = nullptr;
 
   c0StartupConn();
-  _peer->SetMaximumIncomingConnections(1);
+  _transport->setMaximumIncomingConnections(1);
 }
 
 #pragma mark -
@@ -812,6 +1006,32 @@ void NetworkConnection::sendOnlyToHost(const std::vector<uint8_t>& msg) {
         }), _remotePeer);
 }
 
+/**
+ * Sends a byte array to a single player only.
+ *
+ * This is only useful when called from the host (player ID 0). As a client,
+ * this method does nothing. Within a few frames, the given player should
+ * receive this via a call to {@link #receive}. Unlike {@link #send}, the
+ * message is not relayed to any other player.
+ *
+ * This allows the host to limit state to the players that need it. If the
+ * player is not connected, this method does nothing.
+ *
+ * @param msg       The byte array to send.
+ * @param playerID  The player to send to.
+ */
+void NetworkConnection::sendToPlayer(const std::vector<uint8_t>& msg, uint8_t playerID) {
+    std::visit(make_visitor(
+        [&](HostPeers& h) {
+            if (playerID == 0 || playerID > h.peers.size() ||
+                h.peers.at(playerID - 1) == nullptr) {
+                return;
+            }
+            directSend(msg, Standard, *h.peers.at(playerID - 1));
+        },
+        [&](ClientPeer& /*c*/) {}), _remotePeer);
+}
+
 
 /**
  * Receives incoming network messages.
@@ -833,11 +1053,30 @@ void NetworkConnection::sendOnlyToHost(const std::vector<uint8_t>& msg) {
  */
 void NetworkConnection::receive(
   const std::function<void(const std::vector<uint8_t>&)>& dispatcher) {
+    receive([&](const uint8_t* data, size_t size) {
+        dispatcher(std::vector<uint8_t>(data, data + size));
+    });
+}
+
+/**
+ * Receives incoming network messages without copying them.
+ *
+ * This method is identical to the vector version of {@link #receive}, except
+ * that `dispatch` is given a pointer into the received packet and the number
+ * of bytes in the message. The bytes are only valid for the duration of the
+ * call, as the packet is released as soon as `dispatch` returns. This allows
+ * a message to be decoded with {@link NetworkDeserializer} straight out of
+ * the packet.
+ *
+ * @param dispatcher    The function to process received data
+ */
+void NetworkConnection::receive(
+  const std::function<void(const uint8_t*, size_t)>& dispatcher) {
 
   switch (_status) {
   case NetStatus::Reconnecting:
     attemptReconnect();
-    if (_peer == nullptr) {
+    if (_transport == nullptr) {
             if (_debug) {
                 CULog("Peer null");
             }
@@ -857,8 +1096,8 @@ void NetworkConnection::receive(
 
 
   SLNet::Packet* packet = nullptr;
-  for (packet = _peer->Receive(); packet != nullptr;
-    _peer->DeallocatePacket(packet), packet = _peer->Receive()) {
+  for (packet = _transport->receive(); packet != nullptr;
+    _transport->deallocatePacket(packet), packet = _transport->receive()) {
     SLNet::BitStream bts(packet->data, packet->length, false);
 
     switch (packet->data[0]) {
@@ -924,8 +1163,8 @@ void NetworkConnection::receive(
               }
               send(disconnMsg, PlayerLeft);
 
-              if (_peer->GetConnectionState(packet->systemAddress) == SLNet::IS_CONNECTED) {
-                _peer->CloseConnection(packet->systemAddress, true);
+              if (_transport->isConnected(packet->systemAddress)) {
+                _transport->closeConnection(packet->systemAddress);
               }
               return;
             }
@@ -981,21 +1220,65 @@ void NetworkConnection::receive(
 
     // Begin Non-SLikeNet Reported Codes
     case ID_USER_PACKET_ENUM + Standard: {
-      auto msgConverted = readBs(bts);
-      dispatcher(msgConverted);
+      Uint32 size;
+      const uint8_t* msg = peekBs(bts, size);
+      if (msg == nullptr) {
+        CULogError("Received truncated message");
+        break;
+      }
+      dispatcher(msg, size);
 
       std::visit(make_visitor(
-        [&](HostPeers& /*h*/) { broadcast(msgConverted, packet->systemAddress); },
+        [&](HostPeers& h) { queueRelay(h, packet->systemAddress, msg, size); },
         [&](ClientPeer& c) {}), _remotePeer);
 
+      break;
+    }
+    case ID_USER_PACKET_ENUM + Batch: {
+      Uint32 size;
+      const uint8_t* batch = peekBs(bts, size);
+      if (batch == nullptr) {
+        CULogError("Received truncated batch message");
+        break;
+      }
+
+      std::visit(make_visitor(
+        [&](HostPeers& /*h*/) { CULogError("Received batch message as host"); },
+        [&](ClientPeer& c) {
+          Uint32 pos = 0;
+          while (pos < size) {
+            Uint32 length = batch[pos++];
+            if (length == 255) {
+              if (size - pos < sizeof(Uint32)) {
+                CULogError("Received truncated batch message");
+                break;
+              }
+              std::memcpy(&length, batch + pos, sizeof(Uint32));
+              length = marshall(length); // Fix endianness issues
+              pos += sizeof(Uint32);
+            }
+            if (length > size - pos) {
+              CULogError("Received truncated batch message");
+              break;
+            }
+            dispatcher(batch + pos, length);
+            pos += length;
+          }
+        }), _remotePeer);
+
       break;
     }
         case ID_USER_PACKET_ENUM + DirectToHost: {
-            auto msgConverted = readBs(bts);
+            Uint32 size;
+            const uint8_t* msg = peekBs(bts, size);
+            if (msg == nullptr) {
+                CULogError("Received truncated direct to host message");
+                break;
+            }
 
             std::visit(make_visitor(
                 [&](HostPeers& /*h*/) {
-                    dispatcher(msgConverted);
+                    dispatcher(msg, size);
                 },
                 [&](ClientPeer& c) {
                     CULogError("Received direct to host message as client");
@@ -1076,6 +1359,10 @@ void NetworkConnection::receive(
       break;
     }
   }
+
+  std::visit(make_visitor(
+    [&](HostPeers& h) { flushRelay(h); },
+    [&](ClientPeer& /*c*/) {}), _remotePeer);
 }
 
 /**
@@ -486,7 +486,28 @@ void NetworkSerializer::reset() {
  * @param msg The byte vector serialized by {@link NetworkSerializer}
  */
 void NetworkDeserializer::receive(const std::vector<uint8_t>& msg) {
-	_data = msg;
+	_buffer = msg;
+	_data = _buffer.data();
+	_size = _buffer.size();
+	_pos = 0;
+}
+
+/**
+ * Loads a new message to be read without copying it.
+ *
+ * This method is identical to {@link #receive(const std::vector<uint8_t>&)},
+ * except that the bytes are read in place. The caller must keep them alive
+ * and unchanged until the message has been read and {@link #reset} (or
+ * another receive) has been called. This allows a message to be decoded
+ * directly out of a network packet.
+ *
+ * @param data  The bytes serialized by {@link NetworkSerializer}
+ * @param size  The number of bytes
+ */
+void NetworkDeserializer::receive(const uint8_t* data, size_t size) {
+	_buffer.clear();
+	_data = data;
+	_size = size;
 	_pos = 0;
 }
 
@@ -505,7 +526,7 @@ void NetworkDeserializer::receive(const std::vector<uint8_t>& msg) {
  * guaranteed to never corrupt the stream (unlike the other read methods)
  */
 NetworkDeserializer::Message NetworkDeserializer::read() {
-	if (_pos >= _data.size()) {
+	if (_pos >= _size) {
 		return {};
 	}
 
@@ -567,7 +588,7 @@ NetworkDeserializer::Message NetworkDeserializer::read() {
  * @return the type of the next data value to be read.
  */
 NetworkType NetworkDeserializer::nextType() const {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return InvalidType;
     }
     
@@ -612,7 +633,7 @@ NetworkType NetworkDeserializer::nextType() const {
  * @return a single boolean value.
  */
 bool NetworkDeserializer::readBool() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return false;
     }
     uint8_t value = _data[_pos++];
@@ -631,11 +652,11 @@ bool NetworkDeserializer::readBool() {
  * @return a single float value.
  */
 float NetworkDeserializer::readFloat() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0.0f;
     }
     _pos++;
-    const float* r = reinterpret_cast<const float*>(_data.data() + _pos);
+    const float* r = reinterpret_cast<const float*>(_data + _pos);
     _pos += sizeof(float);
     return marshall(*r);
 }
@@ -653,11 +674,11 @@ float NetworkDeserializer::readFloat() {
  * @return a single double value.
  */
 double NetworkDeserializer::readDouble() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0.0;
     }
     _pos++;
-    const double* r = reinterpret_cast<const double*>(_data.data() + _pos);
+    const double* r = reinterpret_cast<const double*>(_data + _pos);
     _pos += sizeof(double);
     return marshall(*r);
 }
@@ -674,11 +695,11 @@ double NetworkDeserializer::readDouble() {
  * @return a single unsigned (32 bit) int value.
  */
 Uint32 NetworkDeserializer::readUint32() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0;
     }
     _pos++;
-    const Uint32* r = reinterpret_cast<const Uint32*>(_data.data() + _pos);
+    const Uint32* r = reinterpret_cast<const Uint32*>(_data + _pos);
     _pos += sizeof(Uint32);
     return marshall(*r);
 }
@@ -695,11 +716,11 @@ Uint32 NetworkDeserializer::readUint32() {
  * @return a single signed (32 bit) int value.
  */
 Sint32 NetworkDeserializer::readSint32() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0;
     }
     _pos++;
-    const Sint32* r = reinterpret_cast<const Sint32*>(_data.data() + _pos);
+    const Sint32* r = reinterpret_cast<const Sint32*>(_data + _pos);
     _pos += sizeof(Sint32);
     return marshall(*r);
 }
@@ -716,11 +737,11 @@ Sint32 NetworkDeserializer::readSint32() {
  * @return a single unsigned (64 bit) int value.
  */
 Uint64 NetworkDeserializer::readUint64() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0;
     }
     _pos++;
-    const Uint64* r = reinterpret_cast<const Uint64*>(_data.data() + _pos);
+    const Uint64* r = reinterpret_cast<const Uint64*>(_data + _pos);
     _pos += sizeof(Uint64);
     return marshall(*r);
 }
@@ -737,11 +758,11 @@ Uint64 NetworkDeserializer::readUint64() {
  * @return a single signed (64 bit) int value.
  */
 Sint64 NetworkDeserializer::readSint64() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return 0;
     }
     _pos++;
-    const Sint64* r = reinterpret_cast<const Sint64*>(_data.data() + _pos);
+    const Sint64* r = reinterpret_cast<const Sint64*>(_data + _pos);
     _pos += sizeof(Sint64);
     return marshall(*r);
 }
@@ -758,7 +779,7 @@ Sint64 NetworkDeserializer::readSint64() {
  * @return a single string.
  */
 std::string NetworkDeserializer::readString() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return std::string();
     }
     _pos++;
@@ -782,7 +803,7 @@ std::string NetworkDeserializer::readString() {
  * @return a single {@link JsonValue} object.
  */
 std::shared_ptr<JsonValue> NetworkDeserializer::readJson() {
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return nullptr;
     }
     _pos++;
@@ -858,7 +879,7 @@ std::vector<bool> NetworkDeserializer::readBoolVector()  {
  */
 std::vector<float> NetworkDeserializer::readFloatVector() {
     std::vector<float> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -882,7 +903,7 @@ std::vector<float> NetworkDeserializer::readFloatVector() {
  */
 std::vector<double> NetworkDeserializer::readDoubleVector()     {
     std::vector<double> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -906,7 +927,7 @@ std::vector<double> NetworkDeserializer::readDoubleVector()     {
  */
 std::vector<Uint32> NetworkDeserializer::readUint32Vector() {
     std::vector<Uint32> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -930,7 +951,7 @@ std::vector<Uint32> NetworkDeserializer::readUint32Vector() {
  */
 std::vector<Sint32> NetworkDeserializer::readSint32Vector()  {
     std::vector<Sint32> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -954,7 +975,7 @@ std::vector<Sint32> NetworkDeserializer::readSint32Vector()  {
  */
 std::vector<Uint64> NetworkDeserializer::readUint64Vector() {
     std::vector<Uint64> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -978,7 +999,7 @@ std::vector<Uint64> NetworkDeserializer::readUint64Vector() {
  */
 std::vector<Sint64> NetworkDeserializer::readSint64Vector() {
     std::vector<Sint64> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -1002,7 +1023,7 @@ std::vector<Sint64> NetworkDeserializer::readSint64Vector() {
  */
 std::vector<std::string> NetworkDeserializer::readStringVector() {
     std::vector<std::string> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -1026,7 +1047,7 @@ std::vector<std::string> NetworkDeserializer::readStringVector() {
  */
 std::vector<std::shared_ptr<JsonValue>> NetworkDeserializer::readJsonVector() {
     std::vector<std::shared_ptr<JsonValue>> vv;
-    if (_pos >= _data.size()) {
+    if (_pos >= _size) {
         return vv;
     }
     _pos++;
@@ -1042,5 +1063,7 @@ std::vector<std::shared_ptr<JsonValue>> NetworkDeserializer::readJsonVector() {
  */
 void NetworkDeserializer::reset() {
 	_pos = 0;
-	_data.clear();
+	_size = 0;
+	_data = nullptr;
+	_buffer.clear();
 }
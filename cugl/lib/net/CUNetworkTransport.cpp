@@ -0,0 +1,246 @@
+//
+//  CUNetworkTransport.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides the datagram layer underneath NetworkConnection.  The
+//  connection handles rooms, player IDs and message relaying, while the
+//  transport only connects to addresses and moves packets between them.  The
+//  default transport is Slikenet with NAT punchthrough.  Other transports (such
+//  as LoopbackNetwork) allow the connection to run without a server.
+//
+//  Addresses and packets use the Slikenet types, so that the connection code
+//  is identical whatever the transport.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#include <cugl/net/CUNetworkTransport.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <WS2tcpip.h>
+#include <WinSock2.h>
+#include <fcntl.h>
+#pragma comment(lib, "ws2_32")
+#include <io.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#ifndef _SSIZE_T_DEFINED
+typedef int ssize_t;
+#define _SSIZE_T_DEFINED
+#endif
+#ifndef _SOCKET_T_DEFINED
+typedef SOCKET socket_t;
+#define _SOCKET_T_DEFINED
+#endif
+#endif
+
+#include <slikenet/peerinterface.h>
+#include <slikenet/NatPunchthroughClient.h>
+#include <slikenet/statistics.h>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Slikenet Transport
+/**
+ * Creates a transport that has not started.
+ */
+SLikeNetTransport::SLikeNetTransport() :
+_natPunchthroughClient(std::make_unique<SLNet::NatPunchthroughClient>()) {
+}
+
+/**
+ * Deletes this transport, closing all connections.
+ */
+SLikeNetTransport::~SLikeNetTransport() {
+    shutdown(0);
+}
+
+/**
+ * Starts the transport so that it can connect to other peers.
+ *
+ * @param maxConnections    The maximum number of connections
+ * @param timeout           The time in milliseconds before a silent peer is dropped
+ *
+ * @return true if the transport started successfully
+ */
+bool SLikeNetTransport::startup(unsigned int maxConnections, unsigned int timeout) {
+    if (_peer) {
+        return false;
+    }
+    _peer = std::unique_ptr<SLNet::RakPeerInterface>(SLNet::RakPeerInterface::GetInstance());
+    _peer->SetTimeoutTime(timeout, SLNet::UNASSIGNED_SYSTEM_ADDRESS);
+    _peer->AttachPlugin(_natPunchthroughClient.get());
+
+    // Use the default socket descriptor
+    // This will make the OS assign us a random port.
+    SLNet::SocketDescriptor socketDescriptor;
+    return _peer->Startup(maxConnections, &socketDescriptor, 1) == SLNet::RAKNET_STARTED;
+}
+
+/**
+ * Stops the transport, closing all connections.
+ *
+ * If block is positive, the transport waits up to that many milliseconds
+ * to notify other peers. Otherwise they see the connection as lost.
+ *
+ * @param block The time in milliseconds to wait for notifications
+ */
+void SLikeNetTransport::shutdown(unsigned int block) {
+    if (!_peer) {
+        return;
+    }
+    _peer->Shutdown(block);
+    _peer->DetachPlugin(_natPunchthroughClient.get());
+    SLNet::RakPeerInterface::DestroyInstance(_peer.release());
+}
+
+/**
+ * Sets the number of peers that may connect to this one.
+ *
+ * @param count The number of peers that may connect to this one
+ */
+void SLikeNetTransport::setMaximumIncomingConnections(unsigned short count) {
+    _peer->SetMaximumIncomingConnections(count);
+}
+
+/**
+ * Starts connecting to the given address.
+ *
+ * @param address   The address to connect to
+ */
+void SLikeNetTransport::connect(const SLNet::SystemAddress& address) {
+    _peer->Connect(address.ToString(false), address.GetPort(), nullptr, 0);
+}
+
+/**
+ * Closes the connection to the given address, notifying the other peer.
+ *
+ * @param address   The address to disconnect from
+ */
+void SLikeNetTransport::closeConnection(const SLNet::SystemAddress& address) {
+    _peer->CloseConnection(address, true);
+}
+
+/**
+ * Returns true if this transport is connected to the given address.
+ *
+ * @param address   The address to check
+ *
+ * @return true if this transport is connected to the given address.
+ */
+bool SLikeNetTransport::isConnected(const SLNet::SystemAddress& address) {
+    return _peer->GetConnectionState(address) == SLNet::IS_CONNECTED;
+}
+
+/**
+ * Returns the number of open connections.
+ *
+ * @return the number of open connections.
+ */
+unsigned short SLikeNetTransport::getNumberOfConnections() {
+    return _peer->NumberOfConnections();
+}
+
+/**
+ * Asks the punchthrough server to connect this peer to the host of a room.
+ *
+ * @param room      The room ID
+ * @param server    The address of the punchthrough server
+ */
+void SLikeNetTransport::openNAT(const std::string& room, const SLNet::SystemAddress& server) {
+    SLNet::RakNetGUID remote;
+    remote.FromString(room.c_str());
+    _natPunchthroughClient->OpenNAT(remote, server);
+}
+
+/**
+ * Sends a packet to the given address.
+ *
+ * If broadcast is true, the packet is instead sent to every connected peer
+ * except the given address.
+ *
+ * @param data          The packet
+ * @param size          The number of bytes in the packet
+ * @param reliability   The packet reliability
+ * @param address       The destination (or the peer to skip on broadcast)
+ * @param broadcast     Whether to send to every other connected peer
+ */
+void SLikeNetTransport::send(const uint8_t* data, size_t size, PacketReliability reliability,
+                             const SLNet::SystemAddress& address, bool broadcast) {
+    _peer->Send(reinterpret_cast<const char*>(data), (int)size, MEDIUM_PRIORITY,
+                reliability, 1, address, broadcast);
+}
+
+/**
+ * Returns the next received packet, or nullptr if there is none.
+ *
+ * Each packet must be returned with {@link #deallocatePacket}.
+ *
+ * @return the next received packet, or nullptr if there is none.
+ */
+SLNet::Packet* SLikeNetTransport::receive() {
+    return _peer->Receive();
+}
+
+/**
+ * Releases a packet returned by {@link #receive}.
+ *
+ * @param packet    The packet to release
+ */
+void SLikeNetTransport::deallocatePacket(SLNet::Packet* packet) {
+    _peer->DeallocatePacket(packet);
+}
+
+/**
+ * Stores the link statistics for the peer at the given address.
+ *
+ * @param address   The address of a connected peer
+ * @param stats     The statistics to write to
+ *
+ * @return true if the peer is connected
+ */
+bool SLikeNetTransport::getPeerStats(const SLNet::SystemAddress& address, PeerStats& stats) {
+    SLNet::RakNetStatistics rns;
+    if (!_peer || _peer->GetStatistics(address, &rns) == nullptr) {
+        return false;
+    }
+    stats.ping = _peer->GetAveragePing(address);
+    stats.lossLastSecond = rns.packetlossLastSecond;
+    stats.lossTotal = rns.packetlossTotal;
+    stats.bytesSent = rns.runningTotal[SLNet::ACTUAL_BYTES_SENT];
+    stats.bytesReceived = rns.runningTotal[SLNet::ACTUAL_BYTES_RECEIVED];
+    return true;
+}
+
+/**
+ * Returns a string identifying this peer, for debugging.
+ *
+ * @return a string identifying this peer, for debugging.
+ */
+std::string SLikeNetTransport::getGuid() {
+    return _peer->GetGuidFromSystemAddress(SLNet::UNASSIGNED_SYSTEM_ADDRESS).ToString();
+}
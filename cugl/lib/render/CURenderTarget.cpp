@@ -61,6 +61,12 @@ using namespace cugl;
  * @return true if initialization was successful.
  */
 bool RenderTarget::prepareBuffer() {
+    // Without a context, only the output textures are needed
+    if (Display::get()->isNullRenderer()) {
+        _depthst = Texture::alloc(_width,_height,Texture::PixelFormat::DEPTH_STENCIL);
+        return _depthst != nullptr;
+    }
+    
     glGetIntegerv(GL_VIEWPORT, _viewport);
     
     GLenum error;
@@ -133,6 +139,8 @@ bool RenderTarget::attachTexture(GLuint index, Texture::PixelFormat format) {
         dispose();
         Display::get()->restoreRenderTarget();
         return false;
+    } else if (!_framebo) {
+        return true;
     }
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+(GLint)index,
                            GL_TEXTURE_2D,  texture->getBuffer(), 0);
@@ -159,6 +167,9 @@ bool RenderTarget::attachTexture(GLuint index, Texture::PixelFormat format) {
  * @return true if the framebuffer was successfully finalized.
  */
 bool RenderTarget::completeBuffer() {
+    if (!_framebo) {
+        return true;
+    }
     glDrawBuffers((int)_outsize, _bindpoints.data());
     GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     if (status != GL_FRAMEBUFFER_COMPLETE) {
@@ -435,6 +446,9 @@ const std::shared_ptr<Texture>& RenderTarget::getTexture(size_t index) const {
  * return control to the default render target (the screen) when done.
  */
 void RenderTarget::begin() {
+    if (!_framebo) {
+        return;
+    }
     glGetIntegerv(GL_VIEWPORT, _viewport);
     glBindFramebuffer(GL_FRAMEBUFFER, _framebo);
     //glBindRenderbuffer(GL_RENDERBUFFER, _renderbo);
@@ -455,6 +469,9 @@ void RenderTarget::begin() {
  * return control to the default render target (the screen) when done.
  */
 void RenderTarget::end() {
+    if (!_framebo) {
+        return;
+    }
     Display::get()->restoreRenderTarget();
     glViewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]);
 }
@@ -7,6 +7,10 @@
 //  shader is general enough that it should not need to be subclassed.
 //  However, to use a shader, it must be attached to a VertexBuffer.
 //
+//  Without an OpenGL context (see Display::isNullRenderer), a shader keeps
+//  its sources but is never compiled. It is never bound, and it has no
+//  attributes, uniforms or uniform blocks.
+//
 //  CUGL MIT License:
 //      This software is provided 'as-is', without any express or implied
 //      warranty.  In no event will the authors be held liable for any damages
@@ -29,6 +33,7 @@
 //  Author: Walker White
 //  Version: 2/10/20
 
+#include <cugl/base/CUDisplay.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/util/CUStrings.h>
 #include <cugl/render/CUShader.h>
@@ -121,7 +126,7 @@ bool Shader::compile() {
  * You must reinitialize the shader to use it.
  */
 void Shader::dispose() {
-    glUseProgram(NULL);
+    if (_program) { glUseProgram(NULL); }
     if (_fragShader) { glDeleteShader(_fragShader); _fragShader = 0;}
     if (_vertShader) { glDeleteShader(_vertShader); _vertShader = 0;}
     if (_program) { glDeleteShader(_program); _program = 0;}
@@ -310,6 +315,8 @@ void Shader::cacheUniforms() {
  * bound.  However, any shader that was actively bound during compilation
  * also be unbound as well.
  *
+ * Without an OpenGL context, the shader only keeps the sources.
+ *
  * @param vsource   The source string for the vertex shader.
  * @param fsource   The source string for the fragment shader.
  *
@@ -318,6 +325,9 @@ void Shader::cacheUniforms() {
 bool Shader::init(const std::string vsource, const std::string fsource) {
     _vertSource = vsource;
     _fragSource = fsource;
+    if (Display::get()->isNullRenderer()) {
+        return true;
+    }
     if (!compile()) {
         return false;
     }
@@ -335,6 +345,9 @@ bool Shader::init(const std::string vsource, const std::string fsource) {
  * call is reentrant, and may safely be called on an active shader.
  */
 void Shader::bind() {
+    if (Display::get()->isNullRenderer()) {
+        return;
+    }
     CUAssertLog(_program, "Shader has not been initialized.");
     glUseProgram( _program );
 }
@@ -345,6 +358,9 @@ void Shader::bind() {
  * Once unbound, OpenGL calls will no longer be sent to this shader.
  */
 void Shader::unbind() {
+    if (Display::get()->isNullRenderer()) {
+        return;
+    }
     CUAssertLog(_program, "Shader has not been initialized.");
     if (isBound()) {
         glUseProgram( NULL );
@@ -359,6 +375,9 @@ void Shader::unbind() {
  * @return true if this shader is currently bound.
  */
 bool Shader::isBound() const {
+    if (!_program) {
+        return false;
+    }
     GLint prog;
     glGetIntegerv(GL_CURRENT_PROGRAM,&prog);
     return prog == _program;
@@ -390,6 +409,9 @@ std::vector<std::string> Shader::getAttributes() const {
  * @return the program offset of the given attribute
  */
 GLint Shader::getAttributeLocation(const std::string name) const {
+    if (!_program) {
+        return -1;
+    }
     return glGetAttribLocation(_program,name.c_str());
 }
 
@@ -447,6 +469,9 @@ GLenum Shader::getAttributeType(const std::string name) const  {
  * @return the program offset of the given output variable.
  */
 GLint Shader::getOutputLocation(const std::string name) const {
+    if (!_program) {
+        return -1;
+    }
     return glGetFragDataLocation(_program, name.c_str());
 }
 
@@ -476,6 +501,9 @@ std::vector<std::string> Shader::getUniforms() const {
  * @return the program offset of the given uniform
  */
 GLint Shader::getUniformLocation(const std::string name) const {
+    if (!_program) {
+        return -1;
+    }
     return glGetUniformLocation(_program,name.c_str());
 }
 
@@ -549,6 +577,9 @@ std::vector<std::string> Shader::getSamplers() const {
  * @return the program offset of the given sampler variable
  */
 GLint Shader::getSamplerLocation(const std::string name) const {
+    if (!_program) {
+        return -1;
+    }
     GLint result =  glGetUniformLocation(_program,name.c_str());
     if (result != -1 && _uniformtypes.at(name) != GL_SAMPLER_2D) {
         result = -1;
@@ -731,6 +762,9 @@ std::vector<std::string> Shader::getUniformsForBlock(GLint pos) const {
  */
 std::vector<std::string> Shader::getUniformsForBlock(std::string name) const {
     std::vector<std::string> result;
+    if (!_program) {
+        return result;
+    }
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index == GL_INVALID_INDEX) {
         return result;
@@ -774,6 +808,9 @@ void Shader::setUniformBlock(GLint pos, GLuint bindpoint) {
  * @param bpoint   The bindpoint for the uniform block
  */
 void Shader::setUniformBlock(const std::string name, GLuint bindpoint) {
+    if (!_program) {
+        return;
+    }
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index != GL_INVALID_INDEX) {
         glUniformBlockBinding(_program, index, bindpoint);
@@ -852,6 +889,9 @@ void Shader::setUniformBlock(GLint pos, const std::shared_ptr<UniformBuffer>& bu
  */
 void Shader::setUniformBlock(const std::string name,
                              const std::shared_ptr<UniformBuffer>& buffer) {
+    if (!_program) {
+        return;
+    }
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index != GL_INVALID_INDEX) {
         setUniformBlock(index, buffer);
@@ -887,6 +927,9 @@ GLuint Shader::getUniformBlock(GLint pos) const {
  * @return the buffer bindpoint associated with the given uniform block.
  */
 GLuint Shader::getUniformBlock(const std::string name) const {
+    if (!_program) {
+        return 0;
+    }
     GLuint index = glGetUniformBlockIndex(_program, name.c_str());
     if (index == GL_INVALID_INDEX) {
         return 0;
@@ -32,6 +32,7 @@
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <sstream>
+#include <cugl/base/CUDisplay.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/util/CUFiletools.h>
 #include <cugl/render/CUTexture.h>
@@ -51,6 +52,18 @@ static unsigned char cu_2x2_white_image[] = {
     0xFF, 0xFF, 0xFF, 0xFF
 };
 
+/** The number of texture slots emulated without an OpenGL context */
+#define NULL_TEXTURE_SLOTS 32
+
+/** The last buffer id assigned without an OpenGL context */
+static GLuint null_texture_id = 0;
+
+/** The active texture slot without an OpenGL context */
+static GLuint null_active_slot = 0;
+
+/** The buffer bound to each texture slot without an OpenGL context */
+static GLuint null_bound_ids[NULL_TEXTURE_SLOTS] = { 0 };
+
 /**
  * Returns the internal format for the pixel format
  *
@@ -183,7 +196,8 @@ _minS(0),
 _maxS(1),
 _minT(0),
 _maxT(1),
-_dirty(false) {}
+_dirty(false),
+_nullbuffer(false) {}
 
 /**
  * Deletes the OpenGL texture and resets all attributes.
@@ -193,7 +207,13 @@ _dirty(false) {}
 void Texture::dispose() {
     if (_buffer != 0) {
         // Do we own the texture?
-        if (_parent == nullptr) {
+        if (_parent == nullptr && _nullbuffer) {
+            for(int ii = 0; ii < NULL_TEXTURE_SLOTS; ii++) {
+                if (null_bound_ids[ii] == _buffer) {
+                    null_bound_ids[ii] = 0;
+                }
+            }
+        } else if (_parent == nullptr) {
             glDeleteTextures(1, &_buffer);
         }
         _buffer = 0;
@@ -208,6 +228,7 @@ void Texture::dispose() {
         _hasMipmaps = false;
         _bindpoint  = 0;
         _dirty = false;
+        _nullbuffer = false;
     }
 }
 
@@ -238,6 +259,19 @@ bool Texture::initWithData(const void *data, int width, int height, Texture::Pix
         return false; // In case asserts are off.
     }
     
+    // Without a context, the texture is just metadata
+    if (Display::get()->isNullRenderer()) {
+        _buffer = ++null_texture_id;
+        _nullbuffer = true;
+        _width  = width;
+        _height = height;
+        _pixelFormat = format;
+        std::stringstream ss;
+        ss << "@" << data;
+        setName(ss.str());
+        return true;
+    }
+    
     glGenTextures(1, &_buffer);
     if (_buffer == 0) {
         error = glGetError();
@@ -366,6 +400,8 @@ const Texture& Texture::set(const void *data) {
     if (!isActive()) {
         CUAssertLog(false,"Texture %s is not currently active.",_name.c_str());
         return *this;
+    } else if (_nullbuffer) {
+        return *this;
     }
 
     glTexImage2D(GL_TEXTURE_2D, 0, (GLenum)_pixelFormat, _width, _height, 0,
@@ -418,7 +454,9 @@ void Texture::buildMipMaps() {
     CUAssertLog(nextPOT(_height) == _height, "Height %d is not a power of two", _height);
     CUAssertLog(_parent == nullptr, "Cannot build mipmaps for a subtexture");
     CUAssertLog(isActive(), "Texture is not active");
-    glGenerateMipmap(GL_TEXTURE_2D);
+    if (!_nullbuffer) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     _hasMipmaps = true;
 }
 
@@ -439,7 +477,7 @@ void Texture::buildMipMaps() {
 void Texture::setMinFilter(GLuint minFilter) {
     CUAssertLog(_parent == nullptr, "Cannot set filters for a subtexture");
     _minFilter = minFilter;
-    if (isActive()) {
+    if (isActive() && !_nullbuffer) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _minFilter);
     } else {
     	_dirty = true;
@@ -463,7 +501,7 @@ void Texture::setMinFilter(GLuint minFilter) {
 void Texture::setMagFilter(GLuint magFilter) {
     CUAssertLog(_parent == nullptr, "Cannot set filters for a subtexture");
     _magFilter = magFilter;
-    if (isActive()) {
+    if (isActive() && !_nullbuffer) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _magFilter);
 	} else {
     	_dirty = true;
@@ -486,7 +524,7 @@ void Texture::setMagFilter(GLuint magFilter) {
 void Texture::setWrapS(GLuint wrap) {
     CUAssertLog(_parent == nullptr, "Cannot set wrap S for a subtexture");
     _wrapS = wrap;
-    if (isActive()) {
+    if (isActive() && !_nullbuffer) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _wrapS);
 	} else {
     	_dirty = true;
@@ -509,7 +547,7 @@ void Texture::setWrapS(GLuint wrap) {
 void Texture::setWrapT(GLuint wrap) {
     CUAssertLog(_parent == nullptr, "Cannot set wrap T for a subtexture");
     _wrapT = wrap;
-    if (isActive()) {
+    if (isActive() && !_nullbuffer) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _wrapT);
 	} else {
     	_dirty = true;
@@ -559,6 +597,7 @@ std::shared_ptr<Texture> Texture::getSubTexture(GLfloat minS, GLfloat maxS,
     result->_parent = source;
     result->_pixelFormat = source->_pixelFormat;
     result->_name = source->_name;
+    result->_nullbuffer = source->_nullbuffer;
     
     // Filters, wrap, and binding defer to parent.
     // These values can be left alone.
@@ -593,6 +632,14 @@ std::shared_ptr<Texture> Texture::getSubTexture(GLfloat minS, GLfloat maxS,
  * @param the texture location to associate with this texture.
  */
 void Texture::setBindPoint(GLuint point) {
+    if (_nullbuffer) {
+        CUAssertLog(point < NULL_TEXTURE_SLOTS, "Bind point %d is invalid", point);
+        if (null_bound_ids[_bindpoint] == _buffer) {
+            null_bound_ids[_bindpoint] = 0;
+        }
+        _bindpoint = point;
+        return;
+    }
     GLint orig;
     glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
     if (orig != _bindpoint+GL_TEXTURE0) {
@@ -631,6 +678,11 @@ void Texture::bind() {
     if (_parent != nullptr) {
         _parent->bind();
         return;
+    } else if (_nullbuffer) {
+        null_active_slot = _bindpoint;
+        null_bound_ids[_bindpoint] = _buffer;
+        _dirty = false;
+        return;
     }
     
     glActiveTexture(GL_TEXTURE0+_bindpoint);
@@ -659,6 +711,9 @@ void Texture::unbind() {
     if (_parent != nullptr) {
         _parent->unbind();
         return;
+    } else if (_nullbuffer) {
+        null_bound_ids[_bindpoint] = 0;
+        return;
     }
 
     GLint orig;
@@ -688,6 +743,8 @@ void Texture::unbind() {
 bool Texture::isBound() const {
     if (!_buffer) {
         return false;
+    } else if (_nullbuffer) {
+        return null_bound_ids[_bindpoint] == _buffer;
     }
     
     GLint orig;
@@ -720,6 +777,9 @@ bool Texture::isBound() const {
 bool Texture::isActive() const {
     if (!_buffer) {
         return false;
+    } else if (_nullbuffer) {
+        return (null_active_slot == _bindpoint &&
+                null_bound_ids[_bindpoint] == _buffer);
     }
     GLint orig;
     glGetIntegerv(GL_ACTIVE_TEXTURE,&orig);
@@ -785,6 +845,9 @@ bool Texture::save(const std::string file) {
     } else if (!filetool::is_absolute(file)) {
         CUAssertLog(false, "Data may not be saved to the asset directory.");
         return false;
+    } else if (_nullbuffer) {
+        CULogError("Texture %s has no pixel data to save.", _name.c_str());
+        return false;
     }
 
     // Make sure file is named properly.
@@ -42,6 +42,7 @@
 //
 //  Author: Walker White
 //  Version: 2/29/20
+#include <cugl/base/CUDisplay.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/render/CUUniformBuffer.h>
 
@@ -115,6 +116,13 @@ bool UniformBuffer::init(GLsizei capacity, GLuint blocks) {
     _blockcount = blocks;
     _blocksize = capacity;
     
+    // Without a context, keep the blocks on the CPU with a std140 alignment
+    if (Display::get()->isNullRenderer()) {
+        _blockstride = (_blocksize+15) & ~15;
+        _bytebuffer = (char*)malloc(_blockstride*_blockcount);
+        return true;
+    }
+    
     GLint value;
     glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
     while (_blockstride < _blocksize) {
@@ -198,6 +206,10 @@ void UniformBuffer::dispose() {
  * @param point The bind point for for this uniform buffer.
  */
 void UniformBuffer::setBindPoint(GLuint point) {
+    if (!_dataBuffer) {
+        _bindpoint = point;
+        return;
+    }
     GLint bound;
     glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING,_bindpoint,&bound);
     if (bound == _dataBuffer) {
@@ -230,6 +242,9 @@ void UniformBuffer::bind(bool activate) {
     if (activate) {
         this->activate();
     }
+    if (!_dataBuffer) {
+        return;
+    }
     glBindBufferBase(GL_UNIFORM_BUFFER, _bindpoint, _dataBuffer);
 }
 
@@ -247,6 +262,9 @@ void UniformBuffer::bind(bool activate) {
  * This call is reentrant.  If can be safely called multiple times.
  */
 void UniformBuffer::unbind() {
+    if (!_dataBuffer) {
+        return;
+    }
     GLint bound;
     glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING,_bindpoint,&bound);
     if (bound == _dataBuffer) {
@@ -269,6 +287,9 @@ void UniformBuffer::unbind() {
  * This call is reentrant.  If can be safely called multiple times.
  */
 void UniformBuffer::activate() {
+    if (!_dataBuffer) {
+        return;
+    }
     glBindBuffer(GL_UNIFORM_BUFFER, _dataBuffer);
     if (_autoflush && _dirty) {
         glBufferData(GL_UNIFORM_BUFFER,_blockstride*_blockcount,_bytebuffer,_drawtype);
@@ -288,6 +309,9 @@ void UniformBuffer::activate() {
  * This call is reentrant.  If can be safely called multiple times.
  */
 void UniformBuffer::deactivate() {
+    if (!_dataBuffer) {
+        return;
+    }
 #if CU_PLATFORM == CU_PLATFORM_ANDROID
  	// There are problems with this query on emulator
  	glBindBuffer(GL_UNIFORM_BUFFER, 0);
@@ -310,6 +334,9 @@ void UniformBuffer::deactivate() {
  * @return true if this uniform block is currently bound.
  */
 bool UniformBuffer::isBound() const {
+    if (!_dataBuffer) {
+        return false;
+    }
     GLint bound;
     glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING,_bindpoint,&bound);
     return bound == _dataBuffer;
@@ -329,6 +356,9 @@ bool UniformBuffer::isBound() const {
  * @return true if this uniform block is currently active.
  */
 bool UniformBuffer::isActive() const {
+    if (!_dataBuffer) {
+        return false;
+    }
     GLint bound;
     glGetIntegerv(GL_UNIFORM_BUFFER_BINDING,&bound);
     return bound == _dataBuffer;
@@ -344,9 +374,12 @@ bool UniformBuffer::isActive() const {
  * @param block The active uniform block in this buffer.
  */
 void UniformBuffer::setBlock(GLuint block) {
-    CUAssertLog(isBound(), "Buffer is not bound.");
+    CUAssertLog(!_dataBuffer || isBound(), "Buffer is not bound.");
     if (_blockpntr != block) {
         _blockpntr = block;
+        if (!_dataBuffer) {
+            return;
+        }
         glBindBufferRange(GL_UNIFORM_BUFFER,_bindpoint,_dataBuffer,
                           block*_blockstride,_blocksize);
     }
@@ -362,7 +395,9 @@ void UniformBuffer::setBlock(GLuint block) {
  */
 void UniformBuffer::flush() {
     // CUAssertLog(isActive(), "Buffer is not active."); // Problems on android emulator for now
-    glBufferData(GL_UNIFORM_BUFFER,_blockstride*_blockcount,_bytebuffer,_drawtype);
+    if (_dataBuffer) {
+        glBufferData(GL_UNIFORM_BUFFER,_blockstride*_blockcount,_bytebuffer,_drawtype);
+    }
     _dirty = false;
 }
 
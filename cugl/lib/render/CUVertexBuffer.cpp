@@ -29,6 +29,7 @@
 //
 //  Author: Walker White
 //  Version: 2/10/20
+#include <cugl/base/CUDisplay.h>
 #include <cugl/util/CUDebug.h>
 #include <cugl/render/CUVertexBuffer.h>
 #include <cugl/render/CUShader.h>
@@ -74,6 +75,9 @@ VertexBuffer::~VertexBuffer() {
  */
 bool VertexBuffer::init(GLsizei stride) {
     _stride = stride;
+    if (Display::get()->isNullRenderer()) {
+        return true;
+    }
     glGenVertexArrays (1, &_vertArray);
     if (!_vertArray) {
         GLenum error = glGetError();
@@ -108,14 +112,13 @@ bool VertexBuffer::init(GLsizei stride) {
  * You must reinitialize the vertex buffer to use it.
  */
 void VertexBuffer::dispose() {
-    if (!_vertBuffer) {
-        return;
+    if (_vertBuffer) {
+        glDeleteBuffers(1,&_indxBuffer);
+        glDeleteBuffers(1,&_vertBuffer);
+        glDeleteVertexArrays(1,&_vertArray);
     }
     _enabled.clear();
     _attributes.clear();
-    glDeleteBuffers(1,&_indxBuffer);
-    glDeleteBuffers(1,&_vertBuffer);
-    glDeleteVertexArrays(1,&_vertArray);
     _indxBuffer = 0;
     _vertBuffer = 0;
     _vertArray  = 0;
@@ -138,6 +141,9 @@ void VertexBuffer::dispose() {
  * as well.
  */
 void VertexBuffer::bind() {
+    if (Display::get()->isNullRenderer()) {
+        return;
+    }
     CUAssertLog(_vertBuffer, "VertexBuffer has not be initialized.");
     glBindVertexArray(_vertArray);
 	glBindBuffer( GL_ARRAY_BUFFER, _vertBuffer );
@@ -178,7 +184,9 @@ void VertexBuffer::unbind() {
  */
 void VertexBuffer::attach(const std::shared_ptr<Shader>& shader) {
     CUAssertLog(shader, "Attempting to attach a null shader");
-    if (_shader != shader) {
+    if (Display::get()->isNullRenderer()) {
+        _shader = shader;
+    } else if (_shader != shader) {
         _shader = shader;
         bind();
         
@@ -225,6 +233,9 @@ std::shared_ptr<Shader> VertexBuffer::detach() {
  * @return true if this vertex is currently bound.
  */
 bool VertexBuffer::isBound() const {
+    if (!_vertArray) {
+        return false;
+    }
     GLint vao;
     glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
     return vao == _vertArray;
@@ -260,6 +271,9 @@ bool VertexBuffer::isBound() const {
  */
 void VertexBuffer::loadVertexData(const void * data, GLsizei size, GLenum usage) {
     //CUAssertLog(isBound(), "Vertex buffer is not bound"); // Problems on android emulator for now
+    if (!_vertBuffer) {
+        return;
+    }
     glBufferData( GL_ARRAY_BUFFER, _stride * size, data, usage );
     
     GLenum error = glGetError();
@@ -294,6 +308,9 @@ void VertexBuffer::loadVertexData(const void * data, GLsizei size, GLenum usage)
  */
 void VertexBuffer::loadIndexData(const void * data, GLsizei size, GLenum usage) {
     //CUAssertLog(isBound(), "Vertex buffer is not bound"); // Problems on android emulator for now
+    if (!_indxBuffer) {
+        return;
+    }
     glBufferData( GL_ELEMENT_ARRAY_BUFFER, size * sizeof(GLuint), data, usage );
     GLenum error = glGetError();
     CUAssertLog(error == GL_NO_ERROR, "VertexBuffer: %s", gl_error_name(error).c_str());
@@ -322,6 +339,9 @@ void VertexBuffer::loadIndexData(const void * data, GLsizei size, GLenum usage)
  */
 void VertexBuffer::draw(GLenum mode, GLsizei count, GLsizei offset) {
     //CUAssertLog(isBound(), "Vertex buffer is not bound"); // Problems on android emulator for now
+    if (!_vertArray) {
+        return;
+    }
     glDrawElements(mode, count, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)));
 }
 
@@ -356,6 +376,9 @@ void VertexBuffer::draw(GLenum mode, GLsizei count, GLsizei offset) {
  */
 void VertexBuffer::drawInstanced(GLenum mode, GLsizei count, GLsizei instance, GLsizei offset) {
     //CUAssertLog(isBound(), "Vertex buffer is not bound"); // Problems on android emulator for now
+    if (!_vertArray) {
+        return;
+    }
     glDrawElementsInstanced(mode, count, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)), instance);
 }
 
@@ -390,7 +413,7 @@ void VertexBuffer::setupAttribute(const std::string name, GLint size, GLenum typ
     _attributes[name] = data;
     _enabled[name] = true;
     
-    if (_shader != nullptr) {
+    if (_shader != nullptr && _vertArray) {
         _shader->bind();
         GLint pos = glGetAttribLocation(_shader->getProgram(), name.c_str());
         if (pos == -1) {
@@ -418,10 +441,10 @@ void VertexBuffer::setupAttribute(const std::string name, GLint size, GLenum typ
 void VertexBuffer::enableAttribute(const std::string name) {
 	CUAssertLog(_enabled.find(name) != _enabled.end(),
                 "Vertex buffer has no attribute %s", name.c_str());
-    CUAssertLog(isBound(), "Vertex buffer is not bound.");
+    CUAssertLog(!_vertArray || isBound(), "Vertex buffer is not bound.");
 	if (!_enabled[name]) {
 		_enabled[name] = true;
-		if (_shader != nullptr) {
+		if (_shader != nullptr && _vertArray) {
 			GLint locale = _shader->getUniformLocation(name);
 			glEnableVertexAttribArray(locale);
 		}
@@ -440,10 +463,10 @@ void VertexBuffer::enableAttribute(const std::string name) {
 void VertexBuffer::disableAttribute(const std::string name) {
 	CUAssertLog(_enabled.find(name) != _enabled.end(),
                 "Vertex buffer has no attribute %s", name.c_str());
-    CUAssertLog(isBound(), "Vertex buffer is not bound.");
+    CUAssertLog(!_vertArray || isBound(), "Vertex buffer is not bound.");
 	if (_enabled[name]) {
 		_enabled[name] = false;
-		if (_shader != nullptr) {
+		if (_shader != nullptr && _vertArray) {
 			GLint locale = _shader->getUniformLocation(name);
 			glDisableVertexAttribArray(locale);
 		}
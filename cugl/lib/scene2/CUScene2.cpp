@@ -41,6 +41,7 @@
 
 #include <cugl/scene2/CUScene2.h>
 #include <cugl/util/CUStrings.h>
+#include <cugl/util/CUProfiler.h>
 #include <sstream>
 #include <algorithm>
 
@@ -366,6 +367,7 @@ void Scene2::removeAllChildren() {
  * @param batch     The SpriteBatch to draw with.
  */
 void Scene2::render(const std::shared_ptr<SpriteBatch>& batch) {
+    CU_PROFILE_SCOPE("Scene2::render");
     batch->begin(_camera->getCombined());
     batch->setSrcBlendFunc(_srcFactor);
     batch->setDstBlendFunc(_dstFactor);
@@ -290,8 +290,8 @@ bool OrderedNode::initWithData(const Scene2Loader* loader, const std::shared_ptr
 void OrderedNode::visit(const std::shared_ptr<SceneNode>& node, const Affine2& transform, Color4 tint) {
     if (!node->isVisible()) { return; }
 
-    Affine2 matrix;
-    Affine2::multiply(node->getTransform(),transform,&matrix);
+    Affine2 local;
+    const Affine2& matrix = node->getRenderTransform(transform,local);
     Color4 color = node->getColor();
     if (node->hasRelativeColor()) {
         color *= tint;
@@ -361,8 +361,8 @@ void OrderedNode::render(const std::shared_ptr<SpriteBatch>& batch, const Affine
         // Drop to standard for efficiency
         SceneNode::render(batch,transform,tint);
     } else {
-        Affine2 matrix;
-        Affine2::multiply(_combined,transform,&matrix);
+        Affine2 local;
+        const Affine2& matrix = getRenderTransform(transform,local);
         Color4 color = _tintColor;
         if (_hasParentColor) {
             color *= tint;
@@ -66,6 +66,7 @@ _anchor(Vec2::ANCHOR_BOTTOM_LEFT),
 _scale(Vec2::ONE),
 _angle(0),
 _useTransform(false),
+_worldDirty(true),
 _parent(nullptr),
 _graph(nullptr),
 _childOffset(-2),
@@ -266,6 +267,7 @@ void SceneNode::dispose() {
     _transform = Affine2::IDENTITY;
     _useTransform = false;
     _combined = Affine2::IDENTITY;
+    _worldDirty = true;
     _parent = nullptr;
     _graph = nullptr;
     _childOffset = -2;
@@ -299,6 +301,7 @@ std::shared_ptr<SceneNode> SceneNode::copy(const std::shared_ptr<SceneNode>& dst
     dst->_transform = _transform;
     dst->_useTransform = _useTransform;
     dst->_combined = _combined;
+    dst->markWorldDirty();
     dst->_tag = _tag;
     dst->_name = _name;
     dst->_hashOfName = _hashOfName;
@@ -325,6 +328,7 @@ void SceneNode::setPosition(float x, float y) {
     _combined.m[4] += (x-_position.x);
     _combined.m[5] += (y-_position.y);
     _position.set(x,y);
+    markWorldDirty();
 }
 
 /**
@@ -419,20 +423,24 @@ Size SceneNode::getSize() const {
 }
 
 /**
- * Returns the matrix transforming node space to world space.
+ * Returns the cached node to world transform, refreshing it if necessary.
  *
  * This matrix is used to convert node coordinates into OpenGL coordinates.
  * It is the recursive (left-multiplied) transforms of all of its descendents.
  *
- * @return the matrix transforming node space to world space.
+ * @return the cached node to world transform.
  */
-Affine2 SceneNode::getNodeToWorldTransform() const {
-    Affine2 result = _combined;
-    if (_parent) {
-        // Multiply on left
-        Affine2::multiply(result,_parent->getNodeToWorldTransform(),&result);
+const Affine2& SceneNode::getWorldTransform() const {
+    if (_worldDirty) {
+        if (_parent) {
+            // Multiply on left
+            Affine2::multiply(_combined,_parent->getWorldTransform(),&_worldTransform);
+        } else {
+            _worldTransform = _combined;
+        }
+        _worldDirty = false;
     }
-    return result;
+    return _worldTransform;
 }
 
 /**
@@ -501,6 +509,23 @@ void SceneNode::updateTransform() {
         _combined.m[4] += _position.x-offset.x;
         _combined.m[5] += _position.y-offset.y;
      }
+    markWorldDirty();
+}
+
+/**
+ * Marks the cached world transform of this node and its descendants dirty.
+ *
+ * The recursion stops at any node that is already dirty, as all of its
+ * descendants are guaranteed to be dirty as well.
+ */
+void SceneNode::markWorldDirty() {
+    if (_worldDirty) {
+        return;
+    }
+    _worldDirty = true;
+    for(auto it = _children.begin(); it != _children.end(); ++it) {
+        (*it)->markWorldDirty();
+    }
 }
 
 
@@ -765,6 +790,12 @@ void SceneNode::doLayout() {
  * transform of this Node.  In addition, if hasRelativeColor() is true, it
  * will blend the Node color with the given tint.
  *
+ * If the transform is the cached world transform of the parent (or the
+ * identity for a node at the top of a scene), this method uses and refreshes
+ * the cached world transform of this node instead of computing a new one.
+ * Children are then passed that cached matrix, so an unchanged scene graph
+ * does not perform any matrix multiplications at all.
+ *
  * @param batch     The SpriteBatch to draw with.
  * @param matrix    The global transformation matrix.
  * @param tint      The tint to blend with the Node color.
@@ -772,8 +803,9 @@ void SceneNode::doLayout() {
 void SceneNode::render(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) {
     if (!_isVisible) { return; }
     
-    Affine2 matrix;
-    Affine2::multiply(_combined,transform,&matrix);
+    Affine2 local;
+    const Affine2& matrix = getRenderTransform(transform,local);
+    bool cached = &matrix == &_worldTransform;
     Color4 color = _tintColor;
     if (_hasParentColor) {
         color *= tint;
@@ -790,8 +822,14 @@ void SceneNode::render(const std::shared_ptr<SpriteBatch>& batch, const Affine2&
     }
 
     draw(batch,matrix,color);
+    if (cached && _worldDirty) {
+        // The node moved while drawing, so the children cannot trust the cache
+        local = _worldTransform;
+        cached = false;
+    }
+    const Affine2& parent = cached ? _worldTransform : local;
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->render(batch, matrix, color);
+        (*it)->render(batch, parent, color);
     }
 
     if (_scissor) {
@@ -799,6 +837,35 @@ void SceneNode::render(const std::shared_ptr<SpriteBatch>& batch, const Affine2&
     }
 }
 
+/**
+ * Returns the node to world transform to render this node with.
+ *
+ * If transform is the cached world transform of the parent (or the
+ * identity for a node at the top of a scene), this method refreshes and
+ * returns the cached world transform of this node. Passing that to the
+ * children lets them use their caches too. Any other transform is
+ * multiplied into local, and local is returned.
+ *
+ * @param transform The global transformation matrix of the parent.
+ * @param local     The matrix to use if the cache cannot be.
+ *
+ * @return the node to world transform to render this node with.
+ */
+const Affine2& SceneNode::getRenderTransform(const Affine2& transform, Affine2& local) const {
+    // Compare addresses, as only our own caches are known to be up to date
+    bool cached = (_parent == nullptr ? &transform == &Affine2::IDENTITY
+                                      : &transform == &_parent->_worldTransform);
+    if (!cached) {
+        Affine2::multiply(_combined,transform,&local);
+        return local;
+    }
+    if (_worldDirty) {
+        Affine2::multiply(_combined,transform,&_worldTransform);
+        _worldDirty = false;
+    }
+    return _worldTransform;
+}
+
 /**
  * Returns the absolute color tinting this node.
  *
@@ -1083,8 +1083,8 @@ void ScrollPane::resetPane() {
 void ScrollPane::render(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) {
     if (!_isVisible) { return; }
     
-    Affine2 matrix;
-    Affine2::multiply(_combined,transform,&matrix);
+    Affine2 local;
+    const Affine2& matrix = getRenderTransform(transform,local);
     Color4 color = _tintColor;
     if (_hasParentColor) {
         color *= tint;
@@ -1108,9 +1108,11 @@ void ScrollPane::render(const std::shared_ptr<SpriteBatch>& batch, const Affine2
     }
 
     draw(batch,matrix,color);
-    Affine2::multiply(_panetrans,matrix,&matrix);
+    // The pane transform is not part of the world transform of the children
+    Affine2 panned;
+    Affine2::multiply(_panetrans,matrix,&panned);
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->render(batch, matrix, color);
+        (*it)->render(batch, panned, color);
     }
 
     if (_scissor) {
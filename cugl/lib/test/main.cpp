@@ -15,7 +15,9 @@
 #include "TCUMathTest.h"
 #include "TCU2DTest.h"
 
+#ifdef __APPLE__
 #include <Accelerate/Accelerate.h>
+#endif
 
 void testBinary() {
     CULog("Writing to File");
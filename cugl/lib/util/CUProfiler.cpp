@@ -0,0 +1,384 @@
+//
+//  CUProfiler.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  Module for lightweight frame instrumentation.  Code is measured by placing
+//  a named scope around it with the macro CU_PROFILE_SCOPE.  Each scope is
+//  recorded as a single event in a fixed-size ring buffer owned by the thread
+//  that executed it, so recording never locks and never allocates.  The events
+//  may be summarized once a frame for a debug overlay, or written out in the
+//  Chrome trace format (chrome://tracing or https://ui.perfetto.dev).
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Version: 10/18/26
+//
+#include <cugl/util/CUProfiler.h>
+#include <cugl/util/CUDebug.h>
+#include <cugl/io/CUTextWriter.h>
+#include <SDL/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Thread Buffers
+
+namespace {
+
+/**
+ * The ring buffer of events for a single thread.
+ *
+ * Only the owning thread writes events or advances the head.  Other threads
+ * may read the buffer, using the head to tell which events are complete.
+ */
+class ThreadBuffer {
+public:
+    /** The SDL id of the owning thread */
+    SDL_threadID tid;
+    /** The number of scopes currently open on the owning thread */
+    Uint32 depth;
+    /** The head at the last frame mark */
+    Uint64 mark;
+    /** The total number of events ever recorded (mod BUFFER_SIZE is the next slot) */
+    std::atomic<Uint64> head;
+    /** Whether the owning thread has exited */
+    bool retired;
+    /** The event storage */
+    Profiler::Event events[Profiler::BUFFER_SIZE];
+
+    ThreadBuffer() : tid(SDL_ThreadID()), depth(0), mark(0), head(0), retired(false) {}
+};
+
+/** Guards the list of buffers (but not the buffers themselves) */
+std::mutex _buffersMutex;
+/** The buffers of every thread that has recorded an event */
+std::vector<ThreadBuffer*> _buffers;
+/** The number of times every buffer has been released */
+std::atomic<Uint32> _generation(0);
+
+/**
+ * The buffer of a single thread, which retires it when the thread exits.
+ */
+class LocalBuffer {
+public:
+    /** The buffer of this thread, or nullptr if it has none */
+    ThreadBuffer* buffer;
+    /** The generation the buffer was created in */
+    Uint32 generation;
+
+    LocalBuffer() : buffer(nullptr), generation(0) {}
+
+    ~LocalBuffer() {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        // A released buffer is gone, so only a current one can be retired
+        if (buffer != nullptr && generation == _generation.load()) {
+            buffer->retired = true;
+        }
+    }
+};
+
+/** The buffer of the current thread */
+thread_local LocalBuffer _localBuffer;
+
+/** The scopes of the last frame */
+std::vector<Profiler::Stat> _frameStats;
+/** The time of the last frame mark */
+Uint64 _lastMark = 0;
+/** The length of the last frame */
+Uint64 _frameTime = 0;
+
+/**
+ * Returns the buffer for the current thread, creating it if necessary.
+ *
+ * @return the buffer for the current thread.
+ */
+ThreadBuffer* localBuffer() {
+    Uint32 generation = _generation.load();
+    if (_localBuffer.buffer == nullptr || _localBuffer.generation != generation) {
+        _localBuffer.buffer = new ThreadBuffer();
+        _localBuffer.generation = generation;
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        _buffers.push_back(_localBuffer.buffer);
+    }
+    return _localBuffer.buffer;
+}
+
+/**
+ * Writes the given event name as a JSON string, escaping as necessary.
+ *
+ * @param writer    The text writer
+ * @param name      The event name
+ */
+void writeName(const std::shared_ptr<TextWriter>& writer, const char* name) {
+    writer->write('"');
+    for (const char* c = name; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            writer->write('\\');
+        }
+        writer->write(*c);
+    }
+    writer->write('"');
+}
+
+}
+
+std::atomic<bool> Profiler::_enabled(false);
+
+#pragma mark -
+#pragma mark Recording
+/**
+ * Returns the current time in nanoseconds.
+ *
+ * The time is measured from an arbitrary fixed point using the steady
+ * clock, and is only meaningful relative to other profiler times.
+ *
+ * @return the current time in nanoseconds.
+ */
+Uint64 Profiler::now() {
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+/**
+ * Opens a scope on the current thread, returning its nesting depth.
+ *
+ * This method should only be called by {@link ProfileScope}.
+ *
+ * @return the nesting depth of the new scope.
+ */
+Uint32 Profiler::push() {
+    return localBuffer()->depth++;
+}
+
+/**
+ * Closes a scope on the current thread, recording it as an event.
+ *
+ * This method should only be called by {@link ProfileScope}.
+ *
+ * @param name  The static name of the scope
+ * @param start The time the scope was opened in nanoseconds
+ * @param depth The nesting depth returned by {@link #push}
+ */
+void Profiler::pop(const char* name, Uint64 start, Uint32 depth) {
+    Uint64 end = now();
+    ThreadBuffer* buffer = localBuffer();
+    buffer->depth = depth;
+
+    Uint64 head = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[head % BUFFER_SIZE];
+    event.name  = name;
+    event.start = start;
+    event.end   = end;
+    event.depth = depth;
+    // Publish the event to readers only once it is complete
+    buffer->head.store(head+1, std::memory_order_release);
+}
+
+/**
+ * Discards all recorded events on every thread.
+ *
+ * This also releases the buffers of threads that have exited. This
+ * method is not safe to call while other threads are recording.
+ */
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for(auto it = _buffers.begin(); it != _buffers.end();) {
+        if ((*it)->retired) {
+            delete *it;
+            it = _buffers.erase(it);
+        } else {
+            (*it)->head.store(0, std::memory_order_relaxed);
+            (*it)->mark = 0;
+            ++it;
+        }
+    }
+    _frameStats.clear();
+}
+
+/**
+ * Releases the buffers of every thread, discarding all recorded events.
+ *
+ * A thread that records again afterwards is given a new buffer.  This
+ * method is not safe to call while other threads are recording.
+ */
+void Profiler::dispose() {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for(auto it = _buffers.begin(); it != _buffers.end(); ++it) {
+        delete *it;
+    }
+    _buffers.clear();
+    // Every thread must now allocate a new buffer before it records
+    _generation++;
+    _frameStats.clear();
+    _lastMark = 0;
+    _frameTime = 0;
+}
+
+#pragma mark -
+#pragma mark Frame Summary
+/**
+ * Marks the end of a frame, summarizing the events since the last mark.
+ *
+ * This should be called once per frame from the main thread, after the
+ * frame has been drawn.  Only the events recorded by the calling thread
+ * are included in the summary.
+ */
+void Profiler::markFrame() {
+    Uint64 time = now();
+    _frameTime = _lastMark ? time-_lastMark : 0;
+    _lastMark = time;
+
+    _frameStats.clear();
+    if (_localBuffer.generation != _generation.load()) {
+        return;
+    }
+    ThreadBuffer* buffer = _localBuffer.buffer;
+    if (buffer == nullptr) {
+        return;
+    }
+
+    Uint64 head  = buffer->head.load(std::memory_order_relaxed);
+    Uint64 first = std::max(buffer->mark, head < BUFFER_SIZE ? 0 : head-BUFFER_SIZE);
+    buffer->mark = head;
+
+    // A frame has a few dozen distinct scopes, so a linear search is fine
+    for(Uint64 ii = first; ii < head; ii++) {
+        const Event& event = buffer->events[ii % BUFFER_SIZE];
+        auto it = std::find_if(_frameStats.begin(), _frameStats.end(),
+                               [&](const Stat& stat) { return stat.name == event.name; });
+        if (it == _frameStats.end()) {
+            Stat stat;
+            stat.name  = event.name;
+            stat.depth = event.depth;
+            stat.start = event.start;
+            stat.calls = 1;
+            stat.total = event.end-event.start;
+            _frameStats.push_back(stat);
+        } else {
+            it->calls++;
+            it->total += event.end-event.start;
+            it->start = std::min(it->start, event.start);
+        }
+    }
+
+    // Events are recorded as they close, so children come before parents
+    std::sort(_frameStats.begin(), _frameStats.end(), [](const Stat& a, const Stat& b) {
+        return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+    });
+}
+
+/**
+ * Returns the scopes of the last frame in the order they first appeared.
+ *
+ * The result is only updated by {@link #markFrame}.  The list is empty
+ * if profiling was disabled for the whole frame.
+ *
+ * @return the scopes of the last frame.
+ */
+const std::vector<Profiler::Stat>& Profiler::getFrameStats() {
+    return _frameStats;
+}
+
+/**
+ * Returns the length of the last frame in nanoseconds.
+ *
+ * This is the time between the last two calls to {@link #markFrame}.
+ *
+ * @return the length of the last frame in nanoseconds.
+ */
+Uint64 Profiler::getFrameTime() {
+    return _frameTime;
+}
+
+#pragma mark -
+#pragma mark Trace Output
+/**
+ * Writes every buffered event to a file in the Chrome trace format.
+ *
+ * The file is a JSON object with a single "traceEvents" array of complete
+ * ("X") events, one thread per ring buffer.  It can be opened in the
+ * Chrome trace viewer or in Perfetto.  The path follows the rules of
+ * {@link TextWriter}, so a relative path is placed in the save directory.
+ *
+ * Threads may continue recording while the trace is written.  Events that
+ * are overwritten during the dump are left out rather than torn.  The
+ * events are copied out while holding the buffer lock, so that no buffer
+ * can be released by {@link #clear} or {@link #dispose} mid-copy, and the
+ * file is written after the lock is released.
+ *
+ * @param path  The file to write to
+ *
+ * @return true if the file was written.
+ */
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::vector<Event> events;
+    std::vector<std::pair<size_t,unsigned long>> threads; // (end, tid)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        events.reserve(BUFFER_SIZE*_buffers.size());
+        for(auto it = _buffers.begin(); it != _buffers.end(); ++it) {
+            ThreadBuffer* buffer = *it;
+            size_t start = events.size();
+            Uint64 head  = buffer->head.load(std::memory_order_acquire);
+            Uint64 first = head < BUFFER_SIZE ? 0 : head-BUFFER_SIZE;
+            for(Uint64 ii = first; ii < head; ii++) {
+                events.push_back(buffer->events[ii % BUFFER_SIZE]);
+            }
+
+            // Drop anything the owner overwrote while we were copying
+            Uint64 after = buffer->head.load(std::memory_order_acquire);
+            if (after >= BUFFER_SIZE && after-BUFFER_SIZE > first) {
+                size_t skip = (size_t)std::min<Uint64>(after-BUFFER_SIZE-first, events.size()-start);
+                events.erase(events.begin()+start, events.begin()+start+skip);
+            }
+            threads.push_back(std::make_pair(events.size(), (unsigned long)buffer->tid));
+        }
+    }
+
+    std::shared_ptr<TextWriter> writer = TextWriter::alloc(path);
+    if (writer == nullptr) {
+        CULogError("Could not write profiler trace to %s", path.c_str());
+        return false;
+    }
+
+    char line[128];
+    bool comma = false;
+    size_t ii = 0;
+    writer->write("{\"traceEvents\":[");
+    for(auto it = threads.begin(); it != threads.end(); ++it) {
+        for(; ii < it->first; ii++) {
+            const Event& event = events[ii];
+            writer->write(comma ? ",\n{\"name\":" : "\n{\"name\":");
+            writeName(writer, event.name);
+            snprintf(line, sizeof(line),
+                     ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu}",
+                     event.start/1000.0, (event.end-event.start)/1000.0,
+                     it->second);
+            writer->write(line);
+            comma = true;
+        }
+    }
+    writer->write("\n],\"displayTimeUnit\":\"ms\"}\n");
+    writer->close();
+    return true;
+}
@@ -53,6 +53,7 @@ void GameApp::onShutdown() {
   _level_loading.dispose();
   _assets = nullptr;
   _batch = nullptr;
+  cugl::Profiler::dispose();
 
   cugl::AudioEngine::stop();
 
@@ -133,6 +134,8 @@ void GameApp::draw() {
       _win.render(_batch);
       break;
   }
+  // Close the profiler frame so the overlay shows this update and draw.
+  cugl::Profiler::markFrame();
 }
 
 void GameApp::updateLoadingScene(float timestep) {
@@ -330,6 +333,15 @@ void GameApp::updateLevelLoadingScene(float timestep) {
                                                ? _hostlobby.getColorIds()
                                                : _joinlobby.getColorIds();
 
+  if (!_level_loading.getIsHost()) {
+    Uint64 hash = _level_loading.getLevelGenerator()->getLayoutHash();
+    if (hash != _joinlobby.getLayoutHash()) {
+      CULogError("Level layout %016llx does not match the host's %016llx",
+                 (unsigned long long)hash,
+                 (unsigned long long)_joinlobby.getLayoutHash());
+    }
+  }
+
   _level_loading.removeChild(_level_loading.getMap());
   _gameplay.init(_assets, _level_loading.getLevelGenerator(),
                  _level_loading.getMap(), betrayer, name, color_ids);
@@ -0,0 +1,277 @@
+#include "HeadlessApp.h"
+
+#include "controllers/Random.h"
+#include "loaders/CustomScene2Loader.h"
+
+/** The number of seconds between tick statistics logs. */
+#define STATS_INTERVAL 10
+/** The timestep of every tick when recording, in seconds. */
+#define FIXED_TIMESTEP (1.0f / 60.0f)
+/** A frame rate high enough that the application never sleeps. */
+#define UNLIMITED_FPS 1000000.0f
+
+void HeadlessApp::onStartup() {
+  Random::Init();
+
+  // Sounds are never played, so they are never loaded.
+  _assets = cugl::AssetManager::alloc();
+  _assets->attach<cugl::Texture>(cugl::TextureLoader::alloc()->getHook());
+  _assets->attach<cugl::Font>(cugl::FontLoader::alloc()->getHook());
+  _assets->attach<cugl::JsonValue>(cugl::JsonLoader::alloc()->getHook());
+  _assets->attach<cugl::WidgetValue>(cugl::WidgetLoader::alloc()->getHook());
+  _assets->attach<cugl::scene2::SceneNode>(
+      cugl::CustomScene2Loader::alloc()->getHook());
+  _assets->loadDirectory("json/assets.json");
+  _assets->loadDirectory("json/tiles.json");
+
+  auto json = _assets->get<cugl::JsonValue>("server");
+  cugl::NetworkConnection::ConnectionConfig& config = _config;
+  config.punchthroughServerAddr = json->getString("address", "");
+  config.punchthroughServerPort = json->getInt("port", 0);
+  // The host takes a slot but does not play.
+  config.maxNumPlayers = json->getInt("maximum", 0) + 1;
+  config.apiVersion = json->getInt("version", 0);
+  config.transport = _transport;
+  if (_num_players <= 0) _num_players = json->getInt("maximum", 0);
+
+  if (!_replay_path.empty()) {
+    if (_replay.open(_replay_path)) {
+      _header = _replay.getHeader();
+      // Nobody joins a replay, so its room is on a network of its own.
+      _loopback = cugl::LoopbackNetwork::alloc();
+      config.transport = _loopback->getTransportFactory();
+      setFPS(UNLIMITED_FPS);
+    } else {
+      CULogError("Could not open the match log %s", _replay_path.c_str());
+      quit();
+    }
+  } else if (_num_soak_clients > 0) {
+    _loopback = cugl::LoopbackNetwork::alloc();
+    _loopback->setConditions(_soak_conditions);
+    config.transport = _loopback->getTransportFactory();
+  }
+
+  _hostlobby.init(_assets);
+  _hostlobby.setDedicated(true);
+
+  _network = cugl::NetworkConnection::alloc(config);
+  _scene = State::CONNECT;
+  if (_replay_path.empty()) {
+    CULog("Dedicated host waiting for %d players", _num_players);
+  }
+
+  cugl::Application::onStartup();  // YOU MUST END with call to parent.
+}
+
+void HeadlessApp::onShutdown() {
+  for (auto& client : _soak_clients) client->dispose();
+  _soak_clients.clear();
+  _recorder.close();
+  _replay.close();
+  _gameplay.dispose();
+  _level_loading.dispose();
+  _hostlobby.dispose();
+  _network = nullptr;
+  _loopback = nullptr;
+  _assets = nullptr;
+  cugl::Profiler::dispose();
+
+  cugl::Application::onShutdown();  // YOU MUST END with call to parent.
+}
+
+void HeadlessApp::update(float timestep) {
+  // The clients go first, so the host sees their messages this tick.
+  for (auto& client : _soak_clients) client->update(timestep);
+
+  switch (_scene) {
+    case CONNECT:
+      updateConnect(timestep);
+      break;
+    case LOBBY:
+      updateLobby(timestep);
+      break;
+    case LEVEL_LOADING:
+      updateLevelLoading(timestep);
+      break;
+    case GAME:
+      updateGame(timestep);
+      break;
+  }
+}
+
+void HeadlessApp::updateConnect(float timestep) {
+  _network->receive([](const std::vector<uint8_t>& data) {});
+  switch (_network->getStatus()) {
+    case cugl::NetworkConnection::NetStatus::Pending:
+    case cugl::NetworkConnection::NetStatus::Reconnecting:
+      break;
+    case cugl::NetworkConnection::NetStatus::Connected:
+      if (!_replay_path.empty()) {
+        CULog("Replaying %s", _replay_path.c_str());
+        startLevelLoading();
+        break;
+      }
+      CULog("Dedicated host opened room %s", _network->getRoomID().c_str());
+      if (_num_soak_clients > 0) startSoakClients(_network->getRoomID());
+      _hostlobby.setActive(true, _network);
+      _scene = State::LOBBY;
+      break;
+    default:
+      CULogError("Dedicated host could not open a room");
+      quit();
+      break;
+  }
+}
+
+void HeadlessApp::updateLobby(float timestep) {
+  _hostlobby.update(timestep);
+  switch (_hostlobby.getStatus()) {
+    case HostLobbyScene::Status::ABORT:
+      CULogError("Dedicated host lost its connection in the lobby");
+      _hostlobby.setActive(false, nullptr);
+      quit();
+      break;
+    case HostLobbyScene::Status::START:
+      _hostlobby.setActive(false, nullptr);
+      _header.random_seed = Random::GetSeed();
+      _header.level_seed = _hostlobby.getSeed();
+      _header.num_players = _network->getNumPlayers();
+      _header.timestep = FIXED_TIMESTEP;
+      _header.color_ids = _hostlobby.getColorIds();
+      startLevelLoading();
+      break;
+    case HostLobbyScene::Status::WAIT:
+      if (_hostlobby.getNumPlayingPlayers() >= _num_players &&
+          _hostlobby.canStartGame()) {
+        CULog("Dedicated host starting with %d players",
+              _hostlobby.getNumPlayingPlayers());
+        _hostlobby.startGame();
+      }
+      break;
+  }
+}
+
+void HeadlessApp::startLevelLoading() {
+  _level_loading.init(_assets, _header.level_seed, _header.num_players);
+  // Transfer connection ownership
+  _level_loading.setConnection(_network);
+  _level_loading.setHost(true);
+  _network = nullptr;
+  _scene = State::LEVEL_LOADING;
+}
+
+void HeadlessApp::updateLevelLoading(float timestep) {
+  if (_level_loading.isActive()) {
+    _level_loading.update(timestep);
+    return;
+  }
+
+  // Transfer connection ownership
+  _gameplay.setConnection(_level_loading.getConnection());
+  _level_loading.disconnect();
+  _gameplay.setHost(true);
+  _gameplay.setHeadless(true);
+
+  _level_loading.removeChild(_level_loading.getMap());
+  // Every stream starts over, so that a replay draws the same numbers.
+  Random::Init(_header.random_seed);
+  _gameplay.init(_assets, _level_loading.getLevelGenerator(),
+                 _level_loading.getMap(), false, "host", _header.color_ids);
+  _level_loading.dispose();
+
+  if (!_record_path.empty()) {
+    if (_recorder.open(_record_path, _header)) {
+      NetworkController::get()->setReceiveObserver(
+          [this](const uint8_t* data, size_t size) {
+            _recorder.record(data, size);
+          });
+    } else {
+      CULogError("Could not record the match to %s", _record_path.c_str());
+    }
+  }
+  if (!_replay_path.empty()) {
+    NetworkController::get()->setReceiveSource(
+        [this](const NetworkController::Receiver& receiver) {
+          _replay.receive(receiver);
+        });
+  }
+
+  _stats_start.mark();
+  _scene = State::GAME;
+}
+
+void HeadlessApp::updateGame(float timestep) {
+  switch (_gameplay.getState()) {
+    case GameScene::State::RUN: {
+      if (!_replay_path.empty() && !_replay.nextTick()) {
+        logTickStats();
+        CULog("Replay over after %llu ticks",
+              (unsigned long long)_replay.getTicks());
+        _gameplay.dispose();
+        quit();
+        break;
+      }
+      if (isDeterministic()) timestep = _header.timestep;
+
+      cugl::Timestamp start;
+      _gameplay.update(timestep);
+      cugl::Timestamp end;
+      _recorder.endTick();
+
+      Uint64 micros = cugl::Timestamp::ellapsedMicros(start, end);
+      _stats_ticks++;
+      _stats_total += micros;
+      _stats_max = std::max(_stats_max, micros);
+      if (end.ellapsedMillis(_stats_start) >= STATS_INTERVAL * 1000) {
+        logTickStats();
+      }
+    } break;
+    case GameScene::State::DONE:
+      _recorder.close();
+      logTickStats();
+      CULog("Match over, %s win",
+            _gameplay.checkCooperatorWin() ? "runners" : "betrayers");
+      _gameplay.dispose();
+      quit();
+      break;
+    case GameScene::State::LEAVE:
+      _recorder.close();
+      logTickStats();
+      CULog("Match ended early");
+      _gameplay.dispose();
+      quit();
+      break;
+    default:
+      break;
+  }
+}
+
+void HeadlessApp::startSoakClients(const std::string& room_id) {
+  CULog("Joining %d soak clients", _num_soak_clients);
+  for (int i = 0; i < _num_soak_clients; i++) {
+    auto client = std::make_unique<SoakClient>();
+    if (client->init(_config, room_id, i)) {
+      _soak_clients.push_back(std::move(client));
+    } else {
+      CULogError("Could not join soak client %d", i + 1);
+    }
+  }
+}
+
+void HeadlessApp::logTickStats() {
+  if (_stats_ticks > 0) {
+    CULog("Ticks: %u, avg %.3f ms, max %.3f ms", _stats_ticks,
+          _stats_total / 1000.0 / _stats_ticks, _stats_max / 1000.0);
+  }
+  if (_num_soak_clients > 0 && _loopback != nullptr) {
+    const cugl::LoopbackNetwork::Stats& stats = _loopback->getStats();
+    CULog("Traffic: %llu packets, %llu bytes, %llu resent",
+          (unsigned long long)stats.packetsSent,
+          (unsigned long long)stats.bytesSent,
+          (unsigned long long)stats.packetsResent);
+  }
+  _stats_start.mark();
+  _stats_ticks = 0;
+  _stats_total = 0;
+  _stats_max = 0;
+}
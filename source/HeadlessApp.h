@@ -0,0 +1,270 @@
+#ifndef HEADLESSAPP_H_
+#define HEADLESSAPP_H_
+#include <cugl/cugl.h>
+
+#include "network/MatchLog.h"
+#include "network/SoakClient.h"
+#include "scenes/GameScene.h"
+#include "scenes/HostLobbyScene.h"
+#include "scenes/LoadingLevelScene.h"
+
+/**
+ * This class represents the application root for a dedicated host.
+ *
+ * A dedicated host runs the authoritative simulation for a match without a
+ * window, input or sound, so it can run on a Linux server. It opens a room,
+ * waits for the given number of players to join and submit their names,
+ * starts the game on its own and runs a headless GameScene until the match
+ * ends. The time taken by each simulation tick is logged periodically, so a
+ * session with many clients doubles as a throughput test.
+ *
+ * A match can be recorded to a log, and a log replayed without any clients.
+ * Both run the game in its deterministic mode, with every random stream
+ * seeded from the log and a fixed timestep. A replay opens its room on an
+ * in-memory network, skips the lobby and runs as fast as it can, feeding
+ * the game the recorded messages of each tick. Its tick statistics are then
+ * a benchmark of the simulation on a real match.
+ *
+ * A soak test opens the room on an in-memory network instead, and joins the
+ * given number of simulated clients to it from the same process. They play
+ * a full match, lobby included, so the tick statistics show how the host
+ * holds up under a full room without any devices.
+ *
+ * Build with HEADLESS_HOST defined to use this application instead of
+ * GameApp.
+ */
+class HeadlessApp : public cugl::Application {
+ protected:
+  /**
+   * The current stage of the match
+   */
+  enum State {
+    /** Waiting for the room to open */
+    CONNECT,
+    /** Waiting for players to join */
+    LOBBY,
+    /** Generating the level */
+    LEVEL_LOADING,
+    /** Running the game */
+    GAME
+  };
+
+  /** The global asset manager */
+  std::shared_ptr<cugl::AssetManager> _assets;
+  /** The connection, until it is handed to the game */
+  std::shared_ptr<cugl::NetworkConnection> _network;
+
+  /** The lobby, which assigns names, roles and colors */
+  HostLobbyScene _hostlobby;
+  /** The scene that generates the level */
+  LoadingLevelScene _level_loading;
+  /** The headless game */
+  GameScene _gameplay;
+
+  /** The current stage of the match */
+  State _scene;
+  /** The number of players to wait for before starting */
+  int _num_players;
+  /** The transport for the connection, or empty for the default */
+  cugl::NetworkTransport::Factory _transport;
+  /** The in-memory network of a replay or soak test */
+  std::shared_ptr<cugl::LoopbackNetwork> _loopback;
+  /** The configuration of the connection, for the soak clients to share */
+  cugl::NetworkConnection::ConnectionConfig _config;
+  /** The number of simulated clients to join, or 0 for a real match */
+  int _num_soak_clients;
+  /** The conditions of the network of a soak test */
+  cugl::LoopbackNetwork::Conditions _soak_conditions;
+  /** The simulated clients, once the room is open */
+  std::vector<std::unique_ptr<SoakClient>> _soak_clients;
+
+  /** The path to record the match to, or empty to not record */
+  std::string _record_path;
+  /** The path of the match to replay, or empty to host a real match */
+  std::string _replay_path;
+  /** The log of the match being recorded */
+  MatchRecorder _recorder;
+  /** The log of the match being replayed */
+  MatchReplay _replay;
+  /** The setup of the match, once the lobby is done */
+  MatchHeader _header;
+
+  /** The start of the current tick statistics window */
+  cugl::Timestamp _stats_start;
+  /** The number of ticks in the current window */
+  Uint32 _stats_ticks;
+  /** The total time of the ticks in the current window, in microseconds */
+  Uint64 _stats_total;
+  /** The longest tick in the current window, in microseconds */
+  Uint64 _stats_max;
+
+ public:
+  /**
+   * Creates, but does not initialized a new application.
+   *
+   * This constructor is called by main.cpp. You will notice that, like
+   * most of the classes in CUGL, we do not do any initialization in the
+   * constructor. That is the purpose of the init() method. Separation
+   * of initialization from the constructor allows main.cpp to perform
+   * advanced configuration of the application before it starts.
+   */
+  HeadlessApp()
+      : cugl::Application(),
+        _scene(State::CONNECT),
+        _num_players(0),
+        _num_soak_clients(0),
+        _stats_ticks(0),
+        _stats_total(0),
+        _stats_max(0) {}
+
+  /**
+   * Sets the number of players to wait for before starting the game.
+   *
+   * If this is 0, the host waits for the maximum number of players in the
+   * server configuration.
+   *
+   * @param num_players The number of players to wait for.
+   */
+  void setNumPlayers(int num_players) { _num_players = num_players; }
+
+  /**
+   * Sets the transport for the connection of this host.
+   *
+   * A soak test can give this the factory of a cugl::LoopbackNetwork, and
+   * join simulated clients to the same network. This must be called before
+   * onStartup.
+   *
+   * @param transport The transport factory, or empty for the default
+   */
+  void setTransport(const cugl::NetworkTransport::Factory& transport) {
+    _transport = transport;
+  }
+
+  /**
+   * Soak tests the host with the given number of simulated clients.
+   *
+   * The room is opened on an in-memory network, and the game starts once
+   * every client has joined. The conditions of the network can be changed
+   * with {@link #setSoakConditions}. This must be called before onStartup.
+   *
+   * @param num_clients The number of simulated clients.
+   */
+  void setSoakClients(int num_clients) {
+    _num_soak_clients = num_clients;
+    _num_players = num_clients;
+  }
+
+  /**
+   * Sets the latency and loss of the network of a soak test. This must be
+   * called before onStartup.
+   *
+   * @param latency The one-way latency in milliseconds.
+   * @param loss    The probability that a packet is lost (0 to 1).
+   */
+  void setSoakConditions(float latency, float loss) {
+    _soak_conditions.latency = latency;
+    _soak_conditions.loss = loss;
+  }
+
+  /**
+   * Records the match to a log at the given path. This must be called
+   * before onStartup.
+   *
+   * @param path The path of the log.
+   */
+  void setRecordPath(const std::string& path) { _record_path = path; }
+
+  /**
+   * Replays the match in the log at the given path instead of hosting one.
+   * This must be called before onStartup.
+   *
+   * @param path The path of the log.
+   */
+  void setReplayPath(const std::string& path) { _replay_path = path; }
+
+  /**
+   * @return If the game runs deterministically, to record or replay it.
+   */
+  bool isDeterministic() const {
+    return !_record_path.empty() || !_replay_path.empty();
+  }
+
+  /**
+   * The method called after OpenGL is initialized, but before running the
+   * application.
+   *
+   * This loads the assets synchronously and opens a room on the server, or
+   * on an in-memory network for a replay.
+   */
+  virtual void onStartup() override;
+
+  /**
+   * The method called when the application is ready to quit.
+   *
+   * This disposes the scenes and closes the connection.
+   */
+  virtual void onShutdown() override;
+
+  /**
+   * The method called to update the application data.
+   *
+   * @param timestep  The amount of time (in seconds) since the last frame
+   */
+  virtual void update(float timestep) override;
+
+  /**
+   * The method called to draw the application to the screen.
+   *
+   * A dedicated host never draws, so this does nothing.
+   */
+  virtual void draw() override {}
+
+  /**
+   * Individualized update method while waiting for the room to open.
+   *
+   * @param timestep  The amount of time (in seconds) since the last frame
+   */
+  void updateConnect(float timestep);
+
+  /**
+   * Individualized update method for the lobby. This starts the game once
+   * enough players have joined and named themselves.
+   *
+   * @param timestep  The amount of time (in seconds) since the last frame
+   */
+  void updateLobby(float timestep);
+
+  /**
+   * Individualized update method for the level loading scene.
+   *
+   * @param timestep  The amount of time (in seconds) since the last frame
+   */
+  void updateLevelLoading(float timestep);
+
+  /**
+   * Starts loading the level of the match in the header.
+   */
+  void startLevelLoading();
+
+  /**
+   * Individualized update method for the game. This records the time of
+   * each tick and quits when the match (or its replay) is over.
+   *
+   * @param timestep  The amount of time (in seconds) since the last frame
+   */
+  void updateGame(float timestep);
+
+  /**
+   * Joins the simulated clients of a soak test to the room.
+   *
+   * @param room_id The room of this host.
+   */
+  void startSoakClients(const std::string& room_id);
+
+  /**
+   * Logs the tick statistics since the last log, and starts a new window.
+   */
+  void logTickStats();
+};
+
+#endif /* HEADLESSAPP_H_ */
@@ -0,0 +1,111 @@
+#include "Animator.h"
+
+#pragma mark Animator
+
+bool Animator::init(const std::shared_ptr<cugl::JsonValue>& json) {
+  if (json == nullptr) return false;
+
+  for (int ii = 0; ii < json->size(); ii++) {
+    std::shared_ptr<cugl::JsonValue> child = json->get(ii);
+    Clip clip;
+    clip.first = child->getInt("first");
+    clip.last = child->getInt("last", clip.first);
+    clip.duration = child->getFloat("duration", 1.0f / 60.0f);
+    clip.loop = child->getBool("loop", true);
+    CUAssertLog(clip.first <= clip.last && clip.duration > 0,
+                "Invalid animation clip %s", child->key().c_str());
+
+    _clip_ids[child->key()] = static_cast<int>(_clips.size());
+    _clips.push_back(clip);
+  }
+
+  _initialized = true;
+  return true;
+}
+
+void Animator::dispose() {
+  _tracks.clear();
+  _free_tracks.clear();
+  _clips.clear();
+  _clip_ids.clear();
+  _initialized = false;
+}
+
+int Animator::getClip(const std::string& name) const {
+  auto it = _clip_ids.find(name);
+  CUAssertLog(it != _clip_ids.end(), "Unknown animation clip %s",
+              name.c_str());
+  return it == _clip_ids.end() ? -1 : it->second;
+}
+
+int Animator::addTrack(const std::shared_ptr<cugl::scene2::SpriteNode>& node) {
+  Track track;
+  track.node = node;
+  track.clip = -1;
+  track.time = 0;
+  track.frame = 0;
+  track.changed = false;
+  track.done = false;
+
+  if (_free_tracks.empty()) {
+    _tracks.push_back(track);
+    return static_cast<int>(_tracks.size()) - 1;
+  }
+  int handle = _free_tracks.back();
+  _free_tracks.pop_back();
+  _tracks[handle] = track;
+  return handle;
+}
+
+void Animator::removeTrack(int track) {
+  if (track < 0 || track >= static_cast<int>(_tracks.size())) return;
+  if (_tracks[track].node == nullptr) return;
+  _tracks[track].node = nullptr;
+  _tracks[track].clip = -1;
+  _free_tracks.push_back(track);
+}
+
+void Animator::play(int track, int clip, bool restart) {
+  Track& t = _tracks[track];
+  if (clip < 0) {
+    t.clip = -1;
+    return;
+  }
+  if (t.clip == clip && !restart) return;
+
+  t.clip = clip;
+  t.time = 0;
+  t.frame = 0;
+  t.changed = true;
+  t.done = false;
+  t.node->setFrame(_clips[clip].first);
+}
+
+void Animator::update(float timestep) {
+  for (Track& track : _tracks) {
+    track.changed = false;
+    if (track.clip < 0 || track.done) continue;
+
+    const Clip& clip = _clips[track.clip];
+    int count = clip.last - clip.first + 1;
+    track.time += timestep;
+    int frame = static_cast<int>(track.time / clip.duration);
+    if (frame >= count) {
+      if (clip.loop) {
+        // Wrap the clock so it does not lose precision over a long loop.
+        track.time = fmodf(track.time, clip.duration * count);
+        frame = static_cast<int>(track.time / clip.duration) % count;
+      } else {
+        frame = count - 1;
+        track.done = true;
+      }
+    }
+
+    // Only shift the texture coordinates when the frame actually changes.
+    if (frame != track.frame) {
+      track.frame = frame;
+      track.changed = true;
+      track.node->setFrame(clip.first + frame);
+    }
+  }
+}
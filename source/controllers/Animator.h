@@ -0,0 +1,167 @@
+#ifndef CONTROLLERS_ANIMATOR_H_
+#define CONTROLLERS_ANIMATOR_H_
+#include <cugl/cugl.h>
+
+#include "Controller.h"
+
+/**
+ * A controller that plays sprite sheet animations.
+ *
+ * Clips are ranges of frames in a sprite sheet, loaded from the "animations"
+ * JSON asset, with the length of each frame given in seconds. Every animated
+ * SpriteNode gets a track, which plays one clip at a time and is referred to
+ * by the handle returned from addTrack. update advances every track in a
+ * single loop and only calls SpriteNode::setFrame when a track moves to a new
+ * frame, so animation speed does not depend on the frame rate.
+ */
+class Animator : public Controller {
+ public:
+  /** A range of frames in a sprite sheet. */
+  struct Clip {
+    /** The first frame of the clip in the sprite sheet. */
+    int first;
+    /** The last frame of the clip in the sprite sheet (inclusive). */
+    int last;
+    /** The time each frame is shown, in seconds. */
+    float duration;
+    /** Whether the clip starts over after the last frame. */
+    bool loop;
+  };
+
+ private:
+  /** The playback state of a single sprite node. */
+  struct Track {
+    /** The node animated by this track, nullptr if the track is free. */
+    std::shared_ptr<cugl::scene2::SpriteNode> node;
+    /** The clip being played, or -1 if stopped. */
+    int clip;
+    /** The time since the clip started, in seconds. */
+    float time;
+    /** The current frame relative to the start of the clip. */
+    int frame;
+    /** Whether the frame changed in the last update. */
+    bool changed;
+    /** Whether a non-looping clip has finished its last frame. */
+    bool done;
+  };
+
+  /** All the clips, indexed by clip id. */
+  std::vector<Clip> _clips;
+  /** A map from clip name to clip id. */
+  std::unordered_map<std::string, int> _clip_ids;
+
+  /** All the tracks, indexed by handle. */
+  std::vector<Track> _tracks;
+  /** The handles of removed tracks, reused by addTrack. */
+  std::vector<int> _free_tracks;
+
+ public:
+#pragma mark Constructors
+  /** Creates a new animator with no clips. */
+  Animator() {}
+
+  /** Disposes the animator, releasing all resources. */
+  ~Animator() { dispose(); }
+
+  /**
+   * Initializes the animator with the clips in the given JSON.
+   *
+   * The JSON is an object with one entry per clip, keyed by clip name. Each
+   * clip has the "first" and "last" frame, the "duration" of a frame in
+   * seconds and whether it should "loop".
+   *
+   * @param json The clip definitions.
+   * @return true if the animator was initialized.
+   */
+  bool init(const std::shared_ptr<cugl::JsonValue>& json);
+
+  /** Disposes all the clips and tracks. */
+  void dispose() override;
+
+#pragma mark Static Constructors
+  /**
+   * Returns a new animator with the clips in the given JSON.
+   *
+   * @param json The clip definitions.
+   * @return a new animator.
+   */
+  static std::shared_ptr<Animator> alloc(
+      const std::shared_ptr<cugl::JsonValue>& json) {
+    auto result = std::make_shared<Animator>();
+    return (result->init(json) ? result : nullptr);
+  }
+
+#pragma mark Clips and Tracks
+  /**
+   * Returns the id of the clip with the given name.
+   *
+   * Clip ids do not change, so callers should look them up once.
+   *
+   * @param name The name of the clip.
+   * @return the clip id, or -1 if there is no such clip.
+   */
+  int getClip(const std::string& name) const;
+
+  /**
+   * Adds a track that animates the given node.
+   *
+   * @param node The sprite node to animate.
+   * @return the handle of the new track.
+   */
+  int addTrack(const std::shared_ptr<cugl::scene2::SpriteNode>& node);
+
+  /**
+   * Removes the given track, releasing its node. Invalid handles such as -1
+   * are ignored, so this is safe to call on a handle that was never assigned.
+   *
+   * @param track The track handle.
+   */
+  void removeTrack(int track);
+
+  /**
+   * Plays the given clip on the given track.
+   *
+   * The first frame of the clip is shown immediately. If the clip is already
+   * playing on the track, it continues unless restart is true.
+   *
+   * @param track The track handle.
+   * @param clip The clip id.
+   * @param restart Whether to start over if the clip is already playing.
+   */
+  void play(int track, int clip, bool restart = false);
+
+  /**
+   * Stops the clip on the given track, leaving the node on its current frame.
+   *
+   * @param track The track handle.
+   */
+  void stop(int track) { _tracks[track].clip = -1; }
+
+  /**
+   * @param track The track handle.
+   * @return the current frame of the track relative to the start of its clip.
+   */
+  int getClipFrame(int track) const { return _tracks[track].frame; }
+
+  /**
+   * @param track The track handle.
+   * @return whether the track moved to a new frame in the last update.
+   */
+  bool frameChanged(int track) const { return _tracks[track].changed; }
+
+  /**
+   * @param track The track handle.
+   * @return whether the non-looping clip on the track has finished.
+   */
+  bool isDone(int track) const { return _tracks[track].done; }
+
+#pragma mark Update
+  /**
+   * Advances every playing track by the given time.
+   *
+   * @param timestep The time since the last update, in seconds.
+   */
+  void update(float timestep) override;
+};
+
+#endif  // CONTROLLERS_ANIMATOR_H_
@@ -2,6 +2,8 @@
 
 #include <box2d/b2_world.h>
 
+#include "Random.h"
+
 #define MIN_DISTANCE 300
 #define HEALTH_LIM 25
 #define ATTACK_RANGE 100
@@ -85,12 +87,30 @@ bool EnemyController::init(
   _world_node = world_node;
   _debug_node = debug_node;
 
-  std::random_device rd;
-  _generator = std::default_random_engine(rd());
+  _generator.seed(Random::Get(Random::ENEMIES).next());
 
   return true;
 }
 
+void EnemyController::playDeath(
+    std::shared_ptr<EnemyModel> enemy,
+    const std::shared_ptr<cugl::scene2::SpriteNode>& node,
+    const std::string& clip) {
+  if (enemy->_death_track < 0) {
+    // Death just began, face the last target and start the clip.
+    float direc_angle =
+        abs((enemy->getAttackDir() - enemy->getPosition()).getAngle());
+    enemy->setFacingLeft(direc_angle > M_PI / 2);
+    enemy->_death_track = _animator->addTrack(node);
+    _animator->play(enemy->_death_track,
+                    _animator->getClip(clip + (enemy->getFacingLeft()
+                                                   ? "-left"
+                                                   : "-right")));
+  } else if (_animator->isDone(enemy->_death_track)) {
+    enemy->setReadyToDie(true);
+  }
+}
+
 void EnemyController::clientUpdateAttackPlayer(
     std::shared_ptr<EnemyModel> enemy) {
   // nothing
@@ -170,7 +190,7 @@ void EnemyController::update(bool is_host, float timestep,
   }
 
   if (enemy->isHit()) {
-    _sound_controller->playEnemyHit();
+    if (_sound_controller) _sound_controller->playEnemyHit();
   }
 
   enemy->update(timestep);
@@ -6,6 +6,8 @@
 
 #include "../models/EnemyModel.h"
 #include "../models/Player.h"
+#include "Animator.h"
+#include "../generators/Pcg32.h"
 #include "RayCastController.h"
 #include "SoundController.h"
 
@@ -24,6 +26,8 @@ class EnemyController {
   std::shared_ptr<cugl::physics2::ObstacleWorld> _world;
   /** A reference to the sound controller. */
   std::shared_ptr<SoundController> _sound_controller;
+  /** A reference to the animator for the death animations. */
+  std::shared_ptr<Animator> _animator;
 
   /** Cache set for vertices to update the polys. */
   std::vector<cugl::Vec2> _vertices_cache;
@@ -38,8 +42,8 @@ class EnemyController {
   /** Timer for doing ray casting. */
   int _timer;
 
-  /** A generator for random numbers. */
-  std::default_random_engine _generator;
+  /** A generator for random numbers, seeded from the enemy stream. */
+  level_gen::Pcg32 _generator;
 
  public:
 #pragma mark Constructors
@@ -70,13 +74,22 @@ class EnemyController {
   void dispose() { _projectile_texture = nullptr; }
 
   /**
-   * Set the sound controller for sound effects.
+   * Set the sound controller for sound effects. This is left unset on a
+   * headless host, in which case no sounds are played.
    * @param controller The sound controller.
    */
   void setSoundController(const std::shared_ptr<SoundController>& controller) {
     _sound_controller = controller;
   }
 
+  /**
+   * Set the animator for the death animations.
+   * @param animator The animator.
+   */
+  void setAnimator(const std::shared_ptr<Animator>& animator) {
+    _animator = animator;
+  }
+
 #pragma mark Static Constructors
   /**
    * Returns a new enemy controller.
@@ -136,6 +149,19 @@ class EnemyController {
 
 #pragma mark Movement
  protected:
+  /**
+   * Plays the death clip facing the enemy's last target, and marks the enemy
+   * ready to die once the clip is done. The clips are named "<clip>-right"
+   * and "<clip>-left".
+   *
+   * @param enemy The dying enemy.
+   * @param node The sprite node to animate.
+   * @param clip The name of the death clips, without the direction.
+   */
+  void playDeath(std::shared_ptr<EnemyModel> enemy,
+                 const std::shared_ptr<cugl::scene2::SpriteNode>& node,
+                 const std::string& clip);
+
   /** Chase the player.
    *
    * @param p the player position.
@@ -10,6 +10,7 @@
 #include "actions/OpenMap.h"
 #include "actions/Settings.h"
 #include "actions/TargetPlayer.h"
+#include "actions/ToggleProfiler.h"
 
 // static
 std::shared_ptr<InputController> InputController::_singleton = nullptr;
@@ -50,6 +51,11 @@ bool InputController::init(const std::shared_ptr<cugl::AssetManager> &assets,
     _active = InputController::attachAction<Dash>(
         Dash::alloc(assets, bounds)->getHook());
 
+#ifdef PROFILER_TOGGLE
+    _active = InputController::attachAction<ToggleProfiler>(
+        ToggleProfiler::alloc(assets, bounds)->getHook());
+#endif  // PROFILER_TOGGLE
+
     if (is_betrayer) {
       _active = InputController::attachAction<Corrupt>(
           Corrupt::alloc(assets, bounds)->getHook());
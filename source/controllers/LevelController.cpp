@@ -35,6 +35,21 @@ bool LevelController::init(
   return true;
 }
 
+void LevelController::setParticleController(
+    const std::shared_ptr<ParticleController> &controller) {
+  _particle_controller = controller;
+
+  // Particles are ordered like the players and enemies in their room.
+  for (auto it : _level_model->getRooms()) {
+    std::shared_ptr<RoomModel> room = it.second;
+    ParticleController::RoomOrder order;
+    order.origin_y = room->getNode()->getPosition().y;
+    order.row_height = TILE_SIZE.y * TILE_SCALE.y;
+    order.num_rows = room->getGridSize().height;
+    _particle_controller->setRoomOrder(it.first, order);
+  }
+}
+
 void LevelController::update(float timestep) {
   // Update all the player's ordering in the scene graph.
   for (std::shared_ptr<Player> &player : _player_controller->getPlayerList()) {
@@ -84,21 +99,6 @@ void LevelController::update(float timestep) {
     }
   }
 
-  {
-    for (const ParticleController::Particle &particle :
-         _particle_controller->getParticles()) {
-      if (particle.props.isOrder()) {
-        std::shared_ptr<RoomModel> room =
-            _level_model->getRoom(particle.props.getRoomId());
-
-        float rel_particle_y =
-            particle.node->getPositionY() - room->getNode()->getPosition().y;
-        float row = rel_particle_y / (TILE_SIZE.y * TILE_SCALE.y) + 1;
-        particle.node->setPriority(room->getGridSize().height - row);
-      }
-    }
-  }
-
   for (auto it : _level_model->getRooms()) {
     std::shared_ptr<RoomModel> room = it.second;
     auto num_players = room->getMapNode()->getChildByName("num_of_players");
@@ -247,12 +247,14 @@ void LevelController::populate() {
   // Initialize every room.
   for (std::shared_ptr<level_gen::Room> room : _level_gen->getRooms()) {
     auto room_node = room->_level_node;
+    // The LoadingLevelScene skips rooms whose layout could not be read.
+    if (room_node == nullptr) continue;
 
     room_node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
     cugl::Vec2 pos = room->getRect().origin * (TILE_SIZE * TILE_SCALE);
     room_node->setPosition(pos);
+    // The room node was already laid out by the LoadingLevelScene.
     room_node->setVisible(false);
-    room_node->doLayout();
 
     auto room_model = RoomModel::alloc(room_node, room->_node, room->_key);
     room_model->setType(room->_type);
@@ -317,13 +319,11 @@ void LevelController::setupMap(bool is_betrayer) {
   for (std::shared_ptr<level_gen::Room> &room : _level_gen->getRooms()) {
     room->_node->setColor(room->getRoomNodeColor());
     // Make all the edges invisible unless you are a betrayer.
+    // Inactive edges are not hallways, so they never get a map node.
     for (std::shared_ptr<level_gen::Edge> &edge : room->_edges) {
+      if (!edge->_active) continue;
       edge->_node->setVisible(is_betrayer);
       edge->_node->setColor(cugl::Color4(255, 255, 255, 200));
-      if (!edge->_active) {
-        auto parent = edge->_node->getParent();
-        if (parent) parent->removeChild(edge->_node);
-      }
     }
     // Make all the rooms invisible unless a betrayer.
     room->_node->setVisible(is_betrayer);
@@ -145,9 +145,7 @@ class LevelController : public Controller {
    * @param controller The particle controller.
    */
   void setParticleController(
-      const std::shared_ptr<ParticleController> &controller) {
-    _particle_controller = controller;
-  }
+      const std::shared_ptr<ParticleController> &controller);
 
  private:
   /**
@@ -2,6 +2,101 @@
 
 #include "Random.h"
 
+namespace {
+
+/**
+ * Advance a xorshift32 random number generator.
+ * @param state The generator state, which must never be 0.
+ * @return A random float in the range [0, 1).
+ */
+inline float nextFloat(Uint32& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  // Only use the top 24 bits, which a float can represent exactly.
+  return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * Evaluate an easing function without going through a std::function. The
+ * simple curves are inlined, the rest are direct calls into
+ * cugl::EasingFunction.
+ * @param type The easing function type.
+ * @param t The time in the range [0, 1].
+ * @return The eased time.
+ */
+inline float ease(cugl::EasingFunction::Type type, float t) {
+  using Type = cugl::EasingFunction::Type;
+  switch (type) {
+    case Type::LINEAR:
+      return t;
+    case Type::SINE_IN:
+      return 1.0f - cosf(t * (float)M_PI_2);
+    case Type::SINE_OUT:
+      return sinf(t * (float)M_PI_2);
+    case Type::SINE_IN_OUT:
+      return -0.5f * (cosf((float)M_PI * t) - 1);
+    case Type::QUAD_IN:
+      return t * t;
+    case Type::QUAD_OUT:
+      return -t * (t - 2);
+    case Type::CUBIC_IN:
+      return t * t * t;
+    case Type::CUBIC_OUT:
+      t -= 1;
+      return t * t * t + 1;
+    case Type::QUAD_IN_OUT:
+      return cugl::EasingFunction::quadInOut(t);
+    case Type::CUBIC_IN_OUT:
+      return cugl::EasingFunction::cubicInOut(t);
+    case Type::QUART_IN:
+      return cugl::EasingFunction::quartIn(t);
+    case Type::QUART_OUT:
+      return cugl::EasingFunction::quartOut(t);
+    case Type::QUART_IN_OUT:
+      return cugl::EasingFunction::quartInOut(t);
+    case Type::QUINT_IN:
+      return cugl::EasingFunction::quintIn(t);
+    case Type::QUINT_OUT:
+      return cugl::EasingFunction::quintOut(t);
+    case Type::QUINT_IN_OUT:
+      return cugl::EasingFunction::quintInOut(t);
+    case Type::EXPO_IN:
+      return cugl::EasingFunction::expoIn(t);
+    case Type::EXPO_OUT:
+      return cugl::EasingFunction::expoOut(t);
+    case Type::EXPO_IN_OUT:
+      return cugl::EasingFunction::expoInOut(t);
+    case Type::CIRC_IN:
+      return cugl::EasingFunction::circIn(t);
+    case Type::CIRC_OUT:
+      return cugl::EasingFunction::circOut(t);
+    case Type::CIRC_IN_OUT:
+      return cugl::EasingFunction::circInOut(t);
+    case Type::BACK_IN:
+      return cugl::EasingFunction::backIn(t);
+    case Type::BACK_OUT:
+      return cugl::EasingFunction::backOut(t);
+    case Type::BACK_IN_OUT:
+      return cugl::EasingFunction::backInOut(t);
+    case Type::BOUNCE_IN:
+      return cugl::EasingFunction::bounceIn(t);
+    case Type::BOUNCE_OUT:
+      return cugl::EasingFunction::bounceOut(t);
+    case Type::BOUNCE_IN_OUT:
+      return cugl::EasingFunction::bounceInOut(t);
+    case Type::ELASTIC_IN:
+      return cugl::EasingFunction::elasticIn(t, ELASTIC_PERIOD);
+    case Type::ELASTIC_OUT:
+      return cugl::EasingFunction::elasticOut(t, ELASTIC_PERIOD);
+    case Type::ELASTIC_IN_OUT:
+      return cugl::EasingFunction::elasticInOut(t, ELASTIC_PERIOD);
+  }
+  return t;
+}
+
+}  // namespace
+
 #pragma mark -
 #pragma mark ParticlePropsSetters
 
@@ -92,7 +187,7 @@ ParticleProps* ParticleProps::setPathVariation(float var) {
 }
 
 ParticleProps* ParticleProps::setEasingFunction(
-    const std::function<float(float)>& easing_function) {
+    cugl::EasingFunction::Type easing_function) {
   if (_type == PATH) {
     _easing = easing_function;
     _easing_separate = false;
@@ -101,7 +196,7 @@ ParticleProps* ParticleProps::setEasingFunction(
 }
 
 ParticleProps* ParticleProps::setEasingFunctionPosX(
-    const std::function<float(float)>& easing_function) {
+    cugl::EasingFunction::Type easing_function) {
   if (_type == PATH) {
     _easing_pos_x = easing_function;
     _easing_separate = true;
@@ -110,7 +205,7 @@ ParticleProps* ParticleProps::setEasingFunctionPosX(
 }
 
 ParticleProps* ParticleProps::setEasingFunctionPosY(
-    const std::function<float(float)>& easing_function) {
+    cugl::EasingFunction::Type easing_function) {
   if (_type == PATH) {
     _easing_pos_y = easing_function;
     _easing_separate = true;
@@ -176,154 +271,270 @@ bool ParticleController::init(
   _particle_world = particle_world;
   _particle_screen = particle_screen;
 
-  _particle_pool.resize(kMaxNumOfParticles + kMaxNumOfParticlesScreen);
-
-  // Add children backwards to render oldest first.
-  for (int i = kMaxNumOfParticles - 1; i >= 0; i--) {
-    using namespace cugl;
-    Particle& particle = _particle_pool[i];
-    particle.node = scene2::PolygonNode::allocWithPoly(Rect(0, 0, 1, 1));
-    particle.node->setVisible(false);
-    particle.active = false;
-    _particle_world->addChild(particle.node);
-  }
-
-  // Add children backwards to render oldest first.
-  for (int i = (int)_particle_pool.size() - 1; i >= kMaxNumOfParticles; i--) {
-    using namespace cugl;
-    Particle& particle = _particle_pool[i];
-    particle.node = scene2::PolygonNode::allocWithPoly(Rect(0, 0, 1, 1));
-    particle.node->setVisible(false);
-    particle.active = false;
-    particle.node->setPosition(_particle_screen->getContentSize() / 2);
-    _particle_screen->addChild(particle.node);
-  }
+  size_t size = kMaxNumOfParticles + kMaxNumOfParticlesScreen;
+  _state.resize(size);
+  _active.assign(size, 0);
+  _ordered.assign(size, 0);
+  _life_remaining.assign(size, 0);
+  _wait_remaining.assign(size, 0);
+  _life.assign(size, 0);
+  _step.assign(size, 0);
+  _pos_x.assign(size, 0);
+  _pos_y.assign(size, 0);
+  _vel_x.assign(size, 0);
+  _vel_y.assign(size, 0);
+  _dist_x.assign(size, 0);
+  _dist_y.assign(size, 0);
+  _angle.assign(size, 0);
+  _spin.assign(size, 0);
+  _scale.assign(size, 1);
+  _scale_start.assign(size, 1);
+  _scale_end.assign(size, 1);
+  _color.assign(size, cugl::Color4f::WHITE);
+  _color_start.assign(size, cugl::Color4f::WHITE);
+  _color_end.assign(size, cugl::Color4f::WHITE);
+  _order.resize(size);
+
+  _rng = Random::Get(Random::PARTICLES).next() | 1;
+
+  _top_node = ParticleNode::alloc();
+  _top_node->setPriority(std::numeric_limits<float>::max());
+  _top_node->setVisible(false);
+  _particle_world->addChild(_top_node);
+
+  _screen_node = ParticleNode::alloc();
+  _screen_node->setVisible(false);
+  _particle_screen->addChild(_screen_node);
 
   return true;
 }
 
 void ParticleController::dispose() {
-  _particle_pool.clear();
+  _band_nodes.clear();
+  _room_orders.clear();
+  _state.clear();
+  _active.clear();
+  _top_node = nullptr;
+  _screen_node = nullptr;
   _particle_world = nullptr;
+  _particle_screen = nullptr;
 }
 
 void ParticleController::update(float timestep) {
-  for (Particle& particle : _particle_pool) {
-    if (!particle.active) continue;
+  const int size = static_cast<int>(_state.size());
 
-    if (particle.wait_remaining > 0) {
-      particle.wait_remaining -= timestep;
+  // Retire finished particles and find the ones that advance this frame.
+  for (int i = 0; i < size; i++) {
+    _step[i] = 0;
+    if (!_active[i]) continue;
+
+    if (_wait_remaining[i] > 0) {
+      _wait_remaining[i] -= timestep;
       continue;
     }
 
-    if (particle.life_remaining <= 0) {
-      particle.active = false;
-      particle.node->setVisible(false);
+    if (_life_remaining[i] <= 0) {
+      _active[i] = false;
       continue;
     }
 
-    particle.life_remaining -= timestep;
-    float life = 1.0f - particle.life_remaining / particle.props._life_time;
-
-    if (particle.props._type == ParticleProps::Type::EMIT) {
-      cugl::Vec2 diff = particle.props._velocity * timestep;
-      particle.node->setPosition(particle.node->getPosition() + diff);
-
-    } else if (particle.props._type == ParticleProps::Type::PATH) {
-      float a = particle.props._easing(life);
-
-      // Variate path pos from path slightly.
-      cugl::Vec2 path_pos;
-
-      if (particle.props._easing_separate) {
-        float a_x = particle.props._easing_pos_x(life);
-        path_pos.x = particle.props._pos_end.x * a_x +
-                     particle.props._pos_start.x * (1 - a_x);
-        float a_y = particle.props._easing_pos_y(life);
-        path_pos.y = particle.props._pos_end.y * a_y +
-                     particle.props._pos_start.y * (1 - a_y);
-      } else {
-        cugl::Vec2 dist = particle.props._pos_end - particle.props._pos_start;
-        path_pos = dist * a + particle.props._pos_start;
-      }
+    _life_remaining[i] -= timestep;
+    _life[i] = 1.0f - _life_remaining[i] / _state[i].life_time;
+    _step[i] = timestep;
+  }
+
+  updatePaths(timestep);
+
+  // The loops below have no branches, so the compiler can vectorize them.
+  // Particles that do not advance have a step of 0 and keep their life.
+  for (int i = 0; i < size; i++) {
+    _pos_x[i] += _vel_x[i] * _step[i];
+    _pos_y[i] += _vel_y[i] * _step[i];
+    _angle[i] += _spin[i] * _step[i];
+  }
 
-      cugl::Vec2 dS = path_pos - particle.node->getPosition();
-      cugl::Vec2 perp = (dS).getNormalization().getPerp();
+  for (int i = 0; i < size; i++) {
+    float life = _life[i];
+    _scale[i] = _scale_start[i] * (1.f - life) + _scale_end[i] * life;
+  }
 
-      // Quadratic function, max at a = 0.5.
-      // So max variation on middle of path.
-      float diff = -0.4f * (2 * a - 1) * (2 * a - 1) +
-                   1 * particle.props._path_variation;
-      // Vary between going towards center and away.
-      diff *= (Random::Float() * 2 - 1);
+  for (int i = 0; i < size; i++) {
+    float life = std::min(std::max(_life[i], 0.0f), 1.0f);
+    const cugl::Color4f& start = _color_start[i];
+    const cugl::Color4f& end = _color_end[i];
+    cugl::Color4f& color = _color[i];
+    color.r = start.r + (end.r - start.r) * life;
+    color.g = start.g + (end.g - start.g) * life;
+    color.b = start.b + (end.b - start.b) * life;
+    color.a = start.a + (end.a - start.a) * life;
+  }
+
+  writeQuads();
+}
 
-      particle.dist_from_path +=
-          (perp * diff * timestep) * (Random::Float() - a);
+void ParticleController::updatePaths(float timestep) {
+  const int size = static_cast<int>(_state.size());
+  for (int i = 0; i < size; i++) {
+    ParticleState& state = _state[i];
+    if (_step[i] == 0 || state.type != ParticleProps::Type::PATH) continue;
 
-      particle.node->setPosition(path_pos + particle.dist_from_path);
+    float life = _life[i];
+    float a = ease(state.easing, life);
+
+    // Variate path pos from path slightly.
+    cugl::Vec2 path_pos;
+
+    if (state.easing_separate) {
+      float a_x = ease(state.easing_pos_x, life);
+      path_pos.x = state.pos_end.x * a_x + state.pos_start.x * (1 - a_x);
+      float a_y = ease(state.easing_pos_y, life);
+      path_pos.y = state.pos_end.y * a_y + state.pos_start.y * (1 - a_y);
+    } else {
+      cugl::Vec2 dist = state.pos_end - state.pos_start;
+      path_pos = dist * a + state.pos_start;
     }
 
-    particle.node->setAngle(particle.node->getAngle() +
-                            particle.props._angular_speed *
-                                particle.props._clockwise * timestep);
+    cugl::Vec2 dS = path_pos - cugl::Vec2(_pos_x[i], _pos_y[i]);
+    cugl::Vec2 perp = (dS).getNormalization().getPerp();
+
+    // Quadratic function, max at a = 0.5.
+    // So max variation on middle of path.
+    float diff = -0.4f * (2 * a - 1) * (2 * a - 1) + 1 * state.path_variation;
+    // Vary between going towards center and away.
+    diff *= (nextFloat(state.rng) * 2 - 1);
+
+    cugl::Vec2 dist_diff =
+        (perp * diff * timestep) * (nextFloat(state.rng) - a);
+    _dist_x[i] += dist_diff.x;
+    _dist_y[i] += dist_diff.y;
 
-    cugl::Color4 color = particle.props._color_start;
-    particle.node->setColor(color.lerp(particle.props._color_end, life));
-    particle.node->setScale(particle.props._scale_start * (1.f - life) +
-                            particle.props._scale_end * life);
+    _pos_x[i] = path_pos.x + _dist_x[i];
+    _pos_y[i] = path_pos.y + _dist_y[i];
   }
 }
 
+void ParticleController::writeQuads() {
+  _top_node->clearQuads();
+  _screen_node->clearQuads();
+  for (auto& it : _band_nodes) it.second->clearQuads();
+
+  // Walk the pools backwards to draw the oldest particles first.
+  for (int i = static_cast<int>(_state.size()) - 1; i >= 0; i--) {
+    if (!_active[i]) continue;
+
+    ParticleNode* node = _top_node.get();
+    if (i >= kMaxNumOfParticles) {
+      node = _screen_node.get();
+    } else if (_ordered[i]) {
+      const RoomOrder& order = _order[i];
+      float row = (_pos_y[i] - order.origin_y) / order.row_height + 1;
+      float priority = order.num_rows - row;
+      node = getBandNode(static_cast<int>(floorf(priority * kBandsPerRow)));
+    }
+
+    const cugl::Color4f& color = _color[i];
+    node->addQuad(_pos_x[i], _pos_y[i], _scale[i], _angle[i],
+                  cugl::Color4(color).getPacked());
+  }
+
+  _top_node->setVisible(_top_node->getNumQuads() > 0);
+  _screen_node->setVisible(_screen_node->getNumQuads() > 0);
+  // Hidden nodes are skipped entirely when the world is sorted.
+  for (auto& it : _band_nodes) {
+    it.second->setVisible(it.second->getNumQuads() > 0);
+  }
+}
+
+ParticleNode* ParticleController::getBandNode(int band) {
+  auto it = _band_nodes.find(band);
+  if (it != _band_nodes.end()) return it->second.get();
+
+  std::shared_ptr<ParticleNode> node = ParticleNode::alloc();
+  node->setPriority((band + 0.5f) / kBandsPerRow);
+  _particle_world->addChild(node);
+  _band_nodes[band] = node;
+  return node.get();
+}
+
 void ParticleController::emit(const ParticleProps& props, int num,
                               float buff_time) {
   for (int i = 0; i < num; i++) {
-    Particle* particle = &_particle_pool[_pool_index];
-    if (props._is_screen_coord) {
-      particle = &_particle_pool[_pool_index_screen];
-    }
+    int index = (props._is_screen_coord) ? _pool_index_screen : _pool_index;
 
-    if (!props._force && particle->active) {
+    if (!props._force && _active[index]) {
       return;
     }
 
     if (props._is_screen_coord) {
-      _pool_index_screen = --_pool_index_screen;
+      _pool_index_screen--;
       if (_pool_index_screen == kMaxNumOfParticles - 1)
-        _pool_index_screen = (int)_particle_pool.size() - 1;
+        _pool_index_screen = (int)_state.size() - 1;
     } else {
-      _pool_index = --_pool_index;
+      _pool_index--;
       if (_pool_index == -1) _pool_index = kMaxNumOfParticles - 1;
     }
 
-    particle->props = props;
-    particle->active = true;
-    particle->node->setVisible(true);
-    particle->life_remaining = props._life_time;
-    particle->wait_remaining = props._wait_time + (buff_time * i);
+    ParticleState& state = _state[index];
+    state.type = props._type;
+    state.life_time = props._life_time;
+    _active[index] = true;
+    _life_remaining[index] = props._life_time;
+    _wait_remaining[index] = props._wait_time + (buff_time * i);
+    _life[index] = 0;
+    _angle[index] = 0;
+    _spin[index] = props._angular_speed * props._clockwise;
+    _dist_x[index] = 0;
+    _dist_y[index] = 0;
 
     if (props._type == ParticleProps::Type::EMIT) {
-      particle->props._position +=
-          particle->props._position_variation *
-          cugl::Vec2(Random::Float() * 2 - 1, Random::Float() * 2 - 1);
-      particle->node->setPosition(props._position);
-
-      particle->props._velocity +=
-          particle->props._velocity_variation *
-          cugl::Vec2(Random::Float() * 2 - 1, Random::Float() * 2 - 1);
+      _pos_x[index] = props._position.x;
+      _pos_y[index] = props._position.y;
+
+      cugl::Vec2 velocity =
+          props._velocity +
+          props._velocity_variation *
+              cugl::Vec2(nextFloat(_rng) * 2 - 1, nextFloat(_rng) * 2 - 1);
+      _vel_x[index] = velocity.x;
+      _vel_y[index] = velocity.y;
     } else if (props._type == ParticleProps::Type::PATH) {
-      particle->props._pos_start +=
-          particle->props._position_variation *
-          cugl::Vec2(Random::Float() * 2 - 1, Random::Float() * 2 - 1);
-      particle->props._pos_end +=
-          particle->props._position_variation *
-          cugl::Vec2(Random::Float() * 2 - 1, Random::Float() * 2 - 1);
-
-      particle->node->setPosition(props._pos_start);
+      state.pos_start =
+          props._pos_start +
+          props._position_variation *
+              cugl::Vec2(nextFloat(_rng) * 2 - 1, nextFloat(_rng) * 2 - 1);
+      state.pos_end =
+          props._pos_end +
+          props._position_variation *
+              cugl::Vec2(nextFloat(_rng) * 2 - 1, nextFloat(_rng) * 2 - 1);
+      state.path_variation = props._path_variation;
+      state.easing = props._easing;
+      state.easing_pos_x = props._easing_pos_x;
+      state.easing_pos_y = props._easing_pos_y;
+      state.easing_separate = props._easing_separate;
+      // Hash the emitter state so neighboring particles do not share a
+      // sequence, and keep the low bit set since xorshift must not be 0.
+      nextFloat(_rng);
+      state.rng = (_rng * 747796405u + 2891336453u) | 1;
+
+      _pos_x[index] = props._pos_start.x;
+      _pos_y[index] = props._pos_start.y;
+      _vel_x[index] = 0;
+      _vel_y[index] = 0;
     }
 
-    particle->node->setColor(props._color_start);
-    particle->node->setScale(props._scale_start);
-    if (!props._is_screen_coord)
-      particle->node->setPriority(std::numeric_limits<float>::max());
+    _scale_start[index] = props._scale_start;
+    _scale_end[index] = props._scale_end;
+    _scale[index] = props._scale_start;
+    _color_start[index] = cugl::Color4f(props._color_start);
+    _color_end[index] = cugl::Color4f(props._color_end);
+    _color[index] = _color_start[index];
+
+    _ordered[index] = false;
+    if (!props._is_screen_coord && props._order) {
+      auto it = _room_orders.find(props._room_id);
+      if (it != _room_orders.end()) {
+        _ordered[index] = true;
+        _order[index] = it->second;
+      }
+    }
   }
 }
@@ -3,6 +3,9 @@
 
 #include <cugl/cugl.h>
 
+#include <unordered_map>
+
+#include "../models/ParticleNode.h"
 #include "Controller.h"
 
 #pragma mark -
@@ -35,7 +38,7 @@ class ParticleProps {
   // Path particle properties
   cugl::Vec2 _pos_start, _pos_end;
   float _path_variation;
-  std::function<float(float)> _easing, _easing_pos_x, _easing_pos_y;
+  cugl::EasingFunction::Type _easing, _easing_pos_x, _easing_pos_y;
   bool _easing_separate;
 
   // Shared values between state
@@ -62,9 +65,9 @@ class ParticleProps {
         _clockwise(true),
         _path_variation(1.0f),
         _easing_separate(false),
-        _easing(cugl::EasingFunction::linear),
-        _easing_pos_x(cugl::EasingFunction::linear),
-        _easing_pos_y(cugl::EasingFunction::linear),
+        _easing(cugl::EasingFunction::Type::LINEAR),
+        _easing_pos_x(cugl::EasingFunction::Type::LINEAR),
+        _easing_pos_y(cugl::EasingFunction::Type::LINEAR),
         _color_start(cugl::Color4::WHITE),
         _color_end(cugl::Color4::WHITE) {}
 
@@ -247,30 +250,29 @@ class ParticleProps {
   /**
    * Set the easing function for traversing the path of a PATH particle. If
    * this particle isn't an PATH type, this function will not do anything.
-   * @param easing_function The easing function cugl::EasingFunction::...
+   * @param easing_function The easing function type.
    */
-  ParticleProps* setEasingFunction(
-      const std::function<float(float)>& easing_function);
+  ParticleProps* setEasingFunction(cugl::EasingFunction::Type easing_function);
   /**
    * Get the easing function for traversing the path of a PATH particle.
-   * @return The easing function.
+   * @return The easing function type.
    */
-  std::function<float(float)> getEasingFunction() const { return _easing; }
+  cugl::EasingFunction::Type getEasingFunction() const { return _easing; }
 
   /**
    * Set the easing function for the x position while traversing the path of a
    * PATH particle. If this particle isn't an PATH type, this function will not
    * do anything.
-   * @param easing_function The easing function cugl::EasingFunction::...
+   * @param easing_function The easing function type.
    */
   ParticleProps* setEasingFunctionPosX(
-      const std::function<float(float)>& easing_function);
+      cugl::EasingFunction::Type easing_function);
   /**
    * Get the easing function for the x position traversing the path of a PATH
    * particle.
-   * @return The easing function.
+   * @return The easing function type.
    */
-  std::function<float(float)> getEasingFunctionPosX() const {
+  cugl::EasingFunction::Type getEasingFunctionPosX() const {
     return _easing_pos_x;
   }
 
@@ -278,16 +280,16 @@ class ParticleProps {
    * Set the easing function for the y position while traversing the path of a
    * PATH particle. If this particle isn't an PATH type, this function will not
    * do anything.
-   * @param easing_function The easing function cugl::EasingFunction::...
+   * @param easing_function The easing function type.
    */
   ParticleProps* setEasingFunctionPosY(
-      const std::function<float(float)>& easing_function);
+      cugl::EasingFunction::Type easing_function);
   /**
    * Get the easing function for the y position traversing the path of a PATH
    * particle.
-   * @return The easing function.
+   * @return The easing function type.
    */
-  std::function<float(float)> getEasingFunctionPosY() const {
+  cugl::EasingFunction::Type getEasingFunctionPosY() const {
     return _easing_pos_y;
   }
 
@@ -396,23 +398,44 @@ class ParticleProps {
 /**
  * This is the particle controller that handles creating and destroying
  * particles in the game.
+ *
+ * Particles are not scene graph nodes. The state of every particle is kept in
+ * parallel arrays, and at the end of every update the live particles are
+ * written as quads into a few ParticleNodes, which each draw all their quads
+ * with one drawMesh call. Ordered world particles are split over one node per
+ * sort-key band, so they still interleave with the y-sorted world.
  */
 class ParticleController : public Controller {
  public:
-  /** A struct to represent a particle on the screen. */
-  struct Particle {
-    /** A copy of the props that define the particle. */
-    ParticleProps props;
-    /** The node for displaying the particle. */
-    std::shared_ptr<cugl::scene2::PolygonNode> node = nullptr;
-    /** The life remaining in the particle. */
-    float life_remaining = 0.0f;
-    /** The wait remaining in the particle. */
-    float wait_remaining = 0.0f;
-    /** Weather the particle is active. */
-    bool active = false;
-    /** The distance from the path, used by PATH particles.*/
-    cugl::Vec2 dist_from_path;
+  /**
+   * The part of a particle's props that update still needs after the
+   * particle is emitted. Emitting copies this instead of the whole props.
+   */
+  struct ParticleState {
+    /** The type of the particle. */
+    ParticleProps::Type type;
+    /** The state of the particle's xorshift random number generator. */
+    Uint32 rng;
+    /** The lifetime of the particle in seconds. */
+    float life_time;
+    /** How far the particle deviates from its path, for PATH particles. */
+    float path_variation;
+    /** The start and end of the path, for PATH particles. */
+    cugl::Vec2 pos_start, pos_end;
+    /** The easing functions along the path, for PATH particles. */
+    cugl::EasingFunction::Type easing, easing_pos_x, easing_pos_y;
+    /** Whether the x and y positions use separate easing functions. */
+    bool easing_separate;
+  };
+
+  /** How a room turns a particle's y position into a draw priority. */
+  struct RoomOrder {
+    /** The y position of the bottom of the room. */
+    float origin_y;
+    /** The height of one tile row. */
+    float row_height;
+    /** The height of the room in tile rows. */
+    float num_rows;
   };
 
  private:
@@ -422,16 +445,62 @@ class ParticleController : public Controller {
   /** A reference to the scene2 screen for particles.*/
   std::shared_ptr<cugl::scene2::SceneNode> _particle_screen;
 
-  /**
-   * A pool of all the particles.
+  /** The node drawing the screen particles. */
+  std::shared_ptr<ParticleNode> _screen_node;
+
+  /** The node drawing the world particles that are not ordered. */
+  std::shared_ptr<ParticleNode> _top_node;
+
+  /** The nodes drawing the ordered world particles, keyed by band. */
+  std::unordered_map<int, std::shared_ptr<ParticleNode>> _band_nodes;
+
+  /** The draw ordering of every room particles can be ordered in. */
+  std::unordered_map<int, RoomOrder> _room_orders;
+
+  /*
+   * The particle pool, one entry per particle in each array.
    * [ World Particles | Screen Particles]
-   * */
-  std::vector<Particle> _particle_pool;
+   */
+
+  /** The state of each particle taken from its props. */
+  std::vector<ParticleState> _state;
+  /** Whether each particle is active. */
+  std::vector<Uint8> _active;
+  /** Whether each particle is drawn in a y-sorted band. */
+  std::vector<Uint8> _ordered;
+  /** The life remaining in each particle. */
+  std::vector<float> _life_remaining;
+  /** The wait remaining in each particle. */
+  std::vector<float> _wait_remaining;
+  /** How far through its life each particle is, from 0 to 1. */
+  std::vector<float> _life;
+  /** The time each particle advances this frame, 0 if it is waiting. */
+  std::vector<float> _step;
+  /** The position of each particle. */
+  std::vector<float> _pos_x, _pos_y;
+  /** The velocity of each particle, 0 for PATH particles. */
+  std::vector<float> _vel_x, _vel_y;
+  /** The distance from the path, used by PATH particles. */
+  std::vector<float> _dist_x, _dist_y;
+  /** The angle and signed angular speed of each particle. */
+  std::vector<float> _angle, _spin;
+  /** The current, starting and ending size of each particle. */
+  std::vector<float> _scale, _scale_start, _scale_end;
+  /** The current, starting and ending color of each particle. */
+  std::vector<cugl::Color4f> _color, _color_start, _color_end;
+  /** The ordering of the room each ordered particle spawned in. */
+  std::vector<RoomOrder> _order;
 
   /** The max number of particles in world. */
   const int kMaxNumOfParticles = 800;
   /** The max number of particles in screen. */
   const int kMaxNumOfParticlesScreen = 200;
+  /**
+   * The number of sort-key bands per tile row. Ordered particles are drawn
+   * at the priority of the center of their band, so they can be at most half
+   * a band off from where a particle node would have been sorted.
+   */
+  const int kBandsPerRow = 4;
 
   /** The current pool index. */
   int _pool_index;
@@ -439,11 +508,15 @@ class ParticleController : public Controller {
   /** The current pool index screen. */
   int _pool_index_screen;
 
+  /** The xorshift state used to vary and seed newly emitted particles. */
+  Uint32 _rng;
+
  public:
   /** Construct an empty particle controller, use alloc instead */
   ParticleController()
       : _pool_index(kMaxNumOfParticles - 1),
-        _pool_index_screen(kMaxNumOfParticlesScreen + kMaxNumOfParticles - 1) {}
+        _pool_index_screen(kMaxNumOfParticlesScreen + kMaxNumOfParticles - 1),
+        _rng(1) {}
   /** Destroy the particle controller */
   ~ParticleController() { dispose(); }
 
@@ -487,10 +560,32 @@ class ParticleController : public Controller {
   void emit(const ParticleProps& props, int num = 1, float buff_time = 0.0f);
 
   /**
-   * Get the pool of particles.
-   * @return The pool of particles.
+   * Set how particles spawned in the given room are ordered with the world.
+   * The priority matches the one the level controller gives players and
+   * enemies in the room.
+   * @param room_id The room id given to ParticleProps::setRoomId().
+   * @param order The ordering of the room.
+   */
+  void setRoomOrder(int room_id, const RoomOrder& order) {
+    _room_orders[room_id] = order;
+  }
+
+ private:
+  /**
+   * Advance all the PATH particles along their path.
+   * @param timestep The amount of time since last frame in seconds.
+   */
+  void updatePaths(float timestep);
+
+  /** Write every active particle as a quad into its particle node. */
+  void writeQuads();
+
+  /**
+   * Get the particle node for the given sort-key band, creating it if needed.
+   * @param band The band index.
+   * @return The particle node for the band.
    */
-  std::vector<Particle>& getParticles() { return _particle_pool; }
+  ParticleNode* getBandNode(int band);
 };
 
-#endif  // CONTROLLERS_PARTICLE_CONTROLLER_H_
\ No newline at end of file
+#endif  // CONTROLLERS_PARTICLE_CONTROLLER_H_
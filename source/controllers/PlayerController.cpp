@@ -28,12 +28,12 @@
 
 #define MIN_POS_CHANGE 0.5f
 
-// The max number of milliseconds between player network position updates.
+// The max number of milliseconds to move between player network positions.
 #define PLAYER_NETWORK_POS_UPDATE_MAX 100.0f
 
 #pragma mark PlayerController
 
-PlayerController::PlayerController(){};
+PlayerController::PlayerController() : _spectator(false){};
 
 bool PlayerController::init(
     const std::shared_ptr<cugl::AssetManager>& assets,
@@ -65,6 +65,10 @@ bool PlayerController::init(
       ->setLifeTime(1.f);
 
   NetworkController::get()->addListener(
+      {NC_HOST_ALL_PLAYER_INFO, NC_HOST_ALL_PLAYER_OTHER_INFO,
+       NC_HOST_ALL_PLAYER_BASIC_INFO, NC_CLIENT_ONE_PLAYER_INFO,
+       NC_CLIENT_PLAYER_OTHER_INFO, NC_CLIENT_PLAYER_BASIC_INFO,
+       NC_TERMINAL_ENERGY_UPDATE},
       [=](const Sint32& code,
           const cugl::CustomNetworkDeserializer::CustomMessage& msg) {
         this->processData(code, msg);
@@ -77,6 +81,7 @@ void PlayerController::update(float timestep) {
   for (auto it : _players) {
     if (it.first != _player->getPlayerId()) interpolate(timestep, it.second);
   }
+  if (_spectator) return;
 
   move(timestep);
   attack();
@@ -145,6 +150,7 @@ std::shared_ptr<Player> PlayerController::makePlayer(int player_id) {
 
   auto player_node = cugl::scene2::SpriteNode::alloc(player, 12, 10);
   new_player->setPlayerNode(player_node);
+  new_player->setAnimator(_animator);
   _world_node->addChild(player_node);
   _world->addObstacle(new_player);
 
@@ -210,7 +216,12 @@ void PlayerController::processData(
       auto info = std::dynamic_pointer_cast<cugl::TerminalUpdate>(
           std::get<std::shared_ptr<cugl::Serializable>>(msg));
       if (info->player_id == _player->getPlayerId()) {
-        _player->setEnergy(info->player_energy);
+        float energy = info->player_energy;
+        if (_input_predictor != nullptr) {
+          _input_predictor->acknowledge(info->ack);
+          energy = _input_predictor->reconcileEnergy(energy);
+        }
+        _player->setEnergy(energy);
         _player->setCorruptedEnergy(info->player_corrupted_energy);
       }
     } break;
@@ -246,7 +257,11 @@ void PlayerController::processPlayerOtherInfo(int player_id, int energy,
                                               int corruption) {
   auto player = getPlayerOrMakePlayer(player_id);
 
-  player->setEnergy(energy);
+  if (player == _player && _input_predictor != nullptr) {
+    player->setEnergy(_input_predictor->reconcileEnergy(energy));
+  } else {
+    player->setEnergy(energy);
+  }
   player->setCorruptedEnergy(corruption);
 }
 
@@ -301,9 +316,14 @@ void PlayerController::interpolate(float timestep,
   cugl::Vec2 cur_pos = old_pos;
 
   float time = player->getTimeSinceLastNetworkPosUpdate();
-
-  if (time <= PLAYER_NETWORK_POS_UPDATE_MAX) {
-    cur_pos.lerp(new_pos, time / PLAYER_NETWORK_POS_UPDATE_MAX);
+  player->advanceNetworkPosTime(timestep * 1000.0f);
+
+  // Positions arrive as often as the host schedules them, so the player
+  // takes as long to reach the new one as it took to arrive.
+  float duration = std::min(player->getNetworkPosInterval(),
+                            PLAYER_NETWORK_POS_UPDATE_MAX);
+  if (time < duration) {
+    cur_pos.lerp(new_pos, time / duration);
   } else {
     cur_pos = new_pos;
   }
@@ -359,7 +379,6 @@ void PlayerController::attack() {
           _player->getPlayerNode()->setColor(cugl::Color4::WHITE);
         }
         if (_player->_attack_frame_count == ATTACK_FRAMES) {
-          _player->_frame_count = 0;
           // Play player swing sound effect.
           _sound_controller->playPlayerSwing();
 
@@ -400,7 +419,6 @@ void PlayerController::attack() {
       // If done attacking, switch to Idle.
       if (_player->_attack_frame_count <= 0) {
         _player->setState(Player::IDLE);
-        _player->_frame_count = 0;
         _sword->setEnabled(false);
         _player->_attack_frame_count = ATTACK_FRAMES;
       }
@@ -448,10 +466,17 @@ void PlayerController::updateSlashes(float timestep) {
 void PlayerController::removePlayer(int id) {
   if (_players.find(id) == _players.end()) return;
   _trail_managers[id]->dispose();
+  _players[id]->setAnimator(nullptr);
   _world->removeObstacle(_players[id].get());
   _players.erase(id);
 }
 
+void PlayerController::makeSpectator() {
+  _spectator = true;
+  removePlayer(_player->getPlayerId());
+  _player->getPlayerNode()->setVisible(false);
+}
+
 void PlayerController::addTrailManager(const std::shared_ptr<Player>& player) {
   TrailManager::Config config;
   config.max_length = 5;
@@ -6,6 +6,8 @@
 #include "../models/Projectile.h"
 #include "../models/Sword.h"
 #include "../network/CustomNetworkSerializer.h"
+#include "../network/InputPredictor.h"
+#include "Animator.h"
 #include "Controller.h"
 #include "InputController.h"
 #include "ParticleController.h"
@@ -40,6 +42,10 @@ class PlayerController : public Controller {
   std::shared_ptr<SoundController> _sound_controller;
   /** A reference to the particle controller. */
   std::shared_ptr<ParticleController> _particle_controller;
+  /** A reference to the animator for the player sprites. */
+  std::shared_ptr<Animator> _animator;
+  /** The inputs of this client the host has not confirmed. */
+  std::shared_ptr<InputPredictor> _input_predictor;
 
   /** A grass particle prop. */
   ParticleProps _grass_particle;
@@ -47,6 +53,9 @@ class PlayerController : public Controller {
   /** A map from player id to color id. */
   std::unordered_map<int, int> _color_ids;
 
+  /** If my player only watches the game, as on a dedicated host. */
+  bool _spectator;
+
  public:
 #pragma mark Constructors
   /** Creates a new enemy controller with the default settings. */
@@ -91,6 +100,15 @@ class PlayerController : public Controller {
     _sound_controller = controller;
   }
 
+  /**
+   * Set the predictor for the inputs of this client, so that host updates of
+   * the player keep the inputs the host has not processed yet.
+   * @param predictor The input predictor.
+   */
+  void setInputPredictor(const std::shared_ptr<InputPredictor>& predictor) {
+    _input_predictor = predictor;
+  }
+
   /**
    * Set the particle controller for particles.
    * @param controller The particle controller.
@@ -100,6 +118,15 @@ class PlayerController : public Controller {
     _particle_controller = controller;
   }
 
+  /**
+   * Set the animator for the player sprites. Must be set before any player
+   * is made.
+   * @param animator The animator.
+   */
+  void setAnimator(const std::shared_ptr<Animator>& animator) {
+    _animator = animator;
+  }
+
 #pragma mark Static Constructors
   /**
    * Returns a new enemy controller.
@@ -214,6 +241,19 @@ class PlayerController : public Controller {
 
   void setMyPlayer(const std::shared_ptr<Player>& player) { _player = player; }
 
+  /**
+   * Turns my player into a spectator, as on a dedicated host. A spectator is
+   * removed from the player list and the physics world, so it is never sent
+   * to clients, targeted by enemies or counted in a room. Its update only
+   * moves the other players, so it needs no input, sound or particles.
+   *
+   * Must be called after my player is set.
+   */
+  void makeSpectator();
+
+  /** @return If my player only watches the game. */
+  bool isSpectator() const { return _spectator; }
+
   std::shared_ptr<Player> getPlayer(int id) {
     if (_players.find(id) != _players.end()) {
       return _players[id];
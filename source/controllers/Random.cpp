@@ -1,4 +1,9 @@
 #include "Random.h"
 
-std::mt19937 Random::engine;
-std::uniform_int_distribution<std::mt19937::result_type> Random::dist;
\ No newline at end of file
+Uint64 Random::seed = 0;
+std::array<level_gen::Pcg32, Random::NUM_STREAMS> Random::streams;
+
+void Random::Init(Uint64 value) {
+  seed = value;
+  for (int i = 0; i < NUM_STREAMS; i++) streams[i].seed(seed, i);
+}
@@ -1,24 +1,54 @@
 #ifndef CONTROLLERS_RANDOM_H_
 #define CONTROLLERS_RANDOM_H_
 
+#include <array>
 #include <random>
 
+#include "../generators/Pcg32.h"
+
+/**
+ * The random numbers of the game, with one stream per subsystem.
+ *
+ * Every stream is derived from a single seed. Given the same seed, each
+ * subsystem draws the same numbers no matter how much the others draw, so a
+ * match can be replayed exactly (see MatchLog).
+ */
 class Random {
  public:
+  /** The subsystems with their own stream of random numbers. */
+  enum Stream { GENERAL, ENEMIES, PARTICLES, SOUND, NUM_STREAMS };
+
   /** Initialize the random class with a random device seed. */
-  static void Init() { engine.seed(std::random_device()()); }
+  static void Init() {
+    std::random_device rd;
+    Init(((Uint64)rd() << 32) | rd());
+  }
 
   /**
-   * Returns a random number between [0, 1].
+   * Initialize the random class with the given seed.
+   * @param seed The seed of every stream.
+   */
+  static void Init(Uint64 seed);
+
+  /** @return The seed of every stream. */
+  static Uint64 GetSeed() { return seed; }
+
+  /**
+   * Returns the stream of random numbers for a subsystem.
+   * @param stream The subsystem.
+   * @return The generator of the subsystem.
+   */
+  static level_gen::Pcg32& Get(Stream stream) { return streams[stream]; }
+
+  /**
+   * Returns a random number between [0, 1).
    * @return A random number.
    */
-  static float Float() {
-    return (float)dist(engine) / (float)std::numeric_limits<uint32_t>::max();
-  }
+  static float Float() { return streams[GENERAL].nextFloat(); }
 
  private:
-  static std::mt19937 engine;
-  static std::uniform_int_distribution<std::mt19937::result_type> dist;
+  static Uint64 seed;
+  static std::array<level_gen::Pcg32, NUM_STREAMS> streams;
 };
 
-#endif  // CONTROLLERS_RANDOM_H_
\ No newline at end of file
+#endif  // CONTROLLERS_RANDOM_H_
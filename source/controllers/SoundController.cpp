@@ -1,10 +1,11 @@
 #include "SoundController.h"
 
+#include "Random.h"
+
 bool SoundController::init(const std::shared_ptr<cugl::AssetManager>& assets) {
   _assets = assets;
 
-  std::random_device rd;
-  _generator = std::default_random_engine(rd());
+  _generator.seed(Random::Get(Random::SOUND).next());
 
   initMusic();
   initPlayerSFX();
@@ -15,6 +15,7 @@ bool TerminalController::init(
   _num_terminals_corrupted = 0;
 
   NetworkController::get()->addListener(
+      {NC_DEPOSIT_ENERGY, NC_TERMINAL_ENERGY_UPDATE},
       [=](const Sint32 &code,
           const cugl::CustomNetworkDeserializer::CustomMessage &msg) {
         this->processNetworkData(code, msg);
@@ -116,6 +117,7 @@ void TerminalController::sendTerminalUpdate(
 
   info->num_terminals_activated = _num_terminals_activated;
   info->num_terminals_corrupted = _num_terminals_corrupted;
+  info->ack = NetworkController::get()->getInputAck(player->getPlayerId());
 
   NetworkController::get()->sendAndProcess(NC_TERMINAL_ENERGY_UPDATE, info);
 }
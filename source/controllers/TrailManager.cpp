@@ -1,76 +1,109 @@
 #include "TrailManager.h"
 
+// How far below the sprite the trail is ordered, so it is drawn behind it.
+#define TRAIL_PRIORITY_OFFSET 0.001f
+
 bool TrailManager::init(const std::shared_ptr<cugl::scene2::SpriteNode>& sprite,
                         Config& config) {
   _sprite = sprite;
   _config = config;
   _buffer = 0;
   _run = true;
-  _trail_nodes_pool.clear();
+  _oldest = 0;
+  _count = 0;
+
+  // Sprite meshes are usually a single quad, so this avoids any allocation.
+  _ghosts.resize(_config.max_length);
+  for (Ghost& ghost : _ghosts) {
+    ghost.vertices.reserve(4);
+    ghost.indices.reserve(6);
+  }
+
+  _node = TrailNode::alloc(_sprite->getTexture());
+  if (_sprite->getParent()) _sprite->getParent()->addChild(_node);
 
   return true;
 }
 
 bool TrailManager::init(
     const std::shared_ptr<cugl::scene2::SpriteNode>& sprite) {
-  _sprite = sprite;
-  _buffer = 0;
-  _run = true;
-  _trail_nodes_pool.clear();
-
-  _config.freq = 4;
-  _config.max_length = 5;
-  _config.max_opacity = 255;
-  _config.min_opacity = 200;
-  _config.color = cugl::Color4::WHITE;
+  Config config;
+  config.freq = 4;
+  config.max_length = 5;
+  config.max_opacity = 255;
+  config.min_opacity = 200;
+  config.color = cugl::Color4::WHITE;
 
-  return true;
+  return init(sprite, config);
 }
 
 void TrailManager::dispose() {
   _buffer = 0;
   _run = false;
-  for (auto& node : _trail_nodes_pool) {
-    node->getParent()->removeChild(node);
+  _oldest = 0;
+  _count = 0;
+  _ghosts.clear();
+  if (_node != nullptr && _node->getParent()) {
+    _node->getParent()->removeChild(_node);
   }
-  _trail_nodes_pool.clear();
+  _node = nullptr;
 }
 
-void TrailManager::update() {
-  std::size_t num_nodes = _trail_nodes_pool.size();
-  for (int i = 0; i < num_nodes; i++) {
-    float t = (i / num_nodes);
+void TrailManager::capture(Ghost& ghost) {
+  const cugl::Mesh<cugl::SpriteVertex2>& mesh = _sprite->getMesh();
+  const cugl::Affine2& transform = _sprite->getNodeToParentTransform();
+
+  ghost.vertices.assign(mesh.vertices.begin(), mesh.vertices.end());
+  for (cugl::SpriteVertex2& vert : ghost.vertices) {
+    vert.position *= transform;
+  }
+  ghost.indices.assign(mesh.indices.begin(), mesh.indices.end());
+}
+
+void TrailManager::rebuild() {
+  _node->clearGhosts();
+  for (int i = 0; i < _count; i++) {
+    float t = static_cast<float>(i) / _count;
     int opacity =
         (_config.max_opacity - _config.min_opacity) * t + _config.min_opacity;
 
     cugl::Color4 color = _config.color;
-    color.a *= opacity;
+    color.a = static_cast<Uint8>(color.a * opacity / 255);
 
-    _trail_nodes_pool[i]->setColor(color);
+    const Ghost& ghost = _ghosts[(_oldest + i) % _ghosts.size()];
+    _node->addGhost(ghost.vertices, ghost.indices, color.getPacked());
   }
+}
 
+void TrailManager::update() {
+  int size = static_cast<int>(_ghosts.size());
+  if (size == 0) return;
+
+  bool changed = false;
   if (_run) {
     _buffer++;
     if (_buffer == _config.freq) {
       _buffer = 0;
 
-      if (num_nodes == _config.max_length) {
-        auto node = _trail_nodes_pool.front();
-        _trail_nodes_pool.pop_front();
-        node->getParent()->removeChild(node);
+      // Once the ring is full, the newest ghost replaces the oldest one.
+      int slot = (_oldest + _count) % size;
+      if (_count == size) {
+        _oldest = (_oldest + 1) % size;
+      } else {
+        _count++;
       }
-
-      auto trail_node =
-          cugl::scene2::SpriteNode::alloc(_sprite->getTexture(), 0, 0);
-      _sprite->copy(trail_node);
-      _trail_nodes_pool.push_back(trail_node);
-      auto parent = _sprite->getParent();
-      if (parent) parent->addChild(trail_node);
+      capture(_ghosts[slot]);
+      changed = true;
     }
-  } else if (num_nodes > 0) {
-    auto node = _trail_nodes_pool.front();
-    auto parent = node->getParent();
-    if (parent) parent->removeChild(node);
-    _trail_nodes_pool.pop_front();
+  } else if (_count > 0) {
+    _oldest = (_oldest + 1) % size;
+    _count--;
+    changed = true;
   }
+
+  if (changed) rebuild();
+
+  auto parent = _sprite->getParent();
+  if (_node->getParent() == nullptr && parent) parent->addChild(_node);
+  _node->setPriority(_sprite->getPriority() - TRAIL_PRIORITY_OFFSET);
 }
@@ -3,8 +3,14 @@
 
 #include <cugl/cugl.h>
 
+#include "../models/TrailNode.h"
+
 /**
  * This is a general use class to create a trail from a sprite node.
+ *
+ * The trail is a fixed ring of ghosts that is allocated once. Leaving a ghost
+ * only copies the current sprite mesh into the oldest slot, and all the
+ * ghosts are drawn by a single TrailNode next to the sprite.
  */
 class TrailManager {
  public:
@@ -35,8 +41,36 @@ class TrailManager {
   /** If the manager should be creating trails. */
   bool _run;
 
-  /** The pool of trail nodes. */
-  std::deque<std::shared_ptr<cugl::scene2::SpriteNode>> _trail_nodes_pool;
+  /** A single ghost in the trail. */
+  struct Ghost {
+    /** The sprite vertices when the ghost was left, in parent space. */
+    std::vector<cugl::SpriteVertex2> vertices;
+    /** The triangle indices of the vertices. */
+    std::vector<Uint32> indices;
+  };
+
+  /** The node that draws all the ghosts. */
+  std::shared_ptr<TrailNode> _node;
+
+  /** The ring of ghosts, with max_length slots. */
+  std::vector<Ghost> _ghosts;
+  /** The slot of the oldest ghost. */
+  int _oldest;
+  /** The number of ghosts in the trail. */
+  int _count;
+
+  /**
+   * Copies the current sprite mesh into the given ghost.
+   *
+   * @param ghost The ghost to overwrite.
+   */
+  void capture(Ghost& ghost);
+
+  /**
+   * Rewrites the trail node from the ghosts, oldest first, fading the
+   * older ghosts towards the minimum opacity.
+   */
+  void rebuild();
 
  public:
   TrailManager() {}
@@ -89,7 +123,7 @@ class TrailManager {
   }
 
   /**
-   * Update the trail manager to spawn, modify and delete trail nodes.
+   * Update the trail manager to spawn and delete ghosts.
    */
   void update();
 
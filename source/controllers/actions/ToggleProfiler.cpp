@@ -0,0 +1,37 @@
+#include "ToggleProfiler.h"
+
+/** The number of fingers that toggle the profiler on a touch screen. */
+#define PROFILER_TOUCH_COUNT 3
+/** How long the fingers must be held to toggle the profiler, in ms. */
+#define PROFILER_HOLD_TIME 1500
+
+ToggleProfiler::ToggleProfiler()
+    : _prev_down(false), _curr_down(false), _pause(false), _touching(false) {}
+
+bool ToggleProfiler::init(const std::shared_ptr<cugl::AssetManager> &assets,
+                          cugl::Rect bounds) {
+  Action::init(assets, bounds);
+  return true;
+}
+
+bool ToggleProfiler::update() {
+  _prev_down = _curr_down;
+  if (_pause) {
+    _curr_down = false;
+    return true;
+  }
+
+#ifdef CU_TOUCH_SCREEN
+  cugl::Touchscreen *touch = cugl::Input::get<cugl::Touchscreen>();
+  bool touching = touch->touchCount() >= PROFILER_TOUCH_COUNT;
+  if (touching && !_touching) _touch_start.mark();
+  _touching = touching;
+  _curr_down = touching && cugl::Timestamp().ellapsedMillis(_touch_start) >=
+                               PROFILER_HOLD_TIME;
+#else
+  cugl::Keyboard *keyboard = cugl::Input::get<cugl::Keyboard>();
+  _curr_down = keyboard->keyDown(cugl::KeyCode::P);
+#endif  // CU_TOUCH_SCREEN
+
+  return true;
+}
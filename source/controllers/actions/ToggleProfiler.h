@@ -0,0 +1,100 @@
+#ifndef CONTROLLERS_ACTIONS_TOGGLE_PROFILER_H_
+#define CONTROLLERS_ACTIONS_TOGGLE_PROFILER_H_
+#include <cugl/cugl.h>
+
+#include "Action.h"
+
+// Debug builds can toggle the profiler. Define PROFILER_TOGGLE to allow it in
+// a release build for QA.
+#if !defined(PROFILER_TOGGLE) && \
+    (defined(CU_DEBUG) || defined(DEBUG) || defined(_DEBUG))
+#define PROFILER_TOGGLE
+#endif
+
+/**
+ * This class is an implementation of Action.
+ *
+ * This class lets QA turn the frame profiler on and off. On desktop the
+ * profiler is toggled with the P key, and on touch screens by holding three
+ * fingers down for a while, which normal play never does. No button is
+ * needed in the game UI.
+ *
+ * The action is only attached when PROFILER_TOGGLE is defined, so get
+ * returns nullptr for it in release builds.
+ *
+ * As with all Actions attach to InputController by calling allocating using
+ * alloc and calling getHook(). This is very similar to Walker White's loader
+ * system.
+ */
+class ToggleProfiler : public Action {
+ protected:
+  /* Toggle gesture was held on the last tick. */
+  bool _prev_down;
+  /* Toggle gesture is held on the current tick. */
+  bool _curr_down;
+  /* Input is paused. */
+  bool _pause;
+  /* Enough fingers were down on the last tick to start the toggle gesture. */
+  bool _touching;
+  /* When enough fingers went down for the toggle gesture. */
+  cugl::Timestamp _touch_start;
+
+ public:
+  /**
+   * Sets default variables.
+   * @param assets The loaded assets for this game mode.
+   * @param bounds The scene2 game bounds.
+   * @return If initialized correctly.
+   */
+  virtual bool init(const std::shared_ptr<cugl::AssetManager> &assets,
+                    cugl::Rect bounds) override;
+
+  /**
+   * Updates action state.
+   * @return If updated correctly.
+   */
+  virtual bool update() override;
+
+  /**
+   * Disposes default variables.
+   * @return If disposed correctly.
+   */
+  virtual bool dispose() override { return true; }
+
+  /** Reset all the internal input values. */
+  virtual void reset() override {
+    _prev_down = false;
+    _curr_down = false;
+    _touching = false;
+  }
+
+  /** Pause all input. */
+  virtual void pause() override { _pause = true; }
+
+  /** Resume all input. */
+  virtual void resume() override { _pause = false; }
+
+  /**
+   * This method allocates ToggleProfiler and initializes it.
+   *
+   * @param assets The loaded assets for this game mode.
+   * @param bounds The scene2 game bounds.
+   * @return A newly allocated ToggleProfiler action.
+   */
+  static std::shared_ptr<ToggleProfiler> alloc(
+      const std::shared_ptr<cugl::AssetManager> &assets, cugl::Rect bounds) {
+    std::shared_ptr<ToggleProfiler> result =
+        std::make_shared<ToggleProfiler>();
+    return (result->init(assets, bounds) ? result : nullptr);
+  }
+
+  /**
+   * @return If the player toggled the profiler on this tick.
+   */
+  bool didToggleProfiler() const { return _curr_down && !_prev_down; }
+
+  ToggleProfiler();
+  ~ToggleProfiler() {}
+};
+
+#endif /* CONTROLLERS_ACTIONS_TOGGLE_PROFILER_H_ */
@@ -13,11 +13,6 @@
 #define GUN_NODE_Y_OFFSET 0.59
 #define GUN_MOVE_FRAMES 15
 
-#define DEATH_RIGHT_LOW_LIM 30
-#define DEATH_RIGHT_UP_LIM 54
-#define DEATH_LEFT_LOW_LIM 60
-#define DEATH_LEFT_UP_LIM 84
-
 #define STATE_CHANGE_LIM 10
 
 #pragma mark Shotgunner Controller
@@ -51,7 +46,7 @@ void ShotgunnerController::clientUpdateAttackPlayer(
     if (enemy->getAttackCooldown() == ATTACK_FRAMES) {
       // Add the bullet!
       enemy->addBullet(enemy->getAttackDir());
-      _sound_controller->playEnemySmallGunshot();
+      if (_sound_controller) _sound_controller->playEnemySmallGunshot();
     }
     enemy->reduceAttackCooldown(1);
   }
@@ -67,7 +62,7 @@ void ShotgunnerController::attackPlayer(std::shared_ptr<EnemyModel> enemy,
     }
     if (enemy->getAttackCooldown() == ATTACK_FRAMES) {
       enemy->addBullet(enemy->getAttackDir());
-      _sound_controller->playEnemySmallGunshot();
+      if (_sound_controller) _sound_controller->playEnemySmallGunshot();
     }
     if (enemy->getAttackCooldown() <= 0) {
       std::uniform_int_distribution<int> dist(0.0f, 50.0f);
@@ -251,33 +246,5 @@ void ShotgunnerController::animateDeath(std::shared_ptr<EnemyModel> enemy) {
   auto gun_node = std::dynamic_pointer_cast<cugl::scene2::SpriteNode>(
       enemy->getNode()->getChildByTag(1));
   gun_node->setVisible(false);
-
-  if (node->getFrame() < DEATH_RIGHT_LOW_LIM) {
-    float direc_angle =
-        abs((enemy->getAttackDir() - enemy->getPosition()).getAngle());
-    enemy->setFacingLeft(direc_angle > M_PI / 2);
-    if (enemy->getFacingLeft()) {
-      node->setFrame(DEATH_LEFT_LOW_LIM);
-    } else {
-      node->setFrame(DEATH_RIGHT_LOW_LIM);
-    }
-  } else {
-    if (enemy->_frame_count >= 4) {
-      enemy->_frame_count = 0;
-      int next_frame = node->getFrame() + 1;
-      if (enemy->getFacingLeft()) {
-        if (next_frame == DEATH_LEFT_UP_LIM) {
-          next_frame = DEATH_LEFT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      } else {
-        if (next_frame == DEATH_RIGHT_UP_LIM) {
-          next_frame = DEATH_RIGHT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      }
-      node->setFrame(next_frame);
-    }
-    enemy->_frame_count++;
-  }
+  playDeath(enemy, node, "shotgunner-death");
 }
@@ -11,11 +11,6 @@
 #define MAX_ATTACK_FRAME 69
 #define MIN_ATTACK_FRAME 30
 
-#define DEATH_RIGHT_LOW_LIM 70
-#define DEATH_RIGHT_UP_LIM 88
-#define DEATH_LEFT_LOW_LIM 90
-#define DEATH_LEFT_UP_LIM 108
-
 #define STATE_CHANGE_LIM 10
 
 #pragma mark Tank Controller
@@ -49,7 +44,7 @@ void TankController::clientUpdateAttackPlayer(
     if (enemy->getAttackCooldown() == ATTACK_FRAMES) {
       // Begin actual dash.
       enemy->setAttackingFilter();
-      _sound_controller->playEnemySwing();
+      if (_sound_controller) _sound_controller->playEnemySwing();
     }
     enemy->reduceAttackCooldown(1);
   }
@@ -71,7 +66,7 @@ void TankController::attackPlayer(std::shared_ptr<EnemyModel> enemy,
   } else if (enemy->getAttackCooldown() == ATTACK_FRAMES) {
     // Begin attack.
     enemy->setAttackingFilter();
-    _sound_controller->playEnemySwing();
+    if (_sound_controller) _sound_controller->playEnemySwing();
   } else if (enemy->getAttackCooldown() < STOP_ATTACK_FRAMES) {
     // Stops in place to wind up attack.
     enemy->move(0, 0);
@@ -215,34 +210,7 @@ void TankController::animate(std::shared_ptr<EnemyModel> enemy) {
 void TankController::animateDeath(std::shared_ptr<EnemyModel> enemy) {
   auto node =
       std::dynamic_pointer_cast<cugl::scene2::SpriteNode>(enemy->getNode());
-  if (node->getFrame() < DEATH_RIGHT_LOW_LIM) {
-    float direc_angle =
-        abs((enemy->getAttackDir() - enemy->getPosition()).getAngle());
-    enemy->setFacingLeft(direc_angle > M_PI / 2);
-    if (enemy->getFacingLeft()) {
-      node->setFrame(DEATH_LEFT_LOW_LIM);
-    } else {
-      node->setFrame(DEATH_RIGHT_LOW_LIM);
-    }
-  } else {
-    if (enemy->_frame_count >= 4) {
-      enemy->_frame_count = 0;
-      int next_frame = node->getFrame() + 1;
-      if (enemy->getFacingLeft()) {
-        if (next_frame == DEATH_LEFT_UP_LIM) {
-          next_frame = DEATH_LEFT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      } else {
-        if (next_frame == DEATH_RIGHT_UP_LIM) {
-          next_frame = DEATH_RIGHT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      }
-      node->setFrame(next_frame);
-    }
-    enemy->_frame_count++;
-  }
+  playDeath(enemy, node, "tank-death");
 }
 
 void TankController::animateChase(std::shared_ptr<EnemyModel> enemy) {
@@ -20,10 +20,6 @@
 #define ATTACK_TOP_LEFT 42
 #define ATTACK_HALF 41
 #define ATTACK_UP_LIM 48
-#define DEATH_RIGHT_LOW_LIM 48
-#define DEATH_RIGHT_UP_LIM 70
-#define DEATH_LEFT_LOW_LIM 80
-#define DEATH_LEFT_UP_LIM 102
 
 #pragma mark Turtle Controller
 
@@ -79,7 +75,7 @@ void TurtleController::clientUpdateAttackPlayer(
       } else {
         enemy->addBullet(att_vec.rotate(M_PI, enemy->getPosition()));
       }
-      _sound_controller->playEnemyLargeGunshot();
+      if (_sound_controller) _sound_controller->playEnemyLargeGunshot();
       enemy->setAttackCooldown(ATTACK_COOLDOWN);
     }
     enemy->reduceAttackCooldown(1);
@@ -119,7 +115,7 @@ void TurtleController::attackPlayer(std::shared_ptr<EnemyModel> enemy,
       enemy->addBullet(att_vec.rotate(M_PI, enemy->getPosition()));
     }
 
-    _sound_controller->playEnemyLargeGunshot();
+    if (_sound_controller) _sound_controller->playEnemyLargeGunshot();
     enemy->setAttackCooldown(ATTACK_COOLDOWN);
   } else if (enemy->getAttackCooldown() == ATTACK_FRAME_POS) {
     enemy->setAttackDir(p);
@@ -237,34 +233,7 @@ void TurtleController::animate(std::shared_ptr<EnemyModel> enemy) {
 void TurtleController::animateDeath(std::shared_ptr<EnemyModel> enemy) {
   auto node =
       std::dynamic_pointer_cast<cugl::scene2::SpriteNode>(enemy->getNode());
-  if (node->getFrame() < DEATH_RIGHT_LOW_LIM) {
-    float direc_angle =
-        abs((enemy->getAttackDir() - enemy->getPosition()).getAngle());
-    enemy->setFacingLeft(direc_angle > M_PI / 2);
-    if (enemy->getFacingLeft()) {
-      node->setFrame(DEATH_LEFT_LOW_LIM);
-    } else {
-      node->setFrame(DEATH_RIGHT_LOW_LIM);
-    }
-  } else {
-    if (enemy->_frame_count >= 4) {
-      enemy->_frame_count = 0;
-      int next_frame = node->getFrame() + 1;
-      if (enemy->getFacingLeft()) {
-        if (next_frame == DEATH_LEFT_UP_LIM) {
-          next_frame = DEATH_LEFT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      } else {
-        if (next_frame == DEATH_RIGHT_UP_LIM) {
-          next_frame = DEATH_RIGHT_UP_LIM - 1;
-          enemy->setReadyToDie(true);
-        }
-      }
-      node->setFrame(next_frame);
-    }
-    enemy->_frame_count++;
-  }
+  playDeath(enemy, node, "turtle-death");
 }
 
 void TurtleController::animateClose(std::shared_ptr<EnemyModel> enemy) {
@@ -201,7 +201,7 @@ class Delaunator {
   void link(std::size_t a, std::size_t b);
 };
 
-Delaunator::Delaunator(std::vector<double> const &in_coords)
+inline Delaunator::Delaunator(std::vector<double> const &in_coords)
     : coords(in_coords),
       triangles(),
       halfedges(),
@@ -423,7 +423,7 @@ Delaunator::Delaunator(std::vector<double> const &in_coords)
   }
 }
 
-double Delaunator::get_hull_area() {
+inline double Delaunator::get_hull_area() {
   std::vector<double> hull_area;
   size_t e = hull_start;
   do {
@@ -434,7 +434,7 @@ double Delaunator::get_hull_area() {
   return sum(hull_area);
 }
 
-std::size_t Delaunator::legalize(std::size_t a) {
+inline std::size_t Delaunator::legalize(std::size_t a) {
   std::size_t i = 0;
   std::size_t ar = 0;
   m_edge_stack.clear();
@@ -537,9 +537,9 @@ inline std::size_t Delaunator::hash_key(const double x, const double y) const {
       m_hash_size);
 }
 
-std::size_t Delaunator::add_triangle(std::size_t i0, std::size_t i1,
-                                     std::size_t i2, std::size_t a,
-                                     std::size_t b, std::size_t c) {
+inline std::size_t Delaunator::add_triangle(std::size_t i0, std::size_t i1,
+                                            std::size_t i2, std::size_t a,
+                                            std::size_t b, std::size_t c) {
   std::size_t t = triangles.size();
   triangles.push_back(i0);
   triangles.push_back(i1);
@@ -550,7 +550,7 @@ std::size_t Delaunator::add_triangle(std::size_t i0, std::size_t i1,
   return t;
 }
 
-void Delaunator::link(const std::size_t a, const std::size_t b) {
+inline void Delaunator::link(const std::size_t a, const std::size_t b) {
   std::size_t s = halfedges.size();
   if (a == s) {
     halfedges.push_back(b);
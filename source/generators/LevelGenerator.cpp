@@ -12,32 +12,127 @@
 
 namespace level_gen {
 
+namespace {
+
+/** Adds the time between its construction and destruction to a stage time. */
+class StageTimer {
+ private:
+  /** The stage time to add to in microseconds. */
+  Uint64 &_stage_time;
+  /** The time the timer was constructed. */
+  cugl::Timestamp _start;
+
+ public:
+  /**
+   * Start timing a stage.
+   * @param stage_time The stage time to add to in microseconds.
+   */
+  explicit StageTimer(Uint64 &stage_time) : _stage_time(stage_time) {}
+  /** Stop timing and add the elapsed time to the stage time. */
+  ~StageTimer() { _stage_time += cugl::Timestamp().ellapsedMicros(_start); }
+};
+
+/**
+ * Mix a value into an FNV-1a hash.
+ * @param hash The hash to mix into.
+ * @param value The value to mix in.
+ */
+void hashValue(Uint64 &hash, Sint64 value) {
+  for (int i = 0; i < 8; i++) {
+    hash ^= static_cast<Uint64>(value >> (i * 8)) & 0xff;
+    hash *= 1099511628211ULL;
+  }
+}
+
+/** One in the Q30 fixed point used for room placement angles. */
+constexpr Sint64 kFixedOne = 1LL << 30;
+
+/** The Taylor coefficients of sin(x * pi / 2) in odd powers of x, in Q30. */
+constexpr Sint64 kSinCoeffs[] = {1686629713, -693598668, 85569306, -5026995,
+                                 172272,     -3864,      61};
+
+/** The Taylor coefficients of cos(x * pi / 2) in even powers of x, in Q30. */
+constexpr Sint64 kCosCoeffs[] = {1073741824, -1324675879, 272375560, -22401992,
+                                 987048,     -27060,      506,       -7};
+
+/**
+ * Evaluate a polynomial in Q30 fixed point.
+ * @param coeffs The coefficients, from the constant term up.
+ * @param x The value to evaluate the polynomial at.
+ * @return The value of the polynomial.
+ */
+template <size_t N>
+Sint64 fixedPolynomial(const Sint64 (&coeffs)[N], Sint64 x) {
+  Sint64 result = 0;
+  for (size_t i = N; i-- > 0;) result = coeffs[i] + result * x / kFixedOne;
+  return result;
+}
+
+/**
+ * Returns the point at a distance and angle from the origin.
+ *
+ * libm sine and cosine can differ in the last bit between platforms, which is
+ * enough to move a room by a unit once it is floored. Their Taylor series are
+ * evaluated in fixed point instead, so every platform places rooms the same.
+ *
+ * @param r The distance from the origin.
+ * @param turns The angle counterclockwise from the x-axis, in turns.
+ * @return The point at that distance and angle.
+ */
+cugl::Vec2 polarPoint(float r, float turns) {
+  // The angle in 32 bit fixed point turns. The top two bits are the quadrant.
+  float fraction = turns - floorf(turns);
+  auto angle =
+      static_cast<Uint32>(static_cast<Uint64>(fraction * 4294967296.0f));
+
+  Sint64 x = angle & (kFixedOne - 1);
+  Sint64 x2 = x * x / kFixedOne;
+  Sint64 sine = fixedPolynomial(kSinCoeffs, x2) * x / kFixedOne;
+  Sint64 cosine = fixedPolynomial(kCosCoeffs, x2);
+
+  Sint64 px, py;
+  switch (angle >> 30) {
+    case 0:
+      px = cosine, py = sine;
+      break;
+    case 1:
+      px = -sine, py = cosine;
+      break;
+    case 2:
+      px = -cosine, py = -sine;
+      break;
+    default:
+      px = sine, py = -cosine;
+      break;
+  }
+  return cugl::Vec2(r * static_cast<float>(px) / kFixedOne,
+                    r * static_cast<float>(py) / kFixedOne);
+}
+
+}  // namespace
+
 LevelGenerator::LevelGenerator() : _active(false), _generator_step(nullptr) {}
 
-void LevelGenerator::init(LevelGeneratorConfig &config,
-                          const std::shared_ptr<cugl::scene2::SceneNode> &map) {
+void LevelGenerator::init(LevelGeneratorConfig &config) {
   if (_active) return;
   _active = true;
 
   _config = config;
-  _map = map;
   _generator_step = [this]() { this->generateRooms(); };
   std::random_device my_random_device;
-  unsigned seed = my_random_device();
-  _generator = std::default_random_engine(static_cast<Uint32>(seed));
+  _generator.seed(my_random_device());
+  _stage_times.fill(0);
 }
 
-void LevelGenerator::init(LevelGeneratorConfig &config,
-                          const std::shared_ptr<cugl::scene2::SceneNode> &map,
-                          Uint64 seed) {
+void LevelGenerator::init(LevelGeneratorConfig &config, Uint64 seed) {
   if (_active) return;
   _active = true;
 
   _config = config;
-  _map = map;
 
   _generator_step = [this]() { this->generateRooms(); };
-  _generator = std::default_random_engine(static_cast<Uint32>(seed));
+  _generator.seed(seed);
+  _stage_times.fill(0);
 }
 
 void LevelGenerator::dispose() {
@@ -49,7 +144,7 @@ void LevelGenerator::dispose() {
   _circle_rooms.clear();
 
   _spawn_room = nullptr;
-  _map = nullptr;
+  _grid.clear();
   _generator_step = nullptr;
 }
 
@@ -61,13 +156,86 @@ bool LevelGenerator::update() {
   return false;  // Done!
 }
 
+std::string LevelGenerator::getStageName(Stage stage) {
+  switch (stage) {
+    case PLACE:
+      return "place";
+    case SEPARATE:
+      return "separate";
+    case SEGREGATE:
+      return "segregate";
+    case SNAP_AND_CULL:
+      return "snap/cull";
+    case DELAUNAY:
+      return "delaunay";
+    case MST:
+      return "mst";
+    case HALLWAYS:
+      return "hallways";
+    default:
+      return "unknown";
+  }
+}
+
+Uint64 LevelGenerator::getLayoutHash() const {
+  std::unordered_map<Room *, Sint64> room_ids;
+  for (int i = 0; i < _rooms.size(); i++) room_ids[_rooms[i].get()] = i;
+
+  Uint64 hash = 14695981039346656037ULL;
+  for (const std::shared_ptr<Room> &room : _rooms) {
+    hashValue(hash, room->_type);
+    hashValue(hash, static_cast<Sint64>(room->_pos.x));
+    hashValue(hash, static_cast<Sint64>(room->_pos.y));
+    hashValue(hash, static_cast<Sint64>(room->_size.width));
+    hashValue(hash, static_cast<Sint64>(room->_size.height));
+  }
+
+  for (const std::shared_ptr<Room> &room : _rooms) {
+    for (const std::shared_ptr<Edge> &edge : room->_edges) {
+      // Every edge is in both of its rooms, only hash it from the source.
+      if (!edge->_active || edge->_source != room) continue;
+      hashValue(hash, room_ids[edge->_source.get()]);
+      hashValue(hash, room_ids[edge->_neighbor.get()]);
+      for (const cugl::Vec2 &point : edge->_hallway) {
+        hashValue(hash, static_cast<Sint64>(point.x));
+        hashValue(hash, static_cast<Sint64>(point.y));
+      }
+    }
+  }
+  return hash;
+}
+
+void LevelGenerator::buildMap(
+    const std::shared_ptr<cugl::scene2::SceneNode> &map) {
+  std::shared_ptr<cugl::scene2::SceneNode> rooms_node =
+      map->getChildByName("rooms");
+  std::shared_ptr<cugl::scene2::SceneNode> edges_node =
+      map->getChildByName("edges");
+
+  for (std::shared_ptr<Room> &room : _rooms) {
+    room->initScene2();
+    rooms_node->addChild(room->_node);
+  }
+
+  for (std::shared_ptr<Room> &room : _rooms) {
+    for (std::shared_ptr<Edge> &edge : room->_edges) {
+      // Every active edge is shared by two rooms, only build it once.
+      if (edge->_active && edge->_node == nullptr) {
+        edge->initScene2();
+        edges_node->addChild(edge->_node);
+      }
+    }
+  }
+
+  map->doLayout();
+}
+
 void LevelGenerator::generateRooms() {
+  StageTimer timer(_stage_times[PLACE]);
   _spawn_room = std::make_shared<Room>(default_rooms::kSpawn);
   _spawn_room->_type = RoomType::SPAWN;
   _spawn_room->_fixed = true;
-  _spawn_room->_node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
-  _spawn_room->_node->setPosition(_spawn_room->_node->getContentSize() / -2.0f);
-  _spawn_room->_node->setColor(_spawn_room->getRoomNodeColorGenerator());
+  _spawn_room->_pos = _spawn_room->_size / -2.0f;
   _rooms.push_back(_spawn_room);
 
   for (int i = 0; i < _config.getLayers().size(); i++) {
@@ -76,8 +244,6 @@ void LevelGenerator::generateRooms() {
 
   _circle_rooms[0].push_back(_spawn_room);
 
-  _map->getChildByName("rooms")->addChild(_spawn_room->_node);
-
   float min_radius = _spawn_room->getRadius();
 
   placeRegularRooms(_config.getNumRooms(), min_radius,
@@ -90,52 +256,49 @@ void LevelGenerator::generateRooms() {
 
 void LevelGenerator::placeRegularRooms(int num_rooms, float min_radius,
                                        float max_radius) {
-  //  Distribution to define the positioning of rooms.
-  std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-
   for (float i = 0; i < num_rooms; i++) {
     int max_room_ii = static_cast<int>(default_rooms::kRegularRooms.size() - 1);
-    std::uniform_int_distribution<> room_iid(0, max_room_ii);
 
     default_rooms::RoomConfig chosen_room =
-        default_rooms::kRegularRooms[room_iid(_generator)];
+        default_rooms::kRegularRooms[_generator.nextInt(0, max_room_ii)];
     std::shared_ptr<Room> room = std::make_shared<Room>(chosen_room);
 
     float room_radius = room->getRadius();
     float min_r = min_radius + room_radius;
     float max_r = max_radius - room_radius;
 
-    float r = dis(_generator) * (max_r - min_r) + min_r;
-    float angle = dis(_generator) * 2 * M_PI;
-    cugl::Vec2 pos(r * cosf(angle), r * sinf(angle));
-    pos -= room->_node->getContentSize() / 2.0f;
+    float r = _generator.nextFloat() * (max_r - min_r) + min_r;
+    cugl::Vec2 pos = polarPoint(r, _generator.nextFloat());
+    pos -= room->_size / 2.0f;
     pos.x = floorf(pos.x);
     pos.y = floorf(pos.y);
 
-    room->_node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
-    room->_node->setPosition(pos);
-    room->_node->setColor(room->getRoomNodeColorGenerator());
+    room->_pos = pos;
 
     _rooms.push_back(room);
-    _map->getChildByName("rooms")->addChild(room->_node);
   }
 }
 
 void LevelGenerator::separateRooms(
     std::function<void(void)> next_generator_step) {
-  if (!anyRoomsOverlapping()) {
-    _generator_step = next_generator_step;
-    return;
-  }
-  for (int i = 0; i < _rooms.size(); i++) {
-    std::shared_ptr<Room> &room = _rooms[i];
-    cugl::Rect room_rect = room->getRect();
+  StageTimer timer(_stage_times[SEPARATE]);
+  cugl::Timestamp start;
+  std::vector<std::pair<int, int>> pairs;
+
+  do {
+    rebuildGrid();
+    _grid.findOverlappingPairs(pairs);
+    if (pairs.empty()) {
+      _generator_step = next_generator_step;
+      return;
+    }
 
-    for (int j = i + 1; j < _rooms.size(); j++) {
-      std::shared_ptr<Room> &n_room = _rooms[j];
-      cugl::Rect n_room_rect = n_room->getRect();
+    for (std::pair<int, int> &pair : pairs) {
+      std::shared_ptr<Room> &room = _rooms[pair.first];
+      std::shared_ptr<Room> &n_room = _rooms[pair.second];
 
-      if (room_rect.doesIntersect(n_room_rect)) {
+      // An earlier move in this pass may have already separated the pair.
+      if (room->getRect().doesIntersect(n_room->getRect())) {
         cugl::Vec2 direction = room->getMid() - n_room->getMid();
         if (direction == cugl::Vec2::ZERO) {
           direction += cugl::Vec2::ONE;
@@ -146,40 +309,43 @@ void LevelGenerator::separateRooms(
         n_room->move(direction * -1.0f);
       }
     }
-  }
+  } while (cugl::Timestamp().ellapsedMicros(start) <
+           _config.getSeparationBudget() * 1000.0f);
 }
 
 bool LevelGenerator::anyRoomsOverlapping() {
-  for (int i = 0; i < _rooms.size(); i++) {
-    cugl::Rect room_rect = _rooms[i]->getRect();
-    for (int j = i + 1; j < _rooms.size(); j++) {
-      if (_rooms[i] != _rooms[j]) {
-        cugl::Rect n_room_rect = _rooms[j]->getRect();
-
-        if (room_rect.doesIntersect(n_room_rect)) {
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+  rebuildGrid();
+  return _grid.anyOverlapping();
 }
 
 std::shared_ptr<Room> LevelGenerator::roomMostOverlappingWith(
     const std::shared_ptr<Room> &room) {
   cugl::Rect room_rect = room->getRect();
 
-  auto it = std::max_element(
-      _rooms.begin(), _rooms.end(),
-      [room, room_rect](const std::shared_ptr<Room> &l,
-                        const std::shared_ptr<Room> &r) {
-        cugl::Size l_size = l->getRect().intersect(room_rect).size;
-        cugl::Size r_size = r->getRect().intersect(room_rect).size;
-        if (l == room || r == room) return false;
-        return l_size.width * l_size.height < r_size.width * r_size.height;
-      });
-
-  return (it != _rooms.end()) ? (*it) : room;
+  std::vector<int> candidates;
+  _grid.query(room_rect, candidates);
+
+  std::shared_ptr<Room> most_overlapping = room;
+  float max_area = 0.0f;
+  for (int i : candidates) {
+    if (_rooms[i] == room) continue;
+    cugl::Size size = _rooms[i]->getRect().intersect(room_rect).size;
+    if (size.width * size.height > max_area) {
+      max_area = size.width * size.height;
+      most_overlapping = _rooms[i];
+    }
+  }
+
+  return most_overlapping;
+}
+
+void LevelGenerator::rebuildGrid() {
+  std::vector<cugl::Rect> rects;
+  rects.reserve(_rooms.size());
+  for (std::shared_ptr<Room> &room : _rooms) {
+    rects.push_back(room->getRect());
+  }
+  _grid.build(rects);
 }
 
 cugl::Vec2 LevelGenerator::snapToGrid(const cugl::Vec2 &pos,
@@ -198,6 +364,7 @@ cugl::Vec2 LevelGenerator::snapToGrid(const cugl::Vec2 &pos,
 }
 
 void LevelGenerator::placeTerminals() {
+  StageTimer timer(_stage_times[PLACE]);
   float min_radius = _config.getLayers()[0].radius * 0.4f;
 
   for (int i = 0; i < _config.getLayers().size(); i++) {
@@ -214,17 +381,16 @@ void LevelGenerator::placeTerminals() {
 void LevelGenerator::placeTerminalRooms(
     std::vector<std::shared_ptr<Room>> &circle, int num_rooms, float min_radius,
     float max_radius) {
-  std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-
   // Make sure the room is always inside of the spawn circle;
   float terminal_radius =
       ((cugl::Vec2)default_rooms::kTerminal.size).length() / 2.0f;
   min_radius += terminal_radius;
   max_radius -= terminal_radius;
 
-  float r = dis(_generator) * (max_radius - min_radius) + min_radius;
-  float min_angle = dis(_generator) * 2 * M_PI;
-  float max_angle = min_angle + M_PI / num_rooms;
+  float r = _generator.nextFloat() * (max_radius - min_radius) + min_radius;
+  // Angles are in turns, see polarPoint.
+  float min_turns = _generator.nextFloat();
+  float max_turns = min_turns + 0.5f / num_rooms;
 
   for (float i = 0; i < num_rooms; i++) {
     std::shared_ptr<Room> room =
@@ -232,28 +398,26 @@ void LevelGenerator::placeTerminalRooms(
 
     room->_type = RoomType::TERMINAL;
 
-    float angle = dis(_generator) * (max_angle - min_angle) + min_angle;
-    cugl::Vec2 pos(r * cosf(angle), r * sinf(angle));
-    pos -= room->_node->getContentSize() / 2.0f;
+    float turns =
+        _generator.nextFloat() * (max_turns - min_turns) + min_turns;
+    cugl::Vec2 pos = polarPoint(r, turns);
+    pos -= room->_size / 2.0f;
     pos.x = floorf(pos.x);
     pos.y = floorf(pos.y);
 
-    room->_node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
-    room->_node->setPosition(pos);
-    room->_node->setColor(room->getRoomNodeColorGenerator());
+    room->_pos = pos;
 
-    min_angle += 2 * M_PI / num_rooms;
-    max_angle += 2 * M_PI / num_rooms;
+    min_turns += 1.0f / num_rooms;
+    max_turns += 1.0f / num_rooms;
 
     _rooms.push_back(room);
     circle.push_back(room);
-    _map->getChildByName("rooms")->addChild(room->_node);
 
+    rebuildGrid();
     std::shared_ptr<Room> overlapping = roomMostOverlappingWith(room);
     if (overlapping != room) {
       auto it = std::find(_rooms.begin(), _rooms.end(), overlapping);
       if (it != _rooms.end() && (*it)->_type != RoomType::SPAWN) {
-        _map->getChildByName("rooms")->removeChild(overlapping->_node);
         _rooms.erase(it);
       }
     }
@@ -261,6 +425,7 @@ void LevelGenerator::placeTerminalRooms(
 }
 
 void LevelGenerator::segregateLayers() {
+  StageTimer timer(_stage_times[SEGREGATE]);
   float min_radius = 0;
   float max_radius = 0;
 
@@ -291,9 +456,9 @@ void LevelGenerator::segregateLayers() {
                _config.getExpansionFactorRooms();
       }
 
-      pos -= room->_node->getSize() / 2.0f;
+      pos -= room->_size / 2.0f;
 
-      room->_node->setPosition(roundf(pos.x), roundf(pos.y));
+      room->_pos.set(roundf(pos.x), roundf(pos.y));
     }
   }
 
@@ -306,13 +471,13 @@ void LevelGenerator::segregateLayers() {
  * Snap all the rooms to grid and remove all the rooms that are overlapping.
  */
 void LevelGenerator::snapToGridAndCullOverlap() {
+  StageTimer timer(_stage_times[SNAP_AND_CULL]);
   for (std::shared_ptr<Room> room : _rooms) {
-    cugl::Vec2 pos = room->_node->getPosition();
-    pos = snapToGrid(pos, this->_config.getGridCell());
-    pos -= room->_node->getSize() / 2.0f;
-    room->_node->setPosition(pos);
+    cugl::Vec2 pos = snapToGrid(room->_pos, this->_config.getGridCell());
+    room->_pos = pos - room->_size / 2.0f;
   }
 
+  rebuildGrid();
   for (std::shared_ptr<Room> room : _rooms) {
     auto overlapping = roomMostOverlappingWith(room);
     if (overlapping != room && !room->_to_delete &&
@@ -323,7 +488,6 @@ void LevelGenerator::snapToGridAndCullOverlap() {
 
   for (auto it = _rooms.begin(); it != _rooms.end(); it++) {
     if ((*it)->_to_delete) {
-      _map->getChildByName("rooms")->removeChild((*it)->_node);
       _rooms.erase(it--);
     }
   }
@@ -364,6 +528,7 @@ void LevelGenerator::markAndFillHallways() {
 
 void LevelGenerator::calculateDelaunayTriangles(
     std::vector<std::shared_ptr<Room>> &rooms, float min_r) {
+  StageTimer timer(_stage_times[DELAUNAY]);
   if (rooms.size() == 0) return;
 
   std::vector<double> coords;
@@ -386,65 +551,76 @@ void LevelGenerator::calculateDelaunayTriangles(
       std::shared_ptr<Edge> edge_0_1 = std::make_shared<Edge>(node_0, node_1);
 
       if (min_r == 0.0f || !edge_0_1->doesIntersect(cugl::Vec2::ZERO, min_r)) {
-        _map->getChildByName("edges")->addChild(edge_0_1->_node);
         node_0->addEdge(edge_0_1);
         node_1->addEdge(edge_0_1);
       }
     }
   }
+}
 
-  _map->doLayout();
+void LevelGenerator::buildAdjacency(
+    const std::vector<std::shared_ptr<Room>> &rooms) {
+  _room_index.clear();
+  for (int i = 0; i < rooms.size(); i++) _room_index[rooms[i].get()] = i;
+
+  // Keep the inner lists to reuse their memory between layers.
+  if (_adjacency.size() < rooms.size()) _adjacency.resize(rooms.size());
+  for (int i = 0; i < rooms.size(); i++) {
+    std::vector<Adjacent> &adjacent = _adjacency[i];
+    adjacent.clear();
+    for (const std::shared_ptr<Edge> &edge : rooms[i]->_edges) {
+      Room *other = (edge->_source == rooms[i]) ? edge->_neighbor.get()
+                                                : edge->_source.get();
+      auto it = _room_index.find(other);
+      if (it != _room_index.end()) adjacent.push_back({it->second, edge.get()});
+    }
+  }
 }
 
 void LevelGenerator::calculateMinimumSpanningTree(
     std::vector<std::shared_ptr<Room>> &rooms) {
-  int num_edges = 0;
-  std::vector<std::shared_ptr<Edge>> result;
+  StageTimer timer(_stage_times[MST]);
   // Reset tree to start Prim's algorithm.
   for (std::shared_ptr<Room> &room : rooms) {
     room->_visited = false;
-    for (std::shared_ptr<Edge> edge : room->_edges) {
-      edge->_node->setVisible(false);
+    for (const std::shared_ptr<Edge> &edge : room->_edges) {
       edge->_active = false;
     }
   }
-  rooms[0]->_visited = true;
-
-  while (num_edges < rooms.size() - 1) {
-    std::shared_ptr<Edge> min_edge = nullptr;
-    std::shared_ptr<Room> min_neighbor = nullptr;
-    float min_weight = FLT_MAX;
-
-    for (std::shared_ptr<Room> &room : rooms) {
-      if (room->_visited) {
-        for (std::shared_ptr<Edge> edge : room->_edges) {
-          if (!edge->getOther(room)->_visited && edge->_weight < min_weight) {
-            min_edge = edge;
-            min_neighbor = edge->getOther(room);
-            min_weight = edge->_weight;
-          }
-        }
-      }
+  if (rooms.empty()) return;
+
+  buildAdjacency(rooms);
+  std::greater<TreeCandidate> later;
+  _tree_heap.clear();
+
+  // Visit a room and push all its edges out of the tree onto the heap.
+  auto visit = [&](int room) {
+    rooms[room]->_visited = true;
+    const std::vector<Adjacent> &adjacent = _adjacency[room];
+    for (int i = 0; i < adjacent.size(); i++) {
+      const Adjacent &next = adjacent[i];
+      if (rooms[next.room]->_visited) continue;
+      _tree_heap.push_back({next.edge->_weight, room, i, next.room, next.edge});
+      std::push_heap(_tree_heap.begin(), _tree_heap.end(), later);
     }
+  };
 
-    num_edges++;
-
-    if (min_edge) {
-      min_neighbor->_visited = true;
-      result.push_back(std::move(min_edge));
-    }
-  }
+  visit(0);
+  while (!_tree_heap.empty()) {
+    std::pop_heap(_tree_heap.begin(), _tree_heap.end(), later);
+    TreeCandidate candidate = _tree_heap.back();
+    _tree_heap.pop_back();
 
-  for (std::shared_ptr<Edge> &edge : result) {
-    edge->_node->setColor(cugl::Color4(255, 14, 14, 124));
-    edge->_node->setVisible(true);
-    edge->_active = true;
+    // The room may have joined the tree since the edge was pushed.
+    if (rooms[candidate.to]->_visited) continue;
+    candidate.edge->_active = true;
+    visit(candidate.to);
   }
 }
 
 void LevelGenerator::addEdgesBackAndRemoveUnecessary(
     std::vector<std::shared_ptr<Room>> &rooms) {
-  std::uniform_real_distribution<float> rand(0.0f, 1.0f);
+  StageTimer timer(_stage_times[MST]);
   for (std::shared_ptr<Room> &room : rooms) {
     for (std::shared_ptr<Edge> edge : room->_edges) {
       if (!edge->_active) {
@@ -474,12 +650,8 @@ void LevelGenerator::addEdgesBackAndRemoveUnecessary(
         // Not on a diagonal.
         add_back &= (int)(edge_angle / M_PI_4) % 2 == 0;
 
-        add_back &= rand(_generator) <= _config.getAddEdgesBackProb();
-        if (add_back) {
-          edge->_node->setVisible(true);
-          edge->_active = true;
-          edge->_node->setColor(cugl::Color4(255, 14, 14, 124));
-        }
+        add_back &= _generator.nextFloat() <= _config.getAddEdgesBackProb();
+        if (add_back) edge->_active = true;
       }
     }
   }
@@ -487,10 +659,7 @@ void LevelGenerator::addEdgesBackAndRemoveUnecessary(
   for (std::shared_ptr<Room> &room : rooms) {
     for (auto it : room->_edge_to_door) {
       float ag = room->angleBetweenEdgeAndDoor(it.first, it.second);
-      if (std::abs(ag) > M_PI_2 + 0.1f) {
-        it.first->_node->setVisible(false);
-        it.first->_active = false;
-      }
+      if (std::abs(ag) > M_PI_2 + 0.1f) it.first->_active = false;
     }
   }
 
@@ -502,77 +671,76 @@ void LevelGenerator::addEdgesBackAndRemoveUnecessary(
 void LevelGenerator::connectLayers(std::vector<std::shared_ptr<Room>> &layer_a,
                                    std::vector<std::shared_ptr<Room>> &layer_b,
                                    int num_connections) {
-  std::vector<std::shared_ptr<Edge>> connections;
+  StageTimer timer(_stage_times[HALLWAYS]);
+  // Connections are only activated at the end, so a room can be checked once
+  // for being a candidate instead of for every pair it is in.
+  auto can_connect = [this](const std::shared_ptr<Room> &room) {
+    if (room->_type != RoomType::STANDARD) return false;
+    long num_edges = std::count_if(
+        room->_edges.begin(), room->_edges.end(),
+        [](const std::shared_ptr<Edge> &edge) { return edge->_active; });
+    return num_edges < _config.getMaxNumEdges();
+  };
+  std::vector<bool> a_open(layer_a.size());
+  std::vector<bool> b_open(layer_b.size());
+  for (int i = 0; i < layer_a.size(); i++) a_open[i] = can_connect(layer_a[i]);
+  for (int i = 0; i < layer_b.size(); i++) b_open[i] = can_connect(layer_b[i]);
+
+  std::vector<std::pair<int, int>> connections;
 
-  std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-  float min_angle = dis(_generator) * 2 * M_PI;
+  float min_angle = _generator.nextFloat() * 2 * M_PI;
   float max_angle = fmod(min_angle + M_PI / num_connections, 2 * M_PI);
 
   for (int i = 0; i < num_connections; i++) {
-    std::shared_ptr<Edge> winner;
+    int winner_a = -1;
+    int winner_b = -1;
     float winner_dist = FLT_MAX;
 
-    for (std::shared_ptr<Room> &a_room : layer_a) {
-      float angle = a_room->getMid().getAngle();
+    for (int a = 0; a < layer_a.size(); a++) {
+      if (!a_open[a]) continue;
+      cugl::Vec2 a_mid = layer_a[a]->getMid();
+
+      float angle = a_mid.getAngle();
       angle += (angle < 0.0f) ? (2 * M_PI) : 0.0f;
 
       bool between_angles = (max_angle > min_angle)
                                 ? (angle >= min_angle && angle <= max_angle)
                                 : (angle >= min_angle || angle <= max_angle);
-
-      if (between_angles && a_room->_type == RoomType::STANDARD) {
-        for (std::shared_ptr<Room> &b_room : layer_b) {
-          if (b_room->_type == RoomType::STANDARD) {
-            // Find if this edge already been chosen.
-            auto curr = std::make_shared<Edge>(a_room, b_room);
-            auto res =
-                std::find_if(connections.begin(), connections.end(),
-                             [curr](const std::shared_ptr<Edge> &edge) {
-                               return *edge == *curr || edge->shareRoom(curr);
-                             });
-
-            long a_num_edges =
-                std::count_if(a_room->_edges.begin(), a_room->_edges.end(),
-                              [](const std::shared_ptr<Edge> &edge) {
-                                return edge->_active;
-                              });
-            long b_num_edges =
-                std::count_if(b_room->_edges.begin(), b_room->_edges.end(),
-                              [](const std::shared_ptr<Edge> &edge) {
-                                return edge->_active;
-                              });
-
-            bool under_limit = a_num_edges < _config.getMaxNumEdges();
-            under_limit &= b_num_edges < _config.getMaxNumEdges();
-
-            if (curr->_weight < winner_dist && under_limit &&
-                res == connections.end()) {
-              winner_dist = curr->_weight;
-              winner = std::move(curr);
-            }
-          }
+      if (!between_angles) continue;
+
+      for (int b = 0; b < layer_b.size(); b++) {
+        if (!b_open[b]) continue;
+        // Same as the weight of an edge between the rooms.
+        float dist = (layer_b[b]->getMid() - a_mid).length();
+        if (dist < winner_dist) {
+          winner_dist = dist;
+          winner_a = a;
+          winner_b = b;
         }
       }
     }
 
-    if (winner) {
-      connections.push_back(winner);
+    if (winner_a != -1) {
+      // A room can only be in one connection.
+      a_open[winner_a] = false;
+      b_open[winner_b] = false;
+      connections.push_back(std::make_pair(winner_a, winner_b));
       min_angle = fmod(min_angle + 2 * M_PI / num_connections, 2 * M_PI);
       max_angle = fmod(min_angle + M_PI / num_connections, 2 * M_PI);
     }
   }
 
-  for (std::shared_ptr<Edge> &connection : connections) {
-    connection->_active = true;
-    connection->_source->addEdge(connection);
-    connection->_neighbor->addEdge(connection);
-    connection->_node->setColor(cugl::Color4(15, 15, 230, 147));
-    _map->getChildByName("edges")->addChild(connection->_node);
+  for (std::pair<int, int> &connection : connections) {
+    auto edge = std::make_shared<Edge>(layer_a[connection.first],
+                                       layer_b[connection.second]);
+    edge->_active = true;
+    edge->_source->addEdge(edge);
+    edge->_neighbor->addEdge(edge);
   }
-  _map->doLayout();
 }
 
 void LevelGenerator::fillHallways() {
+  StageTimer timer(_stage_times[HALLWAYS]);
   // Resset state of all edges.
   for (std::shared_ptr<Room> &room : _rooms) {
     for (std::shared_ptr<Edge> &edge : room->_edges) {
@@ -608,29 +776,13 @@ void LevelGenerator::fillHallways() {
         if (end.x == neighbor->_size.width - 1) end.x++;
         if (end.y == neighbor->_size.height - 1) end.y++;
 
-        start += source->_node->getPosition();
-        end += neighbor->_node->getPosition();
+        start += source->_pos;
+        end += neighbor->_pos;
 
-        cugl::Vec2 start_pos(std::min(start.x, end.x),
-                             std::min(start.y, end.y));
-        cugl::Vec2 end_pos(std::max(start.x, end.x) + 1,
-                           std::max(start.y, end.y) + 1);
-
-        std::vector<cugl::Vec2> path{start, end};
-
-        edge->_node->dispose();
-        edge->_node->initWithPath(path, 1.0f);
-
-        edge->_node->setColor(cugl::Color4(0, 0, 0, 127));
-        edge->_node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
-        edge->_node->setPosition(start_pos);
-
-        _map->getChildByName("edges")->addChild(edge->_node);
+        edge->_hallway = {start, end};
       }
     }
   }
-
-  _map->doLayout();
 }
 
 }  // namespace level_gen
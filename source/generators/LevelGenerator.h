@@ -2,16 +2,78 @@
 #define GENERATORS_LEVEL_GENERATOR_H
 #include <cugl/cugl.h>
 
+#include <array>
+
 #include "../models/level_gen/Room.h"
 #include "LevelGeneratorConfig.h"
+#include "Pcg32.h"
+#include "RoomGrid.h"
 
 namespace level_gen {
 
-/** A level generator that creates a random level with hallway connections. */
+/**
+ * A level generator that creates a random level with hallway connections.
+ *
+ * Generation only works on the room and edge data, and never touches the scene
+ * graph, so it can run without a GL context. The scene2 nodes for the map are
+ * built from the result with buildMap().
+ */
 class LevelGenerator {
+ public:
+  /** The stages of level generation, used for timing the generator. */
+  enum Stage {
+    /** Placing the spawn, regular and terminal rooms. */
+    PLACE,
+    /** Separating the overlapping rooms. */
+    SEPARATE,
+    /** Separating the room layers. */
+    SEGREGATE,
+    /** Snapping the rooms to grid and culling the overlapping rooms. */
+    SNAP_AND_CULL,
+    /** Calculating the delaunay triangles between the rooms. */
+    DELAUNAY,
+    /** Calculating the minimum spanning tree and adding edges back. */
+    MST,
+    /** Connecting the layers and filling the hallways. */
+    HALLWAYS,
+    /** The number of stages. */
+    NUM_STAGES
+  };
+
  private:
-  /** A reference to the scene2 map for level drawing. */
-  std::shared_ptr<cugl::scene2::SceneNode> _map;
+  /** A neighbor of a room in the adjacency list of a layer. */
+  struct Adjacent {
+    /** The index of the neighboring room in the layer. */
+    int room;
+    /** The edge to the neighboring room. Owned by the rooms. */
+    Edge *edge;
+  };
+
+  /** A candidate edge in the heap used to build the minimum spanning tree. */
+  struct TreeCandidate {
+    /** The weight of the edge. */
+    float weight;
+    /** The index of the room in the tree the edge leaves from. */
+    int from;
+    /** The index of the edge in the adjacency list of the from room. */
+    int order;
+    /** The index of the room the edge leads to. */
+    int to;
+    /** The candidate edge. Owned by the rooms. */
+    Edge *edge;
+
+    /**
+     * Order candidates by weight, and break ties by the room and edge order so
+     * the tree does not depend on the heap layout.
+     * @param other The candidate to compare with.
+     * @return If this candidate should be picked after the other.
+     */
+    bool operator>(const TreeCandidate &other) const {
+      if (weight != other.weight) return weight > other.weight;
+      if (from != other.from) return from > other.from;
+      return order > other.order;
+    }
+  };
 
   /** The level generator config with constants for generation. */
   LevelGeneratorConfig _config;
@@ -34,6 +96,9 @@ class LevelGenerator {
   /** A reference to the spawn room of the level. */
   std::shared_ptr<Room> _spawn_room;
 
+  /** A broadphase grid over the room rectangles, indexed like _rooms. */
+  RoomGrid _grid;
+
   /** If the level generator is currently active. Is set to true after init, and
    * reset on dispose. */
   bool _active;
@@ -44,9 +109,22 @@ class LevelGenerator {
 
   /**
    * A generator for random numbers. The seed for the generator is given by a
-   * C++ random_device. If given a seed, levels will always generate the same.
+   * C++ random_device. If given a seed, levels will always generate the same,
+   * on every platform.
    */
-  std::default_random_engine _generator;
+  Pcg32 _generator;
+
+  /** The time spent in each generation stage in microseconds. */
+  std::array<Uint64, NUM_STAGES> _stage_times;
+
+  /** The index of every room in the layer given to buildAdjacency(). */
+  std::unordered_map<Room *, int> _room_index;
+
+  /** The neighbors of every room in the layer, indexed like the layer. */
+  std::vector<std::vector<Adjacent>> _adjacency;
+
+  /** The candidate heap for the minimum spanning tree, kept for its memory. */
+  std::vector<TreeCandidate> _tree_heap;
 
  public:
 #pragma mark Initializers
@@ -62,38 +140,36 @@ class LevelGenerator {
 #pragma mark Game Loop
 
   /**
-   * Initialize the generator given a config and a scene2 map.
+   * Initialize the generator given a config.
    * @param config A LevelGeneratorConfig used for defining generation
    * constants.
-   * @param map A reference to the scene2 map for drawing.
    */
-  void init(LevelGeneratorConfig &config,
-            const std::shared_ptr<cugl::scene2::SceneNode> &map);
+  void init(LevelGeneratorConfig &config);
 
   /**
-   * Initialize the generator given a config, scene2 map and seed
+   * Initialize the generator given a config and seed
    * @param config A LevelGeneratorConfig used for defining generation
    * constants.
-   * @param map A reference to the scene2 map for drawing.
    * @param seed The seed to use.
    */
-  void init(LevelGeneratorConfig &config,
-            const std::shared_ptr<cugl::scene2::SceneNode> &map, Uint64 seed);
+  void init(LevelGeneratorConfig &config, Uint64 seed);
 
   /**
-   * Returns the pointer to the map SceneNode.
+   * Update the level generator. Calls the next generator step function.
+   * Separates the generation steps to spread the generation over frames.
    *
-   * @return The map SceneNode
+   * @return False if the level generation is done.
    */
-  std::shared_ptr<cugl::scene2::SceneNode> getMap() { return _map; }
+  bool update();
 
   /**
-   * Update the level generator. Calls the next generator step function.
-   * Separates the generation steps to be able to draw the generation.
+   * Build the scene2 nodes for the generated rooms and hallways, and add them
+   * to the map. The map must have a "rooms" and an "edges" child. Only call
+   * this once update() has returned false.
    *
-   * @return False if the level generation is done.
+   * @param map A reference to the scene2 map for drawing.
    */
-  bool update();
+  void buildMap(const std::shared_ptr<cugl::scene2::SceneNode> &map);
 
   /**
    * Dispose of the level generator. Clear all the references and variables in
@@ -108,6 +184,30 @@ class LevelGenerator {
   /** Get the spawn room in the level generator. */
   std::shared_ptr<Room> getSpawnRoom() const { return _spawn_room; }
 
+  /**
+   * Get the time spent in a generation stage since init.
+   * @param stage The generation stage.
+   * @return The time spent in the stage in microseconds.
+   */
+  Uint64 getStageTime(Stage stage) const { return _stage_times[stage]; }
+
+  /**
+   * Get a readable name for a generation stage.
+   * @param stage The generation stage.
+   * @return The name of the stage.
+   */
+  static std::string getStageName(Stage stage);
+
+  /**
+   * Get a hash of the generated layout: the type, position and size of every
+   * room and the rooms and hallway of every active edge. Two levels with the
+   * same hash are the same level, so the host and clients can compare hashes
+   * to check they built the same map from the lobby seed.
+   *
+   * @return The hash of the generated layout.
+   */
+  Uint64 getLayoutHash() const;
+
  private:
 #pragma mark Main Generator Steps
   /**
@@ -120,9 +220,10 @@ class LevelGenerator {
   void generateRooms();
 
   /**
-   * Loop through all the rooms, find the distance between them and move them by
-   * opposite the normalized distance. Sets the _generator_step to
-   * next_generator_step when done.
+   * Loop through all the overlapping rooms, find the distance between them and
+   * move them by opposite the normalized distance. Repeats until no rooms
+   * overlap or the separation budget in the config runs out for this step. Sets
+   * the _generator_step to next_generator_step when done.
    *
    * @param next_generator_step The function that _generator_step should be set
    * to when this method is done calculating.
@@ -173,14 +274,19 @@ class LevelGenerator {
   bool anyRoomsOverlapping();
 
   /**
-   * Find the room that is most overlapping with the given room.
+   * Find the room that is most overlapping with the given room. Uses the room
+   * grid, so rebuildGrid() must be called after any room moves.
    *
    * @param room The room we are checking for overlap.
-   * @return The room that is most overlapping with the given room.
+   * @return The room that is most overlapping with the given room, or the
+   * given room if no other room overlaps it.
    */
   std::shared_ptr<Room> roomMostOverlappingWith(
       const std::shared_ptr<Room> &room);
 
+  /** Rebuild the room grid from the current positions of all the rooms. */
+  void rebuildGrid();
+
   /**
    * Separate the three rings by moving each layer farther from the center.
    */
@@ -199,7 +305,16 @@ class LevelGenerator {
                                   float min_r);
 
   /**
-   * Create a minimum spanning tree between the rooms and their edges.
+   * Build the index based adjacency list for the rooms of a layer from their
+   * edges. Only edges between two rooms of the layer are included.
+   *
+   * @param rooms The rooms of the layer.
+   */
+  void buildAdjacency(const std::vector<std::shared_ptr<Room>> &rooms);
+
+  /**
+   * Create a minimum spanning tree between the rooms and their edges, using
+   * Prim's algorithm with a binary heap of candidate edges.
    *
    * @param rooms The rooms to create a minimum spanning tree with.
    */
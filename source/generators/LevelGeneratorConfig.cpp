@@ -12,7 +12,8 @@ LevelGeneratorConfig::LevelGeneratorConfig()
       _max_hallway_length(40),
       _add_edges_back_prob(0.7f),
       _max_num_of_edges(4),
-      _grid_cell(20, 20) {
+      _grid_cell(20, 20),
+      _separation_budget(8.0f) {
   addLayer(Layer(1.0f, _map_radius, 5, 0));
 }
 
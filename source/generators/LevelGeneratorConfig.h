@@ -69,6 +69,10 @@ class LevelGeneratorConfig {
   /** The size of one grid cell */
   cugl::Vec2 _grid_cell;
 
+  /** The time in milliseconds room separation may take in one generator step
+   * before yielding to the next frame. */
+  float _separation_budget;
+
  public:
   /** Construct a new level generation config object with default values. */
   LevelGeneratorConfig();
@@ -182,6 +186,14 @@ class LevelGeneratorConfig {
   void setGridCell(const cugl::Vec2& size) { _grid_cell = size; }
   /** @return The size of one grid cell. */
   cugl::Vec2 getGridCell() const { return _grid_cell; }
+
+  /**
+   * Set the time budget for separating rooms in one generator step.
+   * @param budget The time budget in milliseconds.
+   */
+  void setSeparationBudget(float budget) { _separation_budget = budget; }
+  /** @return The time budget for separating rooms in milliseconds. */
+  float getSeparationBudget() const { return _separation_budget; }
 };
 
 }  // namespace level_gen
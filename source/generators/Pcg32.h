@@ -0,0 +1,95 @@
+#ifndef GENERATORS_PCG32_H_
+#define GENERATORS_PCG32_H_
+#include <cugl/cugl.h>
+
+#include <limits>
+
+namespace level_gen {
+
+/**
+ * A small PCG random number generator (PCG-XSH-RR with 64 bits of state and
+ * 32 bit output). See https://www.pcg-random.org.
+ *
+ * Unlike std::default_random_engine and the std distributions, the output of
+ * this generator and of its float and int helpers is defined by this file
+ * alone, so every platform produces the same numbers from the same seed. This
+ * lets the host and the clients build identical levels from the lobby seed.
+ */
+class Pcg32 {
+ private:
+  /** The internal state of the generator. */
+  Uint64 _state;
+  /** The stream of the generator. Must always be odd. */
+  Uint64 _inc;
+
+ public:
+  /** The type of the numbers returned by the generator. */
+  typedef Uint32 result_type;
+
+  /** Construct a generator with a seed of 0. */
+  Pcg32() { seed(0); }
+
+  /**
+   * Construct a generator with the given seed.
+   * @param s The seed for the generator.
+   * @param stream The stream of the generator, for independent sequences.
+   */
+  explicit Pcg32(Uint64 s, Uint64 stream = 0) { seed(s, stream); }
+
+  /**
+   * Reset the generator with the given seed.
+   * @param s The seed for the generator.
+   * @param stream The stream of the generator, for independent sequences.
+   */
+  void seed(Uint64 s, Uint64 stream = 0) {
+    _state = 0;
+    _inc = (stream << 1) | 1;
+    next();
+    _state += s;
+    next();
+  }
+
+  /** @return The next random 32 bit number. */
+  Uint32 next() {
+    Uint64 old = _state;
+    _state = old * 6364136223846793005ULL + _inc;
+    Uint32 xorshifted = static_cast<Uint32>(((old >> 18) ^ old) >> 27);
+    Uint32 rot = static_cast<Uint32>(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((~rot + 1) & 31));
+  }
+
+  /** @return A random float in the range [0, 1). */
+  float nextFloat() {
+    // Only use the top 24 bits, which a float can represent exactly.
+    return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /**
+   * Returns a uniformly distributed random int in the range [min, max].
+   * @param min The smallest number that can be returned.
+   * @param max The largest number that can be returned.
+   * @return A random int in the range [min, max].
+   */
+  int nextInt(int min, int max) {
+    Uint32 range = static_cast<Uint32>(max - min) + 1;
+    if (range == 0) return static_cast<int>(next());
+    // Reject the low numbers that would bias the modulo.
+    Uint32 threshold = (~range + 1) % range;
+    Uint32 r = next();
+    while (r < threshold) r = next();
+    return min + static_cast<int>(r % range);
+  }
+
+  /** @return The next random 32 bit number, for use with std algorithms. */
+  Uint32 operator()() { return next(); }
+
+  /** @return The smallest number the generator returns. */
+  static constexpr Uint32 min() { return 0; }
+
+  /** @return The largest number the generator returns. */
+  static constexpr Uint32 max() { return std::numeric_limits<Uint32>::max(); }
+};
+
+}  // namespace level_gen
+
+#endif  // GENERATORS_PCG32_H_
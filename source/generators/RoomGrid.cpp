@@ -0,0 +1,84 @@
+#include "RoomGrid.h"
+
+namespace level_gen {
+
+void RoomGrid::build(const std::vector<cugl::Rect>& rects) {
+  clear();
+  _rects = rects;
+
+  _cell_size = 1.0f;
+  for (const cugl::Rect& rect : _rects) {
+    _cell_size = std::max(_cell_size, rect.size.width);
+    _cell_size = std::max(_cell_size, rect.size.height);
+  }
+
+  for (int i = 0; i < _rects.size(); i++) {
+    const cugl::Rect& rect = _rects[i];
+    int max_x = cellIndex(rect.getMaxX());
+    int max_y = cellIndex(rect.getMaxY());
+    for (int x = cellIndex(rect.getMinX()); x <= max_x; x++) {
+      for (int y = cellIndex(rect.getMinY()); y <= max_y; y++) {
+        _cells[cellKey(x, y)].push_back(i);
+      }
+    }
+  }
+}
+
+void RoomGrid::findOverlappingPairs(
+    std::vector<std::pair<int, int>>& pairs) const {
+  pairs.clear();
+  for (auto& it : _cells) {
+    int cell_x = static_cast<int>(static_cast<Uint32>(it.first >> 32));
+    int cell_y = static_cast<int>(static_cast<Uint32>(it.first));
+    const std::vector<int>& cell = it.second;
+
+    for (int a = 0; a < cell.size(); a++) {
+      const cugl::Rect& a_rect = _rects[cell[a]];
+      for (int b = a + 1; b < cell.size(); b++) {
+        const cugl::Rect& b_rect = _rects[cell[b]];
+        if (!a_rect.doesIntersect(b_rect)) continue;
+
+        // Two rects can share several cells, only report the pair from the
+        // cell holding the bottom left corner of their intersection.
+        float min_x = std::max(a_rect.getMinX(), b_rect.getMinX());
+        float min_y = std::max(a_rect.getMinY(), b_rect.getMinY());
+        if (cellIndex(min_x) == cell_x && cellIndex(min_y) == cell_y) {
+          pairs.push_back(std::make_pair(cell[a], cell[b]));
+        }
+      }
+    }
+  }
+  // Cells are visited in hash order, sort to keep generation deterministic.
+  std::sort(pairs.begin(), pairs.end());
+}
+
+bool RoomGrid::anyOverlapping() const {
+  for (auto& it : _cells) {
+    const std::vector<int>& cell = it.second;
+    for (int a = 0; a < cell.size(); a++) {
+      for (int b = a + 1; b < cell.size(); b++) {
+        if (_rects[cell[a]].doesIntersect(_rects[cell[b]])) return true;
+      }
+    }
+  }
+  return false;
+}
+
+void RoomGrid::query(const cugl::Rect& rect, std::vector<int>& result) const {
+  result.clear();
+  int max_x = cellIndex(rect.getMaxX());
+  int max_y = cellIndex(rect.getMaxY());
+  for (int x = cellIndex(rect.getMinX()); x <= max_x; x++) {
+    for (int y = cellIndex(rect.getMinY()); y <= max_y; y++) {
+      auto it = _cells.find(cellKey(x, y));
+      if (it == _cells.end()) continue;
+      for (int i : it->second) {
+        if (_rects[i].doesIntersect(rect)) result.push_back(i);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+}  // namespace level_gen
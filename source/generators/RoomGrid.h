@@ -0,0 +1,95 @@
+#ifndef GENERATORS_ROOM_GRID_H_
+#define GENERATORS_ROOM_GRID_H_
+#include <cugl/cugl.h>
+
+#include <unordered_map>
+
+namespace level_gen {
+
+/**
+ * A uniform grid broadphase for room rectangles. Every rectangle is bucketed
+ * into the cells it covers, so overlap tests only compare rectangles that
+ * share a cell instead of every pair of rooms in the level.
+ *
+ * Rectangles are referred to by their index in the list given to build(), and
+ * intersection is inclusive of touching edges to match cugl::Rect.
+ */
+class RoomGrid {
+ private:
+  /** The width and height of one cell. */
+  float _cell_size;
+
+  /** The rectangles currently in the grid, indexed like the build() input. */
+  std::vector<cugl::Rect> _rects;
+
+  /** The indices of the rectangles that cover each cell, keyed by cell. */
+  std::unordered_map<Uint64, std::vector<int>> _cells;
+
+ public:
+  /** Construct an empty room grid. */
+  RoomGrid() : _cell_size(1.0f) {}
+  /** Destroy the room grid. */
+  ~RoomGrid() {}
+
+  /**
+   * Rebuild the grid from the given rectangles. The cell size is picked from
+   * the largest rectangle so that every rectangle covers at most two cells
+   * along each axis.
+   *
+   * @param rects The rectangles to bucket, referred to by index afterwards.
+   */
+  void build(const std::vector<cugl::Rect>& rects);
+
+  /** Remove all the rectangles from the grid. */
+  void clear() {
+    _rects.clear();
+    _cells.clear();
+  }
+
+  /**
+   * Find every pair of rectangles in the grid that intersect. Each pair is
+   * reported once, with the smaller index first, and the list is sorted.
+   *
+   * @param pairs The list to fill with the intersecting pairs.
+   */
+  void findOverlappingPairs(std::vector<std::pair<int, int>>& pairs) const;
+
+  /**
+   * Find if any two rectangles in the grid intersect.
+   *
+   * @return If any two rectangles in the grid intersect.
+   */
+  bool anyOverlapping() const;
+
+  /**
+   * Find every rectangle in the grid that intersects the given rectangle. The
+   * list is sorted and contains no duplicates.
+   *
+   * @param rect The rectangle to check against.
+   * @param result The list to fill with the intersecting rectangle indices.
+   */
+  void query(const cugl::Rect& rect, std::vector<int>& result) const;
+
+ private:
+  /**
+   * @param x The cell column.
+   * @param y The cell row.
+   * @return The key for the cell in the cell map.
+   */
+  static Uint64 cellKey(int x, int y) {
+    return (static_cast<Uint64>(static_cast<Uint32>(x)) << 32) |
+           static_cast<Uint32>(y);
+  }
+
+  /**
+   * @param v A coordinate in grid units.
+   * @return The index of the cell row or column containing the coordinate.
+   */
+  int cellIndex(float v) const {
+    return static_cast<int>(floorf(v / _cell_size));
+  }
+};
+
+}  // namespace level_gen
+
+#endif  // GENERATORS_ROOM_GRID_H_
@@ -236,6 +236,9 @@ class CustomScene2Loader : public Scene2Loader {
     return (result->init(threads) ? result : nullptr);
   }
 
+  // Scenes in a JsonDocument are built with the node types below as well.
+  using Scene2Loader::build;
+
   /**
    * Recursively builds the scene from the given JSON tree.
    *
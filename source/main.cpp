@@ -1,13 +1,46 @@
 #include <cugl/cugl.h>
 
+#include <cstdlib>
+#include <cstring>
+
+#ifdef HEADLESS_HOST
+#include "HeadlessApp.h"
+#else
 #include "GameApp.h"
+#endif
 
 // Window size if not on mobile device.
 #define GAME_WIDTH 1024
 #define GAME_HEIGHT 576
 
 int main(int argc, char *argv[]) {
+#ifdef HEADLESS_HOST
+  HeadlessApp app;
+  app.setHeadless(true);
+  app.setNullRenderer(true);
+  // The command line is [players] [--record <log> | --replay <log>]
+  // [--soak <clients> [--latency <ms>] [--loss <0 to 1>]].
+  float latency = 0;
+  float loss = 0;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+      app.setRecordPath(argv[++i]);
+    } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      app.setReplayPath(argv[++i]);
+    } else if (std::strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+      app.setSoakClients(std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+      latency = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--loss") == 0 && i + 1 < argc) {
+      loss = std::atof(argv[++i]);
+    } else {
+      app.setNumPlayers(std::atoi(argv[i]));
+    }
+  }
+  app.setSoakConditions(latency, loss);
+#else
   GameApp app;
+#endif
 
   app.setName("Dungeon Deception");
   app.setOrganization("(Oops) Games");
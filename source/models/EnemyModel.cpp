@@ -52,6 +52,7 @@ bool EnemyModel::init(const cugl::Vec2 pos, string name, string type) {
   _isKnockbacked = false;
   _stunned_timer = 0;
   _goal_frame = 0;
+  _death_track = -1;
   _move_back_timer = 0;
   _damage_count = 0;
 
@@ -167,6 +167,9 @@ class EnemyModel : public cugl::physics2::CapsuleObstacle {
   /** The goal frame for the turtle enemy*/
   int _goal_frame;
 
+  /** The animator track for the death animation, or -1 if still alive. */
+  int _death_track;
+
   /** Timer for staying in the move back state. */
   int _move_back_timer;
 
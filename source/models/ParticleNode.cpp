@@ -0,0 +1,57 @@
+#include "ParticleNode.h"
+
+void ParticleNode::dispose() {
+  _mesh.clear();
+  SceneNode::dispose();
+}
+
+bool ParticleNode::init() {
+  if (!SceneNode::init()) return false;
+  _mesh.command = GL_TRIANGLES;
+  return true;
+}
+
+void ParticleNode::addQuad(float x, float y, float size, float angle,
+                           GLuint color) {
+  // Rotate the half extents instead of every corner.
+  float half = size * 0.5f;
+  float c = cosf(angle) * half;
+  float s = sinf(angle) * half;
+
+  GLuint base = static_cast<GLuint>(_mesh.vertices.size());
+  cugl::SpriteVertex2 vert;
+  vert.color = color;
+  vert.gradcoord.setZero();
+
+  vert.position.set(x - c + s, y - s - c);
+  vert.texcoord.set(0, 1);
+  _mesh.vertices.push_back(vert);
+  vert.position.set(x + c + s, y + s - c);
+  vert.texcoord.set(1, 1);
+  _mesh.vertices.push_back(vert);
+  vert.position.set(x + c - s, y + s + c);
+  vert.texcoord.set(1, 0);
+  _mesh.vertices.push_back(vert);
+  vert.position.set(x - c - s, y - s + c);
+  vert.texcoord.set(0, 0);
+  _mesh.vertices.push_back(vert);
+
+  _mesh.indices.push_back(base);
+  _mesh.indices.push_back(base + 1);
+  _mesh.indices.push_back(base + 2);
+  _mesh.indices.push_back(base);
+  _mesh.indices.push_back(base + 2);
+  _mesh.indices.push_back(base + 3);
+}
+
+void ParticleNode::draw(const std::shared_ptr<cugl::SpriteBatch>& batch,
+                        const cugl::Affine2& transform, cugl::Color4 tint) {
+  if (_mesh.indices.empty()) return;
+
+  batch->setColor(tint);
+  batch->setTexture(cugl::Texture::getBlank());
+  batch->setBlendEquation(GL_FUNC_ADD);
+  batch->setSrcBlendFunc(GL_SRC_ALPHA);
+  batch->setDstBlendFunc(GL_ONE_MINUS_SRC_ALPHA);
+  batch->drawMesh(_mesh, transform);
+}
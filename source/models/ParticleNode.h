@@ -0,0 +1,90 @@
+#ifndef MODELS_PARTICLE_NODE_H_
+#define MODELS_PARTICLE_NODE_H_
+
+#include <cugl/cugl.h>
+
+/**
+ * A scene graph node that draws a batch of particle quads with a single
+ * drawMesh call.
+ *
+ * The node does not know anything about particles. The ParticleController
+ * clears the node and writes one quad per particle into it every frame, and
+ * the node hands the whole mesh to the SpriteBatch when it is drawn. Since
+ * the node has a single priority, particles that must be ordered with the
+ * rest of the world are split over several nodes, one per sort-key band.
+ */
+class ParticleNode : public cugl::scene2::SceneNode {
+ protected:
+  /** The quads written this frame, two triangles per quad. */
+  cugl::Mesh<cugl::SpriteVertex2> _mesh;
+
+ public:
+  /**
+   * Creates an empty particle node.
+   *
+   * This constructor should never be called directly, use alloc instead.
+   */
+  ParticleNode() { _classname = "ParticleNode"; }
+
+  /**
+   * Deletes this node, releasing all resources.
+   */
+  ~ParticleNode() { dispose(); }
+
+  /**
+   * Disposes all of the resources used by this node.
+   */
+  void dispose() override;
+
+  /**
+   * Initializes an empty particle node.
+   *
+   * @return true if initialization was successful.
+   */
+  bool init() override;
+
+  /**
+   * Returns a new empty particle node.
+   *
+   * @return a new empty particle node.
+   */
+  static std::shared_ptr<ParticleNode> alloc() {
+    std::shared_ptr<ParticleNode> result = std::make_shared<ParticleNode>();
+    return (result->init() ? result : nullptr);
+  }
+
+  /**
+   * Removes every quad from the node. The node keeps its buffers, so
+   * refilling it does not allocate.
+   */
+  void clearQuads() {
+    _mesh.vertices.clear();
+    _mesh.indices.clear();
+  }
+
+  /**
+   * Appends a square quad to the node.
+   *
+   * @param x The x coordinate of the quad center in node space.
+   * @param y The y coordinate of the quad center in node space.
+   * @param size The width and height of the quad.
+   * @param angle The rotation of the quad about its center, in radians.
+   * @param color The packed color of the quad.
+   */
+  void addQuad(float x, float y, float size, float angle, GLuint color);
+
+  /** @return The number of quads written to the node. */
+  size_t getNumQuads() const { return _mesh.vertices.size() / 4; }
+
+  /**
+   * Draws all the quads in the node with the blank texture.
+   *
+   * @param batch The SpriteBatch to draw with.
+   * @param transform The global transformation matrix.
+   * @param tint The tint to blend with the quad colors.
+   */
+  void draw(const std::shared_ptr<cugl::SpriteBatch>& batch,
+            const cugl::Affine2& transform, cugl::Color4 tint) override;
+};
+
+#endif  // MODELS_PARTICLE_NODE_H_
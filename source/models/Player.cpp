@@ -6,11 +6,6 @@
 #define IDLE_LEFT 80
 #define IDLE_DOWN 81
 #define IDLE_UP 83
-#define RUN_LIM_GAP 9
-#define ATTACK_LIM_GAP 8
-#define ATTACK_SETUP_LIM_GAP 7
-#define DEATH_START_FRAME 90
-#define FINAL_DEATH_FRAME 114
 #define ATTACK_FRAMES 25
 #define ENERGY 0
 #define HEALTH 50
@@ -45,16 +40,18 @@ bool Player::init(const cugl::Vec2 pos, const std::string& name) {
 
   _network_pos_cache[0] = pos_;
   _network_pos_cache[1] = pos_;
+  _time_since_network_pos = 0;
+  _network_pos_interval = 0;
 
   CapsuleObstacle::init(pos_, size_);
   setName(name);
 
   _player_node = nullptr;
+  _anim_track = -1;
   _current_state = IDLE;
   _health = HEALTH;
   _energy = ENERGY;
   _corrupted_energy = 0;
-  _frame_count = 0;
   _attack_frame_count = ATTACK_FRAMES;
   _hurt_frames = 0;
   _corrupt_count = 0;
@@ -82,6 +79,7 @@ bool Player::init(const cugl::Vec2 pos, const std::string& name) {
 }
 
 void Player::dispose() {
+  setAnimator(nullptr);
   _player_node->setVisible(false);
   _player_node = nullptr;
 }
@@ -91,6 +89,24 @@ void Player::setPlayerNode(
   _player_node = node;
 }
 
+void Player::setAnimator(const std::shared_ptr<Animator>& animator) {
+  if (_animator != nullptr) _animator->removeTrack(_anim_track);
+  _animator = animator;
+  _anim_track = -1;
+  if (_animator == nullptr) return;
+
+  // Clips are indexed by move direction: left, down, right, up.
+  const std::string direcs[] = {"left", "down", "right", "up"};
+  for (int i = 0; i < 4; i++) {
+    _idle_clips[i] = _animator->getClip("player-idle-" + direcs[i]);
+    _run_clips[i] = _animator->getClip("player-run-" + direcs[i]);
+    _attack_clips[i] = _animator->getClip("player-attack-" + direcs[i]);
+  }
+  _death_clip = _animator->getClip("player-death");
+  _anim_track = _animator->addTrack(_player_node);
+  _animator->play(_anim_track, _idle_clips[getMoveDir()]);
+}
+
 void Player::setNameNode(const std::shared_ptr<cugl::Font>& name_font,
                          bool display_betrayer) {
   if (_name_node == nullptr) {
@@ -295,64 +311,27 @@ void Player::update(float delta) {
 }
 
 void Player::animate() {
-  if (!_isDead) {
-    switch (_current_state) {
-      case DASHING:
-      case MOVING: {
-        if (_frame_count == 0) {
-          _player_node->setFrame(getRunLowLim());
-        }
-
-        // Play the next animation frame.
-        if (_frame_count >= 5) {
-          _frame_count = 0;
-          if (_player_node->getFrame() >= getRunHighLim()) {
-            _player_node->setFrame(getRunLowLim());
-          } else {
-            _player_node->setFrame(_player_node->getFrame() + 1);
-          }
-        }
-        _frame_count++;
-        break;
-      }
-      case IDLE: {
-        _player_node->setFrame(_mv_direc);
-        _frame_count = 0;
-        break;
-      }
-      case ATTACKING: {
-        int attack_high_lim = getAttackHighLim();
-        int attack_low_lim = attack_high_lim - ATTACK_LIM_GAP;
-
-        // Play the next animation frame.
-        if (_frame_count >= 3) {
-          _frame_count = 0;
-          if (_player_node->getFrame() >= attack_high_lim) {
-            _player_node->setFrame(attack_low_lim);
-          } else {
-            _player_node->setFrame(_player_node->getFrame() + 1);
-          }
-        }
-        _frame_count++;
-        break;
-      }
-    }
-  } else {
+  if (_animator == nullptr) return;
+
+  if (_isDead) {
     if (_mv_direc == IDLE_LEFT) {
       _player_node->flipHorizontal(true);
     }
-    // Death just began, set to initial frame.
-    if (_player_node->getFrame() < DEATH_START_FRAME) {
-      _player_node->setFrame(DEATH_START_FRAME);
-    }
-    
-    if (_player_node->getFrame() != FINAL_DEATH_FRAME) {
-      if (_frame_count >= 5) {
-        _frame_count = 0;
-        _player_node->setFrame(_player_node->getFrame() + 1);
-      }
-      _frame_count++;
-    }
+    _animator->play(_anim_track, _death_clip);
+    return;
+  }
+
+  switch (_current_state) {
+    case DASHING:
+    case MOVING:
+      _animator->play(_anim_track, _run_clips[getMoveDir()]);
+      break;
+    case IDLE:
+      _animator->play(_anim_track, _idle_clips[getMoveDir()]);
+      break;
+    case ATTACKING:
+      _animator->play(_anim_track, _attack_clips[getMoveDir()]);
+      break;
   }
 }
 
@@ -386,10 +365,7 @@ void Player::updateDirection(const cugl::Vec2& diff) {
       new_direc = IDLE_UP;
     }
   }
-  if (new_direc != _mv_direc) {
-    _mv_direc = new_direc;
-    _frame_count = 0;
-  }
+  _mv_direc = new_direc;
 }
 
 void Player::makeSlash(cugl::Vec2 attackDir, cugl::Vec2 swordPos) {
@@ -418,31 +394,10 @@ void Player::checkDeleteSlashes(
   }
 }
 
-int Player::getRunHighLim() {
-  if (_mv_direc == IDLE_RIGHT) {
-    return 59;  // Value for the right run high limit
-  } else if (_mv_direc == IDLE_LEFT) {
-    return 69;  // Value for the left run high limit
-  } else if (_mv_direc == IDLE_UP) {
-    return 79;  // Value for the up run high limit
-  }
-  return 49;  // Value for the down run high limit
-}
-
-int Player::getRunLowLim() { return getRunHighLim() - RUN_LIM_GAP; }
-
 bool Player::isSteppingOnFloor() {
-  int relative_frame = _player_node->getFrame() - getRunLowLim();
-  return (relative_frame == 1 || relative_frame == 6) && _frame_count == 1;
-}
-
-int Player::getAttackHighLim() {
-  if (_mv_direc == IDLE_RIGHT) {
-    return 8;  // Value for the right attack high limit
-  } else if (_mv_direc == IDLE_LEFT) {
-    return 28;  // Value for the left attack high limit
-  } else if (_mv_direc == IDLE_UP) {
-    return 38;  // Value for the up attack high limit
+  if (_animator == nullptr || !_animator->frameChanged(_anim_track)) {
+    return false;
   }
-  return 18;  // Value for the down attack high limit
+  int frame = _animator->getClipFrame(_anim_track);
+  return frame == 1 || frame == 6;
 }
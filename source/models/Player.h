@@ -4,6 +4,7 @@
 #include <cugl/cugl.h>
 #include <stdio.h>
 
+#include "../controllers/Animator.h"
 #include "Projectile.h"
 #include "Sword.h"
 
@@ -16,6 +17,15 @@ class Player : public cugl::physics2::CapsuleObstacle {
   /** The scene graph node for the player (moving). */
   std::shared_ptr<cugl::scene2::SpriteNode> _player_node;
 
+  /** The animator that plays the player clips. */
+  std::shared_ptr<Animator> _animator;
+  /** The animator track of the player node, or -1 without an animator. */
+  int _anim_track;
+  /** The idle, run and attack clips, indexed by move direction. */
+  int _idle_clips[4], _run_clips[4], _attack_clips[4];
+  /** The death clip. */
+  int _death_clip;
+
   /** The scene graph node for the player name (moving). */
   std::shared_ptr<cugl::scene2::Label> _name_node;
 
@@ -36,8 +46,19 @@ class Player : public cugl::physics2::CapsuleObstacle {
   /** The last two positions the server has sent to this player. */
   std::array<cugl::Vec2, 2> _network_pos_cache;
 
-  /** A timestamp that represents the last time the player position was set. */
-  cugl::Timestamp _last_network_pos_udpate;
+  /**
+   * The simulation time since the player position was last set, in
+   * milliseconds. This is game time rather than wall time, so that replays
+   * interpolate exactly as the recorded match did.
+   */
+  float _time_since_network_pos;
+
+  /**
+   * The simulation time between the last two network positions, in
+   * milliseconds. The host does not send every tick, so this is how long
+   * the player takes to move between them.
+   */
+  float _network_pos_interval;
 
   /** The player's current state. */
   State _current_state;
@@ -105,8 +126,6 @@ class Player : public cugl::physics2::CapsuleObstacle {
   std::shared_ptr<std::string> _projectile_sensor_name;
 
  public:
-  /** Countdown to change animation frame. */
-  int _frame_count;
   /** Countdown for attacking frames. */
   int _attack_frame_count;
   /** Countdown for hurting frames. */
@@ -347,20 +366,6 @@ class Player : public cugl::physics2::CapsuleObstacle {
    */
   void toggleBlockPlayerOnBetrayer(int runner_id);
 
-  /**
-   * Internal method for getting the correct run high limit.
-   *
-   * @return the run high limit
-   */
-  int getRunHighLim();
-
-  /**
-   * Internal method for getting the correct run low limit.
-   *
-   * @return the run low limit
-   */
-  int getRunLowLim();
-
   /**
    * Check if the player is stepping on the floor using animation frames.
    *
@@ -368,13 +373,6 @@ class Player : public cugl::physics2::CapsuleObstacle {
    */
   bool isSteppingOnFloor();
 
-  /**
-   * Internal method for getting the correct attack high limit.
-   *
-   * @return the attack high limit
-   */
-  int getAttackHighLim();
-  
   /**
    * Creates the physics Body(s) for this object, adding them to the world.
    *
@@ -423,7 +421,8 @@ class Player : public cugl::physics2::CapsuleObstacle {
    * @param pos The network position.
    */
   void setNetworkPos(cugl::Vec2 pos) {
-    _last_network_pos_udpate.mark();
+    _network_pos_interval = _time_since_network_pos;
+    _time_since_network_pos = 0;
     _network_pos_cache[1] = _network_pos_cache[0];
     _network_pos_cache[0] = pos;
   }
@@ -442,11 +441,24 @@ class Player : public cugl::physics2::CapsuleObstacle {
    * @return The time since the last packet for player position was received. In
    * milliseconds.
    */
-  float getTimeSinceLastNetworkPosUpdate() {
-    cugl::Timestamp time;
-    Uint32 millis =
-        (Uint32)time.ellapsedMicros(_last_network_pos_udpate) / 1000;
-    return (float)millis;
+  float getTimeSinceLastNetworkPosUpdate() { return _time_since_network_pos; }
+
+  /**
+   * Get the time between the last two packets for player position. In
+   * milliseconds.
+   *
+   * @return The time between the last two packets for player position. In
+   * milliseconds.
+   */
+  float getNetworkPosInterval() { return _network_pos_interval; }
+
+  /**
+   * Advance the time since the last packet for player position was received.
+   *
+   * @param millis The simulation time that passed, in milliseconds.
+   */
+  void advanceNetworkPosTime(float millis) {
+    _time_since_network_pos += millis;
   }
 
   /**
@@ -468,6 +480,15 @@ class Player : public cugl::physics2::CapsuleObstacle {
    */
   void setPlayerNode(const std::shared_ptr<cugl::scene2::SpriteNode>& node);
 
+  /**
+   * Sets the animator that plays the player clips, and adds a track for the
+   * player node. The node must be set first. Passing nullptr removes the
+   * track from the previous animator.
+   *
+   * @param animator  The animator for the player node.
+   */
+  void setAnimator(const std::shared_ptr<Animator>& animator);
+
   /**
    * Set the display name for the character. Will display above the head.
    *
@@ -554,7 +575,9 @@ class Player : public cugl::physics2::CapsuleObstacle {
   void setRoomId(int id) { _room_id = id; }
 
   /**
-   * Sets the frame of the animation.
+   * Plays the clip for the current state and direction. The animator
+   * advances the clip, so this only needs to be called when the state or
+   * direction may have changed.
    */
   void animate();
 
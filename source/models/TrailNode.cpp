@@ -0,0 +1,38 @@
+#include "TrailNode.h"
+
+void TrailNode::dispose() {
+  _mesh.clear();
+  _texture = nullptr;
+  SceneNode::dispose();
+}
+
+bool TrailNode::initWithTexture(const std::shared_ptr<cugl::Texture>& texture) {
+  if (!SceneNode::init()) return false;
+  _texture = texture;
+  _mesh.command = GL_TRIANGLES;
+  return true;
+}
+
+void TrailNode::addGhost(const std::vector<cugl::SpriteVertex2>& vertices,
+                         const std::vector<Uint32>& indices, GLuint color) {
+  Uint32 base = static_cast<Uint32>(_mesh.vertices.size());
+  for (const cugl::SpriteVertex2& vert : vertices) {
+    _mesh.vertices.push_back(vert);
+    _mesh.vertices.back().color = color;
+  }
+  for (Uint32 index : indices) {
+    _mesh.indices.push_back(base + index);
+  }
+}
+
+void TrailNode::draw(const std::shared_ptr<cugl::SpriteBatch>& batch,
+                     const cugl::Affine2& transform, cugl::Color4 tint) {
+  if (_mesh.indices.empty()) return;
+
+  batch->setColor(tint);
+  batch->setTexture(_texture);
+  batch->setBlendEquation(GL_FUNC_ADD);
+  batch->setSrcBlendFunc(GL_SRC_ALPHA);
+  batch->setDstBlendFunc(GL_ONE_MINUS_SRC_ALPHA);
+  batch->drawMesh(_mesh, transform);
+}
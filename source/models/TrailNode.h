@@ -0,0 +1,91 @@
+#ifndef MODELS_TRAIL_NODE_H_
+#define MODELS_TRAIL_NODE_H_
+
+#include <cugl/cugl.h>
+
+/**
+ * A scene graph node that draws the ghosts of a motion trail with a single
+ * drawMesh call.
+ *
+ * Every ghost is a copy of a sprite mesh, already transformed into the space
+ * of this node's parent, with its own color. The TrailManager refills the
+ * node whenever a ghost is added or removed, and the node hands the whole
+ * mesh to the SpriteBatch when it is drawn.
+ */
+class TrailNode : public cugl::scene2::SceneNode {
+ protected:
+  /** The texture shared by all the ghosts. */
+  std::shared_ptr<cugl::Texture> _texture;
+  /** The ghosts written to the node. */
+  cugl::Mesh<cugl::SpriteVertex2> _mesh;
+
+ public:
+  /**
+   * Creates an empty trail node.
+   *
+   * This constructor should never be called directly, use alloc instead.
+   */
+  TrailNode() { _classname = "TrailNode"; }
+
+  /**
+   * Deletes this node, releasing all resources.
+   */
+  ~TrailNode() { dispose(); }
+
+  /**
+   * Disposes all of the resources used by this node.
+   */
+  void dispose() override;
+
+  /**
+   * Initializes an empty trail node for ghosts of the given texture.
+   *
+   * @param texture The texture of the sprite that leaves the trail.
+   * @return true if initialization was successful.
+   */
+  bool initWithTexture(const std::shared_ptr<cugl::Texture>& texture);
+
+  /**
+   * Returns a new empty trail node for ghosts of the given texture.
+   *
+   * @param texture The texture of the sprite that leaves the trail.
+   * @return a new empty trail node.
+   */
+  static std::shared_ptr<TrailNode> alloc(
+      const std::shared_ptr<cugl::Texture>& texture) {
+    std::shared_ptr<TrailNode> result = std::make_shared<TrailNode>();
+    return (result->initWithTexture(texture) ? result : nullptr);
+  }
+
+  /**
+   * Removes every ghost from the node. The node keeps its buffers, so
+   * refilling it does not allocate.
+   */
+  void clearGhosts() {
+    _mesh.vertices.clear();
+    _mesh.indices.clear();
+  }
+
+  /**
+   * Appends a ghost to the node. Ghosts are drawn in the order they are
+   * added, so the oldest ghost should be added first.
+   *
+   * @param vertices The ghost vertices, in the space of the node's parent.
+   * @param indices The triangle indices of the ghost vertices.
+   * @param color The packed color of the ghost.
+   */
+  void addGhost(const std::vector<cugl::SpriteVertex2>& vertices,
+                const std::vector<Uint32>& indices, GLuint color);
+
+  /**
+   * Draws all the ghosts in the node.
+   *
+   * @param batch The SpriteBatch to draw with.
+   * @param transform The global transformation matrix.
+   * @param tint The tint to blend with the ghost colors.
+   */
+  void draw(const std::shared_ptr<cugl::SpriteBatch>& batch,
+            const cugl::Affine2& transform, cugl::Color4 tint) override;
+};
+
+#endif  // MODELS_TRAIL_NODE_H_
@@ -14,7 +14,8 @@ Room::Room(default_rooms::RoomConfig config)
       _scene2_source(config.scene2_source),
       _num_players_for_terminal(0),
       _to_delete(false),
-      _key(-1) {
+      _key(-1),
+      _size(config.size) {
   for (cugl::Vec2 &door : config.doors) {
     // If the door is within the bounds of the edges of the room then add it to
     // the rooms doors.
@@ -28,19 +29,17 @@ Room::Room(default_rooms::RoomConfig config)
       _doors.push_back(door);
     }
   }
-
-  initScene2(config.size);
 }
 
 void Room::move(cugl::Vec2 dist) {
   if (!_fixed) {
     dist.set(roundf(dist.x), roundf(dist.y));
-    _node->setPosition(_node->getPosition() + dist);
+    _pos += dist;
   }
 }
 
 void Room::moveTo(cugl::Vec2 pos) {
-  if (!_fixed) _node->setPosition(pos);
+  if (!_fixed) _pos = pos;
 }
 
 void Room::addEdge(const std::shared_ptr<Edge> &edge) {
@@ -141,10 +140,9 @@ float Room::angleBetweenEdgeAndDoor(const std::shared_ptr<Edge> &edge,
   return std::min(diff, approx_diff);
 }
 
-void Room::initScene2(cugl::Size size) {
+void Room::initScene2() {
   _node = cugl::scene2::PolygonNode::alloc();
-  _node->setContentSize(size);
-  _size = size;
+  _node->setContentSize(_size);
 
   for (cugl::Vec2 door : _doors) {
     cugl::Vec2 pos(floorf(door.x), floorf(door.y));
@@ -159,6 +157,9 @@ void Room::initScene2(cugl::Size size) {
     _node->addChild(tile);
   }
 
+  _node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
+  _node->setPosition(_pos);
+  _node->setColor(getRoomNodeColorGenerator());
   _node->doLayout();
 }
 
@@ -173,11 +174,16 @@ Edge::Edge(const std::shared_ptr<Room> &s, const std::shared_ptr<Room> &n)
   _path.push_back(_neighbor->getMid());
 
   _weight = (_path[1] - _path[0]).length();
+}
+
+void Edge::initScene2() {
+  cugl::Vec2 start_pos(std::min(_hallway[0].x, _hallway[1].x),
+                       std::min(_hallway[0].y, _hallway[1].y));
 
-  _node = cugl::scene2::PathNode::allocWithVertices(_path, 0.4f);
+  _node = cugl::scene2::PathNode::allocWithVertices(_hallway, 1.0f);
+  _node->setColor(cugl::Color4(0, 0, 0, 127));
   _node->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_LEFT);
-  _node->setPosition(_node->getBoundingRect().origin);
-  _node->setColor(cugl::Color4(0, 0, 0, 50));
+  _node->setPosition(start_pos);
 }
 
 bool Edge::doesIntersect(cugl::Vec2 origin, float r) {
@@ -23,7 +23,8 @@ class Room {
    * for the activation. */
   int _num_players_for_terminal;
 
-  /** A reference to the scene2 node for the room. */
+  /** A reference to the scene2 node for the room on the map. Is nullptr until
+   * initScene2() is called after generation. */
   std::shared_ptr<cugl::scene2::PolygonNode> _node;
 
   /** A reference to the scene2 node for the level. */
@@ -52,6 +53,9 @@ class Room {
   /** The key for the room object. */
   int _key;
 
+  /** The position of the bottom left corner of the room in grid units. */
+  cugl::Vec2 _pos;
+
   /** The size of the room. */
   cugl::Size _size;
 
@@ -149,25 +153,19 @@ class Room {
    * Get a rectangle representation of the room.
    * @return cugl::Rect with room's position and size.
    */
-  cugl::Rect getRect() const {
-    return cugl::Rect(_node->getPosition(), _node->getSize());
-  }
+  cugl::Rect getRect() const { return cugl::Rect(_pos, _size); }
 
   /**
    * Get the midpoint of the room.
    * @return cugl::Vec2 of the midpoint of the room.
    */
-  cugl::Vec2 getMid() const {
-    return _node->getPosition() + _node->getSize() / 2.0f;
-  }
+  cugl::Vec2 getMid() const { return _pos + _size / 2.0f; }
 
   /**
    * Get the diagonal radius of the room.
    * @return The diagonal radius of the room.
    */
-  float getRadius() const {
-    return cugl::Vec2(_node->getSize()).length() / 2.0f;
-  }
+  float getRadius() const { return cugl::Vec2(_size).length() / 2.0f; }
 
   /** Calculate the edge to door pairing. */
   void initializeEdgeToDoorPairing();
@@ -175,14 +173,12 @@ class Room {
   float angleBetweenEdgeAndDoor(const std::shared_ptr<Edge> &edge,
                                 cugl::Vec2 door);
 
- private:
   /**
-   * Initialize the scene2 nodes for this room given a certain size in grid
-   * units.
-   *
-   * @param size The size of the room in grid units.
+   * Initialize the scene2 nodes for this room on the map from its position,
+   * size and doors. The level generator does not touch the scene graph, so
+   * this is only called once generation is done.
    */
-  void initScene2(cugl::Size size);
+  void initScene2();
 };
 
 /**
@@ -196,13 +192,18 @@ class Edge {
   /** A reference to the neighbor Room. */
   std::shared_ptr<Room> _neighbor;
 
-  /** A reference to the scene2 node for debug drawing. */
+  /** A reference to the scene2 node for the hallway on the map. Is nullptr
+   * until initScene2() is called after generation. */
   std::shared_ptr<cugl::scene2::PathNode> _node;
 
   /** A pair of vectors that represent the line segment connecting both
    * rooms. Will always have a size of 2. */
   std::vector<cugl::Vec2> _path;
 
+  /** A pair of vectors that represent the hallway between the doors of both
+   * rooms in grid units. Is empty until the level generator fills it. */
+  std::vector<cugl::Vec2> _hallway;
+
   /** The length of the edge. */
   float _weight;
 
@@ -219,6 +220,12 @@ class Edge {
    */
   Edge(const std::shared_ptr<Room> &s, const std::shared_ptr<Room> &n);
 
+  /**
+   * Initialize the scene2 node for the hallway of this edge on the map. Only
+   * call this once the level generator has filled the hallway.
+   */
+  void initScene2();
+
   /**
    * Check if the edge intersects a circle with given origin and radius.
    * @param origin The origin of the circle in grid units.
@@ -65,6 +65,12 @@ CustomNetworkDeserializer::CustomNetworkDeserializer() {
   // Register PlayerIdInfo struct in the factory for deserialization.
   _factory[PlayerIdInfo::Key] = []() { return PlayerIdInfo::alloc(); };
 
+  // Register PlayerDeathInfo struct in the factory for deserialization.
+  _factory[PlayerDeathInfo::Key] = []() { return PlayerDeathInfo::alloc(); };
+
+  // Register InputAckInfo struct in the factory for deserialization.
+  _factory[InputAckInfo::Key] = []() { return InputAckInfo::alloc(); };
+
   // Register PlayerInfo struct in the factory for deserialization.
   _factory[PlayerInfo::Key] = []() { return PlayerInfo::alloc(); };
 
@@ -99,7 +105,7 @@ CustomNetworkDeserializer::CustomNetworkDeserializer() {
  * read methods)
  */
 CustomNetworkDeserializer::CustomMessage CustomNetworkDeserializer::read() {
-  if (_pos >= _data.size()) {
+  if (_pos >= _size) {
     return {};
   }
 
@@ -172,7 +178,7 @@ CustomNetworkDeserializer::CustomMessage CustomNetworkDeserializer::read() {
  * @return a single Serializer object.
  */
 std::shared_ptr<Serializable> CustomNetworkDeserializer::readSerializable() {
-  if (_pos >= _data.size()) {
+  if (_pos >= _size) {
     return 0;
   }
   _pos++;
@@ -197,7 +203,7 @@ std::shared_ptr<Serializable> CustomNetworkDeserializer::readSerializable() {
 std::vector<std::shared_ptr<Serializable>>
 CustomNetworkDeserializer::readSerializableVector() {
   std::vector<std::shared_ptr<Serializable>> vv;
-  if (_pos >= _data.size()) {
+  if (_pos >= _size) {
     return vv;
   }
   _pos++;
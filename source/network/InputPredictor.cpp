@@ -0,0 +1,38 @@
+#include "InputPredictor.h"
+
+/** The milliseconds after which an unconfirmed input is dropped. */
+#define INPUT_TIMEOUT 2000
+/** The most inputs kept waiting for the host. */
+#define MAX_PENDING_INPUTS 64
+
+Uint32 InputPredictor::push(Input input) {
+  input.seq = _next_seq++;
+  input.time.mark();
+  _pending.push_back(input);
+  if (_pending.size() > MAX_PENDING_INPUTS) _pending.pop_front();
+  return input.seq;
+}
+
+void InputPredictor::acknowledge(Uint32 ack) {
+  if (ack > _ack) _ack = ack;
+
+  cugl::Timestamp now;
+  while (!_pending.empty() &&
+         (_pending.front().seq <= _ack ||
+          cugl::Timestamp::ellapsedMillis(_pending.front().time, now) >
+              INPUT_TIMEOUT)) {
+    _pending.pop_front();
+  }
+}
+
+int InputPredictor::reconcileHealth(int enemy_id, int health) const {
+  for (const Input& input : _pending) {
+    if (input.enemy_id == enemy_id) health = applyHit(health, input.damage);
+  }
+  return health;
+}
+
+float InputPredictor::reconcileEnergy(float energy) const {
+  for (const Input& input : _pending) energy *= input.energy_scale;
+  return energy;
+}
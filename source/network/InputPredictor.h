@@ -0,0 +1,126 @@
+#ifndef NETWORK_INPUT_PREDICTOR_H_
+#define NETWORK_INPUT_PREDICTOR_H_
+
+#include <cugl/cugl.h>
+
+#include <algorithm>
+#include <deque>
+
+/**
+ * This class lets a client apply its own inputs before the host confirms them.
+ *
+ * Every input a client sends to the host (such as hitting an enemy or dying)
+ * is numbered, applied locally right away and kept as pending. The host sends
+ * back the last number it processed, which drops the inputs it has applied.
+ * Whenever the host's state for an entity arrives, it is taken as the truth
+ * and the inputs still pending are applied on top of it, so the client never
+ * snaps back to a state from before its own inputs.
+ *
+ * Only the host decides if an enemy dies. A predicted hit takes an enemy down
+ * to 0 health at most, and the kill waits for the host.
+ */
+class InputPredictor {
+  /** An input the host has not confirmed yet. */
+  struct Input {
+    /** The sequence number of the input. */
+    Uint32 seq;
+    /** When the input was sent. */
+    cugl::Timestamp time;
+    /** The enemy the input hit, or -1 if it did not hit one. */
+    int enemy_id;
+    /** The damage done to the enemy. */
+    int damage;
+    /** What the input multiplied the player's energy by. */
+    float energy_scale;
+  };
+
+  /** The inputs the host has not confirmed, oldest first. */
+  std::deque<Input> _pending;
+
+  /** The sequence number of the next input. */
+  Uint32 _next_seq;
+
+  /** The last sequence number confirmed by the host. */
+  Uint32 _ack;
+
+  /**
+   * Numbers and records a new input.
+   *
+   * @param input The input, without its sequence number or time.
+   * @return The sequence number to send with the input.
+   */
+  Uint32 push(Input input);
+
+ public:
+  InputPredictor() : _next_seq(1), _ack(0) {}
+
+  /**
+   * Records a hit on an enemy.
+   *
+   * @param enemy_id The enemy hit.
+   * @param damage The damage done.
+   * @return The sequence number to send with the hit.
+   */
+  Uint32 predictHit(int enemy_id, int damage) {
+    return push({0, cugl::Timestamp(), enemy_id, damage, 1.0f});
+  }
+
+  /**
+   * Records the death of the player, which halves their energy.
+   *
+   * @return The sequence number to send with the death.
+   */
+  Uint32 predictDeath() {
+    return push({0, cugl::Timestamp(), -1, 0, 0.5f});
+  }
+
+  /**
+   * Drops the inputs the host has processed, along with inputs so old that
+   * the host must have dropped them.
+   *
+   * @param ack The last sequence number processed by the host.
+   */
+  void acknowledge(Uint32 ack);
+
+  /**
+   * Returns the health an enemy should have locally given its health on the
+   * host, never predicting a kill.
+   *
+   * @param enemy_id The enemy.
+   * @param health The health of the enemy on the host.
+   * @return The predicted health.
+   */
+  int reconcileHealth(int enemy_id, int health) const;
+
+  /**
+   * Returns the energy the player should have locally given their energy on
+   * the host.
+   *
+   * @param energy The energy of the player on the host.
+   * @return The predicted energy.
+   */
+  float reconcileEnergy(float energy) const;
+
+  /**
+   * Returns the health of an enemy after a new hit, never predicting a kill.
+   *
+   * @param health The current health of the enemy.
+   * @param damage The damage of the hit.
+   * @return The health after the hit.
+   */
+  static int applyHit(int health, int damage) {
+    return health < 0 ? health : std::max(0, health - damage);
+  }
+
+  /** @return The number of inputs the host has not confirmed. */
+  size_t getPendingCount() const { return _pending.size(); }
+
+  /** Forgets all inputs, such as when a new game starts. */
+  void reset() {
+    _pending.clear();
+    _next_seq = 1;
+    _ack = 0;
+  }
+};
+
+#endif  // NETWORK_INPUT_PREDICTOR_H_
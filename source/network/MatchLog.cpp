@@ -0,0 +1,167 @@
+#include "MatchLog.h"
+
+/** The first bytes of every match log. */
+#define MATCH_LOG_MAGIC 0x44444D4C /* DDML */
+/** The version of the log format. */
+#define MATCH_LOG_VERSION 1
+/** The largest message a log may hold, to reject corrupt logs. */
+#define MAX_MESSAGE_SIZE (1 << 20)
+
+namespace {
+
+/**
+ * Appends a variable length integer, 7 bits per byte, lowest bits first.
+ *
+ * @param out The bytes to append to.
+ * @param value The integer.
+ */
+void appendVarint(std::vector<uint8_t>& out, Uint64 value) {
+  while (value >= 0x80) {
+    out.push_back((uint8_t)(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back((uint8_t)value);
+}
+
+/**
+ * Reads a variable length integer written by appendVarint.
+ *
+ * @param reader The log.
+ * @param value The integer read.
+ * @return False if the log ended first.
+ */
+bool readVarint(cugl::BinaryReader& reader, Uint64& value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (!reader.ready()) return false;
+    Uint8 byte = reader.readByte();
+    value |= (Uint64)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+#pragma mark MatchRecorder
+
+bool MatchRecorder::open(const std::string& path, const MatchHeader& header) {
+  close();
+  _writer = cugl::BinaryWriter::alloc(path);
+  if (_writer == nullptr) return false;
+
+  _writer->writeUint32(MATCH_LOG_MAGIC);
+  _writer->writeUint32(MATCH_LOG_VERSION);
+  _writer->writeUint64(header.random_seed);
+  _writer->writeUint64(header.level_seed);
+  _writer->writeUint32(header.num_players);
+  _writer->writeFloat(header.timestep);
+  _writer->writeUint32((Uint32)header.color_ids.size());
+  for (auto& it : header.color_ids) {
+    _writer->writeSint32(it.first);
+    _writer->writeSint32(it.second);
+  }
+
+  _tick.clear();
+  _tick_messages = 0;
+  _ticks = 0;
+  return true;
+}
+
+void MatchRecorder::record(const uint8_t* data, size_t size) {
+  if (_writer == nullptr) return;
+  appendVarint(_tick, size);
+  _tick.insert(_tick.end(), data, data + size);
+  _tick_messages++;
+}
+
+void MatchRecorder::endTick() {
+  if (_writer == nullptr) return;
+
+  std::vector<uint8_t> count;
+  appendVarint(count, _tick_messages);
+  _writer->write(count.data(), count.size());
+  if (!_tick.empty()) _writer->write(_tick.data(), _tick.size());
+
+  _tick.clear();
+  _tick_messages = 0;
+  _ticks++;
+}
+
+void MatchRecorder::close() {
+  if (_writer == nullptr) return;
+  _writer->close();
+  _writer = nullptr;
+}
+
+#pragma mark MatchReplay
+
+bool MatchReplay::open(const std::string& path) {
+  close();
+  _reader = cugl::BinaryReader::alloc(path);
+  if (_reader == nullptr) return false;
+
+  if (!_reader->ready(8) || _reader->readUint32() != MATCH_LOG_MAGIC ||
+      _reader->readUint32() != MATCH_LOG_VERSION || !_reader->ready(28)) {
+    CULogError("%s is not a match log of version %d", path.c_str(),
+               MATCH_LOG_VERSION);
+    close();
+    return false;
+  }
+
+  _header.random_seed = _reader->readUint64();
+  _header.level_seed = _reader->readUint64();
+  _header.num_players = _reader->readUint32();
+  _header.timestep = _reader->readFloat();
+  _header.color_ids.clear();
+  Uint32 colors = _reader->readUint32();
+  for (Uint32 ii = 0; ii < colors && _reader->ready(8); ii++) {
+    int player_id = _reader->readSint32();
+    _header.color_ids[player_id] = _reader->readSint32();
+  }
+
+  _tick.clear();
+  _ends.clear();
+  _ticks = 0;
+  return true;
+}
+
+bool MatchReplay::nextTick() {
+  _tick.clear();
+  _ends.clear();
+  if (_reader == nullptr) return false;
+
+  Uint64 count;
+  if (!readVarint(*_reader, count)) return false;
+
+  for (Uint64 ii = 0; ii < count; ii++) {
+    Uint64 size;
+    if (!readVarint(*_reader, size) || size > MAX_MESSAGE_SIZE ||
+        !_reader->ready((unsigned int)size)) {
+      CULogError("Match log ends in the middle of tick %llu",
+                 (unsigned long long)_ticks);
+      _tick.clear();
+      _ends.clear();
+      return false;
+    }
+    for (Uint64 jj = 0; jj < size; jj++) _tick.push_back(_reader->readByte());
+    _ends.push_back(_tick.size());
+  }
+
+  _ticks++;
+  return true;
+}
+
+void MatchReplay::receive(const NetworkController::Receiver& receiver) const {
+  size_t start = 0;
+  for (size_t end : _ends) {
+    receiver(_tick.data() + start, end - start);
+    start = end;
+  }
+}
+
+void MatchReplay::close() {
+  if (_reader == nullptr) return;
+  _reader->close();
+  _reader = nullptr;
+}
@@ -0,0 +1,140 @@
+#ifndef NETWORK_MATCH_LOG_H_
+#define NETWORK_MATCH_LOG_H_
+
+#include <cugl/cugl.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "NetworkController.h"
+
+/**
+ * Everything besides the received messages that a replay needs to rebuild
+ * the match exactly.
+ */
+struct MatchHeader {
+  /** The seed of the game's random streams (see Random). */
+  Uint64 random_seed;
+  /** The seed of the level generator. */
+  Uint64 level_seed;
+  /** The number of players the level was generated for. */
+  Uint32 num_players;
+  /** The fixed timestep of every tick, in seconds. */
+  float timestep;
+  /** The color of each player, by player id. */
+  std::unordered_map<int, int> color_ids;
+};
+
+/**
+ * This class records a match to a compact binary log.
+ *
+ * With the random streams seeded and a fixed timestep, the simulation only
+ * depends on the messages it receives, so the log is the header followed by
+ * the messages received in each tick. Every tick is written as the number of
+ * its messages followed by each message's size and bytes, with counts and
+ * sizes as variable length integers, so an idle tick takes a single byte.
+ */
+class MatchRecorder {
+  /** The log, or nullptr if closed. */
+  std::shared_ptr<cugl::BinaryWriter> _writer;
+
+  /** The messages of the current tick, each prefixed with its size. */
+  std::vector<uint8_t> _tick;
+
+  /** The number of messages in the current tick. */
+  Uint32 _tick_messages;
+
+  /** The number of ticks written. */
+  Uint64 _ticks;
+
+ public:
+  MatchRecorder() : _tick_messages(0), _ticks(0) {}
+  ~MatchRecorder() { close(); }
+
+  /**
+   * Starts a log at the given path, replacing any existing file.
+   *
+   * @param path The path of the log.
+   * @param header The setup of the match.
+   * @return If the log was opened.
+   */
+  bool open(const std::string& path, const MatchHeader& header);
+
+  /**
+   * Records a message received in the current tick.
+   *
+   * @param data The message, exactly as received.
+   * @param size The size of the message in bytes.
+   */
+  void record(const uint8_t* data, size_t size);
+
+  /** Writes the current tick to the log and starts the next one. */
+  void endTick();
+
+  /** Flushes and closes the log. */
+  void close();
+
+  /** @return If the log is open. */
+  bool isOpen() const { return _writer != nullptr; }
+
+  /** @return The number of ticks written. */
+  Uint64 getTicks() const { return _ticks; }
+};
+
+/**
+ * This class reads back a log written by MatchRecorder, one tick at a time.
+ */
+class MatchReplay {
+  /** The log, or nullptr if closed. */
+  std::shared_ptr<cugl::BinaryReader> _reader;
+
+  /** The setup of the match. */
+  MatchHeader _header;
+
+  /** The bytes of every message in the current tick. */
+  std::vector<uint8_t> _tick;
+
+  /** The end of each message of the current tick in _tick. */
+  std::vector<size_t> _ends;
+
+  /** The number of ticks read. */
+  Uint64 _ticks;
+
+ public:
+  MatchReplay() : _ticks(0) {}
+  ~MatchReplay() { close(); }
+
+  /**
+   * Opens the log at the given path and reads its header.
+   *
+   * @param path The path of the log.
+   * @return If the log was opened and has a valid header.
+   */
+  bool open(const std::string& path);
+
+  /** @return The setup of the match. */
+  const MatchHeader& getHeader() const { return _header; }
+
+  /**
+   * Reads the messages of the next tick.
+   *
+   * @return False if the log has no more ticks.
+   */
+  bool nextTick();
+
+  /**
+   * Delivers the messages of the current tick, in the order they were
+   * received.
+   *
+   * @param receiver The receiver of each message.
+   */
+  void receive(const NetworkController::Receiver& receiver) const;
+
+  /** Closes the log. */
+  void close();
+
+  /** @return The number of ticks read. */
+  Uint64 getTicks() const { return _ticks; }
+};
+
+#endif  // NETWORK_MATCH_LOG_H_
@@ -29,4 +29,6 @@
 
 #define NC_HOST_REMOVE_PLAYER 19
 
+#define NC_HOST_INPUT_ACK 20
+
 #endif /* CONTROLLERS_NETWORK_CODES_H_ */
@@ -7,27 +7,58 @@ bool NetworkController::init(
     const std::shared_ptr<cugl::NetworkConnection> &network) {
   _network = network;
   _next_key = 0;
+  _relay_actions.clear();
+  _default_relay_action = cugl::NetworkConnection::RelayAction::Forward;
+  _stats.clear();
+  _input_acks.clear();
+  _receive_observer = nullptr;
+  _receive_source = nullptr;
+  if (_network != nullptr) {
+    _network->setRelayFilter([this](const uint8_t *data, size_t size) {
+      return getRelayRule(data, size);
+    });
+  }
   return true;
 }
 
 void NetworkController::update() {
   if (_network == nullptr) return;
 
-  _network->receive([this](const std::vector<uint8_t> &data) {
-    _deserializer.receive(data);
+  // Decode each message straight out of its packet.
+  Receiver receiver = [this](const uint8_t *data, size_t size) {
+    if (_receive_observer) _receive_observer(data, size);
+    cugl::Timestamp start;
+    _deserializer.receive(data, size);
     Sint32 code = std::get<Sint32>(_deserializer.read());
-    cugl::CustomNetworkDeserializer::CustomMessage msg = _deserializer.read();
-    for (auto it : _listeners) {
-      (it.second)(code, msg);
+    CodeStats &stats = _stats[code];
+    stats.messages_received++;
+    stats.bytes_received += size;
+    if (_listeners.find(code) != _listeners.end()) {
+      cugl::CustomNetworkDeserializer::CustomMessage msg = _deserializer.read();
+      cugl::Timestamp end;
+      stats.deserialize_micros += cugl::Timestamp::ellapsedMicros(start, end);
+      dispatch(code, msg);
     }
     _deserializer.reset();
-  });
+  };
+
+  if (_receive_source) {
+    // The connection must still be serviced, but none of its messages count.
+    _network->receive([](const uint8_t *data, size_t size) {});
+    _receive_source(receiver);
+  } else {
+    _network->receive(receiver);
+  }
 
   checkConnection();
 }
 
 bool NetworkController::dispose() {
+  if (_network != nullptr) _network->setRelayFilter(nullptr);
   _network = nullptr;
+  _relay_actions.clear();
+  _receive_observer = nullptr;
+  _receive_source = nullptr;
   _disconnect_listener = nullptr;
   _listeners.clear();
   return true;
@@ -57,66 +88,127 @@ bool NetworkController::checkConnection() {
   return true;
 }
 
-Uint32 NetworkController::addListener(Listener listener) {
+Uint32 NetworkController::addListener(const std::vector<Sint32> &codes,
+                                      Listener listener) {
   CUAssertLog(_next_key < (Uint32)-1, "No more available listener slots");
-  _listeners[_next_key++] = listener;
-  return _next_key;
+  Uint32 key = _next_key++;
+  for (Sint32 code : codes) {
+    _listeners[code].push_back(std::make_pair(key, listener));
+  }
+  return key;
 }
 
 bool NetworkController::removeListener(Uint32 key) {
-  if (_listeners.find(key) == _listeners.end()) {
-    return false;
+  bool removed = false;
+  for (auto &it : _listeners) {
+    auto &listeners = it.second;
+    auto found =
+        std::remove_if(listeners.begin(), listeners.end(),
+                       [key](const std::pair<Uint32, Listener> &listener) {
+                         return listener.first == key;
+                       });
+    removed = removed || found != listeners.end();
+    listeners.erase(found, listeners.end());
   }
-  _listeners.erase(key);
-  return true;
+  return removed;
+}
+
+void NetworkController::dispatch(
+    const Sint32 &code,
+    const cugl::CustomNetworkDeserializer::CustomMessage &msg) {
+  auto it = _listeners.find(code);
+  if (it == _listeners.end()) return;
+  for (auto &listener : it->second) {
+    (listener.second)(code, msg);
+  }
+}
+
+void NetworkController::countSent(const Sint32 &code, size_t bytes,
+                                  const cugl::Timestamp &start) {
+  cugl::Timestamp end;
+  CodeStats &stats = _stats[code];
+  stats.messages_sent++;
+  stats.bytes_sent += bytes;
+  stats.serialize_micros += cugl::Timestamp::ellapsedMicros(start, end);
+}
+
+bool NetworkController::getPeerStats(
+    int player_id, cugl::NetworkTransport::PeerStats &stats) {
+  if (_network == nullptr) return false;
+  return _network->getPeerStats(player_id, stats);
+}
+
+cugl::NetworkConnection::RelayRule NetworkController::getRelayRule(
+    const uint8_t *data, size_t size) {
+  // The deserializer is free, as the message was dispatched before this.
+  _deserializer.receive(data, size);
+  Sint32 code = std::get<Sint32>(_deserializer.read());
+  _deserializer.reset();
+
+  auto it = _relay_actions.find(code);
+  cugl::NetworkConnection::RelayAction action =
+      it == _relay_actions.end() ? _default_relay_action : it->second;
+  // Merged messages replace older ones with the same code.
+  return {action, static_cast<Uint32>(code)};
 }
 
 void NetworkController::send(const Sint32 &code) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
 
   std::vector<uint8_t> msg = _serializer.serialize();
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->send(msg);
 }
 
 void NetworkController::send(const Sint32 &code,
                              const std::shared_ptr<cugl::JsonValue> &info) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
   _serializer.writeJson(info);
 
   std::vector<uint8_t> msg = _serializer.serialize();
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->send(msg);
 }
 
 void NetworkController::send(const Sint32 &code, InfoVector &info) {
   if (_network == nullptr || info.size() == 0) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
   _serializer.writeJsonVector(info);
 
   std::vector<uint8_t> msg = _serializer.serialize();
   if (msg.size() > _network->getMaxPacketSize()) {
+    _stats[code].splits++;
     std::vector<InfoVector> split_info = splitVector(info);
     for (InfoVector sub_info : split_info) {
       _serializer.reset();
       _serializer.writeSint32(code);
       _serializer.writeJsonVector(sub_info);
-      _network->send(_serializer.serialize());
+      std::vector<uint8_t> part = _serializer.serialize();
+      countSent(code, part.size(), start);
+      _network->send(part);
+      start.mark();
     }
     return;
   }
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->send(msg);
 }
 
 void NetworkController::send(const Sint32 &code,
                              const std::shared_ptr<cugl::Serializable> &info) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.reset();
   _serializer.writeSint32(code);
   _serializer.writeSerializable(info);
@@ -124,6 +216,7 @@ void NetworkController::send(const Sint32 &code,
   std::vector<uint8_t> msg = _serializer.serialize();
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->send(msg);
 }
 
@@ -131,6 +224,7 @@ void NetworkController::send(
     const Sint32 &code,
     std::vector<std::shared_ptr<cugl::Serializable>> &info) {
   if (_network == nullptr || info.size() == 0) return;
+  cugl::Timestamp start;
   _serializer.reset();
 
   _serializer.writeSint32(code);
@@ -139,6 +233,7 @@ void NetworkController::send(
   std::vector<uint8_t> msg = _serializer.serialize();
 
   if (msg.size() > _network->getMaxPacketSize()) {
+    _stats[code].splits++;
     std::vector<std::vector<std::shared_ptr<cugl::Serializable>>> split_info =
         splitVector(info);
     for (std::vector<std::shared_ptr<cugl::Serializable>> sub_info :
@@ -146,59 +241,74 @@ void NetworkController::send(
       _serializer.reset();
       _serializer.writeSint32(code);
       _serializer.writeSerializableVector(sub_info);
-      _network->send(_serializer.serialize());
+      std::vector<uint8_t> part = _serializer.serialize();
+      countSent(code, part.size(), start);
+      _network->send(part);
+      start.mark();
     }
     return;
   }
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->send(msg);
 }
 
 void NetworkController::sendOnlyToHost(const Sint32 &code) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
 
   std::vector<uint8_t> msg = _serializer.serialize();
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->sendOnlyToHost(msg);
 }
 
 void NetworkController::sendOnlyToHost(
     const Sint32 &code, const std::shared_ptr<cugl::JsonValue> &info) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
   _serializer.writeJson(info);
 
   std::vector<uint8_t> msg = _serializer.serialize();
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->sendOnlyToHost(msg);
 }
 
 void NetworkController::sendOnlyToHost(const Sint32 &code, InfoVector &info) {
   if (_network == nullptr || info.size() == 0) return;
+  cugl::Timestamp start;
   _serializer.writeSint32(code);
   _serializer.writeJsonVector(info);
 
   std::vector<uint8_t> msg = _serializer.serialize();
   if (msg.size() > _network->getMaxPacketSize()) {
+    _stats[code].splits++;
     std::vector<InfoVector> split_info = splitVector(info);
     for (InfoVector sub_info : split_info) {
       _serializer.reset();
       _serializer.writeSint32(code);
       _serializer.writeJsonVector(sub_info);
-      _network->sendOnlyToHost(_serializer.serialize());
+      std::vector<uint8_t> part = _serializer.serialize();
+      countSent(code, part.size(), start);
+      _network->sendOnlyToHost(part);
+      start.mark();
     }
     return;
   }
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->sendOnlyToHost(msg);
 }
 
 void NetworkController::sendOnlyToHost(
     const Sint32 &code, const std::shared_ptr<cugl::Serializable> &info) {
   if (_network == nullptr) return;
+  cugl::Timestamp start;
   _serializer.reset();
   _serializer.writeSint32(code);
   _serializer.writeSerializable(info);
@@ -206,6 +316,7 @@ void NetworkController::sendOnlyToHost(
   std::vector<uint8_t> msg = _serializer.serialize();
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->sendOnlyToHost(msg);
 }
 
@@ -213,6 +324,7 @@ void NetworkController::sendOnlyToHost(
     const Sint32 &code,
     std::vector<std::shared_ptr<cugl::Serializable>> &info) {
   if (_network == nullptr || info.size() == 0) return;
+  cugl::Timestamp start;
   _serializer.reset();
 
   _serializer.writeSint32(code);
@@ -221,6 +333,7 @@ void NetworkController::sendOnlyToHost(
   std::vector<uint8_t> msg = _serializer.serialize();
 
   if (msg.size() > _network->getMaxPacketSize()) {
+    _stats[code].splits++;
     std::vector<std::vector<std::shared_ptr<cugl::Serializable>>> split_info =
         splitVector(info);
     for (std::vector<std::shared_ptr<cugl::Serializable>> sub_info :
@@ -228,15 +341,53 @@ void NetworkController::sendOnlyToHost(
       _serializer.reset();
       _serializer.writeSint32(code);
       _serializer.writeSerializableVector(sub_info);
-      _network->sendOnlyToHost(_serializer.serialize());
+      std::vector<uint8_t> part = _serializer.serialize();
+      countSent(code, part.size(), start);
+      _network->sendOnlyToHost(part);
+      start.mark();
     }
     return;
   }
 
   _serializer.reset();
+  countSent(code, msg.size(), start);
   _network->sendOnlyToHost(msg);
 }
 
+void NetworkController::sendToPlayer(
+    int player_id, const Sint32 &code,
+    std::vector<std::shared_ptr<cugl::Serializable>> &info) {
+  if (_network == nullptr || info.size() == 0) return;
+  cugl::Timestamp start;
+  _serializer.reset();
+
+  _serializer.writeSint32(code);
+  _serializer.writeSerializableVector(info);
+
+  std::vector<uint8_t> msg = _serializer.serialize();
+
+  if (msg.size() > _network->getMaxPacketSize()) {
+    _stats[code].splits++;
+    std::vector<std::vector<std::shared_ptr<cugl::Serializable>>> split_info =
+        splitVector(info);
+    for (std::vector<std::shared_ptr<cugl::Serializable>> sub_info :
+         split_info) {
+      _serializer.reset();
+      _serializer.writeSint32(code);
+      _serializer.writeSerializableVector(sub_info);
+      std::vector<uint8_t> part = _serializer.serialize();
+      countSent(code, part.size(), start);
+      _network->sendToPlayer(part, player_id);
+      start.mark();
+    }
+    return;
+  }
+
+  _serializer.reset();
+  countSent(code, msg.size(), start);
+  _network->sendToPlayer(msg, player_id);
+}
+
 std::vector<NetworkController::InfoVector> NetworkController::splitVector(
     InfoVector &info) {
   CUAssertLog(info.size() > 1, "Vector of size %d, cannot be split up.",
@@ -251,7 +402,7 @@ std::vector<NetworkController::InfoVector> NetworkController::splitVector(
   size_one += sizeof(Sint32) / info.size();
   _serializer.reset();
 
-  std::vector<InfoVector> split_info;
+  std::vector<InfoVector> split_info(1);
   int ii = 0;                // Current index in given info.
   int jj = 0;                // Current index in split_info.
   std::size_t cur_size = 0;  // The size of the current index.
@@ -259,6 +410,7 @@ std::vector<NetworkController::InfoVector> NetworkController::splitVector(
     cur_size += size_one;
     if (cur_size > _network->getMaxPacketSize()) {  // Reset to next entry.
       cur_size = size_one;
+      split_info.emplace_back();
       jj++;
     }
     split_info[jj].push_back(info[ii++]);
@@ -283,7 +435,7 @@ NetworkController::splitVector(
   size_one += sizeof(Uint64);  // Add the vector size.
   _serializer.reset();
 
-  std::vector<std::vector<std::shared_ptr<cugl::Serializable>>> split_info;
+  std::vector<std::vector<std::shared_ptr<cugl::Serializable>>> split_info(1);
   int ii = 0;                // Current index in given info.
   int jj = 0;                // Current index in split_info.
   std::size_t cur_size = 0;  // The size of the current index.
@@ -291,6 +443,7 @@ NetworkController::splitVector(
     cur_size += size_one;
     if (cur_size > _network->getMaxPacketSize()) {  // Reset to next entry.
       cur_size = size_one;
+      split_info.emplace_back();
       jj++;
     }
     split_info[jj].push_back(info[ii++]);
@@ -24,6 +24,30 @@ class NetworkController {
   /** A vector of std::shared_ptr<JsonValue> */
   typedef std::vector<std::shared_ptr<cugl::JsonValue>> InfoVector;
 
+  /** Receives a single message, exactly as the connection delivered it. */
+  typedef std::function<void(const uint8_t *data, size_t size)> Receiver;
+
+  /** Delivers the messages of a tick to the given receiver. */
+  typedef std::function<void(const Receiver &receiver)> Source;
+
+  /** The traffic of a single message code, sent and received. */
+  struct CodeStats {
+    /** The number of messages sent, counting each part of a split message. */
+    Uint64 messages_sent;
+    /** The number of bytes sent, before the connection adds its headers. */
+    Uint64 bytes_sent;
+    /** The number of messages that had to be split to fit in a packet. */
+    Uint64 splits;
+    /** The time spent serializing sent messages, in microseconds. */
+    Uint64 serialize_micros;
+    /** The number of messages received. */
+    Uint64 messages_received;
+    /** The number of bytes received. */
+    Uint64 bytes_received;
+    /** The time spent deserializing received messages, in microseconds. */
+    Uint64 deserialize_micros;
+  };
+
  protected:
   /* Single instance of NetworkController. */
   static std::shared_ptr<NetworkController> _singleton;
@@ -31,8 +55,9 @@ class NetworkController {
   /** A reference to the game's network. */
   std::shared_ptr<cugl::NetworkConnection> _network;
 
-  /** The listener callbacks for receiving information */
-  std::unordered_map<Uint32, Listener> _listeners;
+  /** The listener callbacks for receiving information, by message code */
+  std::unordered_map<Sint32, std::vector<std::pair<Uint32, Listener>>>
+      _listeners;
 
   /** The next availiable for the listeners.*/
   Uint32 _next_key;
@@ -45,6 +70,25 @@ class NetworkController {
    * network. */
   cugl::CustomNetworkDeserializer _deserializer;
 
+  /** How the host relays each message code sent by a client. */
+  std::unordered_map<Sint32, cugl::NetworkConnection::RelayAction>
+      _relay_actions;
+
+  /** How the host relays message codes without an action. */
+  cugl::NetworkConnection::RelayAction _default_relay_action;
+
+  /** The traffic of each message code since the connection was set. */
+  std::unordered_map<Sint32, CodeStats> _stats;
+
+  /** The last input sequence number the host processed from each player. */
+  std::unordered_map<int, Uint32> _input_acks;
+
+  /** Called with every received message before it is decoded, if set. */
+  Receiver _receive_observer;
+
+  /** Delivers the received messages instead of the connection, if set. */
+  Source _receive_source;
+
   bool _is_host;
 
   std::function<void(void)> _disconnect_listener;
@@ -105,13 +149,36 @@ class NetworkController {
    */
   bool checkConnection();
 
+  /**
+   * Sets a function to call with every message received, before it is
+   * decoded. This is used to record a match (see MatchRecorder).
+   *
+   * @param observer The function to call, or nullptr to stop.
+   */
+  void setReceiveObserver(const Receiver &observer) {
+    _receive_observer = observer;
+  }
+
+  /**
+   * Sets where received messages come from instead of the connection, which
+   * is then only used to send. This is used to replay a match (see
+   * MatchReplay).
+   *
+   * @param source The source of the messages, or nullptr for the connection.
+   */
+  void setReceiveSource(const Source &source) { _receive_source = source; }
+
   /**
    * Add a listener to the network receive call.
    *
+   * The listener is only called for messages with one of the given codes, so
+   * it does not have to look at every message sent during the game.
+   *
+   * @param codes The message codes the listener handles.
    * @param listener The listener to add.
    * @return The key for the listener.
    */
-  Uint32 addListener(Listener listener);
+  Uint32 addListener(const std::vector<Sint32> &codes, Listener listener);
 
   /**
    * Remove a listener given the listener's key.
@@ -121,6 +188,36 @@ class NetworkController {
    */
   bool removeListener(Uint32 key);
 
+  /**
+   * Sets how the host relays a message code sent by a client to the other
+   * players.
+   *
+   * Forwarded messages are relayed to every other client. Consumed messages
+   * are only processed by the host, so they should only be used for codes
+   * whose effects the host already sends out itself. Merged messages are
+   * relayed like forwarded ones, but a client's newer message replaces its
+   * older one if the host has not relayed it yet.
+   *
+   * This only matters for the host.
+   *
+   * @param code The message code.
+   * @param action How to relay it.
+   */
+  void setRelayAction(const Sint32 &code,
+                      cugl::NetworkConnection::RelayAction action) {
+    _relay_actions[code] = action;
+  }
+
+  /**
+   * Sets how the host relays message codes without a relay action. By
+   * default they are forwarded.
+   *
+   * @param action How to relay them.
+   */
+  void setDefaultRelayAction(cugl::NetworkConnection::RelayAction action) {
+    _default_relay_action = action;
+  }
+
   /**
    * Add a listener to when the network controller disconnects.
    *
@@ -219,9 +316,7 @@ class NetworkController {
    */
   template <typename T>
   void sendAndProcess(const Sint32 &code, const T &info) {
-    for (auto it : _listeners) {
-      (it.second)(code, info);
-    }
+    dispatch(code, info);
     send(code, info);
   }
 
@@ -314,11 +409,83 @@ class NetworkController {
     // If host, this function is a no-op.
     sendOnlyToHost(code, info);
 
-    if (_is_host) {
-      for (auto it : _listeners) {
-        (it.second)(code, info);
-      }
-    }
+    if (_is_host) dispatch(code, info);
+  }
+
+  /**
+   * Sends a byte array to a single player only.
+   *
+   * This is only useful when called from the host. As a client, this method
+   * does nothing. The message is not relayed to any other player.
+   *
+   * @param player_id The player to send to.
+   * @param msg The byte array to send.
+   */
+  void sendToPlayer(int player_id, const std::vector<uint8_t> &msg) {
+    if (_network == nullptr) return;
+    _network->sendToPlayer(msg, player_id);
+  }
+
+  /**
+   * Sends serializable object info to a single player only
+   *
+   * This lets the host send state only to the clients that need it. Within a
+   * few frames, that player should receive this via a call to
+   * {@link #receive}.
+   *
+   * @param player_id The player to send to.
+   * @param code The message code for parsing during receive.
+   * @param info The serializable info.
+   */
+  void sendToPlayer(int player_id, const Sint32 &code,
+                    std::vector<std::shared_ptr<cugl::Serializable>> &info);
+
+  /**
+   * Returns the traffic of each message code since the connection was set.
+   *
+   * Messages relayed by the host count as sent by the client that sent them,
+   * not by the host. Messages sent as raw byte arrays are not counted.
+   *
+   * @return The traffic of each message code.
+   */
+  const std::unordered_map<Sint32, CodeStats> &getStats() const {
+    return _stats;
+  }
+
+  /** Clears the traffic of every message code. */
+  void resetStats() { _stats.clear(); }
+
+  /**
+   * Gets the link statistics (round trip time, packet loss and total bytes)
+   * for the connection to the given player.
+   *
+   * The host has a link to every client, and a client only to the host.
+   *
+   * @param player_id The player at the other end of the link.
+   * @param stats The statistics to write to.
+   * @return If there is a link to the player.
+   */
+  bool getPeerStats(int player_id, cugl::NetworkTransport::PeerStats &stats);
+
+  /**
+   * Records that the host processed an input of a client. Clients number their
+   * predicted inputs in order, so only the highest sequence number is kept.
+   *
+   * @param player_id The player that sent the input.
+   * @param seq The sequence number of the input.
+   */
+  void ackInput(int player_id, Uint32 seq) {
+    Uint32 &ack = _input_acks[player_id];
+    if (seq > ack) ack = seq;
+  }
+
+  /**
+   * @param player_id The player that sent the inputs.
+   * @return The last input sequence number the host processed from the player.
+   */
+  Uint32 getInputAck(int player_id) const {
+    auto it = _input_acks.find(player_id);
+    return it == _input_acks.end() ? 0 : it->second;
   }
 
   /** Get the cugl network connection. */
@@ -361,7 +528,38 @@ class NetworkController {
   ~NetworkController() { dispose(); }
 
  private:
-  NetworkController() : _is_host(false), _next_key(0) {}
+  NetworkController()
+      : _default_relay_action(cugl::NetworkConnection::RelayAction::Forward),
+        _is_host(false),
+        _next_key(0) {}
+
+  /**
+   * Calls the listeners registered for the message code.
+   *
+   * @param code The message code.
+   * @param msg The deserialized message.
+   */
+  void dispatch(const Sint32 &code,
+                const cugl::CustomNetworkDeserializer::CustomMessage &msg);
+
+  /**
+   * Records a message sent with the given code.
+   *
+   * @param code The message code.
+   * @param bytes The size of the message.
+   * @param start When serialization of the message started.
+   */
+  void countSent(const Sint32 &code, size_t bytes,
+                 const cugl::Timestamp &start);
+
+  /**
+   * Returns the relay rule for a message a client sent to the host.
+   *
+   * @param data The message bytes.
+   * @param size The number of bytes.
+   */
+  cugl::NetworkConnection::RelayRule getRelayRule(const uint8_t *data,
+                                                  size_t size);
 };
 
 #endif  // CONTROLLERS_NETWORK_CONTROLLER_H_
@@ -0,0 +1,107 @@
+#include "SendScheduler.h"
+
+#include <algorithm>
+
+/** The bytes a message adds on top of its updates (code, vector and header). */
+#define MESSAGE_OVERHEAD 20
+/** The most a change in state can multiply the rate priority grows at. */
+#define MAX_CHANGE_BOOST 4.0f
+/** The rate priority grows at for an entity the client is up to date on. */
+#define REFRESH_RATE 0.05f
+
+size_t SendScheduler::getSize(
+    const std::shared_ptr<cugl::Serializable>& info) {
+  auto it = _sizes.find(info->key());
+  if (it != _sizes.end()) return it->second;
+
+  // None of the scheduled types have variable length fields.
+  _serializer.reset();
+  _serializer.writeSerializable(info);
+  size_t size = _serializer.serialize().size();
+  _serializer.reset();
+
+  _sizes[info->key()] = size;
+  return size;
+}
+
+SendScheduler::Batch SendScheduler::schedule(
+    int client_id, const cugl::Vec2& pos,
+    const std::unordered_set<int>& rooms) {
+  Batch batch;
+  size_t spent = 0;
+
+  std::unordered_map<Uint64, Entry>& entries = _clients[client_id];
+  std::vector<std::pair<const Update*, Entry*>> candidates;
+
+  for (const Update& update : _updates) {
+    if (update.exclude == client_id) continue;
+    if (update.room_id != -1 && rooms.count(update.room_id) == 0) continue;
+
+    Uint64 key = ((Uint64)(Uint32)update.code << 32) | (Uint32)update.id;
+    Entry& entry = entries[key];
+    entry.tick = _tick;
+
+    // The client only sees an entity stop once it is sent the same state
+    // twice, so the first tick without a change must not wait its turn.
+    bool stopped =
+        entry.sent && entry.moving && update.state == entry.sent_state;
+
+    if (update.critical || stopped) {
+      if (batch[update.code].empty()) spent += MESSAGE_OVERHEAD;
+      batch[update.code].push_back(update.info);
+      spent += getSize(update.info);
+      entry.priority = 0;
+      entry.moving = entry.sent && update.state != entry.sent_state;
+      entry.sent_state = update.state;
+      entry.sent = true;
+      continue;
+    }
+
+    float rate = MAX_CHANGE_BOOST;
+    if (entry.sent) {
+      float change = update.state.distance(entry.sent_state);
+      rate = change > 0 ? 1 + std::min(change, MAX_CHANGE_BOOST - 1)
+                        : REFRESH_RATE;
+    }
+    auto weight = _weights.find(update.code);
+    float falloff = _falloff / (_falloff + pos.distance(update.pos));
+    entry.priority +=
+        (weight == _weights.end() ? 1.0f : weight->second) * falloff * rate;
+
+    if (entry.priority >= 1) candidates.push_back({&update, &entry});
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<const Update*, Entry*>& a,
+               const std::pair<const Update*, Entry*>& b) {
+              return a.second->priority > b.second->priority;
+            });
+
+  // Smaller updates may still fit after a larger one does not.
+  for (auto& candidate : candidates) {
+    const Update& update = *candidate.first;
+    size_t size = getSize(update.info);
+    auto it = batch.find(update.code);
+    if (it == batch.end() || it->second.empty()) size += MESSAGE_OVERHEAD;
+    if (spent + size > _budget) continue;
+
+    spent += size;
+    batch[update.code].push_back(update.info);
+    candidate.second->priority = 0;
+    candidate.second->moving = candidate.second->sent &&
+                               update.state != candidate.second->sent_state;
+    candidate.second->sent_state = update.state;
+    candidate.second->sent = true;
+  }
+
+  // Forget entities the client no longer sees.
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->second.tick != _tick) {
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return batch;
+}
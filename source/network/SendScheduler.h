@@ -0,0 +1,178 @@
+#ifndef NETWORK_SEND_SCHEDULER_H_
+#define NETWORK_SEND_SCHEDULER_H_
+
+#include <cugl/cugl.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CustomNetworkSerializer.h"
+
+/**
+ * This class decides which entity updates the host sends to each client.
+ *
+ * Every tick the host adds one update for each entity it could send. Each
+ * client keeps a priority per entity, which grows every tick by the weight of
+ * the update's message code, scaled down with the entity's distance from the
+ * client and up with how far the entity's state has moved from what that
+ * client was last sent. An entity is worth sending once its priority reaches
+ * 1, and the most important ones are sent first until the client's byte
+ * budget for the tick is spent. Sending an update resets its priority, while
+ * updates left out keep their priority and win a later tick.
+ *
+ * Critical updates (such as an attack or a death) skip the queue, and are
+ * always sent to every client they are relevant to. So is the first update
+ * after an entity stops changing, since clients only see it stop once they
+ * are sent the same state twice.
+ */
+class SendScheduler {
+ public:
+  /** A batch of updates to send, by message code. */
+  typedef std::unordered_map<
+      Sint32, std::vector<std::shared_ptr<cugl::Serializable>>>
+      Batch;
+
+  /** The state of a single entity that could be sent this tick. */
+  struct Update {
+    /** The message code the update is sent with. */
+    Sint32 code;
+    /** The id of the entity, unique within the message code. */
+    int id;
+    /** The room the update is relevant to, or -1 for every room. */
+    int room_id;
+    /** Where the entity is, for its distance to each client. */
+    cugl::Vec2 pos;
+    /**
+     * The state each client should converge to, scaled so that a change of 1
+     * is just noticeable.
+     */
+    cugl::Vec2 state;
+    /** Whether the update must be sent this tick. */
+    bool critical;
+    /** A client that never needs the update (eg. its own position), or -1. */
+    int exclude;
+    /** The update itself. */
+    std::shared_ptr<cugl::Serializable> info;
+  };
+
+ private:
+  /** What a single client knows about a single entity. */
+  struct Entry {
+    /** The accumulated priority. */
+    float priority;
+    /** The state the client was last sent. */
+    cugl::Vec2 sent_state;
+    /** If the client has ever been sent the entity. */
+    bool sent;
+    /** If the state last sent changed, so the client sees it moving. */
+    bool moving;
+    /** The last tick the entity was scheduled for the client. */
+    Uint64 tick;
+  };
+
+  /** The updates added this tick. */
+  std::vector<Update> _updates;
+
+  /** The entries of each client, by message code and entity id. */
+  std::unordered_map<int, std::unordered_map<Uint64, Entry>> _clients;
+
+  /** The priority weight of each message code. */
+  std::unordered_map<Sint32, float> _weights;
+
+  /** The serialized size of each serializable type, by key. */
+  std::unordered_map<Uint32, size_t> _sizes;
+
+  /** The serializer used to measure serializable types. */
+  cugl::CustomNetworkSerializer _serializer;
+
+  /** The bytes each client may be sent per tick. */
+  size_t _budget;
+
+  /** The distance at which an entity accumulates priority at half rate. */
+  float _falloff;
+
+  /** The current tick. */
+  Uint64 _tick;
+
+  /**
+   * Returns the serialized size of the update, including its type tag.
+   *
+   * @param info The update.
+   * @return The size in bytes.
+   */
+  size_t getSize(const std::shared_ptr<cugl::Serializable>& info);
+
+ public:
+  /**
+   * Creates a scheduler with the given byte budget per client per tick.
+   *
+   * @param budget The bytes each client may be sent per tick.
+   * @param falloff The distance at which priority grows at half rate.
+   */
+  SendScheduler(size_t budget = 1024, float falloff = 400.0f)
+      : _budget(budget), _falloff(falloff), _tick(0) {}
+
+  /**
+   * Sets the bytes each client may be sent per tick. Critical updates are
+   * sent even if they exceed it.
+   *
+   * @param budget The bytes per client per tick.
+   */
+  void setBudget(size_t budget) { _budget = budget; }
+
+  /**
+   * Sets the priority a message code accumulates per tick for an entity that
+   * is next to the client and slightly changed. A weight of 1 sends such an
+   * entity every tick, and a weight of 0.25 every fourth tick.
+   *
+   * @param code The message code.
+   * @param weight The priority per tick.
+   */
+  void setWeight(Sint32 code, float weight) { _weights[code] = weight; }
+
+  /**
+   * Starts a new tick, dropping the updates of the last one.
+   */
+  void clear() {
+    _updates.clear();
+    _tick++;
+  }
+
+  /**
+   * Adds an update that could be sent this tick.
+   *
+   * @param update The update.
+   */
+  void add(const Update& update) { _updates.push_back(update); }
+
+  /**
+   * Chooses the updates to send to a client this tick.
+   *
+   * Entities the client no longer sees are forgotten, so they are sent in
+   * full if they come back.
+   *
+   * @param client_id The client's player id.
+   * @param pos The client's position.
+   * @param rooms The rooms relevant to the client.
+   * @return The updates to send, by message code.
+   */
+  Batch schedule(int client_id, const cugl::Vec2& pos,
+                 const std::unordered_set<int>& rooms);
+
+  /**
+   * Forgets everything about a client, such as when it leaves.
+   *
+   * @param client_id The client's player id.
+   */
+  void removeClient(int client_id) { _clients.erase(client_id); }
+
+  /** Forgets all updates and clients. */
+  void reset() {
+    _updates.clear();
+    _clients.clear();
+    _tick = 0;
+  }
+};
+
+#endif  // NETWORK_SEND_SCHEDULER_H_
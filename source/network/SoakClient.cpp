@@ -0,0 +1,169 @@
+#include "SoakClient.h"
+
+#include "NetworkCodes.h"
+#include "structs/PlayerStructs.h"
+
+/** The lobby message a client names itself with. */
+#define CLIENT_SEND_PLAYER_NAME 1
+/** The lobby message that assigns the betrayers. */
+#define HOST_SEND_ROLES 254
+/** The lobby message that starts the game. */
+#define HOST_START_GAME 255
+/** The key of the spawn room, which is always the first room generated. */
+#define SPAWN_ROOM_ID 0
+/** The center of the spawn room, where every player starts. */
+#define SPAWN_POS cugl::Vec2::ZERO
+/** How far from the spawn a client wanders, in pixels. */
+#define WANDER_RADIUS 200.0f
+/** The speed of a player, in pixels per second. */
+#define PLAYER_SPEED 175.0f
+/** The chance that a client stands still instead of picking a direction. */
+#define STOP_CHANCE 0.3f
+/** The shortest time between changes of direction, in seconds. */
+#define MIN_TURN_TIME 0.5f
+/** The longest time between changes of direction, in seconds. */
+#define MAX_TURN_TIME 2.0f
+
+bool SoakClient::init(const cugl::NetworkConnection::ConnectionConfig& config,
+                      const std::string& room_id, int index) {
+  _network = cugl::NetworkConnection::alloc(config, room_id);
+  if (_network == nullptr) return false;
+
+  _name = "Soak " + std::to_string(index + 1);
+  _random.seed(index);
+  _pos = SPAWN_POS;
+  _state = CONNECT;
+  return true;
+}
+
+void SoakClient::dispose() {
+  if (_network != nullptr) _network->dispose();
+  _network = nullptr;
+  _state = DONE;
+}
+
+void SoakClient::update(float timestep) {
+  if (_state == DONE) return;
+
+  _network->receive(
+      [this](const uint8_t* data, size_t size) { processData(data, size); });
+
+  switch (_network->getStatus()) {
+    case cugl::NetworkConnection::NetStatus::Pending:
+    case cugl::NetworkConnection::NetStatus::Reconnecting:
+      return;
+    case cugl::NetworkConnection::NetStatus::Connected:
+      break;
+    default:
+      CULogError("%s lost its connection", _name.c_str());
+      dispose();
+      return;
+  }
+
+  switch (_state) {
+    case CONNECT:
+      sendName();
+      _state = LOBBY;
+      break;
+    case GAME:
+      updateGame(timestep);
+      break;
+    default:
+      break;
+  }
+}
+
+void SoakClient::processData(const uint8_t* data, size_t size) {
+  _deserializer.receive(data, size);
+  Sint32 code = std::get<Sint32>(_deserializer.read());
+
+  switch (code) {
+    case HOST_SEND_ROLES: {
+      auto info =
+          std::get<std::shared_ptr<cugl::JsonValue>>(_deserializer.read());
+      auto betrayer_ids = info->get("betrayer_ids");
+      _betrayer = false;
+      for (int i = 0; i < info->getInt("num_betrayers"); i++) {
+        if (_network->getPlayerID() == betrayer_ids->get(i)->asInt()) {
+          _betrayer = true;
+        }
+      }
+    } break;
+    case HOST_START_GAME:
+      if (_state == LOBBY) _state = GAME;
+      break;
+    case NC_HOST_END_GAME:
+      if (_state == GAME) {
+        CULog("%s saw the match end", _name.c_str());
+        _state = DONE;
+      }
+      break;
+    default:
+      break;
+  }
+
+  _deserializer.reset();
+}
+
+void SoakClient::sendName() {
+  auto info = cugl::JsonValue::allocObject();
+
+  auto player_id = cugl::JsonValue::alloc((long)*_network->getPlayerID());
+  info->appendChild(player_id);
+  player_id->setKey("id");
+
+  auto name_info = cugl::JsonValue::alloc(_name);
+  info->appendChild(name_info);
+  name_info->setKey("name");
+
+  _serializer.writeSint32(CLIENT_SEND_PLAYER_NAME);
+  _serializer.writeJson(info);
+  _network->sendOnlyToHost(_serializer.serialize());
+  _serializer.reset();
+}
+
+void SoakClient::updateGame(float timestep) {
+  _turn_timer -= timestep;
+  if (_turn_timer <= 0) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    if (_pos.distance(SPAWN_POS) > WANDER_RADIUS) {
+      _dir = (SPAWN_POS - _pos).getNormalization();
+    } else if (unit(_random) < STOP_CHANCE) {
+      // Standing still checks that the host sees the player stop.
+      _dir = cugl::Vec2::ZERO;
+    } else {
+      _dir = cugl::Vec2::forAngle(unit(_random) * 2 * M_PI);
+    }
+    _turn_timer =
+        MIN_TURN_TIME + unit(_random) * (MAX_TURN_TIME - MIN_TURN_TIME);
+  }
+  _pos += _dir * PLAYER_SPEED * timestep;
+
+  int player_id = *_network->getPlayerID();
+  {
+    auto info = cugl::PlayerInfo::alloc();
+    info->player_id = player_id;
+    info->room_id = SPAWN_ROOM_ID;
+    info->pos = _pos;
+
+    _serializer.writeSint32(NC_CLIENT_ONE_PLAYER_INFO);
+    _serializer.writeSerializable(info);
+    _network->sendOnlyToHost(_serializer.serialize());
+    _serializer.reset();
+  }
+
+  // Send basic info only once.
+  if (!_basic_info_sent) {
+    _basic_info_sent = true;
+
+    auto info = cugl::BasicPlayerInfo::alloc();
+    info->player_id = player_id;
+    info->name = _name;
+    info->betrayer = _betrayer;
+
+    _serializer.writeSint32(NC_CLIENT_PLAYER_BASIC_INFO);
+    _serializer.writeSerializable(info);
+    _network->sendOnlyToHost(_serializer.serialize());
+    _serializer.reset();
+  }
+}
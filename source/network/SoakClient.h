@@ -0,0 +1,115 @@
+#ifndef NETWORK_SOAK_CLIENT_H_
+#define NETWORK_SOAK_CLIENT_H_
+
+#include <cugl/cugl.h>
+
+#include <random>
+
+#include "CustomNetworkSerializer.h"
+
+/**
+ * This class is a simulated client for soak testing a dedicated host.
+ *
+ * A soak client joins the host's room over a transport such as a
+ * cugl::LoopbackNetwork and speaks the same protocol as a real client, but
+ * without any scenes. It names itself in the lobby, learns its role from
+ * the host, and then wanders around the spawn room, sending its position to
+ * the host every tick and stopping now and then. It never simulates the
+ * level, so many of them can share a process with the host.
+ *
+ * Soak clients talk to their connection directly instead of through
+ * NetworkController, which belongs to the host's game.
+ */
+class SoakClient {
+ public:
+  /** The stage of the client's match. */
+  enum State {
+    /** Joining the host's room */
+    CONNECT,
+    /** Named and waiting for the game to start */
+    LOBBY,
+    /** Playing the game */
+    GAME,
+    /** Disconnected from the host */
+    DONE
+  };
+
+ private:
+  /** The connection to the host */
+  std::shared_ptr<cugl::NetworkConnection> _network;
+  /** The serializer for messages to the host */
+  cugl::CustomNetworkSerializer _serializer;
+  /** The deserializer for messages from the host */
+  cugl::CustomNetworkDeserializer _deserializer;
+
+  /** The stage of the client's match */
+  State _state;
+  /** The name of the client in the lobby */
+  std::string _name;
+  /** If the host made this client a betrayer */
+  bool _betrayer;
+  /** If the basic player info has been sent to the host */
+  bool _basic_info_sent;
+
+  /** The current position of this client */
+  cugl::Vec2 _pos;
+  /** The current direction of movement, or zero when standing still */
+  cugl::Vec2 _dir;
+  /** The time until the client picks a new direction, in seconds */
+  float _turn_timer;
+  /** The generator for the client's movement */
+  std::mt19937 _random;
+
+  /**
+   * Handles a message from the host.
+   *
+   * @param data The message.
+   * @param size The size of the message in bytes.
+   */
+  void processData(const uint8_t* data, size_t size);
+
+  /**
+   * Sends this client's name to the host's lobby.
+   */
+  void sendName();
+
+  /**
+   * Moves the client and sends its position to the host.
+   *
+   * @param timestep The amount of time (in seconds) since the last tick.
+   */
+  void updateGame(float timestep);
+
+ public:
+  SoakClient()
+      : _state(CONNECT),
+        _betrayer(false),
+        _basic_info_sent(false),
+        _turn_timer(0) {}
+
+  /**
+   * Joins the given room as a simulated client.
+   *
+   * @param config The connection configuration, with the transport to use.
+   * @param room_id The room of the host.
+   * @param index The index of the client, which names and seeds it.
+   * @return If the connection could be created.
+   */
+  bool init(const cugl::NetworkConnection::ConnectionConfig& config,
+            const std::string& room_id, int index);
+
+  /** Disconnects from the host. */
+  void dispose();
+
+  /**
+   * Services the connection and plays one tick.
+   *
+   * @param timestep The amount of time (in seconds) since the last tick.
+   */
+  void update(float timestep);
+
+  /** @return The stage of the client's match. */
+  State getState() const { return _state; }
+};
+
+#endif  // NETWORK_SOAK_CLIENT_H_
@@ -52,12 +52,14 @@ void EnemyHitInfo::serialize(cugl::NetworkSerializer* serializer) {
   serializer->writeUint32(enemy_id);
   serializer->writeUint32(player_id);
   serializer->writeUint32(amount);
+  serializer->writeUint32(seq);
 }
 
 void EnemyHitInfo::deserialize(cugl::NetworkDeserializer* deserializer) {
   enemy_id = std::get<Uint32>(deserializer->read());
   player_id = std::get<Uint32>(deserializer->read());
   amount = std::get<Uint32>(deserializer->read());
+  seq = std::get<Uint32>(deserializer->read());
 }
 
 }  // namespace cugl
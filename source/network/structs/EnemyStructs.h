@@ -139,6 +139,8 @@ struct EnemyHitInfo : public Serializable {
   int amount;
   /** The direction of the hit, for knockback. */
   int direction;
+  /** The input sequence number of the hit, or 0 if it is not predicted. */
+  Uint32 seq;
 
   /**
    * Alloc a new serializable object
@@ -70,4 +70,32 @@ void BasicPlayerInfo::deserialize(cugl::NetworkDeserializer* deserializer) {
   betrayer = std::get<bool>(deserializer->read());
 }
 
+#pragma mark -
+#pragma mark PlayerDeathInfo
+
+const Uint32 PlayerDeathInfo::Key = NC_CLIENT_DEATH_INFO;
+
+void PlayerDeathInfo::serialize(cugl::NetworkSerializer* serializer) {
+  serializer->writeUint32(player_id);
+  serializer->writeUint32(seq);
+}
+
+void PlayerDeathInfo::deserialize(cugl::NetworkDeserializer* deserializer) {
+  player_id = std::get<Uint32>(deserializer->read());
+  seq = std::get<Uint32>(deserializer->read());
+}
+
+#pragma mark -
+#pragma mark InputAckInfo
+
+const Uint32 InputAckInfo::Key = NC_HOST_INPUT_ACK;
+
+void InputAckInfo::serialize(cugl::NetworkSerializer* serializer) {
+  serializer->writeUint32(seq);
+}
+
+void InputAckInfo::deserialize(cugl::NetworkDeserializer* deserializer) {
+  seq = std::get<Uint32>(deserializer->read());
+}
+
 }  // namespace cugl
\ No newline at end of file
@@ -218,5 +218,85 @@ struct BasicPlayerInfo : public Serializable {
   virtual Uint32 key() override { return Key; }
 };
 
+#pragma mark -
+#pragma mark PlayerDeathInfo
+
+struct PlayerDeathInfo : public Serializable {
+  /** The unique key for the struct. Must be static. */
+  const static Uint32 Key;
+
+  /** The ID of the player that died. */
+  int player_id;
+  /** The input sequence number of the death. */
+  Uint32 seq;
+
+  /**
+   * Alloc a new serializable object
+   * @return The shared pointer with the new object.
+   */
+  static std::shared_ptr<PlayerDeathInfo> alloc() {
+    return std::make_shared<PlayerDeathInfo>();
+  }
+
+  /**
+   * This method serializes the class into the given serializer.
+   *
+   * @param serializer The network serializer.
+   */
+  void serialize(cugl::NetworkSerializer* serializer) override;
+
+  /**
+   * This method deserializes the given the deserializer.
+   *
+   * @param deserializer
+   */
+  void deserialize(cugl::NetworkDeserializer* deserializer) override;
+
+  /**
+   * This method returns a unique key to the struct.
+   * @return The unique key.
+   */
+  virtual Uint32 key() override { return Key; }
+};
+
+#pragma mark -
+#pragma mark InputAckInfo
+
+struct InputAckInfo : public Serializable {
+  /** The unique key for the struct. Must be static. */
+  const static Uint32 Key;
+
+  /** The last input sequence number the host processed from the client. */
+  Uint32 seq;
+
+  /**
+   * Alloc a new serializable object
+   * @return The shared pointer with the new object.
+   */
+  static std::shared_ptr<InputAckInfo> alloc() {
+    return std::make_shared<InputAckInfo>();
+  }
+
+  /**
+   * This method serializes the class into the given serializer.
+   *
+   * @param serializer The network serializer.
+   */
+  void serialize(cugl::NetworkSerializer* serializer) override;
+
+  /**
+   * This method deserializes the given the deserializer.
+   *
+   * @param deserializer
+   */
+  void deserialize(cugl::NetworkDeserializer* deserializer) override;
+
+  /**
+   * This method returns a unique key to the struct.
+   * @return The unique key.
+   */
+  virtual Uint32 key() override { return Key; }
+};
+
 }  // namespace cugl
 #endif  // NETWORK_STRUCTS_PLAYER_STRUCTS_H_
\ No newline at end of file
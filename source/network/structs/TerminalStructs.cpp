@@ -31,6 +31,7 @@ void TerminalUpdate::serialize(cugl::NetworkSerializer* serializer) {
   serializer->writeUint32(room_corrupted_energy);
   serializer->writeUint32(num_terminals_activated);
   serializer->writeUint32(num_terminals_corrupted);
+  serializer->writeUint32(ack);
 }
 
 void TerminalUpdate::deserialize(cugl::NetworkDeserializer* deserializer) {
@@ -42,6 +43,7 @@ void TerminalUpdate::deserialize(cugl::NetworkDeserializer* deserializer) {
   room_corrupted_energy = std::get<Uint32>(deserializer->read());
   num_terminals_activated = std::get<Uint32>(deserializer->read());
   num_terminals_corrupted = std::get<Uint32>(deserializer->read());
+  ack = std::get<Uint32>(deserializer->read());
 }
 
 }  // namespace cugl
\ No newline at end of file
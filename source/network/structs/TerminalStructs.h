@@ -72,6 +72,9 @@ struct TerminalUpdate : public Serializable {
   /** The amount of terminals corrupted. */
   int num_terminals_corrupted;
 
+  /** The last input sequence number the host processed from the player. */
+  Uint32 ack;
+
   /**
    * Alloc a new serializable object
    * @return The shared pointer with the new object.
@@ -229,6 +229,7 @@ void ClientLobbyScene::processData(const std::vector<uint8_t>& data) {
 
   if (code == 255) {
     _seed = std::get<Uint64>(_deserializer.read());
+    _layout_hash = std::get<Uint64>(_deserializer.read());
     _status = Status::START;
   }
 }
@@ -1,5 +1,8 @@
 #include "GameScene.h"
 
+#include <algorithm>
+#include <ctime>
+
 #include <box2d/b2_collision.h>
 #include <box2d/b2_contact.h>
 #include <box2d/b2_world.h>
@@ -13,6 +16,7 @@
 #include "../controllers/actions/OpenMap.h"
 #include "../controllers/actions/Settings.h"
 #include "../controllers/actions/TargetPlayer.h"
+#include "../controllers/actions/ToggleProfiler.h"
 #include "../loaders/CustomScene2Loader.h"
 #include "../models/RoomModel.h"
 #include "../models/tiles/TileHelper.h"
@@ -29,6 +33,12 @@
 #define ENERGY_BAR_UPDATE_SIZE 0.02f
 /** Set cloud wrap x position based on width and scale of cloud layer **/
 #define CLOUD_WRAP -960
+/** The most scopes listed in the profiler overlay. */
+#define PROFILER_OVERLAY_LINES 24
+/** The milliseconds between refreshes of the network overlay. */
+#define NETWORK_OVERLAY_INTERVAL 1000
+/** The bytes of player and enemy updates the host sends each client a tick. */
+#define HOST_SEND_BUDGET 1024
 
 bool GameScene::init(
     const std::shared_ptr<cugl::AssetManager>& assets,
@@ -42,6 +52,16 @@ bool GameScene::init(
   _display_name = display_name;
   _has_sent_player_basic_info = false;
   _dead_enemy_cache.clear();
+  _send_scheduler.reset();
+  _send_scheduler.setBudget(HOST_SEND_BUDGET);
+  // Movement is sent as often as it changes, while energy and health only
+  // need to be roughly right.
+  _send_scheduler.setWeight(NC_HOST_ALL_PLAYER_INFO, 1.0f);
+  _send_scheduler.setWeight(NC_HOST_ALL_ENEMY_INFO, 1.0f);
+  _send_scheduler.setWeight(NC_HOST_ALL_PLAYER_OTHER_INFO, 0.25f);
+  _send_scheduler.setWeight(NC_HOST_ALL_ENEMY_OTHER_INFO, 0.25f);
+  _input_predictor = std::make_shared<InputPredictor>();
+  _sent_input_acks.clear();
 
   // Initialize the scene to a locked width.
 
@@ -92,16 +112,29 @@ bool GameScene::init(
   _turtle_controller =
       TurtleController::alloc(_assets, _world, _world_node, _debug_node);
 
+  _animator = Animator::alloc(_assets->get<cugl::JsonValue>("animations"));
+  _grunt_controller->setAnimator(_animator);
+  _shotgunner_controller->setAnimator(_animator);
+  _tank_controller->setAnimator(_animator);
+  _turtle_controller->setAnimator(_animator);
+
   setBetrayer(is_betrayer);
 
   _terminal_controller = TerminalController::alloc(_assets);
 
   _player_controller = PlayerController::alloc(_assets, _world, _world_node,
                                                _debug_node, color_ids);
+  _player_controller->setAnimator(_animator);
   populate(dim);
 
   _world_node->doLayout();
 
+  _num_terminals_activated = 0;
+  _num_terminals_corrupted = 0;
+
+  // A dedicated host has nothing to present, so it stops at the simulation.
+  if (_headless) return true;
+
   auto terminal_deposit_layer =
       assets->get<cugl::scene2::SceneNode>("terminal-deposit-scene");
   terminal_deposit_layer->setContentSize(dim);
@@ -176,8 +209,6 @@ bool GameScene::init(
   win_layer->doLayout();
   win_layer->setVisible(false);
 
-  _num_terminals_activated = 0;
-  _num_terminals_corrupted = 0;
   auto corrupted_text =
       ui_layer->getChildByName<cugl::scene2::Label>("corrupted_num");
   std::string corrupted_msg =
@@ -213,6 +244,7 @@ bool GameScene::init(
 
   _sound_controller = SoundController::alloc(_assets);
   _player_controller->setSoundController(_sound_controller);
+  _player_controller->setInputPredictor(_input_predictor);
   _grunt_controller->setSoundController(_sound_controller);
   _shotgunner_controller->setSoundController(_sound_controller);
   _tank_controller->setSoundController(_sound_controller);
@@ -233,6 +265,26 @@ bool GameScene::init(
   cugl::Scene2::addChild(_settings_scene->getNode());
   _debug_node->setVisible(false);
 
+  _profiler_label = cugl::scene2::Label::allocWithTextBox(
+      cugl::Size(dim.width / 2, dim.height), "",
+      _assets->get<cugl::Font>("pixelmix_extra_small"));
+  _profiler_label->setForeground(cugl::Color4::WHITE);
+  _profiler_label->setBackground(cugl::Color4(0, 0, 0, 160));
+  _profiler_label->setAnchor(cugl::Vec2::ANCHOR_TOP_LEFT);
+  _profiler_label->setPosition(0, dim.height);
+  _profiler_label->setVisible(cugl::Profiler::isEnabled());
+  cugl::Scene2::addChild(_profiler_label);
+
+  _network_label = cugl::scene2::Label::allocWithTextBox(
+      cugl::Size(dim.width / 2, dim.height), "",
+      _assets->get<cugl::Font>("pixelmix_extra_small"));
+  _network_label->setForeground(cugl::Color4::WHITE);
+  _network_label->setBackground(cugl::Color4(0, 0, 0, 160));
+  _network_label->setAnchor(cugl::Vec2::ANCHOR_TOP_RIGHT);
+  _network_label->setPosition(dim.width, dim.height);
+  _network_label->setVisible(cugl::Profiler::isEnabled());
+  cugl::Scene2::addChild(_network_label);
+
   InputController::get()->init(_assets, cugl::Scene2::getBounds(), is_betrayer);
 
   InputController::get()->pause();
@@ -243,8 +295,8 @@ bool GameScene::init(
       ->setColorStart(cugl::Color4(148, 183, 212, 200))
       ->setColorEnd(cugl::Color4(148, 183, 212, 120))
       ->setAngularSpeed(0.5f)
-      ->setEasingFunctionPosX(cugl::EasingFunction::sineIn)
-      ->setEasingFunctionPosY(cugl::EasingFunction::sineOut)
+      ->setEasingFunctionPosX(cugl::EasingFunction::Type::SINE_IN)
+      ->setEasingFunctionPosY(cugl::EasingFunction::Type::SINE_OUT)
       ->setPathVariation(50.f)
       ->setSizeStart(5.0f)
       ->setSizeEnd(5.0f)
@@ -255,8 +307,8 @@ bool GameScene::init(
       ->setColorStart(cugl::Color4(148, 183, 212, 200))
       ->setColorEnd(cugl::Color4(148, 183, 212, 120))
       ->setAngularSpeed(0.5f)
-      ->setEasingFunctionPosX(cugl::EasingFunction::sineOut)
-      ->setEasingFunctionPosY(cugl::EasingFunction::sineIn)
+      ->setEasingFunctionPosX(cugl::EasingFunction::Type::SINE_OUT)
+      ->setEasingFunctionPosY(cugl::EasingFunction::Type::SINE_IN)
       ->setPathVariation(50.f)
       ->setSizeStart(5.0f)
       ->setSizeEnd(5.0f)
@@ -271,8 +323,8 @@ bool GameScene::init(
       ->setColorStart(cugl::Color4(223, 113, 38, 200))
       ->setColorEnd(cugl::Color4(223, 113, 38, 120))
       ->setAngularSpeed(0.5f)
-      ->setEasingFunctionPosX(cugl::EasingFunction::sineOut)
-      ->setEasingFunctionPosY(cugl::EasingFunction::sineIn)
+      ->setEasingFunctionPosX(cugl::EasingFunction::Type::SINE_OUT)
+      ->setEasingFunctionPosY(cugl::EasingFunction::Type::SINE_IN)
       ->setPathVariation(50.f)
       ->setSizeStart(5.0f)
       ->setSizeEnd(5.0f)
@@ -285,22 +337,30 @@ void GameScene::dispose() {
   if (!_active) return;
   _state = NONE;
 
-  InputController::get()->dispose();
   _active = false;
 
   _has_sent_player_basic_info = false;
-  _sound_controller->stop();
   _dead_enemy_cache.clear();
+  _send_scheduler.reset();
+  _input_predictor = nullptr;
+  _sent_input_acks.clear();
   _world_node->removeAllChildren();
   _debug_node->removeAllChildren();
-  _role_layer->setVisible(true);
-  _role_layer->deactivate();
-  _role_layer->setDown(false);
-  _settings_scene->dispose();
+  if (!_headless) {
+    InputController::get()->dispose();
+    _sound_controller->stop();
+    _role_layer->setVisible(true);
+    _role_layer->deactivate();
+    _role_layer->setDown(false);
+    _settings_scene->dispose();
+  }
   removeAllChildren();
 
   _world_node = nullptr;
   _debug_node = nullptr;
+  _profiler_label = nullptr;
+  _network_label = nullptr;
+  _network_prev_stats.clear();
   _role_layer = nullptr;
   _cloud_layer = nullptr;
 
@@ -315,6 +375,7 @@ void GameScene::dispose() {
   _tank_controller = nullptr;
   _turtle_controller = nullptr;
   _level_controller = nullptr;
+  _animator = nullptr;
 }
 
 void GameScene::populate(cugl::Size dim) {
@@ -323,6 +384,7 @@ void GameScene::populate(cugl::Size dim) {
     _player_controller->setMyPlayer(player);
     player->setDisplayName(_display_name);
     player->setBetrayer(_is_betrayer);
+    if (_headless && _ishost) _player_controller->makeSpectator();
   }
 
   _terminal_controller->setPlayerController(_player_controller);
@@ -368,26 +430,14 @@ bool GameScene::checkBetrayerWin() {
 }
 
 void GameScene::update(float timestep) {
+  CU_PROFILE_SCOPE("GameScene::update");
   if (NetworkController::get()->isConnectionSet()) {
+    CU_PROFILE_SCOPE("GameScene::network");
     sendNetworkInfo();
     // Receives information and calls listeners (eg. processData).
     NetworkController::get()->update();
   }
 
-  _health_bar->setProgress(_player_controller->getMyPlayer()->getHealth() /
-                           50.0f);
-
-  // Animate energy update.
-  float target_energy_amt =
-      _player_controller->getMyPlayer()->getEnergy() / 100.0f;
-  if (_energy_bar->getProgress() < target_energy_amt) {
-    float diff = _energy_bar->getProgress() + ENERGY_BAR_UPDATE_SIZE;
-    _energy_bar->setProgress(std::min(diff, target_energy_amt));
-  } else if (_energy_bar->getProgress() > target_energy_amt) {
-    float diff = _energy_bar->getProgress() - ENERGY_BAR_UPDATE_SIZE;
-    _energy_bar->setProgress(std::max(diff, target_energy_amt));
-  }
-
   if (_player_controller->getMyPlayer()->getRespawning()) {
     _player_controller->getMyPlayer()->setRespawning(false);
     // TODO: Change this to new terminal system. #233
@@ -397,19 +447,150 @@ void GameScene::update(float timestep) {
 
   if (checkCooperatorWin() || checkBetrayerWin()) _state = DONE;
 
-  cugl::Application::get()->setClearColor(cugl::Color4f::BLACK);
-
-  InputController::get()->update();
+  if (!_headless) updateInput();
 
-  _player_controller->update(timestep);
+  {
+    CU_PROFILE_SCOPE("GameScene::players");
+    _player_controller->update(timestep);
+  }
   _terminal_controller->update(timestep);
-  _level_controller->update(timestep);
-  _sound_controller->update(timestep);
-  _particle_controller->update(timestep);
+  if (!_headless) {
+    _level_controller->update(timestep);
+    _sound_controller->update(timestep);
+    CU_PROFILE_SCOPE("GameScene::particles");
+    _particle_controller->update(timestep);
+  }
+  {
+    CU_PROFILE_SCOPE("GameScene::animator");
+    _animator->update(timestep);
+  }
 
   _num_terminals_activated = _terminal_controller->getNumTerminalsActivated();
   _num_terminals_corrupted = _terminal_controller->getNumTerminalsCorrupted();
 
+  if (!_headless) updateAbilities();
+
+  std::shared_ptr<RoomModel> current_room =
+      _level_controller->getLevelModel()->getCurrentRoom();
+  _player_controller->getMyPlayer()->setRoomId(current_room->getKey());
+
+  std::unordered_set<int> enemy_update_rooms = getRoomIdsWithPlayers();
+  for (auto room_id_to_update : enemy_update_rooms) {
+    auto room_to_update =
+        _level_controller->getLevelModel()->getRoom(room_id_to_update);
+    updateEnemies(timestep, room_to_update);
+  }
+
+  // Also update the adjacent room enemies if is host.
+  // Must check here or weird interactions occur with clients updating
+  // adjacent rooms.
+  if (_ishost) {
+    std::unordered_set<int> adj_enemy_update_rooms =
+        getAdjacentRoomIdsWithoutPlayers();
+    for (auto room_id_to_update : adj_enemy_update_rooms) {
+      auto room_to_update =
+          _level_controller->getLevelModel()->getRoom(room_id_to_update);
+      updateEnemies(timestep, room_to_update);
+    }
+  }
+
+  if (!_headless) {
+    // update cloud background layer
+    _cloud_layer->setPositionX(_cloud_layer->getPositionX() + .3);
+    if (_cloud_layer->getPositionX() >= 0) {
+      _cloud_layer->setPositionX(CLOUD_WRAP);
+    }
+
+    updateCamera(timestep);
+  }
+
+  {
+    CU_PROFILE_SCOPE("GameScene::physics");
+    _world->update(timestep);
+  }
+
+  // ===== POST-UPDATE =======
+  {
+    CU_PROFILE_SCOPE("GameScene::postUpdate");
+    if (!_headless) updateHUD();
+
+    // Check for disposal
+
+    //  auto room_ids_with_players = getRoomIdsWithPlayers();
+    auto room_id_player_count_map = getRoomPlayerCounts();
+    for (auto it : room_id_player_count_map) {
+      auto room_id = it.first;
+      auto room = _level_controller->getLevelModel()->getRoom(room_id);
+      std::vector<std::shared_ptr<EnemyModel>>& enemies = room->getEnemies();
+
+      for (auto it = enemies.begin(); it != enemies.end(); it++) {
+        auto enemy = *it;
+
+        if (enemy->isReadyToDie()) {
+          // Send particles if there's things to send.
+          if (!_headless &&
+              _player_controller->getMyPlayer()->getEnergy() < 100) {
+            cugl::Vec2 end_pos = _energy_bar->getWorldPosition();
+            end_pos.x += _energy_bar->getContentWidth() *
+                         _energy_bar->getProgress() * 1.2f;
+            _energy_particle.setPosStart(enemy->getNode()->getWorldPosition())
+                ->setPosEnd(end_pos);
+            _particle_controller->emit(_energy_particle, 5, 0.03f);
+          }
+
+          // Update player eneregies.
+          if (NetworkController::get()->isHost()) {
+            for (auto jt : _player_controller->getPlayers()) {
+              std::shared_ptr<Player> player = jt.second;
+              if (player->getRoomId() != room_id) continue;
+              if (player->isBetrayer()) {
+                // Give betrayer less energy than regular players.
+                player->setEnergy(player->getEnergy() + 3);
+              } else {
+                // Give all players in the same room some energy if an enemy
+                // dies.
+                player->setEnergy(player->getEnergy() + 7);
+              }
+            }
+          }
+
+          if (NetworkController::get()->isHost()) {
+            _dead_enemy_cache.push_back(enemy->getEnemyId());
+          }
+          enemy->deleteAllProjectiles(_world, _world_node);
+          enemy->deactivatePhysics(*_world->getWorld());
+          _animator->removeTrack(enemy->_death_track);
+          room->getNode()->removeChild(enemy->getNode());
+          _world->removeObstacle(enemy.get());
+          enemies.erase(it--);
+        } else {
+          enemy->deleteProjectile(_world, _world_node);
+        }
+      }
+    }
+
+    _player_controller->getMyPlayer()->checkDeleteSlashes(_world, _world_node);
+  }
+}
+
+void GameScene::updateInput() {
+  cugl::Application::get()->setClearColor(cugl::Color4f::BLACK);
+
+  {
+    CU_PROFILE_SCOPE("GameScene::input");
+    InputController::get()->update();
+  }
+
+  // Only attached in builds that allow toggling the profiler.
+  auto toggle_profiler = InputController::get<ToggleProfiler>();
+  if (toggle_profiler != nullptr && toggle_profiler->didToggleProfiler()) {
+    setProfiling(!cugl::Profiler::isEnabled());
+  }
+  if (_profiler_label->isVisible()) updateProfilerOverlay();
+  if (_network_label->isVisible()) updateNetworkOverlay();
+}
+
+void GameScene::updateAbilities() {
   if (InputController::get<OpenMap>()->didOpenMap()) {
     _map->setVisible(!_map->isVisible());
   }
@@ -547,42 +728,23 @@ void GameScene::update(float timestep) {
       }
     }
   }
+}
 
-  std::shared_ptr<RoomModel> current_room =
-      _level_controller->getLevelModel()->getCurrentRoom();
-  _player_controller->getMyPlayer()->setRoomId(current_room->getKey());
-
-  std::unordered_set<int> enemy_update_rooms = getRoomIdsWithPlayers();
-  for (auto room_id_to_update : enemy_update_rooms) {
-    auto room_to_update =
-        _level_controller->getLevelModel()->getRoom(room_id_to_update);
-    updateEnemies(timestep, room_to_update);
-  }
-
-  // Also update the adjacent room enemies if is host.
-  // Must check here or weird interactions occur with clients updating
-  // adjacent rooms.
-  if (_ishost) {
-    std::unordered_set<int> adj_enemy_update_rooms =
-        getAdjacentRoomIdsWithoutPlayers();
-    for (auto room_id_to_update : adj_enemy_update_rooms) {
-      auto room_to_update =
-          _level_controller->getLevelModel()->getRoom(room_id_to_update);
-      updateEnemies(timestep, room_to_update);
-    }
-  }
+void GameScene::updateHUD() {
+  _health_bar->setProgress(_player_controller->getMyPlayer()->getHealth() /
+                           50.0f);
 
-  // update cloud background layer
-  _cloud_layer->setPositionX(_cloud_layer->getPositionX() + .3);
-  if (_cloud_layer->getPositionX() >= 0) {
-    _cloud_layer->setPositionX(CLOUD_WRAP);
+  // Animate energy update.
+  float target_energy_amt =
+      _player_controller->getMyPlayer()->getEnergy() / 100.0f;
+  if (_energy_bar->getProgress() < target_energy_amt) {
+    float diff = _energy_bar->getProgress() + ENERGY_BAR_UPDATE_SIZE;
+    _energy_bar->setProgress(std::min(diff, target_energy_amt));
+  } else if (_energy_bar->getProgress() > target_energy_amt) {
+    float diff = _energy_bar->getProgress() - ENERGY_BAR_UPDATE_SIZE;
+    _energy_bar->setProgress(std::max(diff, target_energy_amt));
   }
 
-  updateCamera(timestep);
-
-  _world->update(timestep);
-
-  // ===== POST-UPDATE =======
   auto ui_layer = _assets->get<cugl::scene2::SceneNode>("ui-scene");
 
   auto name_text = ui_layer->getChildByName<cugl::scene2::Label>("name");
@@ -629,64 +791,10 @@ void GameScene::update(float timestep) {
     role_msg = "(RUNNER)";
     role_text->setForeground(cugl::Color4::BLACK);
   }
-
-  // POST-UPDATE
-  // Check for disposal
-
-  //  auto room_ids_with_players = getRoomIdsWithPlayers();
-  auto room_id_player_count_map = getRoomPlayerCounts();
-  for (auto it : room_id_player_count_map) {
-    auto room_id = it.first;
-    auto room = _level_controller->getLevelModel()->getRoom(room_id);
-    std::vector<std::shared_ptr<EnemyModel>>& enemies = room->getEnemies();
-
-    for (auto it = enemies.begin(); it != enemies.end(); it++) {
-      auto enemy = *it;
-
-      if (enemy->isReadyToDie()) {
-        // Send particles if there's things to send.
-        if (_player_controller->getMyPlayer()->getEnergy() < 100) {
-          cugl::Vec2 end_pos = _energy_bar->getWorldPosition();
-          end_pos.x += _energy_bar->getContentWidth() *
-                       _energy_bar->getProgress() * 1.2f;
-          _energy_particle.setPosStart(enemy->getNode()->getWorldPosition())
-              ->setPosEnd(end_pos);
-          _particle_controller->emit(_energy_particle, 5, 0.03f);
-        }
-
-        // Update player eneregies.
-        if (NetworkController::get()->isHost()) {
-          for (auto jt : _player_controller->getPlayers()) {
-            std::shared_ptr<Player> player = jt.second;
-            if (player->getRoomId() != room_id) continue;
-            if (player->isBetrayer()) {
-              // Give betrayer less energy than regular players.
-              player->setEnergy(player->getEnergy() + 3);
-            } else {
-              // Give all players in the same room some energy if an enemy dies.
-              player->setEnergy(player->getEnergy() + 7);
-            }
-          }
-        }
-
-        if (NetworkController::get()->isHost()) {
-          _dead_enemy_cache.push_back(enemy->getEnemyId());
-        }
-        enemy->deleteAllProjectiles(_world, _world_node);
-        enemy->deactivatePhysics(*_world->getWorld());
-        room->getNode()->removeChild(enemy->getNode());
-        _world->removeObstacle(enemy.get());
-        enemies.erase(it--);
-      } else {
-        enemy->deleteProjectile(_world, _world_node);
-      }
-    }
-  }
-
-  _player_controller->getMyPlayer()->checkDeleteSlashes(_world, _world_node);
 }
 
 void GameScene::updateEnemies(float timestep, std::shared_ptr<RoomModel> room) {
+  CU_PROFILE_SCOPE("GameScene::enemies");
   int room_id = room->getKey();
   // Update the enemy controllers
   for (std::shared_ptr<EnemyModel>& enemy : room->getEnemies()) {
@@ -736,29 +844,39 @@ void GameScene::sendNetworkInfo() {
 void GameScene::sendNetworkInfoHost() {
   if (!NetworkController::get()->isHost()) return;
 
-  {
-    std::vector<std::shared_ptr<cugl::Serializable>> all_player_info;
-    for (auto it : _player_controller->getPlayers()) {
-      std::shared_ptr<Player> player = it.second;
-
-      auto info = cugl::PlayerInfo::alloc();
-
-      info->player_id = player->getPlayerId();
-      info->room_id = player->getRoomId();
-      info->pos = player->getPosition();
+  _send_scheduler.clear();
 
-      all_player_info.push_back(info);
-    }
+  for (auto it : _player_controller->getPlayers()) {
+    std::shared_ptr<Player> player = it.second;
 
-    NetworkController::get()->send(NC_HOST_ALL_PLAYER_INFO, all_player_info);
+    auto info = cugl::PlayerInfo::alloc();
+    info->player_id = player->getPlayerId();
+    info->room_id = player->getRoomId();
+    info->pos = player->getPosition();
+    // A client already knows where it is.
+    _send_scheduler.add({NC_HOST_ALL_PLAYER_INFO, player->getPlayerId(), -1,
+                         info->pos, info->pos, false, player->getPlayerId(),
+                         info});
+
+    auto other_info = cugl::PlayerOtherInfo::alloc();
+    other_info->player_id = player->getPlayerId();
+    other_info->energy = player->getEnergy();
+    other_info->corruption = player->getCorruptedEnergy();
+    _send_scheduler.add(
+        {NC_HOST_ALL_PLAYER_OTHER_INFO, player->getPlayerId(), -1, info->pos,
+         cugl::Vec2(other_info->energy, other_info->corruption), false, -1,
+         other_info});
   }
 
   {
     std::vector<std::shared_ptr<cugl::Serializable>> player_basic_info;
 
-    bool all_players_present =
-        _player_controller->getPlayers().size() ==
+    // A dedicated host is connected but is not one of the players.
+    size_t num_players =
         NetworkController::get()->getConnection()->getNumPlayers();
+    if (_player_controller->isSpectator()) num_players--;
+    bool all_players_present =
+        _player_controller->getPlayers().size() == num_players;
 
     bool all_player_info = all_players_present;
     for (auto it : _player_controller->getPlayers()) {
@@ -784,89 +902,68 @@ void GameScene::sendNetworkInfoHost() {
     }
   }
 
-  {
-    //    cugl::Timestamp time;
-    //    Uint64 millis =
-    //    time.ellapsedMillis(_time_of_last_player_other_info_update);
-    //
-    //    if (millis > 5000) {
-    //      _time_of_last_player_other_info_update.mark();
-    std::vector<std::shared_ptr<cugl::Serializable>> all_player_info;
-    for (auto it : _player_controller->getPlayers()) {
-      std::shared_ptr<Player> player = it.second;
-
-      auto info = cugl::PlayerOtherInfo::alloc();
-
-      info->player_id = player->getPlayerId();
-      info->energy = player->getEnergy();
-      info->corruption = player->getCorruptedEnergy();
-
-      all_player_info.push_back(info);
-    }
-
-    NetworkController::get()->send(NC_HOST_ALL_PLAYER_OTHER_INFO,
-                                   all_player_info);
-    //    }
-  }
-
-  auto room_ids_with_players = getRoomIdsWithPlayers();
-  for (auto room_id : room_ids_with_players) {
-    // get enemy info for the rooms that players are in
+  // The host only simulates enemies in rooms next to a player.
+  for (auto room_id : getAdjacentRoomIdsWithPlayers()) {
     auto room = _level_controller->getLevelModel()->getRoom(room_id);
-    {
-      std::vector<std::shared_ptr<cugl::Serializable>> enemy_info;
-      for (std::shared_ptr<EnemyModel> enemy : room->getEnemies()) {
-        auto info = cugl::EnemyInfo::alloc();
-
-        info->enemy_id = enemy->getEnemyId();
-        info->pos = enemy->getPosition();
-        info->has_target = enemy->didAttack();
-        info->target = enemy->getAttackDir();
-        if (info->has_target) {
-          // Make sure bullet & attack is only sent once
-          enemy->clearAttackState();
-        }
-        // Serialize one enemy at a time to avoid reaching packet limit
-        enemy_info.push_back(info);
-      }
-      if (enemy_info.size() > 0) {
-        NetworkController::get()->send(NC_HOST_ALL_ENEMY_INFO, enemy_info);
+    for (std::shared_ptr<EnemyModel> enemy : room->getEnemies()) {
+      auto info = cugl::EnemyInfo::alloc();
+
+      info->enemy_id = enemy->getEnemyId();
+      info->pos = enemy->getPosition();
+      info->has_target = enemy->didAttack();
+      info->target = enemy->getAttackDir();
+      if (info->has_target) {
+        // Make sure bullet & attack is only sent once
+        enemy->clearAttackState();
       }
+      // Attacks must reach every client near the room on this tick.
+      _send_scheduler.add({NC_HOST_ALL_ENEMY_INFO, enemy->getEnemyId(),
+                           room_id, info->pos, info->pos, info->has_target,
+                           -1, info});
+
+      // Health is sent everywhere, so that it is roughly right by the time a
+      // client walks over, but distant rooms have low priority.
+      auto other_info = cugl::EnemyOtherInfo::alloc();
+      other_info->enemy_id = enemy->getEnemyId();
+      other_info->health = enemy->getHealth();
+      _send_scheduler.add({NC_HOST_ALL_ENEMY_OTHER_INFO, enemy->getEnemyId(),
+                           -1, info->pos, cugl::Vec2(other_info->health, 0),
+                           false, -1, other_info});
     }
+  }
 
-    {
-      cugl::Timestamp time;
-      Uint64 millis =
-          time.ellapsedMillis(_time_of_last_enemy_other_info_update);
-
-      if (millis > 200) {
-        _time_of_last_enemy_other_info_update.mark();
-
-        std::vector<std::shared_ptr<cugl::Serializable>> enemy_info;
-
-        for (std::shared_ptr<EnemyModel> enemy : room->getEnemies()) {
-          auto info = cugl::EnemyOtherInfo::alloc();
-
-          info->enemy_id = enemy->getEnemyId();
-          info->health = enemy->getHealth();
-
-          enemy_info.push_back(info);
-        }
-
-        // Go through all the enemies that have died between these other info
-        // update calls (200ms), and then clear the cache.
-        for (int enemy_id : _dead_enemy_cache) {
-          auto info = cugl::EnemyOtherInfo::alloc();
-          info->enemy_id = enemy_id;
-          info->health = -1;
+  // Every client hears about every death.
+  for (int enemy_id : _dead_enemy_cache) {
+    auto info = cugl::EnemyOtherInfo::alloc();
+    info->enemy_id = enemy_id;
+    info->health = -1;
+    _send_scheduler.add({NC_HOST_ALL_ENEMY_OTHER_INFO, enemy_id, -1,
+                         cugl::Vec2::ZERO, cugl::Vec2(-1, 0), true, -1, info});
+  }
+  _dead_enemy_cache.clear();
 
-          enemy_info.push_back(info);
-        }
-        _dead_enemy_cache.clear();
+  // Each client gets the most important updates that fit in its budget.
+  for (std::shared_ptr<Player> player : _player_controller->getPlayerList()) {
+    if (player == _player_controller->getMyPlayer()) continue;
+
+    // The acknowledgement goes first, so the client reconciles the updates
+    // after it against the inputs the host had processed.
+    Uint32 ack = NetworkController::get()->getInputAck(player->getPlayerId());
+    if (ack != _sent_input_acks[player->getPlayerId()]) {
+      auto info = cugl::InputAckInfo::alloc();
+      info->seq = ack;
+      std::vector<std::shared_ptr<cugl::Serializable>> acks{info};
+      NetworkController::get()->sendToPlayer(player->getPlayerId(),
+                                             NC_HOST_INPUT_ACK, acks);
+      _sent_input_acks[player->getPlayerId()] = ack;
+    }
 
-        NetworkController::get()->send(NC_HOST_ALL_ENEMY_OTHER_INFO,
-                                       enemy_info);
-      }
+    SendScheduler::Batch batch = _send_scheduler.schedule(
+        player->getPlayerId(), player->getPosition(),
+        getRelevantRoomIds(player->getRoomId()));
+    for (auto& it : batch) {
+      NetworkController::get()->sendToPlayer(player->getPlayerId(), it.first,
+                                             it.second);
     }
   }
 }
@@ -904,9 +1001,11 @@ void GameScene::sendNetworkInfoClient() {
   
   if (_player_controller->getMyPlayer()->getHealth() <= 0
       && !_player_controller->getMyPlayer()->getDead()) {
-    auto info = cugl::PlayerIdInfo::alloc();
+    auto info = cugl::PlayerDeathInfo::alloc();
 
     info->player_id = _player_controller->getMyPlayer()->getPlayerId();
+    // The player controller halves the energy right away.
+    info->seq = _input_predictor->predictDeath();
 
     // Send individual player information.
     NetworkController::get()->sendOnlyToHost(NC_CLIENT_DEATH_INFO, info);
@@ -919,6 +1018,16 @@ void GameScene::sendEnemyHitNetworkInfo(int player_id, int enemy_id,
   info->enemy_id = enemy_id;
   info->player_id = player_id;
   info->amount = amount;
+  info->seq = 0;
+
+  // The host applies its own hits when it processes them.
+  if (!NetworkController::get()->isHost()) {
+    info->seq = _input_predictor->predictHit(enemy_id, amount);
+    auto enemy = _level_controller->getEnemy(enemy_id);
+    if (enemy != nullptr) {
+      enemy->setHealth(InputPredictor::applyHit(enemy->getHealth(), amount));
+    }
+  }
 
   NetworkController::get()->sendOnlyToHostOrProcess(NC_CLIENT_ENEMY_HIT_INFO,
                                                     info);
@@ -1012,6 +1121,8 @@ void GameScene::processData(
       auto info = std::dynamic_pointer_cast<cugl::PlayerIdInfo>(
           std::get<std::shared_ptr<cugl::Serializable>>(msg));
       _player_controller->removePlayer(info->player_id);
+      _send_scheduler.removeClient(info->player_id);
+      _sent_input_acks.erase(info->player_id);
     } break;
 
     case NC_HOST_ALL_ENEMY_INFO: {
@@ -1041,7 +1152,8 @@ void GameScene::processData(
         std::shared_ptr<EnemyModel> enemy =
             _level_controller->getEnemy(info->enemy_id);
         if (enemy != nullptr) {
-          enemy->setHealth(info->health);
+          enemy->setHealth(
+              _input_predictor->reconcileHealth(info->enemy_id, info->health));
         }
       }
     } break;
@@ -1049,6 +1161,7 @@ void GameScene::processData(
     case NC_CLIENT_ENEMY_HIT_INFO: {
       auto info = std::dynamic_pointer_cast<cugl::EnemyHitInfo>(
           std::get<std::shared_ptr<cugl::Serializable>>(msg));
+      NetworkController::get()->ackInput(info->player_id, info->seq);
 
       auto enemy = _level_controller->getEnemy(info->enemy_id);
 
@@ -1059,12 +1172,22 @@ void GameScene::processData(
     } break;
       
     case NC_CLIENT_DEATH_INFO: {
-      auto info = std::dynamic_pointer_cast<cugl::PlayerIdInfo>(
+      auto info = std::dynamic_pointer_cast<cugl::PlayerDeathInfo>(
           std::get<std::shared_ptr<cugl::Serializable>>(msg));
+      NetworkController::get()->ackInput(info->player_id, info->seq);
       auto player = _player_controller->getPlayer(info->player_id);
       player->setEnergy(player->getEnergy() * 0.5f);
     } break;
 
+    case NC_HOST_INPUT_ACK: {
+      auto all_info =
+          std::get<std::vector<std::shared_ptr<cugl::Serializable>>>(msg);
+      for (std::shared_ptr<cugl::Serializable>& info_ : all_info) {
+        auto info = std::dynamic_pointer_cast<cugl::InputAckInfo>(info_);
+        _input_predictor->acknowledge(info->seq);
+      }
+    } break;
+
     case NC_BETRAYAL_TARGET_INFO: {
       if (NetworkController::get()->isHost()) {
         auto target_data = std::get<std::shared_ptr<cugl::JsonValue>>(msg);
@@ -1103,10 +1226,24 @@ void GameScene::setConnection(
     const std::shared_ptr<cugl::NetworkConnection>& network) {
   NetworkController::get()->init(network);
   NetworkController::get()->addListener(
+      {NC_HOST_END_GAME, NC_CLIENT_END_GAME, NC_HOST_REMOVE_PLAYER,
+       NC_HOST_ALL_ENEMY_INFO, NC_HOST_ALL_ENEMY_OTHER_INFO,
+       NC_CLIENT_ENEMY_HIT_INFO, NC_CLIENT_DEATH_INFO, NC_BETRAYAL_TARGET_INFO,
+       NC_SEND_DISABLE_PLAYER_INFO, NC_SEND_BETRAYAL_CORRUPT_INFO,
+       NC_HOST_INPUT_ACK},
       [=](const Sint32& code,
           const cugl::CustomNetworkDeserializer::CustomMessage& msg) {
         this->processData(code, msg);
       });
+
+  // Clients only send the host messages with send when every other client
+  // has to act on them. Anything else the host needs is sent to it directly,
+  // and its effects reach the other clients through the host's own updates.
+  NetworkController::get()->setDefaultRelayAction(
+      cugl::NetworkConnection::RelayAction::Consume);
+  NetworkController::get()->setRelayAction(
+      NC_SEND_DISABLE_PLAYER_INFO,
+      cugl::NetworkConnection::RelayAction::Forward);
   NetworkController::get()->setDisconnectListener([=]() { _state = LEAVE; });
 }
 
@@ -1141,8 +1278,7 @@ void GameScene::beginContact(b2Contact* contact) {
     float damage = 20;
     EnemyModel::EnemyType type = dynamic_cast<EnemyModel*>(ob1)->getType();
     if (type == EnemyModel::EnemyType::TURTLE) damage = 3;
-    // Show hit on client-side without potentially causing de-sync with host
-    // (0 dmg)
+    // Flash the hit right away, the damage is predicted when it is sent.
     _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob1)->getEnemyId())
         ->takeDamage(0);
 
@@ -1154,8 +1290,7 @@ void GameScene::beginContact(b2Contact* contact) {
     float damage = 20;
     EnemyModel::EnemyType type = dynamic_cast<EnemyModel*>(ob2)->getType();
     if (type == EnemyModel::EnemyType::TURTLE) damage = 3;
-    // Show hit on client-side without potentially causing de-sync with host
-    // (0 dmg)
+    // Flash the hit right away, the damage is predicted when it is sent.
     _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob2)->getEnemyId())
         ->takeDamage(0);
 
@@ -1168,8 +1303,7 @@ void GameScene::beginContact(b2Contact* contact) {
       ob2 == _player_controller->getMyPlayer().get()) {
     Player::State player_state = _player_controller->getMyPlayer()->getState();
     if (player_state == Player::State::DASHING) {
-      // Show hit on client-side without potentially causing de-sync with host
-      // (0 dmg)
+      // Flash the hit right away, the damage is predicted when it is sent.
       _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob1)->getEnemyId())
           ->takeDamage(0);
       sendEnemyHitNetworkInfo(_player_controller->getMyPlayer()->getPlayerId(),
@@ -1180,8 +1314,7 @@ void GameScene::beginContact(b2Contact* contact) {
              ob1 == _player_controller->getMyPlayer().get()) {
     Player::State player_state = _player_controller->getMyPlayer()->getState();
     if (player_state == Player::State::DASHING) {
-      // Show hit on client-side without potentially causing de-sync with host
-      // (0 dmg)
+      // Flash the hit right away, the damage is predicted when it is sent.
       _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob2)->getEnemyId())
           ->takeDamage(0);
       sendEnemyHitNetworkInfo(_player_controller->getMyPlayer()->getPlayerId(),
@@ -1219,15 +1352,13 @@ void GameScene::beginContact(b2Contact* contact) {
   }
 
   if (fx1_name == "enemy_hitbox" && ob2->getName() == "slash") {
-    // Show hit on client-side without potentially causing de-sync with host
-    // (0 dmg)
+    // Flash the hit right away, the damage is predicted when it is sent.
     _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob1)->getEnemyId())
         ->takeDamage(0);
     sendEnemyHitNetworkInfo(_player_controller->getMyPlayer()->getPlayerId(),
                             dynamic_cast<EnemyModel*>(ob1)->getEnemyId(), 30);
   } else if (fx2_name == "enemy_hitbox" && ob1->getName() == "slash") {
-    // Show hit on client-side without potentially causing de-sync with host
-    // (0 dmg)
+    // Flash the hit right away, the damage is predicted when it is sent.
     _level_controller->getEnemy(dynamic_cast<EnemyModel*>(ob2)->getEnemyId())
         ->takeDamage(0);
     sendEnemyHitNetworkInfo(_player_controller->getMyPlayer()->getPlayerId(),
@@ -1334,6 +1465,103 @@ void GameScene::render(const std::shared_ptr<cugl::SpriteBatch>& batch) {
   Scene2::render(batch);
 }
 
+void GameScene::setProfiling(bool value) {
+  if (value == cugl::Profiler::isEnabled()) return;
+
+  if (value) {
+    cugl::Profiler::clear();
+    cugl::Profiler::setEnabled(true);
+  } else {
+    cugl::Profiler::setEnabled(false);
+    // Relative paths are written to the save directory.
+    std::string path =
+        "trace-" + std::to_string(std::time(nullptr)) + ".json";
+    if (cugl::Profiler::writeChromeTrace(path)) {
+      CULog("Wrote profiler trace %s", path.c_str());
+    }
+  }
+  _profiler_label->setVisible(value);
+
+  // The network overlay shows with the profiler, starting a fresh window.
+  _network_label->setVisible(value);
+  _network_label->setText("");
+  _network_prev_stats = NetworkController::get()->getStats();
+  _network_prev_time.mark();
+}
+
+void GameScene::updateProfilerOverlay() {
+  char line[96];
+  snprintf(line, sizeof(line), "frame %.2f ms\n",
+           cugl::Profiler::getFrameTime() / 1.0e6);
+  std::string text = line;
+
+  int count = 0;
+  for (const cugl::Profiler::Stat& stat : cugl::Profiler::getFrameStats()) {
+    if (count++ == PROFILER_OVERLAY_LINES) break;
+    std::string indent(2 * stat.depth, ' ');
+    if (stat.calls > 1) {
+      snprintf(line, sizeof(line), "%s%s %.2f ms x%u\n", indent.c_str(),
+               stat.name, stat.total / 1.0e6, stat.calls);
+    } else {
+      snprintf(line, sizeof(line), "%s%s %.2f ms\n", indent.c_str(),
+               stat.name, stat.total / 1.0e6);
+    }
+    text += line;
+  }
+  _profiler_label->setText(text);
+}
+
+void GameScene::updateNetworkOverlay() {
+  cugl::Timestamp now;
+  Uint64 millis = now.ellapsedMillis(_network_prev_time);
+  if (millis < NETWORK_OVERLAY_INTERVAL) return;
+  float seconds = millis / 1000.0f;
+
+  const std::unordered_map<Sint32, NetworkController::CodeStats>& stats =
+      NetworkController::get()->getStats();
+  std::vector<Sint32> codes;
+  for (auto& it : stats) codes.push_back(it.first);
+  std::sort(codes.begin(), codes.end());
+
+  char line[96];
+  std::string text = "code  out B/s msg/s split ser us  in B/s msg/s\n";
+  for (Sint32 code : codes) {
+    const NetworkController::CodeStats& curr = stats.at(code);
+    NetworkController::CodeStats prev = {};
+    auto it = _network_prev_stats.find(code);
+    if (it != _network_prev_stats.end()) prev = it->second;
+
+    Uint64 sent = curr.messages_sent - prev.messages_sent;
+    Uint64 received = curr.messages_received - prev.messages_received;
+    if (sent == 0 && received == 0) continue;
+    Uint64 serialize = curr.serialize_micros - prev.serialize_micros;
+    snprintf(line, sizeof(line), "%4d %8.0f %5.1f %5llu %6llu %7.0f %5.1f\n",
+             code, (curr.bytes_sent - prev.bytes_sent) / seconds,
+             sent / seconds, (unsigned long long)(curr.splits - prev.splits),
+             (unsigned long long)(sent > 0 ? serialize / sent : 0),
+             (curr.bytes_received - prev.bytes_received) / seconds,
+             received / seconds);
+    text += line;
+  }
+
+  std::shared_ptr<cugl::NetworkConnection> network =
+      NetworkController::get()->getConnection();
+  if (network != nullptr) {
+    for (int id = 0; id < network->getTotalPlayers(); id++) {
+      cugl::NetworkTransport::PeerStats peer;
+      if (!NetworkController::get()->getPeerStats(id, peer)) continue;
+      snprintf(line, sizeof(line), "peer %d: rtt %d ms, loss %.1f%% (%.1f%%)\n",
+               id, peer.ping, peer.lossLastSecond * 100,
+               peer.lossTotal * 100);
+      text += line;
+    }
+  }
+  _network_label->setText(text);
+
+  _network_prev_stats = stats;
+  _network_prev_time = now;
+}
+
 void GameScene::updateCamera(float timestep) {
   if (_settings_scene->isActive()) return;
 
@@ -3,6 +3,7 @@
 #include <box2d/b2_world_callbacks.h>
 #include <cugl/cugl.h>
 
+#include "../controllers/Animator.h"
 #include "../controllers/Controller.h"
 #include "../controllers/InputController.h"
 #include "../controllers/LevelController.h"
@@ -16,7 +17,9 @@
 #include "../controllers/enemies/TurtleController.h"
 #include "../generators/LevelGenerator.h"
 #include "../models/Player.h"
+#include "../network/InputPredictor.h"
 #include "../network/NetworkController.h"
+#include "../network/SendScheduler.h"
 #include "SettingsScene.h"
 
 class GameScene : public cugl::Scene2 {
@@ -54,6 +57,15 @@ class GameScene : public cugl::Scene2 {
   /** Reference to the debug root of the scene graph. */
   std::shared_ptr<cugl::scene2::SceneNode> _debug_node;
 
+  /** The overlay listing the profiled scopes of the last frame. */
+  std::shared_ptr<cugl::scene2::Label> _profiler_label;
+  /** The overlay listing the network traffic of each message code. */
+  std::shared_ptr<cugl::scene2::Label> _network_label;
+  /** The network traffic when the network overlay was last refreshed. */
+  std::unordered_map<Sint32, NetworkController::CodeStats> _network_prev_stats;
+  /** When the network overlay was last refreshed. */
+  cugl::Timestamp _network_prev_time;
+
   /** Reference to the role screen scene graph. */
   std::shared_ptr<cugl::scene2::Button> _role_layer;
 
@@ -79,6 +91,9 @@ class GameScene : public cugl::Scene2 {
   /** A reference to the particle controller. */
   std::shared_ptr<ParticleController> _particle_controller;
 
+  /** The animator for the player and enemy sprites. */
+  std::shared_ptr<Animator> _animator;
+
   /** The level controller for the game*/
   std::shared_ptr<LevelController> _level_controller;
   /** The terminal controller for voting in the game. */
@@ -101,6 +116,9 @@ class GameScene : public cugl::Scene2 {
   /** Whether this player is the host. */
   bool _ishost;
 
+  /** Whether only the simulation runs, as on a dedicated host. */
+  bool _headless;
+
   /** Whether this player is a betrayer. */
   bool _is_betrayer;
 
@@ -122,13 +140,16 @@ class GameScene : public cugl::Scene2 {
   /** The display name of my player. */
   std::string _display_name;
 
-  /** Timestamp so unimportant enemy info isn't sent. */
-  cugl::Timestamp _time_of_last_enemy_other_info_update;
+  /** Chooses the player and enemy updates the host sends to each client. */
+  SendScheduler _send_scheduler;
   /** A list of enemy IDs to die. */
   std::vector<int> _dead_enemy_cache;
 
-  /** Timestamp so unimportant player info isn't sent every tick. */
-  cugl::Timestamp _time_of_last_player_other_info_update;
+  /** The inputs of this client the host has not confirmed. */
+  std::shared_ptr<InputPredictor> _input_predictor;
+  /** The last input acknowledgement the host sent to each client. */
+  std::unordered_map<int, Uint32> _sent_input_acks;
+
   /** If the has sent play basic_info to all clients. */
   bool _has_sent_player_basic_info;
 
@@ -138,7 +159,7 @@ class GameScene : public cugl::Scene2 {
   ParticleProps _deposit_particle_regular, _deposit_particle_corrupted;
 
  public:
-  GameScene() : cugl::Scene2() {}
+  GameScene() : cugl::Scene2(), _headless(false) {}
 
   /**
    * Disposes of all resources allocated to this mode.
@@ -178,6 +199,29 @@ class GameScene : public cugl::Scene2 {
    */
   void setDebug(bool value) { _debug_node->setVisible(value); }
 
+  /**
+   * Sets whether the frame profiler is recording.
+   *
+   * Turning the profiler on clears old events and shows the profiler
+   * overlay. Turning it off hides the overlay and writes everything recorded
+   * to a Chrome trace file in the save directory, so a trace can be pulled
+   * off the device and attached to a bug report.
+   *
+   * @param value whether the profiler is recording.
+   */
+  void setProfiling(bool value);
+
+  /**
+   * Refreshes the profiler overlay with the scopes of the last frame.
+   */
+  void updateProfilerOverlay();
+
+  /**
+   * Refreshes the network overlay with the traffic of each message code over
+   * the last second, and the round trip time and loss of each peer.
+   */
+  void updateNetworkOverlay();
+
   /**
    * Populate the scene with the Box2D objects.
    *
@@ -207,6 +251,21 @@ class GameScene : public cugl::Scene2 {
    */
   void update(float timestep) override;
 
+  /**
+   * Updates the input of my player, before the players are updated.
+   */
+  void updateInput();
+
+  /**
+   * Updates the map, the settings menu and the abilities of my player.
+   */
+  void updateAbilities();
+
+  /**
+   * Updates the health and energy bars and the labels of the HUD.
+   */
+  void updateHUD();
+
   /**
    * This method serves as a helper to updating all the enemies
    *
@@ -287,6 +346,24 @@ class GameScene : public cugl::Scene2 {
     return all_enemy_update_rooms;
   }
 
+  /**
+   * Returns an unordered set of the room ids a player in the given room needs
+   * enemy updates for: the room itself and the rooms connected to it.
+   *
+   * @param room_id The room the player is in.
+   */
+  std::unordered_set<int> getRelevantRoomIds(int room_id) {
+    std::unordered_set<int> relevant_rooms;
+    if (room_id == -1) return relevant_rooms;
+
+    relevant_rooms.emplace(room_id);
+    auto room = _level_controller->getLevelModel()->getRoom(room_id);
+    for (auto room_map : room->getAllConnectedRooms()) {
+      relevant_rooms.emplace(room_map.second);
+    }
+    return relevant_rooms;
+  }
+
   /**
    * Draws all this scene to the given SpriteBatch.
    *
@@ -330,6 +407,18 @@ class GameScene : public cugl::Scene2 {
     NetworkController::get()->setIsHost(host);
   }
 
+  /**
+   * Sets whether only the simulation runs, for a dedicated host.
+   *
+   * A headless scene builds the level, the players, the enemies and the
+   * physics world, and keeps them in sync over the network, but it has no
+   * HUD, input, sound, particles or camera. The host's own player becomes a
+   * spectator. This must be set before {@link #init}.
+   *
+   * @param headless  Whether only the simulation runs.
+   */
+  void setHeadless(bool headless) { _headless = headless; }
+
   /**
    * Sets whether the player is a betrayer or cooperator.
    *
@@ -378,6 +467,9 @@ class GameScene : public cugl::Scene2 {
   /**
    * Broadcasts enemy being hit to the host.
    *
+   * A client applies the damage right away, but never kills the enemy, which
+   * is left to the host.
+   *
    * @param player_id the player that hit the enemy
    * @param enemy_id the enemy that was hit
    * @param amount the amount of damage taken
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <sstream>
 
+#include "LoadingLevelScene.h"
+
 #pragma mark -
 #pragma mark Level Layout
 
@@ -127,16 +129,18 @@ void HostLobbyScene::setActive(
       _status = WAIT;
       _network = network;
       _name->setText("");
-      _name->activate();
-      _startgame->activate();
-      _backout->activate();
+      if (!_dedicated) {
+        _name->activate();
+        _startgame->activate();
+        _backout->activate();
+        _copy->activate();
+      }
 
       _names_set->setVisible(false);
       _names_in_use->setVisible(false);
       _names_success->setVisible(false);
       _names_waiting->setVisible(false);
 
-      _copy->activate();
       _copy_tooltip->setVisible(false);
       _copy_tooltip_lifetime = 0;
 
@@ -165,7 +169,7 @@ void HostLobbyScene::setActive(
 }
 
 void HostLobbyScene::startGame() {
-  if (_player_id_to_name.size() < _network->getNumPlayers()) {
+  if (!canStartGame()) {
     _names_waiting->setVisible(true);
     return;
   }
@@ -175,10 +179,13 @@ void HostLobbyScene::startGame() {
 
   std::random_device my_random_device;
   _seed = my_random_device();
+  _layout_hash =
+      LoadingLevelScene::getLayoutHash(_seed, _network->getNumPlayers());
 
   // Send individual player information.
   _serializer.writeSint32(255);
   _serializer.writeUint64(_seed);
+  _serializer.writeUint64(_layout_hash);
   std::vector<uint8_t> msg = _serializer.serialize();
   _serializer.reset();
 
@@ -193,7 +200,8 @@ void HostLobbyScene::update(float timestep) {
         [this](const std::vector<uint8_t>& data) { processData(data); });
     checkConnection();
 
-    if (_player_id_to_name.size() == _network->getNumPlayers()) {
+    if (static_cast<int>(_player_id_to_name.size()) ==
+        getNumPlayingPlayers()) {
       _names_in_use->setVisible(false);
       _names_waiting->setVisible(false);
       _names_success->setVisible(true);
@@ -338,7 +346,7 @@ void HostLobbyScene::determineAndSendRoles() {
   // determine number of betrayers for number of connected players
   // TODO make this a constant somewhere
   int num_betrayers_per_num_players[8] = {1, 1, 1, 1, 2, 2, 2, 2};
-  int num_players = _network->getNumPlayers();
+  int num_players = getNumPlayingPlayers();
   int num_betrayers = num_betrayers_per_num_players[num_players - 1];
 
   // assign betrayers randomly
@@ -364,7 +372,8 @@ void HostLobbyScene::determineAndSendRoles() {
   // this is necessary if any players disconnect in the lobby, as a player might
   // have an id that is >= numPlayers.
   int num_player_ids_found = 0;
-  int current_id = 0;
+  // A dedicated host (id 0) never plays, so it is never a betrayer.
+  int current_id = _dedicated ? 1 : 0;
   int player_ids[8] = {};  // 8 is max number of players
   while (num_player_ids_found < num_players) {
     if (_network->isPlayerActive(current_id)) {
@@ -420,7 +429,8 @@ void HostLobbyScene::determineAndSendRoles() {
 }
 
 void HostLobbyScene::determineAndSendColors() {
-  int num_players = _network->getNumPlayers();
+  int num_players = getNumPlayingPlayers();
+  int first_id = _dedicated ? 1 : 0;
 
   auto info = cugl::JsonValue::allocArray();
 
@@ -430,7 +440,7 @@ void HostLobbyScene::determineAndSendColors() {
   std::default_random_engine generator(rd());
   std::uniform_real_distribution<float> dist(0.f, 1.f);
 
-  for (int i = 0; i < num_players; i++) {
+  for (int i = first_id; i < first_id + num_players; i++) {
     auto player_info = cugl::JsonValue::allocObject();
 
     int color_ii = (int)(dist(generator) * colors.size() - 1.f);
@@ -30,13 +30,16 @@ class HostLobbyScene : public PeerLobbyScene {
   /** The number of players in the game. */
   int _num_of_players;
 
+  /** Whether the host runs the game without playing in it. */
+  bool _dedicated;
+
  public:
 #pragma mark -
 #pragma mark Constructors
   /**
    * Creates a new host scene with the default values.
    */
-  HostLobbyScene() : PeerLobbyScene() {}
+  HostLobbyScene() : PeerLobbyScene(), _dedicated(false) {}
 
   /**
    * Disposes of all (non-static) resources allocated to this mode.
@@ -79,6 +82,37 @@ class HostLobbyScene : public PeerLobbyScene {
    */
   virtual void setGameId(string id) { _gameid->setText(id); };
 
+  /**
+   * Sets whether the host runs the game without playing in it.
+   *
+   * A dedicated host has no name, role or color, and its lobby buttons are
+   * never activated, so it can run without input. This must be set before
+   * the scene is activated.
+   *
+   * @param value Whether the host runs the game without playing in it.
+   */
+  void setDedicated(bool value) { _dedicated = value; }
+
+  /**
+   * @return The number of connected players that play in the game.
+   */
+  int getNumPlayingPlayers() const {
+    return _network->getNumPlayers() - (_dedicated ? 1 : 0);
+  }
+
+  /**
+   * @return If every playing player has submitted a name.
+   */
+  bool canStartGame() const {
+    return static_cast<int>(_player_id_to_name.size()) >=
+           getNumPlayingPlayers();
+  }
+
+  /**
+   * Starts the game.
+   */
+  void startGame();
+
  private:
   /**
    * Checks that the network connection is still active.
@@ -119,11 +153,6 @@ class HostLobbyScene : public PeerLobbyScene {
   HostResponse processReceivedPlayerName(const int player_id,
                                          const std::string& name);
 
-  /**
-   * Starts the game.
-   */
-  void startGame();
-
   /**
    * Determine the roles of all the players before the game starts.
    * Afterwards, send number of betrayers and ids to all clients.
@@ -5,6 +5,27 @@
 #include "../generators/LevelGeneratorConfig.h"
 
 #define SCENE_HEIGHT 720
+/** The time in milliseconds the main thread may spend on room layout a frame. */
+#define LAYOUT_BUDGET_MS 8
+/** The fraction of the progress bar for generating the level. */
+#define GENERATE_PROGRESS 0.1f
+/** The fraction of the progress bar for building the room scene2 graphs. */
+#define BUILD_PROGRESS 0.7f
+/** The fraction of the progress bar for laying out the room scene2 graphs. */
+#define LAYOUT_PROGRESS 0.2f
+
+namespace {
+
+/**
+ * Returns the number of rooms in a level.
+ * @param num_players The number of players in the game.
+ * @return The number of rooms in a level for that many players.
+ */
+int getNumRooms(int num_players) {
+  return 25 + 6 * (std::max(num_players, 3) - 3);
+}
+
+}  // namespace
 
 bool LoadingLevelScene::init(
     const std::shared_ptr<cugl::AssetManager>& assets) {
@@ -32,6 +53,7 @@ bool LoadingLevelScene::init(const std::shared_ptr<cugl::AssetManager>& assets,
   _map->addChild(map_bkg);
 
   auto map_rooms = cugl::scene2::SceneNode::alloc();
+  map_rooms->setName("map_rooms");
   _map->addChild(map_rooms);
 
   auto rooms = cugl::scene2::SceneNode::alloc();
@@ -41,45 +63,138 @@ bool LoadingLevelScene::init(const std::shared_ptr<cugl::AssetManager>& assets,
   map_rooms->addChild(edges);
   map_rooms->addChild(rooms);
 
-  _config.setNumRooms(25 + 6 * (std::max(num_players, 3) - 3));
+  _config.setNumRooms(getNumRooms(num_players));
   _level_generator = std::make_shared<level_gen::LevelGenerator>();
-  _level_generator->init(_config, map_rooms, seed);
+  _level_generator->init(_config, seed);
 
   _map->doLayout();
   cugl::Scene2::addChild(_map);
 
+  auto energy_fill = _assets->get<cugl::Texture>("energy-fill-small");
+  auto energy_bar = _assets->get<cugl::Texture>("energy-bar-small");
+  auto energy_outline = _assets->get<cugl::Texture>("energy-outline-small");
+
+  _progress_bar = cugl::scene2::ProgressBar::alloc(energy_fill, energy_bar);
+  _progress_bar->addChild(
+      cugl::scene2::PolygonNode::allocWithTexture(energy_outline));
+  _progress_bar->setForegroundColor(cugl::Color4("#9ec1de"));
+  _progress_bar->setAnchor(cugl::Vec2::ANCHOR_BOTTOM_CENTER);
+  _progress_bar->setScale(4.0f);
+  _progress_bar->setPosition(dim.width / 2, dim.height * 0.05f);
+  _progress_bar->setProgress(0.0f);
+  cugl::Scene2::addChild(_progress_bar);
+
+  _generated = false;
+  _num_rooms = 0;
+  _num_rooms_built = 0;
+  _num_rooms_laid_out = 0;
+
+  _worker = cugl::ThreadPool::alloc(1);
+  _worker->addTask([this]() { this->generateLevel(); });
+
   return true;
 }
 
+Uint64 LoadingLevelScene::getLayoutHash(Uint64 seed, int num_players) {
+  level_gen::LevelGeneratorConfig config;
+  config.setNumRooms(getNumRooms(num_players));
+  level_gen::LevelGenerator generator;
+  generator.init(config, seed);
+  while (generator.update()) {
+  }
+  return generator.getLayoutHash();
+}
+
 void LoadingLevelScene::dispose() {
   if (_active) return;
   _active = false;
+  if (_worker != nullptr) {
+    // Blocks until the worker has finished with the level generator.
+    _worker->dispose();
+    _worker = nullptr;
+  }
   _level_generator = nullptr;
   _map = nullptr;
+  _progress_bar = nullptr;
   _loading_phase = GENERATE_ROOMS;
 }
 
+void LoadingLevelScene::generateLevel() {
+  while (_level_generator->update()) {
+  }
+
+  std::vector<std::shared_ptr<level_gen::Room>> rooms =
+      _level_generator->getRooms();
+  _num_rooms = static_cast<int>(rooms.size());
+
+  // Scene2Loader::build is safe off the main thread, the asset manager uses
+  // it the same way for asynchronous scene2 loading.
+  auto loader = std::dynamic_pointer_cast<cugl::Scene2Loader>(
+      _assets->access<cugl::scene2::SceneNode>());
+
+  // Many rooms share a layout, and building never modifies the json, so each
+  // layout file is only read and parsed once. Rooms are built straight from
+  // the parsed document.
+  std::unordered_map<std::string, std::shared_ptr<cugl::JsonDocument>> layouts;
+
+  for (int i = 0; i < rooms.size(); i++) {
+    std::shared_ptr<level_gen::Room> room = rooms[i];
+    room->_key = i;
+
+    auto it = layouts.find(room->_scene2_source);
+    if (it == layouts.end()) {
+      auto reader = cugl::JsonReader::allocWithAsset(room->_scene2_source);
+      auto doc = (reader == nullptr ? nullptr : reader->readJsonDocument());
+      if (doc == nullptr) {
+        CULogError("Could not read room %s", room->_scene2_source.c_str());
+      }
+      it = layouts.emplace(room->_scene2_source, doc).first;
+    }
+    // A room without a layout is skipped, and has no scene graph.
+    if (it->second != nullptr) {
+      room->_level_node = loader->build("", *it->second, it->second->root());
+    }
+    _num_rooms_built++;
+  }
+
+  _generated = true;
+}
+
+float LoadingLevelScene::getProgress() const {
+  float progress = 0.0f;
+  if (_num_rooms > 0) {
+    progress += GENERATE_PROGRESS;
+    progress += BUILD_PROGRESS * _num_rooms_built / _num_rooms;
+    progress += LAYOUT_PROGRESS * _num_rooms_laid_out / _num_rooms;
+  }
+  return progress;
+}
+
 void LoadingLevelScene::update(float timestep) {
   cugl::Application::get()->setClearColor(cugl::Color4(230, 228, 211));
   switch (_loading_phase) {
     case GENERATE_ROOMS:
-      if (!_level_generator->update()) {
-        _loading_phase = LOAD_ROOM_SCENE2;
-
-        std::vector<std::shared_ptr<level_gen::Room>> rooms =
-            _level_generator->getRooms();
-
-        for (int i = 0; i < rooms.size(); i++) {
-          std::shared_ptr<level_gen::Room> room = rooms[i];
-          room->_key = i;
-          auto loader = std::dynamic_pointer_cast<cugl::Scene2Loader>(
-              _assets->access<cugl::scene2::SceneNode>());
-          auto reader = cugl::JsonReader::allocWithAsset(room->_scene2_source);
-          auto json = (reader == nullptr ? nullptr : reader->readJson());
-          room->_level_node = loader->build("", json);
-        }
+      if (_generated) {
+        _loading_phase = LAYOUT_ROOMS;
+        _level_generator->buildMap(_map->getChildByName("map_rooms"));
       }
       break;
+    case LAYOUT_ROOMS: {
+      std::vector<std::shared_ptr<level_gen::Room>> rooms =
+          _level_generator->getRooms();
+
+      cugl::Timestamp start;
+      while (_num_rooms_laid_out < rooms.size() &&
+             cugl::Timestamp().ellapsedMillis(start) < LAYOUT_BUDGET_MS) {
+        auto node = rooms[_num_rooms_laid_out]->_level_node;
+        if (node != nullptr) node->doLayout();
+        _num_rooms_laid_out++;
+      }
+
+      if (_num_rooms_laid_out == rooms.size()) {
+        _loading_phase = LOAD_ROOM_SCENE2;
+      }
+    } break;
     case LOAD_ROOM_SCENE2:
       if (_assets->progress() >= 1) {
         _loading_phase = DONE;
@@ -89,6 +204,8 @@ void LoadingLevelScene::update(float timestep) {
       _active = false;
       break;
   }
+
+  _progress_bar->setProgress(getProgress());
 }
 
 void LoadingLevelScene::render(
@@ -2,6 +2,8 @@
 #define SCENES_LEVEL_GENERATION_DEMO_SCENE_H
 #include <cugl/cugl.h>
 
+#include <atomic>
+
 #include "../generators/LevelGenerator.h"
 #include "../generators/LevelGeneratorConfig.h"
 #include "../models/level_gen/Room.h"
@@ -17,6 +19,26 @@ class LoadingLevelScene : public cugl::Scene2 {
   /** A reference to the scene2 map for rendering. */
   std::shared_ptr<cugl::scene2::SceneNode> _map;
 
+  /** A reference to the progress bar for the level loading. */
+  std::shared_ptr<cugl::scene2::ProgressBar> _progress_bar;
+
+  /** A worker thread that generates the level and builds the room scene2
+   * graphs, so the main thread never stalls on them. */
+  std::shared_ptr<cugl::ThreadPool> _worker;
+
+  /** If the worker is done generating the level and building the rooms. The
+   * level generator and rooms must not be touched until this is set. */
+  std::atomic<bool> _generated;
+
+  /** The number of rooms in the generated level, or 0 while generating. */
+  std::atomic<int> _num_rooms;
+
+  /** The number of room scene2 graphs that the worker has built. */
+  std::atomic<int> _num_rooms_built;
+
+  /** The number of room scene2 graphs that have been laid out. */
+  int _num_rooms_laid_out;
+
   /** A reference to the assets for the game. */
   std::shared_ptr<cugl::AssetManager> _assets;
 
@@ -27,8 +49,11 @@ class LoadingLevelScene : public cugl::Scene2 {
   bool _ishost;
 
   enum {
-    /** Generate Rooms using the Level Generator. */
+    /** Generate Rooms using the Level Generator and build their scene2 graphs
+     * on the worker thread. */
     GENERATE_ROOMS,
+    /** Lay out the room scene2 graphs a few at a time on the main thread. */
+    LAYOUT_ROOMS,
     /** Load in all the used room scene2 graphs. */
     LOAD_ROOM_SCENE2,
     /** Level loader is done. */
@@ -37,7 +62,13 @@ class LoadingLevelScene : public cugl::Scene2 {
 
  public:
   /** Initializes the level generation scene2. */
-  LoadingLevelScene() : cugl::Scene2(), _loading_phase(GENERATE_ROOMS) {}
+  LoadingLevelScene()
+      : cugl::Scene2(),
+        _generated(false),
+        _num_rooms(0),
+        _num_rooms_built(0),
+        _num_rooms_laid_out(0),
+        _loading_phase(GENERATE_ROOMS) {}
 
   /** Disposes of all resources allocated to this mode. */
   ~LoadingLevelScene() { dispose(); }
@@ -71,6 +102,19 @@ class LoadingLevelScene : public cugl::Scene2 {
   bool init(const std::shared_ptr<cugl::AssetManager>& assets, Uint64 seed,
             int num_players);
 
+  /**
+   * Returns the hash of the level layout generated from the given seed.
+   *
+   * The host sends this with the seed, so clients can check that they built
+   * the same level. Only the layout is generated, which is cheap enough to do
+   * on the main thread.
+   *
+   * @param seed        The seed to be used in the map generation
+   * @param num_players The number of players in the game.
+   * @return The hash of the level layout.
+   */
+  static Uint64 getLayoutHash(Uint64 seed, int num_players);
+
   /**
    * The method called to update the level loading mode.
    *
@@ -78,6 +122,14 @@ class LoadingLevelScene : public cugl::Scene2 {
    */
   void update(float timestep) override;
 
+  /**
+   * Returns the progress of the level loading, including the level generation,
+   * the building of the room scene2 graphs and their layout.
+   *
+   * @return The progress of the level loading in the range [0, 1].
+   */
+  float getProgress() const;
+
   /**
    * Draws all this scene to the given SpriteBatch.
    *
@@ -158,6 +210,13 @@ class LoadingLevelScene : public cugl::Scene2 {
    * Get the map scene2 node.
    */
   std::shared_ptr<cugl::scene2::SceneNode> getMap() { return _map; }
+
+ private:
+  /**
+   * Run the level generator to completion, and build the scene2 graph for
+   * every room. This is run on the worker thread.
+   */
+  void generateLevel();
 };
 
 #endif /* SCENES_LEVEL_GENERATION_DEMO_SCENE_H */
@@ -61,6 +61,9 @@ class PeerLobbyScene : public cugl::Scene2 {
   /** The map seed. */
   Uint64 _seed;
 
+  /** The hash of the level layout the host generated from the map seed. */
+  Uint64 _layout_hash;
+
   /** If the user is a betrayer (true) or cooperator (false). */
   bool _is_betrayer;
 
@@ -135,6 +138,12 @@ class PeerLobbyScene : public cugl::Scene2 {
    */
   Uint64 getSeed() { return _seed; }
 
+  /**
+   * Returns the hash of the level layout the host generated from the seed.
+   * @return The hash of the level layout
+   */
+  Uint64 getLayoutHash() { return _layout_hash; }
+
   /**
    * Returns the player name to be used in game.
    * @return The player name
@@ -119,6 +119,19 @@ class PeerScene : public cugl::Scene2 {
    */
   std::string getGameId() const { return _gameid->getText(); }
 
+  /**
+   * Sets the transport for the connections made by this scene.
+   *
+   * This must be called after init, which reads the server configuration.
+   * Use the factory of a cugl::LoopbackNetwork to connect to other peers in
+   * the same process without a punchthrough server.
+   *
+   * @param transport The transport factory, or empty for the default
+   */
+  void setTransport(const cugl::NetworkTransport::Factory& transport) {
+    _config.transport = transport;
+  }
+
   /**
    * The method called to update the scene by constantly talking to the server
    *